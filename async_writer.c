@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+
+#include "./async_writer.h"
+#include "./vpx_config.h"
+#include "vpx_util/vpx_thread.h"
+
+struct AsyncWriter {
+  async_writer_fn write;
+  void *priv;
+  void **items;
+  int capacity;
+  int head;
+  int count;
+  // Set while the writer thread is writing an item it took off the queue.
+  int busy;
+  int done;
+  // Set once an item has failed to be written.
+  int failed;
+#if CONFIG_MULTITHREAD
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  // Signalled when an item is queued or the writer is destroyed.
+  pthread_cond_t queued;
+  // Signalled when an item has been written.
+  pthread_cond_t written;
+#endif
+};
+
+#if CONFIG_MULTITHREAD
+static THREADFN writer_thread(void *arg) {
+  struct AsyncWriter *const writer = (struct AsyncWriter *)arg;
+
+  pthread_mutex_lock(&writer->mutex);
+  for (;;) {
+    void *item;
+    int ok;
+
+    while (writer->count == 0 && !writer->done)
+      pthread_cond_wait(&writer->queued, &writer->mutex);
+    if (writer->count == 0)
+      break;
+    item = writer->items[writer->head];
+    writer->head = (writer->head + 1) % writer->capacity;
+    --writer->count;
+    writer->busy = 1;
+    pthread_mutex_unlock(&writer->mutex);
+
+    ok = writer->write(item, writer->priv);
+
+    pthread_mutex_lock(&writer->mutex);
+    if (!ok)
+      writer->failed = 1;
+    writer->busy = 0;
+    pthread_cond_signal(&writer->written);
+  }
+  pthread_mutex_unlock(&writer->mutex);
+  return THREAD_RETURN(NULL);
+}
+#endif
+
+struct AsyncWriter *async_writer_create(int capacity,
+                                        async_writer_fn write_item,
+                                        void *priv) {
+  struct AsyncWriter *const writer =
+      (struct AsyncWriter *)calloc(1, sizeof(*writer));
+
+  if (writer == NULL)
+    return NULL;
+  writer->write = write_item;
+  writer->priv = priv;
+#if CONFIG_MULTITHREAD
+  writer->capacity = capacity > 0 ? capacity : 1;
+  writer->items = (void **)calloc(writer->capacity, sizeof(*writer->items));
+  if (writer->items == NULL) {
+    free(writer);
+    return NULL;
+  }
+  pthread_mutex_init(&writer->mutex, NULL);
+  pthread_cond_init(&writer->queued, NULL);
+  pthread_cond_init(&writer->written, NULL);
+  if (pthread_create(&writer->thread, NULL, writer_thread, writer)) {
+    pthread_cond_destroy(&writer->written);
+    pthread_cond_destroy(&writer->queued);
+    pthread_mutex_destroy(&writer->mutex);
+    free(writer->items);
+    free(writer);
+    return NULL;
+  }
+#else
+  (void)capacity;
+#endif
+  return writer;
+}
+
+int async_writer_push(struct AsyncWriter *writer, void *item) {
+#if CONFIG_MULTITHREAD
+  int ok;
+
+  pthread_mutex_lock(&writer->mutex);
+  while (writer->count == writer->capacity)
+    pthread_cond_wait(&writer->written, &writer->mutex);
+  writer->items[(writer->head + writer->count) % writer->capacity] = item;
+  ++writer->count;
+  pthread_cond_signal(&writer->queued);
+  ok = !writer->failed;
+  pthread_mutex_unlock(&writer->mutex);
+  return ok;
+#else
+  if (!writer->write(item, writer->priv))
+    writer->failed = 1;
+  return !writer->failed;
+#endif
+}
+
+int async_writer_flush(struct AsyncWriter *writer) {
+#if CONFIG_MULTITHREAD
+  int ok;
+
+  pthread_mutex_lock(&writer->mutex);
+  while (writer->count > 0 || writer->busy)
+    pthread_cond_wait(&writer->written, &writer->mutex);
+  ok = !writer->failed;
+  pthread_mutex_unlock(&writer->mutex);
+  return ok;
+#else
+  return !writer->failed;
+#endif
+}
+
+int async_writer_destroy(struct AsyncWriter *writer) {
+  int ok;
+
+  if (writer == NULL)
+    return 1;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&writer->mutex);
+  writer->done = 1;
+  pthread_cond_signal(&writer->queued);
+  pthread_mutex_unlock(&writer->mutex);
+  pthread_join(writer->thread, NULL);
+  pthread_cond_destroy(&writer->written);
+  pthread_cond_destroy(&writer->queued);
+  pthread_mutex_destroy(&writer->mutex);
+  free(writer->items);
+#endif
+  ok = !writer->failed;
+  free(writer);
+  return ok;
+}
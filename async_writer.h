@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef ASYNC_WRITER_H_
+#define ASYNC_WRITER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Writes items on a thread of its own, in the order they were queued. The
+// queue is bounded, so a producer that outpaces the output blocks instead of
+// buffering without limit. Without multithreading the items are written when
+// they are queued.
+struct AsyncWriter;
+
+// Writes |item| and releases it. Only ever called on the writer thread.
+// Returns 0 if |item| could not be written. Errors are reported back to the
+// thread that queues the items, which decides how to handle them.
+typedef int (*async_writer_fn)(void *item, void *priv);
+
+// Returns NULL if the writer can not be created.
+struct AsyncWriter *async_writer_create(int capacity,
+                                        async_writer_fn write_item,
+                                        void *priv);
+
+// Returns 0 once any of the items queued so far failed to be written.
+int async_writer_push(struct AsyncWriter *writer, void *item);
+
+// Returns once all the queued items have been written, 0 if any of them
+// failed to be written.
+int async_writer_flush(struct AsyncWriter *writer);
+
+// Writes the remaining items and frees |writer|. Returns 0 if any of the
+// items failed to be written.
+int async_writer_destroy(struct AsyncWriter *writer);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif  // ASYNC_WRITER_H_
@@ -1174,8 +1174,15 @@ EOF
             7|8|9|10)
               echo "${tgt_cc} does not support avx/avx2, disabling....."
               RTCD_OPTIONS="${RTCD_OPTIONS}--disable-avx --disable-avx2 "
+              RTCD_OPTIONS="${RTCD_OPTIONS}--disable-avx512 "
               soft_disable avx
               soft_disable avx2
+              soft_disable avx512
+              ;;
+            11|12|14)
+              echo "${tgt_cc} does not support avx512, disabling....."
+              RTCD_OPTIONS="${RTCD_OPTIONS}--disable-avx512 "
+              soft_disable avx512
               ;;
           esac
           ;;
@@ -1206,6 +1213,7 @@ EOF
       check_gcc_machine_option sse4 sse4_1
       check_gcc_machine_option avx
       check_gcc_machine_option avx2
+      check_gcc_machine_option avx512bw avx512
 
       case "${AS}" in
         auto|"")
@@ -107,7 +107,9 @@ generate_filter() {
                     # Separate file names with Condition?
                     tag_content ObjectFileName "\$(IntDir)$objf"
                     # Check for AVX and turn it on to avoid warnings.
-                    if [[ $f =~ avx.?\.c$ ]]; then
+                    if [[ $f =~ avx512\.c$ ]]; then
+                        tag_content AdditionalOptions "/arch:AVX512"
+                    elif [[ $f =~ avx.?\.c$ ]]; then
                         tag_content AdditionalOptions "/arch:AVX"
                     fi
                     close_tag ClCompile
@@ -166,6 +166,49 @@ sub declare_function_pointers {
   }
 }
 
+sub declare_variant_list {
+  my $list = uc($opts{sym})."_VARIANTS";
+  print <<EOF;
+/* Expands to X(function, variant_function, variant, cpu_flag, return_type,
+ * (arguments)) for every variant of every function. */
+#define ${list}(X) \\
+EOF
+  foreach my $fn (sort keys %ALL_FUNCS) {
+    my @val = @{$ALL_FUNCS{$fn}};
+    my $args = pop @val;
+    my $rtyp = "@val";
+    $args =~ s/\s+/ /g;
+    foreach my $opt (@_) {
+      my $ofn = eval "\$${fn}_${opt}";
+      next if !$ofn;
+      my $flag = eval "\$flag_${opt}";
+      $flag = "0" if !$flag;
+      print "  X($fn, $ofn, $opt, $flag, $rtyp, ($args)) \\\n";
+    }
+  }
+  print "\n";
+}
+
+# Reduces an argument list to its types, e.g.
+# "const uint8_t *src, int stride, const uint8_t *const ref[]" gives
+# "constuint8_t*,int,constuint8_t*const*".
+sub normalize_args {
+  my @types;
+  foreach my $arg (split /,/, $_[0]) {
+    $arg =~ s/^\s+|\s+$//g;
+    if ($arg =~ /\w+\s*\[\d*\]$/) {
+      $arg =~ s/\s*\w+\s*\[\d*\]$/*/;
+    } elsif ($arg =~ /^(.*\W)?\w+\s*\w+$/ || $arg =~ /[*]\s*\w+$/) {
+      $arg =~ s/\s*\w+$//;
+    }
+    $arg =~ s/\s+//g;
+    push @types, $arg;
+  }
+  return join(",", @types);
+}
+
+# Lists the variants linked for each indirect function, starting with the
+# default, and lets vpx_rtcd_select() pick among those the CPU supports.
 sub set_function_pointers {
   foreach my $fn (sort keys %ALL_FUNCS) {
     my @val = @{$ALL_FUNCS{$fn}};
@@ -174,16 +217,30 @@ sub set_function_pointers {
     my $dfn = eval "\$${fn}_default";
     $dfn = eval "\$${dfn}";
     if (eval "\$${fn}_indirect" eq "true") {
-      print "    $fn = $dfn;\n";
+      my @variants;
       foreach my $opt (@_) {
         my $ofn = eval "\$${fn}_${opt}";
         next if !$ofn;
-        next if "$ofn" eq "$dfn";
+        if ("$ofn" eq "$dfn") {
+          unshift @variants, "{ (rtcd_fn_t)$ofn, \"$opt\", 0 }";
+          next;
+        }
         my $link = eval "\$${fn}_${opt}_link";
         next if $link && $link eq "false";
-        my $cond = eval "\$have_${opt}";
-        print "    if (${cond}) $fn = $ofn;\n"
+        my $flag = eval "\$flag_${opt}";
+        $flag = "0" if !$flag;
+        push @variants, "{ (rtcd_fn_t)$ofn, \"$opt\", $flag }";
       }
+      my $proto = $rtyp.'('.normalize_args($args).')';
+      $proto =~ s/\s+//g;
+      my $num_variants = @variants;
+      print "    {\n";
+      print "      static const rtcd_variant_t variants[] = {\n";
+      print "        $_,\n" foreach (@variants);
+      print "      };\n";
+      print "      $fn = ($rtyp (*)($args))vpx_rtcd_select(\n";
+      print "          \"$fn\", \"$proto\", flags, variants, $num_variants);\n";
+      print "    }\n";
     }
   }
 }
@@ -225,6 +282,7 @@ print <<EOF;
 void $opts{sym}(void);
 
 EOF
+declare_variant_list("c", @ALL_ARCHS);
 }
 
 sub common_bottom() {
@@ -244,12 +302,13 @@ sub x86() {
   # Assign the helper variable for each enabled extension
   foreach my $opt (@ALL_ARCHS) {
     my $opt_uc = uc $opt;
-    eval "\$have_${opt}=\"flags & HAS_${opt_uc}\"";
+    eval "\$flag_${opt}=\"HAS_${opt_uc}\"";
   }
 
   common_top;
   print <<EOF;
 #ifdef RTCD_C
+#include "vpx_ports/rtcd_select.h"
 #include "vpx_ports/x86.h"
 static void setup_rtcd_internal(void)
 {
@@ -277,7 +336,7 @@ sub arm() {
     # Enable neon assembly based on HAVE_NEON logic instead of adding new
     # HAVE_NEON_ASM logic
     if ($opt eq 'neon_asm') { $opt_uc = 'NEON' }
-    eval "\$have_${opt}=\"flags & HAS_${opt_uc}\"";
+    eval "\$flag_${opt}=\"HAS_${opt_uc}\"";
   }
 
   common_top;
@@ -286,6 +345,7 @@ sub arm() {
 
 #ifdef RTCD_C
 #include "vpx_ports/arm.h"
+#include "vpx_ports/rtcd_select.h"
 static void setup_rtcd_internal(void)
 {
     int flags = arm_cpu_caps();
@@ -361,10 +421,10 @@ EOF
 
 &require("c");
 if ($opts{arch} eq 'x86') {
-  @ALL_ARCHS = filter(qw/mmx sse sse2 sse3 ssse3 sse4_1 avx avx2/);
+  @ALL_ARCHS = filter(qw/mmx sse sse2 sse3 ssse3 sse4_1 avx avx2 avx512/);
   x86;
 } elsif ($opts{arch} eq 'x86_64') {
-  @ALL_ARCHS = filter(qw/mmx sse sse2 sse3 ssse3 sse4_1 avx avx2/);
+  @ALL_ARCHS = filter(qw/mmx sse sse2 sse3 ssse3 sse4_1 avx avx2 avx512/);
   @REQUIRES = filter(keys %required ? keys %required : qw/mmx sse sse2/);
   &require(@REQUIRES);
   x86;
@@ -56,6 +56,7 @@ LIBWEBM_PARSER_SRCS = third_party/libwebm/mkvparser.cpp \
 # while EXAMPLES demonstrate specific portions of the API.
 UTILS-$(CONFIG_DECODERS)    += vpxdec.c
 vpxdec.SRCS                 += md5_utils.c md5_utils.h
+vpxdec.SRCS                 += async_writer.c async_writer.h
 vpxdec.SRCS                 += vpx_ports/mem_ops.h
 vpxdec.SRCS                 += vpx_ports/mem_ops_aligned.h
 vpxdec.SRCS                 += vpx_ports/msvc.h
@@ -65,6 +66,7 @@ vpxdec.SRCS                 += args.c args.h
 vpxdec.SRCS                 += ivfdec.c ivfdec.h
 vpxdec.SRCS                 += tools_common.c tools_common.h
 vpxdec.SRCS                 += y4menc.c y4menc.h
+vpxdec.SRCS                 += vpx_util/vpx_thread.h
 ifeq ($(CONFIG_LIBYUV),yes)
   vpxdec.SRCS                 += $(LIBYUV_SRCS)
 endif
@@ -77,8 +79,10 @@ vpxdec.GUID                  = BA5FE66F-38DD-E034-F542-B1578C5FB950
 vpxdec.DESCRIPTION           = Full featured decoder
 UTILS-$(CONFIG_ENCODERS)    += vpxenc.c
 vpxenc.SRCS                 += args.c args.h y4minput.c y4minput.h vpxenc.h
+vpxenc.SRCS                 += async_writer.c async_writer.h
 vpxenc.SRCS                 += ivfdec.c ivfdec.h
 vpxenc.SRCS                 += ivfenc.c ivfenc.h
+vpxenc.SRCS                 += mmapinput.c mmapinput.h
 vpxenc.SRCS                 += rate_hist.c rate_hist.h
 vpxenc.SRCS                 += tools_common.c tools_common.h
 vpxenc.SRCS                 += warnings.c warnings.h
@@ -87,6 +91,7 @@ vpxenc.SRCS                 += vpx_ports/mem_ops_aligned.h
 vpxenc.SRCS                 += vpx_ports/msvc.h
 vpxenc.SRCS                 += vpx_ports/vpx_timer.h
 vpxenc.SRCS                 += vpxstats.c vpxstats.h
+vpxenc.SRCS                 += vpx_util/vpx_thread.h
 ifeq ($(CONFIG_LIBYUV),yes)
   vpxenc.SRCS                 += $(LIBYUV_SRCS)
 endif
@@ -114,6 +119,22 @@ ifneq ($(CONFIG_SHARED),yes)
 EXAMPLES-$(CONFIG_VP9_ENCODER)    += resize_util.c
 endif
 
+# Uses library internals, so it can only link against the static library.
+ifneq ($(CONFIG_SHARED),yes)
+EXAMPLES-yes                      += vpx_bench.c
+vpx_bench.SRCS                    += vpx_ports/mem.h
+vpx_bench.SRCS                    += vpx_ports/vpx_timer.h
+vpx_bench.SRCS                    += vpx_ports/x86.h
+vpx_bench.DESCRIPTION              = Benchmark of the RTCD kernel variants
+endif
+
+EXAMPLES-$(CONFIG_ENCODERS)       += vpx_perf.c
+vpx_perf.SRCS                     += tools_common.h tools_common.c
+vpx_perf.SRCS                     += vpx_ports/msvc.h
+vpx_perf.SRCS                     += vpx_ports/vpx_timer.h
+vpx_perf.GUID                      = 359B16CE-74A2-456E-A987-F41A0392DEB0
+vpx_perf.DESCRIPTION               = Encode and decode throughput benchmark
+
 EXAMPLES-$(CONFIG_ENCODERS)          += vpx_temporal_svc_encoder.c
 vpx_temporal_svc_encoder.SRCS        += ivfenc.c ivfenc.h
 vpx_temporal_svc_encoder.SRCS        += tools_common.c tools_common.h
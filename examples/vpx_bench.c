@@ -0,0 +1,1104 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Times every variant (c, sse2, avx2, neon, ...) of the run time CPU
+// detected kernels of vpx_dsp and vp9, as listed by the *_VARIANTS macros
+// of the generated rtcd headers. The kernels are called through a runner
+// chosen by their prototype, so any kernel with a known prototype is covered
+// without further changes here.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#if CONFIG_VP9
+#include "./vp9_rtcd.h"
+#endif
+#include "vpx/vpx_integer.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/vpx_timer.h"
+#if ARCH_X86 || ARCH_X86_64
+#include "vpx_ports/x86.h"
+#elif ARCH_ARM
+#include "vpx_ports/arm.h"
+#endif
+
+typedef void (*rtcd_fn)(void);
+
+typedef struct {
+  const char *function;
+  const char *variant;
+  int cpu_flag;
+  const char *prototype;
+  rtcd_fn fn;
+} KernelVariant;
+
+#define KERNEL_VARIANT(function, variant_function, variant, cpu_flag, \
+                       return_type, args) \
+  { #function, #variant, cpu_flag, #return_type #args, \
+    (rtcd_fn)variant_function },
+
+static const KernelVariant kKernels[] = {
+  VPX_DSP_RTCD_VARIANTS(KERNEL_VARIANT)
+#if CONFIG_VP9
+  VP9_RTCD_VARIANTS(KERNEL_VARIANT)
+#endif
+};
+
+#define NUM_KERNELS ((int)(sizeof(kKernels) / sizeof(kKernels[0])))
+
+// The variant each function dispatches to on this CPU.
+static void get_dispatched(rtcd_fn *dispatched) {
+  int i = 0;
+#define DISPATCHED_VARIANT(function, variant_function, variant, cpu_flag, \
+                           return_type, args) \
+  dispatched[i++] = (rtcd_fn)function;
+  VPX_DSP_RTCD_VARIANTS(DISPATCHED_VARIANT)
+#if CONFIG_VP9
+  VP9_RTCD_VARIANTS(DISPATCHED_VARIANT)
+#endif
+#undef DISPATCHED_VARIANT
+}
+
+static int get_cpu_flags(void) {
+#if ARCH_X86 || ARCH_X86_64
+  return x86_simd_caps();
+#elif ARCH_ARM
+  return arm_cpu_caps();
+#else
+  return 0;
+#endif
+}
+
+// Frame-like buffers: kStride x kRows, with the blocks placed kBorder pixels
+// in, so that kernels may read around them.
+#define kStride 192
+#define kRows 192
+#define kBorder 32
+#define kMaxCoeffs 1024
+#define kBitDepth 10
+
+typedef struct {
+  int width;
+  int height;
+  int high_bitdepth;
+} BlockInfo;
+
+typedef struct {
+  uint8_t *src;
+  uint8_t *ref;
+  uint8_t *dst;
+  uint8_t *second_pred;
+#if CONFIG_VP9_HIGHBITDEPTH
+  uint16_t *src16;
+  uint16_t *ref16;
+  uint16_t *dst16;
+  uint16_t *second_pred16;
+#endif
+  int16_t *residual;
+  tran_low_t *coeff;
+  tran_low_t *dqcoeff;
+  tran_low_t *qcoeff;
+  int16_t *coeff16;
+  int16_t *scan;
+  int16_t *iscan;
+  uint16_t eob;
+  uint8_t *above;
+  uint8_t *left;
+#if CONFIG_VP9_HIGHBITDEPTH
+  uint16_t *above16;
+  uint16_t *left16;
+#endif
+  uint32_t sad_array[8];
+} BenchBuffers;
+
+static BenchBuffers bufs;
+static volatile uint32_t sink;
+
+DECLARE_ALIGNED(256, static int16_t, filter_kernels[16][8]);
+DECLARE_ALIGNED(16, static int16_t, zbin[8]);
+DECLARE_ALIGNED(16, static int16_t, round_factor[8]);
+DECLARE_ALIGNED(16, static int16_t, quant[8]);
+DECLARE_ALIGNED(16, static int16_t, quant_shift[8]);
+DECLARE_ALIGNED(16, static int16_t, dequant[8]);
+DECLARE_ALIGNED(16, static uint8_t, blimit[16]);
+DECLARE_ALIGNED(16, static uint8_t, limit[16]);
+DECLARE_ALIGNED(16, static uint8_t, thresh[16]);
+
+static void *alloc_aligned(size_t size) {
+  void *const p = vpx_memalign(32, size);
+  if (!p) {
+    fprintf(stderr, "Failed to allocate %d bytes.\n", (int)size);
+    exit(EXIT_FAILURE);
+  }
+  return p;
+}
+
+static uint8_t *alloc_pixels(void) {
+  uint8_t *const p = (uint8_t *)alloc_aligned(kStride * kRows);
+  int i;
+  for (i = 0; i < kStride * kRows; ++i)
+    p[i] = rand() & 0xff;
+  return p + kBorder * kStride + kBorder;
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static uint16_t *alloc_pixels16(void) {
+  uint16_t *const p =
+      (uint16_t *)alloc_aligned(kStride * kRows * sizeof(*p));
+  int i;
+  // 8-bit values are valid for every bit depth.
+  for (i = 0; i < kStride * kRows; ++i)
+    p[i] = rand() & 0xff;
+  return p + kBorder * kStride + kBorder;
+}
+#endif
+
+static void init_buffers(void) {
+  int i;
+
+  bufs.src = alloc_pixels();
+  bufs.ref = alloc_pixels();
+  bufs.dst = alloc_pixels();
+  bufs.second_pred = alloc_pixels();
+  bufs.above = alloc_pixels();
+  bufs.left = alloc_pixels();
+#if CONFIG_VP9_HIGHBITDEPTH
+  bufs.src16 = alloc_pixels16();
+  bufs.ref16 = alloc_pixels16();
+  bufs.dst16 = alloc_pixels16();
+  bufs.second_pred16 = alloc_pixels16();
+  bufs.above16 = alloc_pixels16();
+  bufs.left16 = alloc_pixels16();
+#endif
+
+  bufs.residual = (int16_t *)alloc_aligned(kMaxCoeffs * sizeof(int16_t));
+  bufs.coeff16 = (int16_t *)alloc_aligned(kMaxCoeffs * sizeof(int16_t));
+  bufs.coeff = (tran_low_t *)alloc_aligned(kMaxCoeffs * sizeof(tran_low_t));
+  bufs.qcoeff = (tran_low_t *)alloc_aligned(kMaxCoeffs * sizeof(tran_low_t));
+  bufs.dqcoeff = (tran_low_t *)alloc_aligned(kMaxCoeffs * sizeof(tran_low_t));
+  bufs.scan = (int16_t *)alloc_aligned(kMaxCoeffs * sizeof(int16_t));
+  bufs.iscan = (int16_t *)alloc_aligned(kMaxCoeffs * sizeof(int16_t));
+  for (i = 0; i < kMaxCoeffs; ++i) {
+    bufs.residual[i] = (rand() & 0x1ff) - 256;
+    bufs.coeff16[i] = (rand() & 0x1ff) - 256;
+    // Small enough for the inverse transforms to stay in range.
+    bufs.coeff[i] = (rand() & 0x3f) - 32;
+    bufs.dqcoeff[i] = (rand() & 0x3f) - 32;
+    bufs.scan[i] = i;
+    bufs.iscan[i] = i;
+  }
+
+  for (i = 0; i < 16; ++i) {
+    static const int16_t kIdentity[8] = { 0, 0, 0, 128, 0, 0, 0, 0 };
+    static const int16_t kHalfPel[8] = { -1, 6, -19, 78, 78, -19, 6, -1 };
+    memcpy(filter_kernels[i], i == 8 ? kHalfPel : kIdentity,
+           sizeof(filter_kernels[i]));
+  }
+  for (i = 0; i < 8; ++i) {
+    zbin[i] = i ? 48 : 40;
+    round_factor[i] = i ? 36 : 30;
+    quant[i] = i ? 20000 : 24000;
+    quant_shift[i] = 1 << 14;
+    dequant[i] = i ? 80 : 64;
+  }
+  memset(blimit, 60, sizeof(blimit));
+  memset(limit, 10, sizeof(limit));
+  memset(thresh, 4, sizeof(thresh));
+}
+
+// Runners, one per kernel prototype. Each calls |fn| |n| times on a block of
+// the size given by |b|.
+
+static void run_intra(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(uint8_t *, ptrdiff_t, const uint8_t *, const uint8_t *) =
+      (void (*)(uint8_t *, ptrdiff_t, const uint8_t *, const uint8_t *))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.dst, kStride, bufs.above, bufs.left);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static void run_highbd_intra(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(uint16_t *, ptrdiff_t, const uint16_t *, const uint16_t *,
+                  int) =
+      (void (*)(uint16_t *, ptrdiff_t, const uint16_t *, const uint16_t *,
+                int))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.dst16, kStride, bufs.above16, bufs.left16, kBitDepth);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+// Pixel pointers as expected by the kernels, which take high bitdepth
+// buffers converted with CONVERT_TO_BYTEPTR().
+#if CONFIG_VP9_HIGHBITDEPTH
+#define SRC(b) ((b)->high_bitdepth ? CONVERT_TO_BYTEPTR(bufs.src16) : bufs.src)
+#define REF(b) ((b)->high_bitdepth ? CONVERT_TO_BYTEPTR(bufs.ref16) : bufs.ref)
+#define DST(b) ((b)->high_bitdepth ? CONVERT_TO_BYTEPTR(bufs.dst16) : bufs.dst)
+#define PRED(b) ((b)->high_bitdepth ? \
+    CONVERT_TO_BYTEPTR(bufs.second_pred16) : bufs.second_pred)
+#else
+#define SRC(b) bufs.src
+#define REF(b) bufs.ref
+#define DST(b) bufs.dst
+#define PRED(b) bufs.second_pred
+#endif
+
+static void run_sad(rtcd_fn fn, const BlockInfo *b, int n) {
+  unsigned int (*const f)(const uint8_t *, int, const uint8_t *, int) =
+      (unsigned int (*)(const uint8_t *, int, const uint8_t *, int))fn;
+  const uint8_t *const src = SRC(b);
+  const uint8_t *const ref = REF(b);
+  unsigned int sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(src, kStride, ref, kStride);
+  sink = sum;
+}
+
+static void run_sad_avg(rtcd_fn fn, const BlockInfo *b, int n) {
+  unsigned int (*const f)(const uint8_t *, int, const uint8_t *, int,
+                          const uint8_t *) =
+      (unsigned int (*)(const uint8_t *, int, const uint8_t *, int,
+                        const uint8_t *))fn;
+  const uint8_t *const src = SRC(b);
+  const uint8_t *const ref = REF(b);
+  const uint8_t *const pred = PRED(b);
+  unsigned int sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(src, kStride, ref, kStride, pred);
+  sink = sum;
+}
+
+static void run_sad_multi(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const uint8_t *, int, const uint8_t *, int, uint32_t *) =
+      (void (*)(const uint8_t *, int, const uint8_t *, int, uint32_t *))fn;
+  const uint8_t *const src = SRC(b);
+  const uint8_t *const ref = REF(b);
+  int i;
+  for (i = 0; i < n; ++i)
+    f(src, kStride, ref, kStride, bufs.sad_array);
+  sink = bufs.sad_array[0];
+}
+
+static void run_sad4d(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const uint8_t *, int, const uint8_t *const *, int,
+                  uint32_t *) =
+      (void (*)(const uint8_t *, int, const uint8_t *const *, int,
+                uint32_t *))fn;
+  const uint8_t *const src = SRC(b);
+  const uint8_t *refs[4];
+  int i;
+  for (i = 0; i < 4; ++i) {
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (b->high_bitdepth) {
+      refs[i] = CONVERT_TO_BYTEPTR(bufs.ref16 + i);
+      continue;
+    }
+#endif
+    refs[i] = bufs.ref + i;
+  }
+  for (i = 0; i < n; ++i)
+    f(src, kStride, refs, kStride, bufs.sad_array);
+  sink = bufs.sad_array[0];
+}
+
+static void run_variance(rtcd_fn fn, const BlockInfo *b, int n) {
+  unsigned int (*const f)(const uint8_t *, int, const uint8_t *, int,
+                          unsigned int *) =
+      (unsigned int (*)(const uint8_t *, int, const uint8_t *, int,
+                        unsigned int *))fn;
+  const uint8_t *const src = SRC(b);
+  const uint8_t *const ref = REF(b);
+  unsigned int sse, sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(src, kStride, ref, kStride, &sse);
+  sink = sum + sse;
+}
+
+static void run_get_var(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const uint8_t *, int, const uint8_t *, int, unsigned int *,
+                  int *) =
+      (void (*)(const uint8_t *, int, const uint8_t *, int, unsigned int *,
+                int *))fn;
+  const uint8_t *const src = SRC(b);
+  const uint8_t *const ref = REF(b);
+  unsigned int sse;
+  int sum;
+  int i;
+  for (i = 0; i < n; ++i)
+    f(src, kStride, ref, kStride, &sse, &sum);
+  sink = sse + sum;
+}
+
+static void run_subpel_variance(rtcd_fn fn, const BlockInfo *b, int n) {
+  uint32_t (*const f)(const uint8_t *, int, int, int, const uint8_t *, int,
+                      uint32_t *) =
+      (uint32_t (*)(const uint8_t *, int, int, int, const uint8_t *, int,
+                    uint32_t *))fn;
+  const uint8_t *const src = SRC(b);
+  const uint8_t *const ref = REF(b);
+  uint32_t sse, sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(src, kStride, 3, 5, ref, kStride, &sse);
+  sink = sum + sse;
+}
+
+static void run_subpel_avg_variance(rtcd_fn fn, const BlockInfo *b, int n) {
+  uint32_t (*const f)(const uint8_t *, int, int, int, const uint8_t *, int,
+                      uint32_t *, const uint8_t *) =
+      (uint32_t (*)(const uint8_t *, int, int, int, const uint8_t *, int,
+                    uint32_t *, const uint8_t *))fn;
+  const uint8_t *const src = SRC(b);
+  const uint8_t *const ref = REF(b);
+  const uint8_t *const pred = PRED(b);
+  uint32_t sse, sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(src, kStride, 3, 5, ref, kStride, &sse, pred);
+  sink = sum + sse;
+}
+
+static void run_avg(rtcd_fn fn, const BlockInfo *b, int n) {
+  unsigned int (*const f)(const uint8_t *, int) =
+      (unsigned int (*)(const uint8_t *, int))fn;
+  const uint8_t *const src = SRC(b);
+  unsigned int sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(src, kStride);
+  sink = sum;
+}
+
+static void run_minmax(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const uint8_t *, int, const uint8_t *, int, int *, int *) =
+      (void (*)(const uint8_t *, int, const uint8_t *, int, int *, int *))fn;
+  const uint8_t *const src = SRC(b);
+  const uint8_t *const ref = REF(b);
+  int min, max;
+  int i;
+  for (i = 0; i < n; ++i)
+    f(src, kStride, ref, kStride, &min, &max);
+  sink = min + max;
+}
+
+static void run_fdct(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const int16_t *, tran_low_t *, int) =
+      (void (*)(const int16_t *, tran_low_t *, int))fn;
+  int i;
+  for (i = 0; i < n; ++i)
+    f(bufs.residual, bufs.qcoeff, b->width);
+}
+
+static void run_fht(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const int16_t *, tran_low_t *, int, int) =
+      (void (*)(const int16_t *, tran_low_t *, int, int))fn;
+  int i;
+  for (i = 0; i < n; ++i)
+    f(bufs.residual, bufs.qcoeff, b->width, 3);
+}
+
+static void run_idct_add(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const tran_low_t *, uint8_t *, int) =
+      (void (*)(const tran_low_t *, uint8_t *, int))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.coeff, bufs.dst, kStride);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static void run_highbd_idct_add(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const tran_low_t *, uint8_t *, int, int) =
+      (void (*)(const tran_low_t *, uint8_t *, int, int))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.coeff, CONVERT_TO_BYTEPTR(bufs.dst16), kStride, kBitDepth);
+}
+#endif
+
+static void run_iht_add(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const tran_low_t *, uint8_t *, int, int) =
+      (void (*)(const tran_low_t *, uint8_t *, int, int))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.coeff, bufs.dst, kStride, 3);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static void run_highbd_iht_add(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const tran_low_t *, uint8_t *, int, int, int) =
+      (void (*)(const tran_low_t *, uint8_t *, int, int, int))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.coeff, CONVERT_TO_BYTEPTR(bufs.dst16), kStride, 3, kBitDepth);
+}
+#endif
+
+static void run_convolve(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t,
+                  const int16_t *, int, const int16_t *, int, int, int) =
+      (void (*)(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t,
+                const int16_t *, int, const int16_t *, int, int, int))fn;
+  int i;
+  for (i = 0; i < n; ++i) {
+    f(bufs.src, kStride, bufs.dst, kStride, filter_kernels[8], 16,
+      filter_kernels[8], 16, b->width, b->height);
+  }
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static void run_highbd_convolve(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t,
+                  const int16_t *, int, const int16_t *, int, int, int, int) =
+      (void (*)(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t,
+                const int16_t *, int, const int16_t *, int, int, int,
+                int))fn;
+  int i;
+  for (i = 0; i < n; ++i) {
+    f(CONVERT_TO_BYTEPTR(bufs.src16), kStride, CONVERT_TO_BYTEPTR(bufs.dst16),
+      kStride, filter_kernels[8], 16, filter_kernels[8], 16, b->width,
+      b->height, kBitDepth);
+  }
+}
+#endif
+
+static void run_quantize(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const tran_low_t *, intptr_t, int, const int16_t *,
+                  const int16_t *, const int16_t *, const int16_t *,
+                  tran_low_t *, tran_low_t *, const int16_t *, uint16_t *,
+                  const int16_t *, const int16_t *) =
+      (void (*)(const tran_low_t *, intptr_t, int, const int16_t *,
+                const int16_t *, const int16_t *, const int16_t *,
+                tran_low_t *, tran_low_t *, const int16_t *, uint16_t *,
+                const int16_t *, const int16_t *))fn;
+  int i;
+  for (i = 0; i < n; ++i) {
+    f(bufs.coeff, b->width * b->height, 0, zbin, round_factor, quant,
+      quant_shift, bufs.qcoeff, bufs.dqcoeff, dequant, &bufs.eob, bufs.scan,
+      bufs.iscan);
+  }
+}
+
+static void run_lpf(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(uint8_t *, int, const uint8_t *, const uint8_t *,
+                  const uint8_t *) =
+      (void (*)(uint8_t *, int, const uint8_t *, const uint8_t *,
+                const uint8_t *))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.dst, kStride, blimit, limit, thresh);
+}
+
+static void run_lpf_count(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(uint8_t *, int, const uint8_t *, const uint8_t *,
+                  const uint8_t *, int) =
+      (void (*)(uint8_t *, int, const uint8_t *, const uint8_t *,
+                const uint8_t *, int))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.dst, kStride, blimit, limit, thresh, 1);
+}
+
+static void run_lpf_dual(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(uint8_t *, int, const uint8_t *, const uint8_t *,
+                  const uint8_t *, const uint8_t *, const uint8_t *,
+                  const uint8_t *) =
+      (void (*)(uint8_t *, int, const uint8_t *, const uint8_t *,
+                const uint8_t *, const uint8_t *, const uint8_t *,
+                const uint8_t *))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.dst, kStride, blimit, limit, thresh, blimit, limit, thresh);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static void run_highbd_lpf(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(uint16_t *, int, const uint8_t *, const uint8_t *,
+                  const uint8_t *, int) =
+      (void (*)(uint16_t *, int, const uint8_t *, const uint8_t *,
+                const uint8_t *, int))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.dst16, kStride, blimit, limit, thresh, kBitDepth);
+}
+
+static void run_highbd_lpf_count(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(uint16_t *, int, const uint8_t *, const uint8_t *,
+                  const uint8_t *, int, int) =
+      (void (*)(uint16_t *, int, const uint8_t *, const uint8_t *,
+                const uint8_t *, int, int))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    f(bufs.dst16, kStride, blimit, limit, thresh, 1, kBitDepth);
+}
+
+static void run_highbd_lpf_dual(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(uint16_t *, int, const uint8_t *, const uint8_t *,
+                  const uint8_t *, const uint8_t *, const uint8_t *,
+                  const uint8_t *, int) =
+      (void (*)(uint16_t *, int, const uint8_t *, const uint8_t *,
+                const uint8_t *, const uint8_t *, const uint8_t *,
+                const uint8_t *, int))fn;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i) {
+    f(bufs.dst16, kStride, blimit, limit, thresh, blimit, limit, thresh,
+      kBitDepth);
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+static void run_hadamard(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(const int16_t *, int, int16_t *) =
+      (void (*)(const int16_t *, int, int16_t *))fn;
+  int i;
+  for (i = 0; i < n; ++i)
+    f(bufs.residual, b->width, bufs.coeff16);
+}
+
+static void run_satd(rtcd_fn fn, const BlockInfo *b, int n) {
+  int16_t (*const f)(const int16_t *, int) =
+      (int16_t (*)(const int16_t *, int))fn;
+  int sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(bufs.coeff16, b->width * b->height);
+  sink = sum;
+}
+
+static void run_int_pro_row(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(int16_t *, const uint8_t *, const int, const int) =
+      (void (*)(int16_t *, const uint8_t *, const int, const int))fn;
+  int i;
+  for (i = 0; i < n; ++i)
+    f(bufs.coeff16, bufs.src, kStride, b->height);
+}
+
+static void run_int_pro_col(rtcd_fn fn, const BlockInfo *b, int n) {
+  int16_t (*const f)(const uint8_t *, const int) =
+      (int16_t (*)(const uint8_t *, const int))fn;
+  int sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(bufs.src, b->width);
+  sink = sum;
+}
+
+static void run_vector_var(rtcd_fn fn, const BlockInfo *b, int n) {
+  int (*const f)(const int16_t *, const int16_t *, const int) =
+      (int (*)(const int16_t *, const int16_t *, const int))fn;
+  int sum = 0;
+  int i;
+  (void)b;
+  for (i = 0; i < n; ++i)
+    sum += f(bufs.residual, bufs.coeff16, 4);
+  sink = sum;
+}
+
+static void run_subtract(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(int, int, int16_t *, ptrdiff_t, const uint8_t *, ptrdiff_t,
+                  const uint8_t *, ptrdiff_t) =
+      (void (*)(int, int, int16_t *, ptrdiff_t, const uint8_t *, ptrdiff_t,
+                const uint8_t *, ptrdiff_t))fn;
+  int i;
+  for (i = 0; i < n; ++i) {
+    f(b->height, b->width, bufs.residual, b->width, bufs.src, kStride,
+      bufs.ref, kStride);
+  }
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static void run_highbd_subtract(rtcd_fn fn, const BlockInfo *b, int n) {
+  void (*const f)(int, int, int16_t *, ptrdiff_t, const uint8_t *, ptrdiff_t,
+                  const uint8_t *, ptrdiff_t, int) =
+      (void (*)(int, int, int16_t *, ptrdiff_t, const uint8_t *, ptrdiff_t,
+                const uint8_t *, ptrdiff_t, int))fn;
+  int i;
+  for (i = 0; i < n; ++i) {
+    f(b->height, b->width, bufs.residual, b->width,
+      CONVERT_TO_BYTEPTR(bufs.src16), kStride, CONVERT_TO_BYTEPTR(bufs.ref16),
+      kStride, kBitDepth);
+  }
+}
+#endif
+
+static void run_block_error(rtcd_fn fn, const BlockInfo *b, int n) {
+  int64_t (*const f)(const tran_low_t *, const tran_low_t *, intptr_t,
+                     int64_t *) =
+      (int64_t (*)(const tran_low_t *, const tran_low_t *, intptr_t,
+                   int64_t *))fn;
+  int64_t ssz, sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(bufs.coeff, bufs.dqcoeff, b->width * b->height, &ssz);
+  sink = (uint32_t)(sum + ssz);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static void run_highbd_block_error(rtcd_fn fn, const BlockInfo *b, int n) {
+  int64_t (*const f)(const tran_low_t *, const tran_low_t *, intptr_t,
+                     int64_t *, int) =
+      (int64_t (*)(const tran_low_t *, const tran_low_t *, intptr_t,
+                   int64_t *, int))fn;
+  int64_t ssz, sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(bufs.coeff, bufs.dqcoeff, b->width * b->height, &ssz, kBitDepth);
+  sink = (uint32_t)(sum + ssz);
+}
+#endif
+
+typedef void (*runner_fn)(rtcd_fn fn, const BlockInfo *b, int n);
+
+typedef struct {
+  // Prototype with the parameter names and spaces removed.
+  const char *prototype;
+  runner_fn run;
+  // Block size for kernels without one in their name. Kernels working on
+  // any size (w, h arguments) are timed for every size from 4x4 to 64x64.
+  int width;
+  int height;
+  int any_size;
+  // Set for the runners of high bitdepth kernels whose prototype is shared
+  // with kernels of another kind.
+  int high_bitdepth_only;
+} Runner;
+
+static const Runner kRunners[] = {
+  { "void(uint8_t*,ptrdiff_t,constuint8_t*,constuint8_t*)", run_intra,
+    0, 0, 0, 0 },
+#if CONFIG_VP9_HIGHBITDEPTH
+  { "void(uint16_t*,ptrdiff_t,constuint16_t*,constuint16_t*,int)",
+    run_highbd_intra, 0, 0, 0, 0 },
+#endif
+  { "unsignedint(constuint8_t*,int,constuint8_t*,int)", run_sad, 0, 0, 0, 0 },
+  { "unsignedint(constuint8_t*,int,constuint8_t*,int,constuint8_t*)",
+    run_sad_avg, 0, 0, 0, 0 },
+  { "void(constuint8_t*,int,constuint8_t*,int,uint32_t*)", run_sad_multi,
+    0, 0, 0, 0 },
+  { "void(constuint8_t*,int,constuint8_t*const,int,uint32_t*)", run_sad4d,
+    0, 0, 0, 0 },
+  { "unsignedint(constuint8_t*,int,constuint8_t*,int,unsignedint*)",
+    run_variance, 0, 0, 0, 0 },
+  { "uint32_t(constunsignedchar*,int,constunsignedchar*,int,uint32_t*)",
+    run_variance, 16, 16, 0, 0 },
+  { "unsignedint(constunsignedchar*,int,constunsignedchar*,int)",
+    run_sad, 0, 0, 0, 0 },
+  { "void(constuint8_t*,int,constuint8_t*,int,unsignedint*,int*)",
+    run_get_var, 0, 0, 0, 0 },
+  { "uint32_t(constuint8_t*,int,int,int,constuint8_t*,int,uint32_t*)",
+    run_subpel_variance, 0, 0, 0, 0 },
+  { "uint32_t(constuint8_t*,int,int,int,constuint8_t*,int,uint32_t*,"
+    "constuint8_t*)", run_subpel_avg_variance, 0, 0, 0, 0 },
+  { "unsignedint(constuint8_t*,int)", run_avg, 0, 0, 0, 0 },
+  { "void(constuint8_t*,int,constuint8_t*,int,int*,int*)", run_minmax,
+    0, 0, 0, 0 },
+  { "void(constint16_t*,tran_low_t*,int)", run_fdct, 0, 0, 0, 0 },
+  { "void(constint16_t*,tran_low_t*,int,int)", run_fht, 0, 0, 0, 0 },
+  { "void(consttran_low_t*,uint8_t*,int)", run_idct_add, 0, 0, 0, 0 },
+#if CONFIG_VP9_HIGHBITDEPTH
+  { "void(consttran_low_t*,uint8_t*,int,int)", run_highbd_idct_add,
+    0, 0, 0, 1 },
+#endif
+  { "void(consttran_low_t*,uint8_t*,int,int)", run_iht_add, 0, 0, 0, 0 },
+#if CONFIG_VP9_HIGHBITDEPTH
+  { "void(consttran_low_t*,uint8_t*,int,int,int)", run_highbd_iht_add,
+    0, 0, 0, 1 },
+#endif
+  { "void(constuint8_t*,ptrdiff_t,uint8_t*,ptrdiff_t,constint16_t*,int,"
+    "constint16_t*,int,int,int)", run_convolve, 0, 0, 1, 0 },
+#if CONFIG_VP9_HIGHBITDEPTH
+  { "void(constuint8_t*,ptrdiff_t,uint8_t*,ptrdiff_t,constint16_t*,int,"
+    "constint16_t*,int,int,int,int)", run_highbd_convolve, 0, 0, 1, 0 },
+#endif
+  { "void(consttran_low_t*,intptr_t,int,constint16_t*,constint16_t*,"
+    "constint16_t*,constint16_t*,tran_low_t*,tran_low_t*,constint16_t*,"
+    "uint16_t*,constint16_t*,constint16_t*)", run_quantize, 16, 16, 0, 0 },
+  { "void(uint8_t*,int,constuint8_t*,constuint8_t*,constuint8_t*)", run_lpf,
+    8, 1, 0, 0 },
+  { "void(uint8_t*,int,constuint8_t*,constuint8_t*,constuint8_t*,int)",
+    run_lpf_count, 8, 1, 0, 0 },
+  { "void(uint8_t*,int,constuint8_t*,constuint8_t*,constuint8_t*,"
+    "constuint8_t*,constuint8_t*,constuint8_t*)", run_lpf_dual, 16, 1, 0, 0 },
+#if CONFIG_VP9_HIGHBITDEPTH
+  { "void(uint16_t*,int,constuint8_t*,constuint8_t*,constuint8_t*,int)",
+    run_highbd_lpf, 8, 1, 0, 0 },
+  { "void(uint16_t*,int,constuint8_t*,constuint8_t*,constuint8_t*,int,int)",
+    run_highbd_lpf_count, 8, 1, 0, 0 },
+  { "void(uint16_t*,int,constuint8_t*,constuint8_t*,constuint8_t*,"
+    "constuint8_t*,constuint8_t*,constuint8_t*,int)", run_highbd_lpf_dual,
+    16, 1, 0, 0 },
+#endif
+  { "void(int16_tconst*,int,int16_t*)", run_hadamard, 0, 0, 0, 0 },
+  { "int16_t(constint16_t*,int)", run_satd, 16, 16, 0, 0 },
+  { "void(int16_t*,uint8_tconst*,constint,constint)", run_int_pro_row,
+    16, 64, 0, 0 },
+  { "int16_t(uint8_tconst*,constint)", run_int_pro_col, 64, 1, 0, 0 },
+  { "int(int16_tconst*,int16_tconst*,constint)", run_vector_var, 64, 1, 0, 0 },
+  { "void(int,int,int16_t*,ptrdiff_t,constuint8_t*,ptrdiff_t,constuint8_t*,"
+    "ptrdiff_t)", run_subtract, 0, 0, 1, 0 },
+#if CONFIG_VP9_HIGHBITDEPTH
+  { "void(int,int,int16_t*,ptrdiff_t,constuint8_t*,ptrdiff_t,constuint8_t*,"
+    "ptrdiff_t,int)", run_highbd_subtract, 0, 0, 1, 0 },
+#endif
+  { "int64_t(consttran_low_t*,consttran_low_t*,intptr_t,int64_t*)",
+    run_block_error, 32, 32, 0, 0 },
+#if CONFIG_VP9_HIGHBITDEPTH
+  { "int64_t(consttran_low_t*,consttran_low_t*,intptr_t,int64_t*,int)",
+    run_highbd_block_error, 32, 32, 0, 0 },
+#endif
+};
+
+#define NUM_RUNNERS ((int)(sizeof(kRunners) / sizeof(kRunners[0])))
+
+static int is_ident_char(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_';
+}
+
+// Reduces a "return_type(arguments)" prototype to its types, e.g.
+// "unsigned int(const uint8_t *src, int stride)" gives
+// "unsignedint(constuint8_t*,int)".
+static void normalize_prototype(const char *proto, char *out, size_t size) {
+  char param[256];
+  size_t len = 0;
+  const char *p = strchr(proto, '(');
+
+  if (p == NULL || (size_t)(p - proto) + 2 > size) {
+    out[0] = '\0';
+    return;
+  }
+  for (; proto < p; ++proto) {
+    if (*proto != ' ')
+      out[len++] = *proto;
+  }
+  out[len++] = '(';
+  ++p;
+  while (*p && *p != ')') {
+    size_t n = 0, end;
+    int words = 0, in_word = 0;
+
+    while (*p == ' ')
+      ++p;
+    while (*p && *p != ',' && *p != ')' && n + 1 < sizeof(param))
+      param[n++] = *p++;
+    if (*p == ',')
+      ++p;
+    while (n > 0 && param[n - 1] == ' ')
+      --n;
+    // Drop array dimensions.
+    while (n > 0 && param[n - 1] == ']') {
+      while (n > 0 && param[n - 1] != '[')
+        --n;
+      if (n > 0)
+        --n;
+      while (n > 0 && param[n - 1] == ' ')
+        --n;
+    }
+    // Drop the parameter name, if the declaration has one.
+    for (end = 0; end < n; ++end) {
+      if (is_ident_char(param[end])) {
+        if (!in_word)
+          ++words;
+        in_word = 1;
+      } else {
+        in_word = 0;
+      }
+    }
+    if (n > 0 && is_ident_char(param[n - 1]) &&
+        (words > 1 || memchr(param, '*', n) != NULL)) {
+      while (n > 0 && is_ident_char(param[n - 1]))
+        --n;
+    }
+    for (end = 0; end < n && len + 2 < size; ++end) {
+      if (param[end] != ' ')
+        out[len++] = param[end];
+    }
+    if (*p && *p != ')' && len + 2 < size)
+      out[len++] = ',';
+  }
+  out[len++] = ')';
+  out[len] = '\0';
+}
+
+static int is_high_bitdepth(const char *name) {
+  return !strncmp(name, "vpx_highbd_", 11) || !strncmp(name, "vp9_highbd_", 11);
+}
+
+static const Runner *find_runner(const KernelVariant *kernel) {
+  char proto[512];
+  int i;
+
+  normalize_prototype(kernel->prototype, proto, sizeof(proto));
+  for (i = 0; i < NUM_RUNNERS; ++i) {
+    if (kRunners[i].high_bitdepth_only && !is_high_bitdepth(kernel->function))
+      continue;
+    if (!strcmp(proto, kRunners[i].prototype))
+      return &kRunners[i];
+  }
+  return NULL;
+}
+
+// Takes the block size from the function name, e.g. vpx_sad16x8.
+static int parse_block_size(const char *name, int *width, int *height) {
+  const char *p;
+
+  for (p = name; *p; ++p) {
+    if (*p >= '0' && *p <= '9' && (p == name || !(p[-1] >= '0' &&
+                                                  p[-1] <= '9'))) {
+      char *end;
+      const long w = strtol(p, &end, 10);
+      if (*end == 'x' && end[1] >= '0' && end[1] <= '9') {
+        *width = (int)w;
+        *height = (int)strtol(end + 1, NULL, 10);
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+typedef struct {
+  const KernelVariant *kernel;
+  BlockInfo block;
+  int dispatched;
+  int iterations;
+  double ns_per_call;
+  double cycles_per_call;
+} BenchResult;
+
+static int have_cycle_counter(void) {
+#if ARCH_X86 || ARCH_X86_64
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+static uint64_t read_cycles(void) {
+#if ARCH_X86 || ARCH_X86_64
+  return x86_readtsc64();
+#else
+  return 0;
+#endif
+}
+
+static void time_kernel(const Runner *runner, BenchResult *r,
+                        int64_t min_time_us) {
+  struct vpx_usec_timer timer;
+  uint64_t cycles;
+  int64_t elapsed;
+  int n = 1;
+
+  // Warm up, then double the iterations until the run is long enough to be
+  // timed accurately.
+  runner->run(r->kernel->fn, &r->block, 1);
+  for (;;) {
+    vpx_usec_timer_start(&timer);
+    cycles = read_cycles();
+    runner->run(r->kernel->fn, &r->block, n);
+    cycles = read_cycles() - cycles;
+    vpx_usec_timer_mark(&timer);
+    elapsed = vpx_usec_timer_elapsed(&timer);
+    if (elapsed >= min_time_us || n >= (1 << 30))
+      break;
+    n = elapsed > 0 && elapsed * 2 < min_time_us ?
+        (int)VPXMIN((int64_t)n * min_time_us / elapsed, (int64_t)1 << 30) :
+        n * 2;
+  }
+  r->iterations = n;
+  r->ns_per_call = elapsed * 1000.0 / n;
+  r->cycles_per_call = (double)cycles / n;
+}
+
+static void print_result(const BenchResult *r, const BenchResult *c_result,
+                         int json, int first) {
+  const double pixels = (double)r->block.width * r->block.height;
+  const double speedup = c_result && r->ns_per_call > 0 ?
+      c_result->ns_per_call / r->ns_per_call : 0;
+
+  if (json) {
+    printf("%s  {\"function\": \"%s\", \"variant\": \"%s\", "
+           "\"width\": %d, \"height\": %d, \"dispatched\": %s, "
+           "\"iterations\": %d, \"ns_per_call\": %.3f, ",
+           first ? "" : ",\n", r->kernel->function, r->kernel->variant,
+           r->block.width, r->block.height, r->dispatched ? "true" : "false",
+           r->iterations, r->ns_per_call);
+    if (have_cycle_counter()) {
+      printf("\"cycles_per_call\": %.2f, \"pixels_per_cycle\": %.3f, ",
+             r->cycles_per_call,
+             r->cycles_per_call > 0 ? pixels / r->cycles_per_call : 0);
+    } else {
+      printf("\"cycles_per_call\": null, \"pixels_per_cycle\": null, ");
+    }
+    printf("\"speedup_vs_c\": %.2f}", speedup);
+  } else {
+    char size[32];
+    snprintf(size, sizeof(size), "%dx%d", r->block.width, r->block.height);
+    printf("%-40s %-8s %-7s %11.2f", r->kernel->function, r->kernel->variant,
+           size, r->ns_per_call);
+    if (have_cycle_counter()) {
+      printf(" %11.1f %8.3f", r->cycles_per_call,
+             r->cycles_per_call > 0 ? pixels / r->cycles_per_call : 0);
+    }
+    printf(" %7.2fx%s\n", speedup, r->dispatched ? " *" : "");
+  }
+}
+
+static void usage(const char *exec_name) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "Times every variant of the RTCD kernels of vpx_dsp and vp9.\n"
+          "  --filter=<str>     Only kernels whose name contains <str>\n"
+          "  --variant=<name>   Only the c variant and variant <name>\n"
+          "  --min-time=<ms>    Minimum timed run per kernel (default 10)\n"
+          "  --json             Print the results as JSON\n"
+          "  --list             List the kernels and their runners\n"
+          "Results are ns per call, CPU cycles (time stamp counter) per\n"
+          "call and pixels per cycle where available, and the speedup over\n"
+          "the c variant. '*' marks the variant dispatched on this CPU;\n"
+          "set VPX_SIMD_CAPS to restrict the CPU features used.\n",
+          exec_name);
+  exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+  static const int kSizes[] = { 4, 8, 16, 32, 64 };
+  const char *filter = NULL;
+  const char *variant = NULL;
+  int64_t min_time_us = 10000;
+  int json = 0, list = 0, first = 1;
+  int num_timed = 0, num_skipped = 0;
+  int cpu_flags, i, s;
+  rtcd_fn *dispatched;
+  BenchResult c_results[sizeof(kSizes) / sizeof(kSizes[0])];
+
+  for (i = 1; i < argc; ++i) {
+    if (!strncmp(argv[i], "--filter=", 9))
+      filter = argv[i] + 9;
+    else if (!strncmp(argv[i], "--variant=", 10))
+      variant = argv[i] + 10;
+    else if (!strncmp(argv[i], "--min-time=", 11))
+      min_time_us = (int64_t)atoi(argv[i] + 11) * 1000;
+    else if (!strcmp(argv[i], "--json"))
+      json = 1;
+    else if (!strcmp(argv[i], "--list"))
+      list = 1;
+    else
+      usage(argv[0]);
+  }
+  if (min_time_us <= 0)
+    usage(argv[0]);
+
+  vpx_dsp_rtcd();
+#if CONFIG_VP9
+  vp9_rtcd();
+#endif
+  cpu_flags = get_cpu_flags();
+  dispatched = (rtcd_fn *)malloc(NUM_KERNELS * sizeof(*dispatched));
+  if (!dispatched)
+    return EXIT_FAILURE;
+  get_dispatched(dispatched);
+  srand(0);
+  init_buffers();
+  memset(c_results, 0, sizeof(c_results));
+
+  if (json)
+    printf("{\n\"results\": [\n");
+  else if (!list)
+    printf("%-40s %-8s %-7s %11s%s %8s\n", "function", "variant", "size",
+           "ns/call", have_cycle_counter() ? " cycles/call pix/cyc" : "",
+           "vs c");
+
+  for (i = 0; i < NUM_KERNELS; ++i) {
+    const KernelVariant *const kernel = &kKernels[i];
+    const Runner *const runner = find_runner(kernel);
+    const int is_c = !strcmp(kernel->variant, "c");
+    const int num_sizes = runner && runner->any_size ?
+        (int)(sizeof(kSizes) / sizeof(kSizes[0])) : 1;
+
+    if (filter && !strstr(kernel->function, filter))
+      continue;
+    if (variant && !is_c && strcmp(kernel->variant, variant))
+      continue;
+    if (kernel->cpu_flag && !(cpu_flags & kernel->cpu_flag))
+      continue;
+    if (list) {
+      char proto[512];
+      normalize_prototype(kernel->prototype, proto, sizeof(proto));
+      printf("%-40s %-8s %s %s\n", kernel->function, kernel->variant,
+             runner ? "timed  " : "skipped", proto);
+      continue;
+    }
+    if (!runner) {
+      ++num_skipped;
+      continue;
+    }
+
+    for (s = 0; s < num_sizes; ++s) {
+      BenchResult r;
+
+      memset(&r, 0, sizeof(r));
+      r.kernel = kernel;
+      r.dispatched = dispatched[i] == kernel->fn;
+      r.block.high_bitdepth = is_high_bitdepth(kernel->function);
+      if (runner->any_size) {
+        r.block.width = r.block.height = kSizes[s];
+      } else if (!parse_block_size(kernel->function, &r.block.width,
+                                   &r.block.height)) {
+        r.block.width = runner->width;
+        r.block.height = runner->height;
+      }
+      if (r.block.width <= 0 || r.block.height <= 0) {
+        ++num_skipped;
+        break;
+      }
+
+      time_kernel(runner, &r, min_time_us);
+      // The c variant comes first in the list of each function.
+      if (is_c)
+        c_results[s] = r;
+      print_result(&r, c_results[s].kernel &&
+                   !strcmp(c_results[s].kernel->function, kernel->function) ?
+                       &c_results[s] : NULL, json, first);
+      first = 0;
+      ++num_timed;
+    }
+  }
+
+  if (json) {
+    printf("\n],\n\"timed\": %d,\n\"skipped\": %d\n}\n", num_timed,
+           num_skipped);
+  } else if (!list) {
+    printf("%d kernel variants timed, %d without a runner skipped "
+           "(see --list).\n", num_timed, num_skipped);
+  }
+  free(dispatched);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,614 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// End to end encode and decode throughput benchmark.
+//
+// Encodes synthetic content generated in process (moving gradients, noise
+// and scrolling screen content), so that no test data is needed, for every
+// combination of the requested resolutions, speeds and thread counts. The
+// stream is then decoded with the same number of threads. For each run the
+// encode and decode frame rates are reported along with the scaling
+// efficiency against the first thread count of the sweep and the peak
+// resident set size. The content and the encoder settings are fixed, so
+// runs on the same build are directly comparable.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include "../tools_common.h"
+#include "../vpx_ports/vpx_timer.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vpx_encoder.h"
+#if CONFIG_DECODERS
+#include "vpx/vpx_decoder.h"
+#endif
+
+#define MAX_LIST 16
+
+typedef enum {
+  CONTENT_GRADIENT,
+  CONTENT_NOISE,
+  CONTENT_SCREEN,
+  NUM_CONTENT_TYPES
+} ContentType;
+
+static const char *const kContentNames[NUM_CONTENT_TYPES] = {
+  "gradient", "noise", "screen"
+};
+
+typedef struct {
+  const VpxInterface *encoder;
+#if CONFIG_DECODERS
+  const VpxInterface *decoder;
+#endif
+  int num_contents;
+  ContentType contents[NUM_CONTENT_TYPES];
+  int num_sizes;
+  int widths[MAX_LIST];
+  int heights[MAX_LIST];
+  int num_speeds;
+  int speeds[MAX_LIST];
+  int num_threads;
+  int threads[MAX_LIST];
+  int frames;
+  int realtime;
+  int decode;
+  int json;
+} PerfConfig;
+
+typedef struct {
+  double encode_fps;
+  double decode_fps;
+  double encode_efficiency;
+  double decode_efficiency;
+  double kbps;
+  long peak_rss_kb;
+} PerfResult;
+
+// The compressed frames, kept in memory to be decoded afterwards.
+typedef struct {
+  uint8_t *data;
+  size_t size;
+  size_t capacity;
+  size_t *frame_sizes;
+  int num_frames;
+} Stream;
+
+static const char *exec_name;
+
+void usage_exit(void) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "Encodes and decodes synthetic content and reports the frame rates,\n"
+          "the multi-thread scaling efficiency and the peak memory use.\n"
+          "  --codec=<name>       Codec to test (default vp9)\n"
+          "  --content=<list>     gradient, noise and/or screen (default all)\n"
+          "  --sizes=<list>       Frame sizes, e.g. 640x360,1280x720\n"
+          "                       (default 352x288,640x360,1280x720)\n"
+          "  --speeds=<list>      Encoder speeds (cpu-used, default 5,8)\n"
+          "  --threads=<list>     Thread counts (default 1,2,4); scaling is\n"
+          "                       relative to the first one\n"
+          "  --frames=<n>         Frames per run (default 60)\n"
+          "  --rt                 Use the realtime deadline (default good)\n"
+          "  --no-decode          Only time the encoder\n"
+          "  --json               Print the results as JSON\n",
+          exec_name);
+  exit(EXIT_FAILURE);
+}
+
+// Fills |values| from a comma separated list of integers.
+static int parse_int_list(const char *arg, int *values, int max_values) {
+  const char *const list = arg;
+  int n = 0;
+  char *end;
+
+  while (*arg) {
+    if (n == max_values)
+      die("Too many values in '%s'.\n", list);
+    values[n++] = (int)strtol(arg, &end, 10);
+    if (end == arg || (*end && *end != ','))
+      die("Invalid list '%s'.\n", list);
+    arg = *end ? end + 1 : end;
+  }
+  return n;
+}
+
+static int parse_size_list(const char *arg, int *widths, int *heights,
+                           int max_values) {
+  const char *const list = arg;
+  int n = 0;
+  char *end;
+
+  while (*arg) {
+    if (n == max_values)
+      die("Too many sizes in '%s'.\n", list);
+    widths[n] = (int)strtol(arg, &end, 10);
+    if (end == arg || *end != 'x')
+      die("Invalid size list '%s'.\n", list);
+    arg = end + 1;
+    heights[n] = (int)strtol(arg, &end, 10);
+    if (end == arg || (*end && *end != ',') ||
+        widths[n] < 16 || heights[n] < 16 || (widths[n] & 1) ||
+        (heights[n] & 1))
+      die("Invalid size list '%s'.\n", list);
+    ++n;
+    arg = *end ? end + 1 : end;
+  }
+  return n;
+}
+
+static int parse_content_list(const char *arg, ContentType *contents) {
+  const char *const list = arg;
+  int n = 0;
+
+  while (*arg) {
+    const size_t len = strcspn(arg, ",");
+    int i;
+
+    for (i = 0; i < NUM_CONTENT_TYPES; ++i) {
+      if (strlen(kContentNames[i]) == len &&
+          !strncmp(arg, kContentNames[i], len))
+        break;
+    }
+    if (i == NUM_CONTENT_TYPES || n == NUM_CONTENT_TYPES)
+      die("Invalid content list '%s'.\n", list);
+    contents[n++] = (ContentType)i;
+    arg += len;
+    if (*arg)
+      ++arg;
+  }
+  return n;
+}
+
+// Deterministic, so that every run encodes the same frames.
+static uint32_t lcg_rand(uint32_t *state) {
+  *state = *state * 1103515245 + 12345;
+  return *state >> 16;
+}
+
+static uint8_t clip_pixel(int v) {
+  return v < 0 ? 0 : v > 255 ? 255 : (uint8_t)v;
+}
+
+// A diagonal triangle wave moving by a few pixels per frame.
+static uint8_t gradient_pixel(int x, int y, int t) {
+  const int v = (x + y / 2 + 3 * t) & 511;
+  return (uint8_t)(v < 256 ? v : 511 - v);
+}
+
+static void draw_gradient(vpx_image_t *img, int t, int noise,
+                          uint32_t *seed) {
+  const int w = img->d_w, h = img->d_h;
+  const int cw = (w + 1) / 2, ch = (h + 1) / 2;
+  int x, y;
+
+  for (y = 0; y < h; ++y) {
+    uint8_t *const row = img->planes[VPX_PLANE_Y] + y * img->stride[0];
+    for (x = 0; x < w; ++x) {
+      const int v = gradient_pixel(x, y, t);
+      row[x] = noise ? clip_pixel(v + (int)(lcg_rand(seed) & 31) - 16) :
+                       (uint8_t)v;
+    }
+  }
+  for (y = 0; y < ch; ++y) {
+    uint8_t *const u = img->planes[VPX_PLANE_U] + y * img->stride[1];
+    uint8_t *const v = img->planes[VPX_PLANE_V] + y * img->stride[2];
+    for (x = 0; x < cw; ++x) {
+      u[x] = (uint8_t)(64 + gradient_pixel(y, x, t) / 2);
+      v[x] = (uint8_t)(192 - gradient_pixel(x, y, 2 * t) / 2);
+    }
+  }
+}
+
+// Lines of pseudo text on a light background scrolling up by two lines of
+// pixels per frame, with a colored window moving across them.
+static void draw_screen(vpx_image_t *img, int t) {
+  const int w = img->d_w, h = img->d_h;
+  const int cw = (w + 1) / 2, ch = (h + 1) / 2;
+  const int win_x = (4 * t) % (w / 2 + 1), win_y = h / 4;
+  const int win_w = w / 3, win_h = h / 3;
+  int x, y;
+
+  for (y = 0; y < h; ++y) {
+    uint8_t *const row = img->planes[VPX_PLANE_Y] + y * img->stride[0];
+    const int page_y = y + 2 * t;
+    const int line = page_y / 12, glyph_y = page_y % 12;
+    for (x = 0; x < w; ++x) {
+      const int glyph = x / 8, glyph_x = x % 8;
+      // Each glyph is a 6x8 pattern picked by hashing its position, in a
+      // 8x12 cell. Some cells are left empty as spaces.
+      uint32_t hash = (uint32_t)(line * 131 + glyph) * 2654435761u;
+      int ink = 0;
+      if (glyph_y < 8 && glyph_x < 6 && (hash >> 28) > 2)
+        ink = (hash >> ((glyph_y * 6 + glyph_x) % 27)) & 1;
+      if (x >= win_x && x < win_x + win_w && y >= win_y && y < win_y + win_h)
+        row[x] = ink ? 255 : 40;
+      else
+        row[x] = ink ? 16 : 235;
+    }
+  }
+  for (y = 0; y < ch; ++y) {
+    uint8_t *const u = img->planes[VPX_PLANE_U] + y * img->stride[1];
+    uint8_t *const v = img->planes[VPX_PLANE_V] + y * img->stride[2];
+    for (x = 0; x < cw; ++x) {
+      const int in_window = 2 * x >= win_x && 2 * x < win_x + win_w &&
+                            2 * y >= win_y && 2 * y < win_y + win_h;
+      u[x] = in_window ? 160 : 128;
+      v[x] = in_window ? 96 : 128;
+    }
+  }
+}
+
+static void draw_frame(vpx_image_t *img, ContentType content, int t,
+                       uint32_t *seed) {
+  switch (content) {
+    case CONTENT_GRADIENT: draw_gradient(img, t, 0, seed); break;
+    case CONTENT_NOISE: draw_gradient(img, t, 1, seed); break;
+    default: draw_screen(img, t); break;
+  }
+}
+
+// Resets the peak resident set size where the OS allows it, so that each run
+// reports its own peak rather than that of the whole process.
+static void reset_peak_rss(void) {
+#if defined(__linux__)
+  FILE *const f = fopen("/proc/self/clear_refs", "w");
+  if (f) {
+    fputs("5", f);
+    fclose(f);
+  }
+#endif
+}
+
+// Returns the peak resident set size in kB, or -1 if it is not known.
+static long get_peak_rss_kb(void) {
+#if defined(_WIN32)
+  return -1;
+#else
+  struct rusage usage;
+#if defined(__linux__)
+  FILE *const f = fopen("/proc/self/status", "r");
+  if (f) {
+    char line[128];
+    long kb = -1;
+    while (fgets(line, sizeof(line), f)) {
+      if (!strncmp(line, "VmHWM:", 6)) {
+        kb = strtol(line + 6, NULL, 10);
+        break;
+      }
+    }
+    fclose(f);
+    if (kb >= 0)
+      return kb;
+  }
+#endif
+  if (getrusage(RUSAGE_SELF, &usage))
+    return -1;
+#if defined(__APPLE__)
+  return (long)(usage.ru_maxrss / 1024);
+#else
+  return (long)usage.ru_maxrss;
+#endif
+#endif
+}
+
+static void stream_append(Stream *stream, const vpx_codec_cx_pkt_t *pkt) {
+  const size_t size = pkt->data.frame.sz;
+
+  if (stream->size + size > stream->capacity) {
+    size_t capacity = stream->capacity ? stream->capacity : 1 << 16;
+    while (capacity < stream->size + size)
+      capacity *= 2;
+    stream->data = (uint8_t *)realloc(stream->data, capacity);
+    if (!stream->data)
+      die("Failed to allocate the stream buffer.\n");
+    stream->capacity = capacity;
+  }
+  memcpy(stream->data + stream->size, pkt->data.frame.buf, size);
+  stream->size += size;
+  stream->frame_sizes[stream->num_frames++] = size;
+}
+
+static int get_packets(vpx_codec_ctx_t *codec, Stream *stream) {
+  vpx_codec_iter_t iter = NULL;
+  const vpx_codec_cx_pkt_t *pkt;
+  int got_pkts = 0;
+
+  while ((pkt = vpx_codec_get_cx_data(codec, &iter)) != NULL) {
+    got_pkts = 1;
+    if (pkt->kind == VPX_CODEC_CX_FRAME_PKT)
+      stream_append(stream, pkt);
+  }
+  return got_pkts;
+}
+
+static int log2_floor(int n) {
+  int l = 0;
+  while (n >>= 1)
+    ++l;
+  return l;
+}
+
+// Returns the time spent in the encoder, in microseconds.
+static int64_t encode_stream(const PerfConfig *config, ContentType content,
+                             int width, int height, int speed, int threads,
+                             Stream *stream) {
+  vpx_codec_ctx_t codec;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_image_t img;
+  struct vpx_usec_timer timer;
+  const unsigned long deadline =
+      config->realtime ? VPX_DL_REALTIME : VPX_DL_GOOD_QUALITY;
+  const uint32_t fourcc = config->encoder->fourcc;
+  uint32_t seed = 0x1234;
+  int64_t elapsed = 0;
+  int i;
+
+  if (vpx_codec_enc_config_default(config->encoder->codec_interface(), &cfg,
+                                   0))
+    die("Failed to get the default encoder configuration.\n");
+  cfg.g_w = width;
+  cfg.g_h = height;
+  cfg.g_timebase.num = 1;
+  cfg.g_timebase.den = 30;
+  cfg.g_threads = threads;
+  cfg.g_lag_in_frames = 0;
+  cfg.g_error_resilient = 0;
+  cfg.rc_end_usage = VPX_VBR;
+  // About 0.1 bits per pixel at 30 frames per second.
+  cfg.rc_target_bitrate = (unsigned int)((int64_t)width * height * 3 / 1000);
+  cfg.kf_max_dist = 9999;
+
+  if (!vpx_img_alloc(&img, VPX_IMG_FMT_I420, width, height, 32))
+    die("Failed to allocate a %dx%d image.\n", width, height);
+  if (vpx_codec_enc_init(&codec, config->encoder->codec_interface(), &cfg, 0))
+    die_codec(&codec, "Failed to initialize the encoder");
+  if (vpx_codec_control(&codec, VP8E_SET_CPUUSED, speed))
+    die_codec(&codec, "Failed to set the speed");
+  if (fourcc == VP8_FOURCC) {
+    if (vpx_codec_control(&codec, VP8E_SET_TOKEN_PARTITIONS,
+                          log2_floor(threads) > 3 ? 3 : log2_floor(threads)))
+      die_codec(&codec, "Failed to set the token partitions");
+  } else {
+    // Tiles are what VP9 encodes and decodes in parallel.
+    if (vpx_codec_control(&codec, VP9E_SET_TILE_COLUMNS, log2_floor(threads)))
+      die_codec(&codec, "Failed to set the tile columns");
+  }
+
+  for (i = 0; i < config->frames; ++i) {
+    draw_frame(&img, content, i, &seed);
+    vpx_usec_timer_start(&timer);
+    if (vpx_codec_encode(&codec, &img, i, 1, 0, deadline))
+      die_codec(&codec, "Failed to encode frame");
+    get_packets(&codec, stream);
+    vpx_usec_timer_mark(&timer);
+    elapsed += vpx_usec_timer_elapsed(&timer);
+  }
+  vpx_usec_timer_start(&timer);
+  do {
+    if (vpx_codec_encode(&codec, NULL, -1, 1, 0, deadline))
+      die_codec(&codec, "Failed to flush the encoder");
+  } while (get_packets(&codec, stream));
+  vpx_usec_timer_mark(&timer);
+  elapsed += vpx_usec_timer_elapsed(&timer);
+
+  vpx_img_free(&img);
+  if (vpx_codec_destroy(&codec))
+    die_codec(&codec, "Failed to destroy the encoder");
+  return elapsed;
+}
+
+#if CONFIG_DECODERS
+// Returns the time spent in the decoder, in microseconds.
+static int64_t decode_stream(const PerfConfig *config, int threads,
+                             const Stream *stream) {
+  vpx_codec_ctx_t codec;
+  vpx_codec_dec_cfg_t cfg;
+  struct vpx_usec_timer timer;
+  const uint8_t *data = stream->data;
+  int i;
+
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.threads = threads;
+  if (vpx_codec_dec_init(&codec, config->decoder->codec_interface(), &cfg, 0))
+    die_codec(&codec, "Failed to initialize the decoder");
+
+  vpx_usec_timer_start(&timer);
+  for (i = 0; i < stream->num_frames; ++i) {
+    vpx_codec_iter_t iter = NULL;
+    if (vpx_codec_decode(&codec, data, (unsigned int)stream->frame_sizes[i],
+                         NULL, 0))
+      die_codec(&codec, "Failed to decode frame");
+    while (vpx_codec_get_frame(&codec, &iter) != NULL) {
+    }
+    data += stream->frame_sizes[i];
+  }
+  vpx_usec_timer_mark(&timer);
+
+  if (vpx_codec_destroy(&codec))
+    die_codec(&codec, "Failed to destroy the decoder");
+  return vpx_usec_timer_elapsed(&timer);
+}
+#endif
+
+static void run_perf(const PerfConfig *config, ContentType content,
+                     int width, int height, int speed, int threads,
+                     PerfResult *result) {
+  Stream stream;
+  int64_t encode_us;
+
+  memset(&stream, 0, sizeof(stream));
+  // Each frame gives at most one packet, plus a few for the flush.
+  stream.frame_sizes =
+      (size_t *)malloc((config->frames + 16) * sizeof(*stream.frame_sizes));
+  if (!stream.frame_sizes)
+    die("Failed to allocate the stream buffer.\n");
+
+  reset_peak_rss();
+  encode_us = encode_stream(config, content, width, height, speed, threads,
+                            &stream);
+  result->encode_fps =
+      encode_us > 0 ? config->frames * 1000000.0 / encode_us : 0;
+  result->kbps = stream.size * 8.0 * 30 / config->frames / 1000;
+  result->decode_fps = 0;
+#if CONFIG_DECODERS
+  if (config->decode) {
+    const int64_t decode_us = decode_stream(config, threads, &stream);
+    result->decode_fps =
+        decode_us > 0 ? stream.num_frames * 1000000.0 / decode_us : 0;
+  }
+#endif
+  result->peak_rss_kb = get_peak_rss_kb();
+
+  free(stream.frame_sizes);
+  free(stream.data);
+}
+
+static void print_result(const PerfConfig *config, ContentType content,
+                         int width, int height, int speed, int threads,
+                         const PerfResult *r, int first) {
+  if (config->json) {
+    printf("%s  {\"codec\": \"%s\", \"content\": \"%s\", \"width\": %d, "
+           "\"height\": %d, \"speed\": %d, \"threads\": %d, "
+           "\"frames\": %d, \"encode_fps\": %.2f, "
+           "\"encode_scaling_efficiency\": %.3f, \"kbps\": %.1f, ",
+           first ? "" : ",\n", config->encoder->name, kContentNames[content],
+           width, height, speed, threads, config->frames, r->encode_fps,
+           r->encode_efficiency, r->kbps);
+    if (config->decode) {
+      printf("\"decode_fps\": %.2f, \"decode_scaling_efficiency\": %.3f, ",
+             r->decode_fps, r->decode_efficiency);
+    }
+    if (r->peak_rss_kb >= 0)
+      printf("\"peak_rss_kb\": %ld}", r->peak_rss_kb);
+    else
+      printf("\"peak_rss_kb\": null}");
+  } else {
+    char size[32];
+    snprintf(size, sizeof(size), "%dx%d", width, height);
+    printf("%-5s %-9s %-10s %5d %7d %9.2f %6.0f%% %9.1f", config->encoder->name,
+           kContentNames[content], size, speed, threads, r->encode_fps,
+           100 * r->encode_efficiency, r->kbps);
+    if (config->decode) {
+      printf(" %9.2f %6.0f%%", r->decode_fps, 100 * r->decode_efficiency);
+    }
+    if (r->peak_rss_kb >= 0)
+      printf(" %9.1f\n", r->peak_rss_kb / 1024.0);
+    else
+      printf(" %9s\n", "n/a");
+  }
+}
+
+int main(int argc, char **argv) {
+  PerfConfig config;
+  const char *codec_name = "vp9";
+  int c, s, sp, t, i, first = 1;
+
+  exec_name = argv[0];
+  memset(&config, 0, sizeof(config));
+  config.num_contents = parse_content_list("gradient,noise,screen",
+                                           config.contents);
+  config.num_sizes = parse_size_list("352x288,640x360,1280x720",
+                                     config.widths, config.heights, MAX_LIST);
+  config.num_speeds = parse_int_list("5,8", config.speeds, MAX_LIST);
+  config.num_threads = parse_int_list("1,2,4", config.threads, MAX_LIST);
+  config.frames = 60;
+  config.decode = CONFIG_DECODERS;
+
+  for (i = 1; i < argc; ++i) {
+    const char *const arg = argv[i];
+    if (!strncmp(arg, "--codec=", 8)) {
+      codec_name = arg + 8;
+    } else if (!strncmp(arg, "--content=", 10)) {
+      config.num_contents = parse_content_list(arg + 10, config.contents);
+    } else if (!strncmp(arg, "--sizes=", 8)) {
+      config.num_sizes = parse_size_list(arg + 8, config.widths,
+                                         config.heights, MAX_LIST);
+    } else if (!strncmp(arg, "--speeds=", 9)) {
+      config.num_speeds = parse_int_list(arg + 9, config.speeds, MAX_LIST);
+    } else if (!strncmp(arg, "--threads=", 10)) {
+      config.num_threads = parse_int_list(arg + 10, config.threads, MAX_LIST);
+    } else if (!strncmp(arg, "--frames=", 9)) {
+      config.frames = atoi(arg + 9);
+    } else if (!strcmp(arg, "--rt")) {
+      config.realtime = 1;
+    } else if (!strcmp(arg, "--no-decode")) {
+      config.decode = 0;
+    } else if (!strcmp(arg, "--json")) {
+      config.json = 1;
+    } else {
+      usage_exit();
+    }
+  }
+  if (config.frames <= 0 || !config.num_contents || !config.num_sizes ||
+      !config.num_speeds || !config.num_threads)
+    usage_exit();
+  for (t = 0; t < config.num_threads; ++t) {
+    if (config.threads[t] <= 0)
+      usage_exit();
+  }
+
+  config.encoder = get_vpx_encoder_by_name(codec_name);
+  if (!config.encoder)
+    die("Unsupported codec '%s'.\n", codec_name);
+#if CONFIG_DECODERS
+  config.decoder = get_vpx_decoder_by_name(codec_name);
+  if (!config.decoder)
+    config.decode = 0;
+#endif
+
+  if (config.json) {
+    printf("{\n\"results\": [\n");
+  } else {
+    printf("%-5s %-9s %-10s %5s %7s %9s %7s %9s%s %9s\n", "codec", "content",
+           "size", "speed", "threads", "enc fps", "scaling", "kbps",
+           config.decode ? "   dec fps scaling" : "", "peak MB");
+  }
+
+  for (c = 0; c < config.num_contents; ++c) {
+    for (s = 0; s < config.num_sizes; ++s) {
+      for (sp = 0; sp < config.num_speeds; ++sp) {
+        PerfResult base;
+        memset(&base, 0, sizeof(base));
+        for (t = 0; t < config.num_threads; ++t) {
+          PerfResult r;
+          const double thread_ratio =
+              (double)config.threads[t] / config.threads[0];
+
+          run_perf(&config, config.contents[c], config.widths[s],
+                   config.heights[s], config.speeds[sp], config.threads[t],
+                   &r);
+          if (t == 0)
+            base = r;
+          // The speedup over the first thread count of the sweep, divided by
+          // the ratio of the thread counts: 1 is perfect scaling.
+          r.encode_efficiency = base.encode_fps > 0 ?
+              r.encode_fps / base.encode_fps / thread_ratio : 0;
+          r.decode_efficiency = base.decode_fps > 0 ?
+              r.decode_fps / base.decode_fps / thread_ratio : 0;
+          print_result(&config, config.contents[c], config.widths[s],
+                       config.heights[s], config.speeds[sp],
+                       config.threads[t], &r, first);
+          fflush(stdout);
+          first = 0;
+        }
+      }
+    }
+  }
+
+  if (config.json)
+    printf("\n]\n}\n");
+  return EXIT_SUCCESS;
+}
@@ -21,12 +21,13 @@ endif
 # Rule to generate runtime cpu detection files
 #
 define rtcd_h_template
-$$(BUILD_PFX)$(1).h: $$(SRC_PATH_BARE)/$(2)
+$$(BUILD_PFX)$(1).h: $$(SRC_PATH_BARE)/$(2) \
+                     $$(SRC_PATH_BARE)/build/make/rtcd.pl
 	@echo "    [CREATE] $$@"
 	$$(qexec)$$(SRC_PATH_BARE)/build/make/rtcd.pl --arch=$$(TGT_ISA) \
           --sym=$(1) \
           --config=$$(CONFIG_DIR)$$(target)-$$(TOOLCHAIN).mk \
-          $$(RTCD_OPTIONS) $$^ > $$@
+          $$(RTCD_OPTIONS) $$(SRC_PATH_BARE)/$(2) > $$@
 CLEAN-OBJS += $$(BUILD_PFX)$(1).h
 RTCD += $$(BUILD_PFX)$(1).h
 endef
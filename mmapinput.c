@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "./vpx_config.h"
+
+#if HAVE_UNISTD_H && !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#else
+#define HAVE_MMAP 0
+#endif
+
+#include "./mmapinput.h"
+
+#if HAVE_MMAP && CONFIG_MULTITHREAD
+static THREADFN prefetch_thread(void *arg) {
+  struct VpxMappedInput *const map = (struct VpxMappedInput *)arg;
+
+  pthread_mutex_lock(&map->mutex);
+  for (;;) {
+    const volatile uint8_t *p;
+    const volatile uint8_t *end;
+    uint8_t sum = 0;
+
+    while (map->prefetch_size == 0 && !map->done)
+      pthread_cond_wait(&map->requested, &map->mutex);
+    if (map->done)
+      break;
+    p = map->data + map->prefetch_start;
+    end = p + map->prefetch_size;
+    map->prefetch_size = 0;
+    pthread_mutex_unlock(&map->mutex);
+
+    for (; p < end; p += map->page_size)
+      sum += *p;
+
+    pthread_mutex_lock(&map->mutex);
+    map->prefetch_sum = sum;
+  }
+  pthread_mutex_unlock(&map->mutex);
+  return THREAD_RETURN(NULL);
+}
+#endif
+
+int mapped_input_open(struct VpxMappedInput *map, FILE *file, int64_t offset) {
+#if HAVE_MMAP
+  struct stat st;
+  void *data;
+
+  memset(map, 0, sizeof(*map));
+  if (fstat(fileno(file), &st) || !S_ISREG(st.st_mode) ||
+      st.st_size <= offset || (uint64_t)st.st_size > (size_t)-1)
+    return 0;
+
+  data = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+              fileno(file), 0);
+  if (data == MAP_FAILED)
+    return 0;
+  madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+  map->data = (uint8_t *)data;
+  map->size = (size_t)st.st_size;
+  map->position = (size_t)offset;
+  map->page_size = (size_t)sysconf(_SC_PAGESIZE);
+  if (map->page_size == 0 || map->page_size == (size_t)-1)
+    map->page_size = 4096;
+
+  // Without a thread the pages are simply faulted in by the reader.
+#if CONFIG_MULTITHREAD
+  pthread_mutex_init(&map->mutex, NULL);
+  pthread_cond_init(&map->requested, NULL);
+  map->prefetching =
+      !pthread_create(&map->prefetch_thread, NULL, prefetch_thread, map);
+  if (!map->prefetching) {
+    pthread_cond_destroy(&map->requested);
+    pthread_mutex_destroy(&map->mutex);
+  }
+#endif
+  return 1;
+#else
+  (void)file;
+  (void)offset;
+  memset(map, 0, sizeof(*map));
+  return 0;
+#endif
+}
+
+void mapped_input_close(struct VpxMappedInput *map) {
+#if HAVE_MMAP
+  if (map->data) {
+#if CONFIG_MULTITHREAD
+    if (map->prefetching) {
+      pthread_mutex_lock(&map->mutex);
+      map->done = 1;
+      pthread_cond_signal(&map->requested);
+      pthread_mutex_unlock(&map->mutex);
+      pthread_join(map->prefetch_thread, NULL);
+      pthread_cond_destroy(&map->requested);
+      pthread_mutex_destroy(&map->mutex);
+    }
+#endif
+    munmap(map->data, map->size);
+  }
+#endif
+  memset(map, 0, sizeof(*map));
+}
+
+int mapped_input_is_open(const struct VpxMappedInput *map) {
+  return map->data != NULL;
+}
+
+int64_t mapped_input_position(const struct VpxMappedInput *map) {
+  return (int64_t)map->position;
+}
+
+uint8_t *mapped_input_peek(const struct VpxMappedInput *map,
+                           size_t *available) {
+  *available = map->size - map->position;
+  return map->data + map->position;
+}
+
+void mapped_input_consume(struct VpxMappedInput *map, size_t size,
+                          size_t read_ahead) {
+  map->position += size;
+  if (map->position > map->size)
+    map->position = map->size;
+  if (!map->prefetching || read_ahead == 0)
+    return;
+
+#if CONFIG_MULTITHREAD
+  // A read-ahead still pending is replaced: it covered the data just
+  // consumed.
+  pthread_mutex_lock(&map->mutex);
+  map->prefetch_start = map->position;
+  map->prefetch_size = map->size - map->position;
+  if (map->prefetch_size > read_ahead)
+    map->prefetch_size = read_ahead;
+  pthread_cond_signal(&map->requested);
+  pthread_mutex_unlock(&map->mutex);
+#endif
+}
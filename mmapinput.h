@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef MMAPINPUT_H_
+#define MMAPINPUT_H_
+
+#include <stdio.h>
+
+#include "./vpx_config.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_util/vpx_thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Readable and writable private mapping of an input file. A thread touches
+// the pages of the data expected to be read next, so the page faults are
+// taken off the reading thread. Images may point straight into the mapping;
+// it is copy on write, so writing to them never reaches the file.
+struct VpxMappedInput {
+  uint8_t *data;
+  size_t size;
+  // Read position, as an offset from the start of the file.
+  size_t position;
+  size_t page_size;
+  int prefetching;
+#if CONFIG_MULTITHREAD
+  pthread_t prefetch_thread;
+  pthread_mutex_t mutex;
+  // Signalled when a new read-ahead is requested or the map is closed.
+  pthread_cond_t requested;
+  int done;
+#endif
+  size_t prefetch_start;
+  size_t prefetch_size;
+  uint8_t prefetch_sum;
+};
+
+// Maps |file| with reading starting at |offset|. Returns 0, leaving |map|
+// unused, if the file can not be mapped, e.g. when it is a pipe.
+int mapped_input_open(struct VpxMappedInput *map, FILE *file, int64_t offset);
+
+void mapped_input_close(struct VpxMappedInput *map);
+
+int mapped_input_is_open(const struct VpxMappedInput *map);
+
+// Returns the read position as an offset from the start of the file.
+int64_t mapped_input_position(const struct VpxMappedInput *map);
+
+// Returns the data at the read position and sets |available| to the number of
+// bytes left in the file.
+uint8_t *mapped_input_peek(const struct VpxMappedInput *map,
+                           size_t *available);
+
+// Advances the read position by |size| bytes and starts touching the
+// |read_ahead| bytes that follow.
+void mapped_input_consume(struct VpxMappedInput *map, size_t size,
+                          size_t read_ahead);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif  // MMAPINPUT_H_
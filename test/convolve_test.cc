@@ -961,6 +961,78 @@ using std::tr1::make_tuple;
 
 #if CONFIG_VP9_HIGHBITDEPTH
 #if HAVE_SSE2 && ARCH_X86_64
+void wrap_convolve_copy_sse2_8(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const int16_t *filter_x,
+                               int filter_x_stride,
+                               const int16_t *filter_y,
+                               int filter_y_stride,
+                               int w, int h) {
+  vpx_highbd_convolve_copy_sse2(src, src_stride, dst, dst_stride,
+                                filter_x, filter_x_stride,
+                                filter_y, filter_y_stride, w, h, 8);
+}
+
+void wrap_convolve_avg_sse2_8(const uint8_t *src, ptrdiff_t src_stride,
+                              uint8_t *dst, ptrdiff_t dst_stride,
+                              const int16_t *filter_x,
+                              int filter_x_stride,
+                              const int16_t *filter_y,
+                              int filter_y_stride,
+                              int w, int h) {
+  vpx_highbd_convolve_avg_sse2(src, src_stride, dst, dst_stride,
+                               filter_x, filter_x_stride,
+                               filter_y, filter_y_stride, w, h, 8);
+}
+
+void wrap_convolve_copy_sse2_10(const uint8_t *src, ptrdiff_t src_stride,
+                                uint8_t *dst, ptrdiff_t dst_stride,
+                                const int16_t *filter_x,
+                                int filter_x_stride,
+                                const int16_t *filter_y,
+                                int filter_y_stride,
+                                int w, int h) {
+  vpx_highbd_convolve_copy_sse2(src, src_stride, dst, dst_stride,
+                                filter_x, filter_x_stride,
+                                filter_y, filter_y_stride, w, h, 10);
+}
+
+void wrap_convolve_avg_sse2_10(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const int16_t *filter_x,
+                               int filter_x_stride,
+                               const int16_t *filter_y,
+                               int filter_y_stride,
+                               int w, int h) {
+  vpx_highbd_convolve_avg_sse2(src, src_stride, dst, dst_stride,
+                               filter_x, filter_x_stride,
+                               filter_y, filter_y_stride, w, h, 10);
+}
+
+void wrap_convolve_copy_sse2_12(const uint8_t *src, ptrdiff_t src_stride,
+                                uint8_t *dst, ptrdiff_t dst_stride,
+                                const int16_t *filter_x,
+                                int filter_x_stride,
+                                const int16_t *filter_y,
+                                int filter_y_stride,
+                                int w, int h) {
+  vpx_highbd_convolve_copy_sse2(src, src_stride, dst, dst_stride,
+                                filter_x, filter_x_stride,
+                                filter_y, filter_y_stride, w, h, 12);
+}
+
+void wrap_convolve_avg_sse2_12(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const int16_t *filter_x,
+                               int filter_x_stride,
+                               const int16_t *filter_y,
+                               int filter_y_stride,
+                               int w, int h) {
+  vpx_highbd_convolve_avg_sse2(src, src_stride, dst, dst_stride,
+                               filter_x, filter_x_stride,
+                               filter_y, filter_y_stride, w, h, 12);
+}
+
 void wrap_convolve8_horiz_sse2_8(const uint8_t *src, ptrdiff_t src_stride,
                                  uint8_t *dst, ptrdiff_t dst_stride,
                                  const int16_t *filter_x,
@@ -1178,6 +1250,80 @@ void wrap_convolve8_avg_sse2_12(const uint8_t *src, ptrdiff_t src_stride,
 }
 #endif  // HAVE_SSE2 && ARCH_X86_64
 
+#if HAVE_AVX2 && HAVE_SSE2 && ARCH_X86_64
+void wrap_convolve_copy_avx2_8(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const int16_t *filter_x,
+                               int filter_x_stride,
+                               const int16_t *filter_y,
+                               int filter_y_stride,
+                               int w, int h) {
+  vpx_highbd_convolve_copy_avx2(src, src_stride, dst, dst_stride,
+                                filter_x, filter_x_stride,
+                                filter_y, filter_y_stride, w, h, 8);
+}
+
+void wrap_convolve_avg_avx2_8(const uint8_t *src, ptrdiff_t src_stride,
+                              uint8_t *dst, ptrdiff_t dst_stride,
+                              const int16_t *filter_x,
+                              int filter_x_stride,
+                              const int16_t *filter_y,
+                              int filter_y_stride,
+                              int w, int h) {
+  vpx_highbd_convolve_avg_avx2(src, src_stride, dst, dst_stride,
+                               filter_x, filter_x_stride,
+                               filter_y, filter_y_stride, w, h, 8);
+}
+
+void wrap_convolve_copy_avx2_10(const uint8_t *src, ptrdiff_t src_stride,
+                                uint8_t *dst, ptrdiff_t dst_stride,
+                                const int16_t *filter_x,
+                                int filter_x_stride,
+                                const int16_t *filter_y,
+                                int filter_y_stride,
+                                int w, int h) {
+  vpx_highbd_convolve_copy_avx2(src, src_stride, dst, dst_stride,
+                                filter_x, filter_x_stride,
+                                filter_y, filter_y_stride, w, h, 10);
+}
+
+void wrap_convolve_avg_avx2_10(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const int16_t *filter_x,
+                               int filter_x_stride,
+                               const int16_t *filter_y,
+                               int filter_y_stride,
+                               int w, int h) {
+  vpx_highbd_convolve_avg_avx2(src, src_stride, dst, dst_stride,
+                               filter_x, filter_x_stride,
+                               filter_y, filter_y_stride, w, h, 10);
+}
+
+void wrap_convolve_copy_avx2_12(const uint8_t *src, ptrdiff_t src_stride,
+                                uint8_t *dst, ptrdiff_t dst_stride,
+                                const int16_t *filter_x,
+                                int filter_x_stride,
+                                const int16_t *filter_y,
+                                int filter_y_stride,
+                                int w, int h) {
+  vpx_highbd_convolve_copy_avx2(src, src_stride, dst, dst_stride,
+                                filter_x, filter_x_stride,
+                                filter_y, filter_y_stride, w, h, 12);
+}
+
+void wrap_convolve_avg_avx2_12(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const int16_t *filter_x,
+                               int filter_x_stride,
+                               const int16_t *filter_y,
+                               int filter_y_stride,
+                               int w, int h) {
+  vpx_highbd_convolve_avg_avx2(src, src_stride, dst, dst_stride,
+                               filter_x, filter_x_stride,
+                               filter_y, filter_y_stride, w, h, 12);
+}
+#endif  // HAVE_AVX2 && HAVE_SSE2 && ARCH_X86_64
+
 void wrap_convolve_copy_c_8(const uint8_t *src, ptrdiff_t src_stride,
                             uint8_t *dst, ptrdiff_t dst_stride,
                             const int16_t *filter_x,
@@ -1563,7 +1709,7 @@ INSTANTIATE_TEST_CASE_P(C, ConvolveTest, ::testing::Values(
 #if HAVE_SSE2 && ARCH_X86_64
 #if CONFIG_VP9_HIGHBITDEPTH
 const ConvolveFunctions convolve8_sse2(
-    wrap_convolve_copy_c_8, wrap_convolve_avg_c_8,
+    wrap_convolve_copy_sse2_8, wrap_convolve_avg_sse2_8,
     wrap_convolve8_horiz_sse2_8, wrap_convolve8_avg_horiz_sse2_8,
     wrap_convolve8_vert_sse2_8, wrap_convolve8_avg_vert_sse2_8,
     wrap_convolve8_sse2_8, wrap_convolve8_avg_sse2_8,
@@ -1571,7 +1717,7 @@ const ConvolveFunctions convolve8_sse2(
     wrap_convolve8_vert_sse2_8, wrap_convolve8_avg_vert_sse2_8,
     wrap_convolve8_sse2_8, wrap_convolve8_avg_sse2_8, 8);
 const ConvolveFunctions convolve10_sse2(
-    wrap_convolve_copy_c_10, wrap_convolve_avg_c_10,
+    wrap_convolve_copy_sse2_10, wrap_convolve_avg_sse2_10,
     wrap_convolve8_horiz_sse2_10, wrap_convolve8_avg_horiz_sse2_10,
     wrap_convolve8_vert_sse2_10, wrap_convolve8_avg_vert_sse2_10,
     wrap_convolve8_sse2_10, wrap_convolve8_avg_sse2_10,
@@ -1579,7 +1725,7 @@ const ConvolveFunctions convolve10_sse2(
     wrap_convolve8_vert_sse2_10, wrap_convolve8_avg_vert_sse2_10,
     wrap_convolve8_sse2_10, wrap_convolve8_avg_sse2_10, 10);
 const ConvolveFunctions convolve12_sse2(
-    wrap_convolve_copy_c_12, wrap_convolve_avg_c_12,
+    wrap_convolve_copy_sse2_12, wrap_convolve_avg_sse2_12,
     wrap_convolve8_horiz_sse2_12, wrap_convolve8_avg_horiz_sse2_12,
     wrap_convolve8_vert_sse2_12, wrap_convolve8_avg_vert_sse2_12,
     wrap_convolve8_sse2_12, wrap_convolve8_avg_sse2_12,
@@ -1692,8 +1838,34 @@ const ConvolveFunctions convolve8_avx2(
     vpx_scaled_horiz_c, vpx_scaled_avg_horiz_c,
     vpx_scaled_vert_c, vpx_scaled_avg_vert_c,
     vpx_scaled_2d_c, vpx_scaled_avg_2d_c, 0);
+#if CONFIG_VP9_HIGHBITDEPTH && HAVE_SSE2 && ARCH_X86_64
+const ConvolveFunctions convolve8_highbd_avx2(
+    wrap_convolve_copy_avx2_8, wrap_convolve_avg_avx2_8,
+    wrap_convolve8_horiz_sse2_8, wrap_convolve8_avg_horiz_sse2_8,
+    wrap_convolve8_vert_sse2_8, wrap_convolve8_avg_vert_sse2_8,
+    wrap_convolve8_sse2_8, wrap_convolve8_avg_sse2_8,
+    wrap_convolve8_horiz_sse2_8, wrap_convolve8_avg_horiz_sse2_8,
+    wrap_convolve8_vert_sse2_8, wrap_convolve8_avg_vert_sse2_8,
+    wrap_convolve8_sse2_8, wrap_convolve8_avg_sse2_8, 8);
+const ConvolveFunctions convolve10_highbd_avx2(
+    wrap_convolve_copy_avx2_10, wrap_convolve_avg_avx2_10,
+    wrap_convolve8_horiz_sse2_10, wrap_convolve8_avg_horiz_sse2_10,
+    wrap_convolve8_vert_sse2_10, wrap_convolve8_avg_vert_sse2_10,
+    wrap_convolve8_sse2_10, wrap_convolve8_avg_sse2_10,
+    wrap_convolve8_horiz_sse2_10, wrap_convolve8_avg_horiz_sse2_10,
+    wrap_convolve8_vert_sse2_10, wrap_convolve8_avg_vert_sse2_10,
+    wrap_convolve8_sse2_10, wrap_convolve8_avg_sse2_10, 10);
+const ConvolveFunctions convolve12_highbd_avx2(
+    wrap_convolve_copy_avx2_12, wrap_convolve_avg_avx2_12,
+    wrap_convolve8_horiz_sse2_12, wrap_convolve8_avg_horiz_sse2_12,
+    wrap_convolve8_vert_sse2_12, wrap_convolve8_avg_vert_sse2_12,
+    wrap_convolve8_sse2_12, wrap_convolve8_avg_sse2_12,
+    wrap_convolve8_horiz_sse2_12, wrap_convolve8_avg_horiz_sse2_12,
+    wrap_convolve8_vert_sse2_12, wrap_convolve8_avg_vert_sse2_12,
+    wrap_convolve8_sse2_12, wrap_convolve8_avg_sse2_12, 12);
+#endif  // CONFIG_VP9_HIGHBITDEPTH && HAVE_SSE2 && ARCH_X86_64
 
-INSTANTIATE_TEST_CASE_P(AVX2, ConvolveTest, ::testing::Values(
+const ConvolveParam kArrayConvolve_avx2[] = {
     make_tuple(4, 4, &convolve8_avx2),
     make_tuple(8, 4, &convolve8_avx2),
     make_tuple(4, 8, &convolve8_avx2),
@@ -1706,9 +1878,73 @@ INSTANTIATE_TEST_CASE_P(AVX2, ConvolveTest, ::testing::Values(
     make_tuple(32, 32, &convolve8_avx2),
     make_tuple(64, 32, &convolve8_avx2),
     make_tuple(32, 64, &convolve8_avx2),
-    make_tuple(64, 64, &convolve8_avx2)));
+    make_tuple(64, 64, &convolve8_avx2),
+#if CONFIG_VP9_HIGHBITDEPTH && HAVE_SSE2 && ARCH_X86_64
+    make_tuple(4, 4, &convolve8_highbd_avx2),
+    make_tuple(8, 4, &convolve8_highbd_avx2),
+    make_tuple(4, 8, &convolve8_highbd_avx2),
+    make_tuple(8, 8, &convolve8_highbd_avx2),
+    make_tuple(8, 16, &convolve8_highbd_avx2),
+    make_tuple(16, 8, &convolve8_highbd_avx2),
+    make_tuple(16, 16, &convolve8_highbd_avx2),
+    make_tuple(32, 16, &convolve8_highbd_avx2),
+    make_tuple(16, 32, &convolve8_highbd_avx2),
+    make_tuple(32, 32, &convolve8_highbd_avx2),
+    make_tuple(64, 32, &convolve8_highbd_avx2),
+    make_tuple(32, 64, &convolve8_highbd_avx2),
+    make_tuple(64, 64, &convolve8_highbd_avx2),
+    make_tuple(4, 4, &convolve10_highbd_avx2),
+    make_tuple(8, 4, &convolve10_highbd_avx2),
+    make_tuple(4, 8, &convolve10_highbd_avx2),
+    make_tuple(8, 8, &convolve10_highbd_avx2),
+    make_tuple(8, 16, &convolve10_highbd_avx2),
+    make_tuple(16, 8, &convolve10_highbd_avx2),
+    make_tuple(16, 16, &convolve10_highbd_avx2),
+    make_tuple(32, 16, &convolve10_highbd_avx2),
+    make_tuple(16, 32, &convolve10_highbd_avx2),
+    make_tuple(32, 32, &convolve10_highbd_avx2),
+    make_tuple(64, 32, &convolve10_highbd_avx2),
+    make_tuple(32, 64, &convolve10_highbd_avx2),
+    make_tuple(64, 64, &convolve10_highbd_avx2),
+    make_tuple(4, 4, &convolve12_highbd_avx2),
+    make_tuple(8, 4, &convolve12_highbd_avx2),
+    make_tuple(4, 8, &convolve12_highbd_avx2),
+    make_tuple(8, 8, &convolve12_highbd_avx2),
+    make_tuple(8, 16, &convolve12_highbd_avx2),
+    make_tuple(16, 8, &convolve12_highbd_avx2),
+    make_tuple(16, 16, &convolve12_highbd_avx2),
+    make_tuple(32, 16, &convolve12_highbd_avx2),
+    make_tuple(16, 32, &convolve12_highbd_avx2),
+    make_tuple(32, 32, &convolve12_highbd_avx2),
+    make_tuple(64, 32, &convolve12_highbd_avx2),
+    make_tuple(32, 64, &convolve12_highbd_avx2),
+    make_tuple(64, 64, &convolve12_highbd_avx2),
+#endif  // CONFIG_VP9_HIGHBITDEPTH && HAVE_SSE2 && ARCH_X86_64
+};
+INSTANTIATE_TEST_CASE_P(AVX2, ConvolveTest,
+                        ::testing::ValuesIn(kArrayConvolve_avx2));
 #endif  // HAVE_AVX2 && HAVE_SSSE3
 
+#if HAVE_AVX512 && HAVE_AVX2 && HAVE_SSSE3
+const ConvolveFunctions convolve8_avx512(
+    vpx_convolve_copy_c, vpx_convolve_avg_c,
+    vpx_convolve8_horiz_avx512, vpx_convolve8_avg_horiz_ssse3,
+    vpx_convolve8_vert_avx512, vpx_convolve8_avg_vert_ssse3,
+    vpx_convolve8_avx512, vpx_convolve8_avg_ssse3,
+    vpx_scaled_horiz_c, vpx_scaled_avg_horiz_c,
+    vpx_scaled_vert_c, vpx_scaled_avg_vert_c,
+    vpx_scaled_2d_c, vpx_scaled_avg_2d_c, 0);
+
+INSTANTIATE_TEST_CASE_P(AVX512, ConvolveTest, ::testing::Values(
+    make_tuple(16, 16, &convolve8_avx512),
+    make_tuple(32, 16, &convolve8_avx512),
+    make_tuple(16, 32, &convolve8_avx512),
+    make_tuple(32, 32, &convolve8_avx512),
+    make_tuple(64, 32, &convolve8_avx512),
+    make_tuple(32, 64, &convolve8_avx512),
+    make_tuple(64, 64, &convolve8_avx512)));
+#endif  // HAVE_AVX512 && HAVE_AVX2 && HAVE_SSSE3
+
 #if HAVE_NEON
 #if HAVE_NEON_ASM
 const ConvolveFunctions convolve8_neon(
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "vpx/vpx_codec.h"
+#include "vpx_ports/rtcd_select.h"
+
+namespace {
+
+void KernelC() {}
+void KernelA() {}
+void KernelB() {}
+
+const int kFlagA = 0x1;
+const int kFlagB = 0x2;
+
+const rtcd_variant_t kVariants[] = {
+  { KernelC, "c", 0 },
+  { KernelA, "sse2", kFlagA },
+  { KernelB, "avx2", kFlagB },
+};
+
+class RtcdSelectTest : public ::testing::Test {
+ protected:
+  // Each test starts without rules and may set new ones.
+  virtual void SetUp() { vpx_rtcd_select_reset(); }
+  virtual void TearDown() { vpx_rtcd_select_reset(); }
+};
+
+rtcd_fn_t Select(int cpu_flags) {
+  // A prototype without a tuning runner, so that the default choice is made
+  // even with VPX_SIMD_TUNE set.
+  return vpx_rtcd_select("rtcd_select_test_kernel", "void(void)", cpu_flags,
+                         kVariants, 3);
+}
+
+TEST_F(RtcdSelectTest, SelectsLastSupportedVariant) {
+  EXPECT_EQ(&KernelC, Select(0));
+  EXPECT_EQ(&KernelA, Select(kFlagA));
+  EXPECT_EQ(&KernelB, Select(kFlagB));
+  EXPECT_EQ(&KernelB, Select(kFlagA | kFlagB));
+}
+
+TEST_F(RtcdSelectTest, DeniedVariantIsSkipped) {
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_set_kernel_isa("rtcd_select_test_", "avx2",
+                                     VPX_KERNEL_ISA_DENY));
+  EXPECT_EQ(&KernelA, Select(kFlagA | kFlagB));
+  EXPECT_EQ(&KernelC, Select(kFlagB));
+}
+
+TEST_F(RtcdSelectTest, RulesOnlyApplyToMatchingKernels) {
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_set_kernel_isa("vpx_sad", "avx2", VPX_KERNEL_ISA_DENY));
+  EXPECT_EQ(&KernelB, Select(kFlagA | kFlagB));
+}
+
+TEST_F(RtcdSelectTest, ForcedVariantIsUsedWhereSupported) {
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_set_kernel_isa("rtcd_select_test_kernel", "sse2",
+                                     VPX_KERNEL_ISA_FORCE));
+  EXPECT_EQ(&KernelA, Select(kFlagA | kFlagB));
+  // The CPU does not support the forced variant.
+  EXPECT_EQ(&KernelB, Select(kFlagB));
+  EXPECT_EQ(&KernelC, Select(0));
+}
+
+TEST_F(RtcdSelectTest, LaterRulesTakePrecedence) {
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_set_kernel_isa("rtcd_select_test_", "c",
+                                     VPX_KERNEL_ISA_FORCE));
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_set_kernel_isa("rtcd_select_test_kernel", "c",
+                                     VPX_KERNEL_ISA_DENY));
+  EXPECT_EQ(&KernelB, Select(kFlagA | kFlagB));
+}
+
+TEST_F(RtcdSelectTest, FallsBackToCWhenAllVariantsAreDenied) {
+  static const char *const kIsas[] = { "c", "sse2", "avx2" };
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_set_kernel_isa("rtcd_select_test_kernel", kIsas[i],
+                                       VPX_KERNEL_ISA_DENY));
+  }
+  EXPECT_EQ(&KernelC, Select(kFlagA | kFlagB));
+  EXPECT_EQ(&KernelC, Select(0));
+}
+
+TEST_F(RtcdSelectTest, RejectsInvalidRules) {
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_set_kernel_isa(NULL, "sse2", VPX_KERNEL_ISA_DENY));
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_set_kernel_isa("vpx_sad", NULL, VPX_KERNEL_ISA_DENY));
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_set_kernel_isa("vpx_sad", "sse9", VPX_KERNEL_ISA_FORCE));
+}
+
+TEST_F(RtcdSelectTest, RejectsRulesAfterSelection) {
+  Select(0);
+  EXPECT_EQ(VPX_CODEC_ERROR,
+            vpx_codec_set_kernel_isa("vpx_convolve8", "avx2",
+                                     VPX_KERNEL_ISA_DENY));
+  EXPECT_EQ(VPX_CODEC_ERROR, vpx_codec_set_kernel_tuning(1));
+}
+
+}  // namespace
@@ -1113,6 +1113,33 @@ const SadMxNx4Param x4d_avx2_tests[] = {
 INSTANTIATE_TEST_CASE_P(AVX2, SADx4Test, ::testing::ValuesIn(x4d_avx2_tests));
 #endif  // HAVE_AVX2
 
+#if HAVE_AVX512
+const SadMxNFunc sad64x64_avx512 = vpx_sad64x64_avx512;
+const SadMxNFunc sad64x32_avx512 = vpx_sad64x32_avx512;
+const SadMxNFunc sad32x64_avx512 = vpx_sad32x64_avx512;
+const SadMxNFunc sad32x32_avx512 = vpx_sad32x32_avx512;
+const SadMxNParam avx512_tests[] = {
+  make_tuple(64, 64, sad64x64_avx512, -1),
+  make_tuple(64, 32, sad64x32_avx512, -1),
+  make_tuple(32, 64, sad32x64_avx512, -1),
+  make_tuple(32, 32, sad32x32_avx512, -1),
+};
+INSTANTIATE_TEST_CASE_P(AVX512, SADTest, ::testing::ValuesIn(avx512_tests));
+
+const SadMxNx4Func sad64x64x4d_avx512 = vpx_sad64x64x4d_avx512;
+const SadMxNx4Func sad64x32x4d_avx512 = vpx_sad64x32x4d_avx512;
+const SadMxNx4Func sad32x64x4d_avx512 = vpx_sad32x64x4d_avx512;
+const SadMxNx4Func sad32x32x4d_avx512 = vpx_sad32x32x4d_avx512;
+const SadMxNx4Param x4d_avx512_tests[] = {
+  make_tuple(64, 64, sad64x64x4d_avx512, -1),
+  make_tuple(64, 32, sad64x32x4d_avx512, -1),
+  make_tuple(32, 64, sad32x64x4d_avx512, -1),
+  make_tuple(32, 32, sad32x32x4d_avx512, -1),
+};
+INSTANTIATE_TEST_CASE_P(AVX512, SADx4Test,
+                        ::testing::ValuesIn(x4d_avx512_tests));
+#endif  // HAVE_AVX512
+
 //------------------------------------------------------------------------------
 // MIPS functions
 #if HAVE_MSA
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstring>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+const int kNumIterations = 1000;
+const int kMaxBlocks = 40;
+const int kStride = 4 * kMaxBlocks + 16;
+const int kNumSums = 5;
+
+typedef void (*SsimParmsRowFunc)(const uint8_t *s, int sp, const uint8_t *r,
+                                 int rp, int n, uint32_t *sum_s,
+                                 uint32_t *sum_r, uint32_t *sum_sq_s,
+                                 uint32_t *sum_sq_r, uint32_t *sum_sxr);
+
+class SsimParmsRowTest : public ::testing::TestWithParam<SsimParmsRowFunc> {
+ public:
+  virtual ~SsimParmsRowTest() {}
+  virtual void SetUp() { parms_op_ = GetParam(); }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  SsimParmsRowFunc parms_op_;
+};
+
+TEST_P(SsimParmsRowTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint8_t, src[4 * kStride]);
+  DECLARE_ALIGNED(16, uint8_t, ref[4 * kStride]);
+  // One extra entry for each sum to catch writes past block n - 1.
+  uint32_t ref_sums[kNumSums][kMaxBlocks + 1];
+  uint32_t sums[kNumSums][kMaxBlocks + 1];
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    const int n = 1 + rnd(kMaxBlocks);
+    // Unaligned rows, and every other iteration extreme values.
+    const int offset = rnd(16);
+
+    for (int k = 0; k < 4 * kStride; ++k) {
+      if (i & 1) {
+        src[k] = rnd.Rand8();
+        ref[k] = rnd.Rand8();
+      } else {
+        src[k] = (rnd.Rand8() & 1) ? 255 : 0;
+        ref[k] = (rnd.Rand8() & 1) ? 255 : rnd.Rand8();
+      }
+    }
+    memset(ref_sums, 0xa5, sizeof(ref_sums));
+    memset(sums, 0xa5, sizeof(sums));
+
+    vpx_ssim_parms_4x4_row_c(src + offset, kStride, ref + offset, kStride, n,
+                             ref_sums[0], ref_sums[1], ref_sums[2],
+                             ref_sums[3], ref_sums[4]);
+    ASM_REGISTER_STATE_CHECK(parms_op_(src + offset, kStride, ref + offset,
+                                       kStride, n, sums[0], sums[1], sums[2],
+                                       sums[3], sums[4]));
+    ASSERT_EQ(0, memcmp(ref_sums, sums, sizeof(sums)))
+        << "n: " << n << " offset: " << offset;
+  }
+}
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(SSE2, SsimParmsRowTest,
+                        ::testing::Values(&vpx_ssim_parms_4x4_row_sse2));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, SsimParmsRowTest,
+                        ::testing::Values(&vpx_ssim_parms_4x4_row_avx2));
+#endif  // HAVE_AVX2
+}  // namespace
@@ -0,0 +1,218 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstring>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#if CONFIG_VP8_ENCODER
+#include "./vp8_rtcd.h"
+#endif
+#if CONFIG_VP9_ENCODER
+#include "./vp9_rtcd.h"
+#endif
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+const int kNumIterations = 1000;
+const int kMaxBlockSize = 32;
+const int kStride = 48;
+
+// Fills |frame1| and |frame2| with pixels of |bit_depth| bits. Every other
+// block uses extreme values, giving differences too large to fit the
+// modifier in 16 bits.
+template <typename Pixel>
+void FillBlocks(ACMRandom *rnd, int bit_depth, int i, Pixel *frame1,
+                Pixel *frame2) {
+  const int mask = (1 << bit_depth) - 1;
+  for (int k = 0; k < kMaxBlockSize * kStride; ++k) {
+    if (i & 1) {
+      frame1[k] = rnd->Rand16() & mask;
+      frame2[k] = rnd->Rand16() & mask;
+    } else {
+      frame1[k] = (rnd->Rand8() & 1) ? mask : 0;
+      frame2[k] = (rnd->Rand8() & 1) ? mask : rnd->Rand16() & mask;
+    }
+  }
+}
+
+#if CONFIG_VP9_ENCODER
+typedef void (*Vp9TemporalFilterFunc)(uint8_t *frame1, unsigned int stride,
+                                      uint8_t *frame2,
+                                      unsigned int block_width,
+                                      unsigned int block_height,
+                                      int strength, int filter_weight,
+                                      unsigned int *accumulator,
+                                      uint16_t *count);
+typedef std::tr1::tuple<Vp9TemporalFilterFunc, Vp9TemporalFilterFunc, int>
+    Vp9TemporalFilterParam;
+
+class Vp9TemporalFilterTest
+    : public ::testing::TestWithParam<Vp9TemporalFilterParam> {
+ public:
+  virtual ~Vp9TemporalFilterTest() {}
+  virtual void SetUp() {
+    filter_op_ = GET_PARAM(0);
+    ref_filter_op_ = GET_PARAM(1);
+    bit_depth_ = GET_PARAM(2);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  Vp9TemporalFilterFunc filter_op_;
+  Vp9TemporalFilterFunc ref_filter_op_;
+  int bit_depth_;
+};
+
+TEST_P(Vp9TemporalFilterTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint16_t, frame1[kMaxBlockSize * kStride]);
+  DECLARE_ALIGNED(16, uint16_t, frame2[kMaxBlockSize * kStride]);
+  DECLARE_ALIGNED(16, uint8_t, frame1_8[kMaxBlockSize * kStride]);
+  DECLARE_ALIGNED(16, uint8_t, frame2_8[kMaxBlockSize * kStride]);
+  DECLARE_ALIGNED(16, unsigned int, ref_accumulator[kMaxBlockSize *
+                                                    kMaxBlockSize]);
+  DECLARE_ALIGNED(16, unsigned int, accumulator[kMaxBlockSize *
+                                                kMaxBlockSize]);
+  DECLARE_ALIGNED(16, uint16_t, ref_count[kMaxBlockSize * kMaxBlockSize]);
+  DECLARE_ALIGNED(16, uint16_t, count[kMaxBlockSize * kMaxBlockSize]);
+  uint8_t *src1 = frame1_8;
+  uint8_t *src2 = frame2_8;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (bit_depth_ > 8) {
+    src1 = CONVERT_TO_BYTEPTR(frame1);
+    src2 = CONVERT_TO_BYTEPTR(frame2);
+  }
+#endif
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    const unsigned int width = 8 * (1 + rnd(kMaxBlockSize / 8));
+    const unsigned int height = 1 + rnd(kMaxBlockSize);
+    const int strength = rnd(7 + 2 * (bit_depth_ - 8));
+    const int filter_weight = rnd(3);
+
+    FillBlocks(&rnd, bit_depth_, i, frame1, frame2);
+    for (int k = 0; k < kMaxBlockSize * kStride; ++k) {
+      frame1_8[k] = static_cast<uint8_t>(frame1[k]);
+      frame2_8[k] = static_cast<uint8_t>(frame2[k]);
+    }
+    for (int k = 0; k < kMaxBlockSize * kMaxBlockSize; ++k) {
+      ref_accumulator[k] = accumulator[k] = rnd.Rand16();
+      ref_count[k] = count[k] = rnd.Rand8();
+    }
+
+    ref_filter_op_(src1, kStride, src2, width, height, strength,
+                   filter_weight, ref_accumulator, ref_count);
+    ASM_REGISTER_STATE_CHECK(filter_op_(src1, kStride, src2, width, height,
+                                        strength, filter_weight, accumulator,
+                                        count));
+    ASSERT_EQ(0, memcmp(ref_accumulator, accumulator, sizeof(accumulator)))
+        << width << "x" << height << " strength: " << strength
+        << " weight: " << filter_weight;
+    ASSERT_EQ(0, memcmp(ref_count, count, sizeof(count)))
+        << width << "x" << height << " strength: " << strength
+        << " weight: " << filter_weight;
+  }
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_AVX2
+#if CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Vp9TemporalFilterTest,
+    ::testing::Values(
+        make_tuple(&vp9_temporal_filter_apply_avx2,
+                   &vp9_temporal_filter_apply_c, 8),
+        make_tuple(&vp9_highbd_temporal_filter_apply_avx2,
+                   &vp9_highbd_temporal_filter_apply_c, 10),
+        make_tuple(&vp9_highbd_temporal_filter_apply_avx2,
+                   &vp9_highbd_temporal_filter_apply_c, 12)));
+#else
+INSTANTIATE_TEST_CASE_P(
+    AVX2, Vp9TemporalFilterTest,
+    ::testing::Values(make_tuple(&vp9_temporal_filter_apply_avx2,
+                                 &vp9_temporal_filter_apply_c, 8)));
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+#endif  // HAVE_AVX2
+#endif  // CONFIG_VP9_ENCODER
+
+#if CONFIG_VP8_ENCODER && !CONFIG_REALTIME_ONLY
+typedef void (*Vp8TemporalFilterFunc)(unsigned char *frame1,
+                                      unsigned int stride,
+                                      unsigned char *frame2,
+                                      unsigned int block_size, int strength,
+                                      int filter_weight,
+                                      unsigned int *accumulator,
+                                      unsigned short *count);
+
+class Vp8TemporalFilterTest
+    : public ::testing::TestWithParam<Vp8TemporalFilterFunc> {
+ public:
+  virtual ~Vp8TemporalFilterTest() {}
+  virtual void SetUp() { filter_op_ = GetParam(); }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  Vp8TemporalFilterFunc filter_op_;
+};
+
+TEST_P(Vp8TemporalFilterTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint8_t, frame1[kMaxBlockSize * kStride]);
+  DECLARE_ALIGNED(16, uint8_t, frame2[kMaxBlockSize * kStride]);
+  DECLARE_ALIGNED(16, unsigned int, ref_accumulator[16 * 16]);
+  DECLARE_ALIGNED(16, unsigned int, accumulator[16 * 16]);
+  DECLARE_ALIGNED(16, uint16_t, ref_count[16 * 16]);
+  DECLARE_ALIGNED(16, uint16_t, count[16 * 16]);
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    // The luma and chroma block sizes.
+    const unsigned int block_size = (i & 2) ? 16 : 8;
+    const int strength = rnd(7);
+    const int filter_weight = rnd(3);
+
+    FillBlocks(&rnd, 8, i, frame1, frame2);
+    for (int k = 0; k < 16 * 16; ++k) {
+      ref_accumulator[k] = accumulator[k] = rnd.Rand16();
+      ref_count[k] = count[k] = rnd.Rand8();
+    }
+
+    vp8_temporal_filter_apply_c(frame1, kStride, frame2, block_size, strength,
+                                filter_weight, ref_accumulator, ref_count);
+    ASM_REGISTER_STATE_CHECK(filter_op_(frame1, kStride, frame2, block_size,
+                                        strength, filter_weight, accumulator,
+                                        count));
+    ASSERT_EQ(0, memcmp(ref_accumulator, accumulator, sizeof(accumulator)))
+        << block_size << "x" << block_size << " strength: " << strength
+        << " weight: " << filter_weight;
+    ASSERT_EQ(0, memcmp(ref_count, count, sizeof(count)))
+        << block_size << "x" << block_size << " strength: " << strength
+        << " weight: " << filter_weight;
+  }
+}
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, Vp8TemporalFilterTest,
+                        ::testing::Values(&vp8_temporal_filter_apply_avx2));
+#endif  // HAVE_AVX2
+#endif  // CONFIG_VP8_ENCODER && !CONFIG_REALTIME_ONLY
+}  // namespace
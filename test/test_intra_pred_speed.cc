@@ -100,6 +100,22 @@ void TestIntraPred4(VpxPredFunc const *pred_funcs) {
                 kSignatures, 4, 4 * 4 * kNumVp9IntraFuncs);
 }
 
+const int kNumVp9IntraPredExtFuncs = 2;
+const char *kVp9IntraPredExtNames[kNumVp9IntraPredExtFuncs] = {
+  "D45E_PRED", "D63E_PRED"
+};
+
+// The 4x4 variants of d45 and d63 that also use above[7].
+void TestIntraPred4Ext(VpxPredFunc const *pred_funcs) {
+  static const char *const kSignatures[kNumVp9IntraPredExtFuncs] = {
+    "eb54839b2bad6699d8946f01ec041cd0",
+    "c0889e2039bcf7bcb5d2f33cdca69adc",
+  };
+  TestIntraPred("Intra4", pred_funcs, kVp9IntraPredExtNames,
+                kNumVp9IntraPredExtFuncs, kSignatures, 4,
+                4 * 4 * kNumVp9IntraPredExtFuncs);
+}
+
 void TestIntraPred8(VpxPredFunc const *pred_funcs) {
   static const int kNumVp9IntraFuncs = 13;
   static const char *const kSignatures[kNumVp9IntraFuncs] = {
@@ -176,6 +192,13 @@ void TestIntraPred32(VpxPredFunc const *pred_funcs) {
     test_func(vpx_intra_pred);                                              \
   }
 
+// Defines a test case for the 4x4 d45e and d63e predictors of |arch|.
+#define INTRA_PRED_EXT_TEST(arch, d45e, d63e)                    \
+  TEST(arch, TestIntraPred4Ext) {                                \
+    static const VpxPredFunc vpx_intra_pred[] = { d45e, d63e }; \
+    TestIntraPred4Ext(vpx_intra_pred);                           \
+  }
+
 // -----------------------------------------------------------------------------
 // 4x4
 
@@ -187,6 +210,8 @@ INTRA_PRED_TEST(C, TestIntraPred4, vpx_dc_predictor_4x4_c,
                 vpx_d153_predictor_4x4_c, vpx_d207_predictor_4x4_c,
                 vpx_d63_predictor_4x4_c, vpx_tm_predictor_4x4_c)
 
+INTRA_PRED_EXT_TEST(C, vpx_d45e_predictor_4x4_c, vpx_d63e_predictor_4x4_c)
+
 #if HAVE_SSE && CONFIG_USE_X86INC
 INTRA_PRED_TEST(SSE, TestIntraPred4, vpx_dc_predictor_4x4_sse,
                 vpx_dc_left_predictor_4x4_sse, vpx_dc_top_predictor_4x4_sse,
@@ -194,12 +219,21 @@ INTRA_PRED_TEST(SSE, TestIntraPred4, vpx_dc_predictor_4x4_sse,
                 NULL, NULL, NULL, NULL, NULL, NULL, vpx_tm_predictor_4x4_sse)
 #endif  // HAVE_SSE && CONFIG_USE_X86INC
 
-#if HAVE_SSSE3 && CONFIG_USE_X86INC
+#if HAVE_SSSE3
+#if CONFIG_USE_X86INC
 INTRA_PRED_TEST(SSSE3, TestIntraPred4, NULL, NULL, NULL, NULL, NULL,
-                vpx_h_predictor_4x4_ssse3, vpx_d45_predictor_4x4_ssse3, NULL,
-                NULL, vpx_d153_predictor_4x4_ssse3,
-                vpx_d207_predictor_4x4_ssse3, vpx_d63_predictor_4x4_ssse3, NULL)
-#endif  // HAVE_SSSE3 && CONFIG_USE_X86INC
+                vpx_h_predictor_4x4_ssse3, vpx_d45_predictor_4x4_ssse3,
+                vpx_d135_predictor_4x4_ssse3, vpx_d117_predictor_4x4_ssse3,
+                vpx_d153_predictor_4x4_ssse3, vpx_d207_predictor_4x4_ssse3,
+                vpx_d63_predictor_4x4_ssse3, NULL)
+#else
+INTRA_PRED_TEST(SSSE3, TestIntraPred4, NULL, NULL, NULL, NULL, NULL, NULL,
+                NULL, vpx_d135_predictor_4x4_ssse3,
+                vpx_d117_predictor_4x4_ssse3, NULL, NULL, NULL, NULL)
+#endif  // CONFIG_USE_X86INC
+INTRA_PRED_EXT_TEST(SSSE3, vpx_d45e_predictor_4x4_ssse3,
+                    vpx_d63e_predictor_4x4_ssse3)
+#endif  // HAVE_SSSE3
 
 #if HAVE_DSPR2
 INTRA_PRED_TEST(DSPR2, TestIntraPred4, vpx_dc_predictor_4x4_dspr2, NULL, NULL,
@@ -247,12 +281,19 @@ INTRA_PRED_TEST(SSE2, TestIntraPred8, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
                 NULL, NULL, NULL, NULL, NULL, vpx_tm_predictor_8x8_sse2)
 #endif  // HAVE_SSE2 && CONFIG_USE_X86INC
 
-#if HAVE_SSSE3 && CONFIG_USE_X86INC
+#if HAVE_SSSE3
+#if CONFIG_USE_X86INC
 INTRA_PRED_TEST(SSSE3, TestIntraPred8, NULL, NULL, NULL, NULL, NULL,
-                vpx_h_predictor_8x8_ssse3, vpx_d45_predictor_8x8_ssse3, NULL,
-                NULL, vpx_d153_predictor_8x8_ssse3,
-                vpx_d207_predictor_8x8_ssse3, vpx_d63_predictor_8x8_ssse3, NULL)
-#endif  // HAVE_SSSE3 && CONFIG_USE_X86INC
+                vpx_h_predictor_8x8_ssse3, vpx_d45_predictor_8x8_ssse3,
+                vpx_d135_predictor_8x8_ssse3, vpx_d117_predictor_8x8_ssse3,
+                vpx_d153_predictor_8x8_ssse3, vpx_d207_predictor_8x8_ssse3,
+                vpx_d63_predictor_8x8_ssse3, NULL)
+#else
+INTRA_PRED_TEST(SSSE3, TestIntraPred8, NULL, NULL, NULL, NULL, NULL, NULL,
+                NULL, vpx_d135_predictor_8x8_ssse3,
+                vpx_d117_predictor_8x8_ssse3, NULL, NULL, NULL, NULL)
+#endif  // CONFIG_USE_X86INC
+#endif  // HAVE_SSSE3
 
 #if HAVE_DSPR2
 INTRA_PRED_TEST(DSPR2, TestIntraPred8, vpx_dc_predictor_8x8_dspr2, NULL, NULL,
@@ -297,13 +338,19 @@ INTRA_PRED_TEST(SSE2, TestIntraPred16, vpx_dc_predictor_16x16_sse2,
                 vpx_tm_predictor_16x16_sse2)
 #endif  // HAVE_SSE2 && CONFIG_USE_X86INC
 
-#if HAVE_SSSE3 && CONFIG_USE_X86INC
+#if HAVE_SSSE3
+#if CONFIG_USE_X86INC
 INTRA_PRED_TEST(SSSE3, TestIntraPred16, NULL, NULL, NULL, NULL, NULL,
                 vpx_h_predictor_16x16_ssse3, vpx_d45_predictor_16x16_ssse3,
-                NULL, NULL, vpx_d153_predictor_16x16_ssse3,
-                vpx_d207_predictor_16x16_ssse3, vpx_d63_predictor_16x16_ssse3,
-                NULL)
-#endif  // HAVE_SSSE3 && CONFIG_USE_X86INC
+                vpx_d135_predictor_16x16_ssse3, vpx_d117_predictor_16x16_ssse3,
+                vpx_d153_predictor_16x16_ssse3, vpx_d207_predictor_16x16_ssse3,
+                vpx_d63_predictor_16x16_ssse3, NULL)
+#else
+INTRA_PRED_TEST(SSSE3, TestIntraPred16, NULL, NULL, NULL, NULL, NULL, NULL,
+                NULL, vpx_d135_predictor_16x16_ssse3,
+                vpx_d117_predictor_16x16_ssse3, NULL, NULL, NULL, NULL)
+#endif  // CONFIG_USE_X86INC
+#endif  // HAVE_SSSE3
 
 #if HAVE_DSPR2
 INTRA_PRED_TEST(DSPR2, TestIntraPred16, vpx_dc_predictor_16x16_dspr2, NULL,
@@ -356,13 +403,19 @@ INTRA_PRED_TEST(SSE2, TestIntraPred32, vpx_dc_predictor_32x32_sse2,
 #endif  // ARCH_X86_64
 #endif  // HAVE_SSE2 && CONFIG_USE_X86INC
 
-#if HAVE_SSSE3 && CONFIG_USE_X86INC
+#if HAVE_SSSE3
+#if CONFIG_USE_X86INC
 INTRA_PRED_TEST(SSSE3, TestIntraPred32, NULL, NULL, NULL, NULL, NULL,
                 vpx_h_predictor_32x32_ssse3, vpx_d45_predictor_32x32_ssse3,
-                NULL, NULL, vpx_d153_predictor_32x32_ssse3,
-                vpx_d207_predictor_32x32_ssse3, vpx_d63_predictor_32x32_ssse3,
-                NULL)
-#endif  // HAVE_SSSE3 && CONFIG_USE_X86INC
+                vpx_d135_predictor_32x32_ssse3, vpx_d117_predictor_32x32_ssse3,
+                vpx_d153_predictor_32x32_ssse3, vpx_d207_predictor_32x32_ssse3,
+                vpx_d63_predictor_32x32_ssse3, NULL)
+#else
+INTRA_PRED_TEST(SSSE3, TestIntraPred32, NULL, NULL, NULL, NULL, NULL, NULL,
+                NULL, vpx_d135_predictor_32x32_ssse3,
+                vpx_d117_predictor_32x32_ssse3, NULL, NULL, NULL, NULL)
+#endif  // CONFIG_USE_X86INC
+#endif  // HAVE_SSSE3
 
 #if HAVE_NEON
 INTRA_PRED_TEST(NEON, TestIntraPred32, vpx_dc_predictor_32x32_neon,
@@ -1847,6 +1847,37 @@ INSTANTIATE_TEST_CASE_P(
                       make_tuple(5, 5, subpel_avg_variance32x32_avx2, 0)));
 #endif  // HAVE_AVX2
 
+#if HAVE_AVX512
+const VarianceMxNFunc variance64x64_avx512 = vpx_variance64x64_avx512;
+const VarianceMxNFunc variance64x32_avx512 = vpx_variance64x32_avx512;
+const VarianceMxNFunc variance32x64_avx512 = vpx_variance32x64_avx512;
+const VarianceMxNFunc variance32x32_avx512 = vpx_variance32x32_avx512;
+INSTANTIATE_TEST_CASE_P(
+    AVX512, VpxVarianceTest,
+    ::testing::Values(make_tuple(6, 6, variance64x64_avx512, 0),
+                      make_tuple(6, 5, variance64x32_avx512, 0),
+                      make_tuple(5, 6, variance32x64_avx512, 0),
+                      make_tuple(5, 5, variance32x32_avx512, 0)));
+
+const SubpixVarMxNFunc subpel_variance64x64_avx512 =
+    vpx_sub_pixel_variance64x64_avx512;
+const SubpixVarMxNFunc subpel_variance64x32_avx512 =
+    vpx_sub_pixel_variance64x32_avx512;
+INSTANTIATE_TEST_CASE_P(
+    AVX512, VpxSubpelVarianceTest,
+    ::testing::Values(make_tuple(6, 6, subpel_variance64x64_avx512, 0),
+                      make_tuple(6, 5, subpel_variance64x32_avx512, 0)));
+
+const SubpixAvgVarMxNFunc subpel_avg_variance64x64_avx512 =
+    vpx_sub_pixel_avg_variance64x64_avx512;
+const SubpixAvgVarMxNFunc subpel_avg_variance64x32_avx512 =
+    vpx_sub_pixel_avg_variance64x32_avx512;
+INSTANTIATE_TEST_CASE_P(
+    AVX512, VpxSubpelAvgVarianceTest,
+    ::testing::Values(make_tuple(6, 6, subpel_avg_variance64x64_avx512, 0),
+                      make_tuple(6, 5, subpel_avg_variance64x32_avx512, 0)));
+#endif  // HAVE_AVX512
+
 #if HAVE_MEDIA
 const VarianceMxNFunc mse16x16_media = vpx_mse16x16_media;
 INSTANTIATE_TEST_CASE_P(MEDIA, VpxMseTest,
@@ -28,17 +28,30 @@ using libvpx_test::ACMRandom;
 namespace {
 
 const int kNumPixels = 16 * 16;
-class VP8DenoiserTest : public ::testing::TestWithParam<int> {
+
+typedef int (*Vp8DenoiserFilterFunc)(unsigned char *mc_running_avg_y,
+                                     int mc_avg_y_stride,
+                                     unsigned char *running_avg_y,
+                                     int avg_y_stride, unsigned char *sig,
+                                     int sig_stride,
+                                     unsigned int motion_magnitude,
+                                     int increase_denoising);
+typedef std::tr1::tuple<Vp8DenoiserFilterFunc, int> VP8DenoiserTestParam;
+
+class VP8DenoiserTest
+    : public ::testing::TestWithParam<VP8DenoiserTestParam> {
  public:
   virtual ~VP8DenoiserTest() {}
 
   virtual void SetUp() {
-    increase_denoising_ = GetParam();
+    filter_op_ = GET_PARAM(0);
+    increase_denoising_ = GET_PARAM(1);
   }
 
   virtual void TearDown() { libvpx_test::ClearSystemState(); }
 
  protected:
+  Vp8DenoiserFilterFunc filter_op_;
   int increase_denoising_;
 };
 
@@ -82,7 +95,7 @@ TEST_P(VP8DenoiserTest, BitexactCheck) {
         mc_avg_block, stride, avg_block_c, stride, sig_block_c, stride,
         motion_magnitude_ran, increase_denoising_));
 
-    ASM_REGISTER_STATE_CHECK(vp8_denoiser_filter_sse2(
+    ASM_REGISTER_STATE_CHECK(filter_op_(
         mc_avg_block, stride, avg_block_sse2, stride, sig_block_sse2, stride,
         motion_magnitude_ran, increase_denoising_));
 
@@ -112,5 +125,15 @@ TEST_P(VP8DenoiserTest, BitexactCheck) {
 }
 
 // Test for all block size.
-INSTANTIATE_TEST_CASE_P(SSE2, VP8DenoiserTest, ::testing::Values(0, 1));
+INSTANTIATE_TEST_CASE_P(
+    SSE2, VP8DenoiserTest,
+    ::testing::Combine(::testing::Values(&vp8_denoiser_filter_sse2),
+                       ::testing::Values(0, 1)));
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP8DenoiserTest,
+    ::testing::Combine(::testing::Values(&vp8_denoiser_filter_avx2),
+                       ::testing::Values(0, 1)));
+#endif  // HAVE_AVX2
 }  // namespace
@@ -0,0 +1,202 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+#include "test/video_source.h"
+#include "vpx/vp8cx.h"
+
+namespace {
+
+const unsigned int kFrames = 40;
+
+class AsyncEncodeTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWith2Params<libvpx_test::TestMode, int> {
+ protected:
+  AsyncEncodeTest()
+      : EncoderTest(GET_PARAM(0)),
+        encoding_mode_(GET_PARAM(1)),
+        threads_(GET_PARAM(2)),
+        async_(false) {}
+
+  virtual ~AsyncEncodeTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(encoding_mode_);
+    cfg_.g_lag_in_frames = encoding_mode_ == ::libvpx_test::kRealTime ? 0 : 10;
+    cfg_.g_threads = threads_;
+    cfg_.rc_target_bitrate = 300;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, 4);
+      encoder->Control(VP9E_SET_TILE_COLUMNS, threads_ > 1);
+      if (encoding_mode_ != ::libvpx_test::kRealTime)
+        encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
+      if (async_) {
+        vpx_codec_priv_output_cx_pkt_cb_pair_t cb;
+        cb.output_cx_pkt = OutputPacket;
+        cb.user_priv = this;
+        encoder->Control(VP9E_SET_ASYNC_ENCODE, &cb);
+      }
+    }
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    EXPECT_FALSE(async_) << "packet returned by vpx_codec_get_cx_data()";
+    AddPacket(pkt);
+  }
+
+  static void OutputPacket(vpx_codec_cx_pkt_t *pkt, void *user_priv) {
+    AsyncEncodeTest *const test = reinterpret_cast<AsyncEncodeTest *>(user_priv);
+    if (pkt->kind == VPX_CODEC_CX_FRAME_PKT)
+      test->AddPacket(pkt);
+  }
+
+  void AddPacket(const vpx_codec_cx_pkt_t *pkt) {
+    ::libvpx_test::MD5 md5;
+    md5.Add(reinterpret_cast<const uint8_t *>(pkt->data.frame.buf),
+            pkt->data.frame.sz);
+    frame_md5_.push_back(md5.Get());
+  }
+
+  std::vector<std::string> Encode(bool async) {
+    // The source overwrites its image for every frame, so queued frames
+    // have to be copied.
+    ::libvpx_test::RandomVideoSource video;
+    video.SetSize(176, 144);
+    video.set_limit(kFrames);
+    async_ = async;
+    frame_md5_.clear();
+    EXPECT_NO_FATAL_FAILURE(RunLoop(&video));
+    return frame_md5_;
+  }
+
+  ::libvpx_test::TestMode encoding_mode_;
+  int threads_;
+  bool async_;
+  std::vector<std::string> frame_md5_;
+};
+
+TEST_P(AsyncEncodeTest, MatchesSyncEncode) {
+  const std::vector<std::string> sync = Encode(false);
+  const std::vector<std::string> async = Encode(true);
+  ASSERT_EQ(kFrames, sync.size());
+  ASSERT_EQ(sync.size(), async.size());
+  for (size_t i = 0; i < sync.size(); ++i)
+    EXPECT_EQ(sync[i], async[i]) << "frame " << i;
+}
+
+VP9_INSTANTIATE_TEST_CASE(AsyncEncodeTest,
+                          ::testing::Values(::libvpx_test::kOnePassGood,
+                                            ::libvpx_test::kRealTime),
+                          ::testing::Values(1, 2));
+
+const unsigned int kBadFrame = 3;
+
+void AddFramePacket(vpx_codec_cx_pkt_t *pkt, void *user_priv) {
+  std::vector<std::string> *const frame_md5 =
+      reinterpret_cast<std::vector<std::string> *>(user_priv);
+  if (pkt->kind != VPX_CODEC_CX_FRAME_PKT)
+    return;
+  ::libvpx_test::MD5 md5;
+  md5.Add(reinterpret_cast<const uint8_t *>(pkt->data.frame.buf),
+          pkt->data.frame.sz);
+  frame_md5->push_back(md5.Get());
+}
+
+// Encodes kFrames frames, of which kBadFrame has conflicting flags, and
+// returns the result of every vpx_codec_encode() call, the flush included.
+std::vector<vpx_codec_err_t> EncodeWithBadFrame(
+    bool async, std::vector<std::string> *frame_md5) {
+  std::vector<vpx_codec_err_t> results;
+  vpx_codec_enc_cfg_t cfg;
+  vpx_codec_ctx_t enc;
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_config_default(vpx_codec_vp9_cx(), &cfg, 0));
+  cfg.g_w = 176;
+  cfg.g_h = 144;
+  cfg.g_lag_in_frames = 0;
+  cfg.rc_target_bitrate = 300;
+  EXPECT_EQ(VPX_CODEC_OK,
+            vpx_codec_enc_init(&enc, vpx_codec_vp9_cx(), &cfg, 0));
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_control(&enc, VP8E_SET_CPUUSED, 8));
+  if (async) {
+    vpx_codec_priv_output_cx_pkt_cb_pair_t cb;
+    cb.output_cx_pkt = AddFramePacket;
+    cb.user_priv = frame_md5;
+    EXPECT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&enc, VP9E_SET_ASYNC_ENCODE, &cb));
+  }
+
+  vpx_image_t *const img =
+      vpx_img_alloc(NULL, VPX_IMG_FMT_I420, cfg.g_w, cfg.g_h, 16);
+  for (unsigned int frame = 0; frame <= kFrames; ++frame) {
+    const vpx_enc_frame_flags_t flags =
+        frame == kBadFrame ? VP8_EFLAG_NO_UPD_GF | VP8_EFLAG_FORCE_GF : 0;
+    for (int plane = 0; plane < 3; ++plane) {
+      const int w = plane ? cfg.g_w / 2 : cfg.g_w;
+      const int h = plane ? cfg.g_h / 2 : cfg.g_h;
+      for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+          img->planes[plane][y * img->stride[plane] + x] =
+              static_cast<uint8_t>((x + 2 * frame) ^ y);
+        }
+      }
+    }
+    results.push_back(vpx_codec_encode(&enc, frame < kFrames ? img : NULL,
+                                       frame, 1, flags, VPX_DL_REALTIME));
+    if (!async) {
+      vpx_codec_iter_t iter = NULL;
+      const vpx_codec_cx_pkt_t *pkt;
+      while ((pkt = vpx_codec_get_cx_data(&enc, &iter)) != NULL) {
+        vpx_codec_cx_pkt_t copy = *pkt;
+        AddFramePacket(&copy, frame_md5);
+      }
+    }
+  }
+  vpx_img_free(img);
+  EXPECT_EQ(VPX_CODEC_OK, vpx_codec_destroy(&enc));
+  return results;
+}
+
+// A queued frame that fails is reported by the next call, which still
+// queues its own frame.
+TEST(AsyncEncodeErrorTest, KeepsFrameAfterFailure) {
+  std::vector<std::string> sync_md5, async_md5;
+  const std::vector<vpx_codec_err_t> sync =
+      EncodeWithBadFrame(false, &sync_md5);
+  const std::vector<vpx_codec_err_t> async =
+      EncodeWithBadFrame(true, &async_md5);
+  ASSERT_EQ(kFrames + 1, sync.size());
+  ASSERT_EQ(kFrames + 1, async.size());
+  for (unsigned int i = 0; i <= kFrames; ++i) {
+    EXPECT_EQ(i == kBadFrame ? VPX_CODEC_INVALID_PARAM : VPX_CODEC_OK,
+              sync[i]) << "call " << i;
+    EXPECT_EQ(i == kBadFrame + 1 ? VPX_CODEC_INVALID_PARAM : VPX_CODEC_OK,
+              async[i]) << "call " << i;
+  }
+  ASSERT_EQ(kFrames - 1, sync_md5.size());
+  ASSERT_EQ(sync_md5.size(), async_md5.size());
+  for (size_t i = 0; i < sync_md5.size(); ++i)
+    EXPECT_EQ(sync_md5[i], async_md5[i]) << "frame " << i;
+}
+}  // namespace
@@ -24,6 +24,7 @@
 #include "test/register_state_check.h"
 #include "test/util.h"
 #include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/mem.h"
 
 using libvpx_test::ACMRandom;
 
@@ -121,6 +122,41 @@ class AverageTest
   }
 };
 
+typedef void (*AverageBlockFunction)(const uint8_t* s, int pitch, int *avg);
+
+// Block size, source offset, function.
+typedef std::tr1::tuple<int, int, AverageBlockFunction> AvgBlockFunc;
+
+class AverageBlockTest
+    : public AverageTestBase,
+      public ::testing::WithParamInterface<AvgBlockFunc> {
+ public:
+  AverageBlockTest()
+      : AverageTestBase(GET_PARAM(0) + GET_PARAM(1), GET_PARAM(0)) {}
+
+ protected:
+  void CheckAverages() {
+    const int block_size = GET_PARAM(0);
+    const int sub_size = block_size == 64 ? 8 : 4;
+    const int blocks = block_size / sub_size;
+    const uint8_t *const source = source_data_ + GET_PARAM(1);
+    int actual[64];
+
+    ASM_REGISTER_STATE_CHECK(GET_PARAM(2)(source, source_stride_, actual));
+    for (int r = 0; r < blocks; ++r) {
+      for (int c = 0; c < blocks; ++c) {
+        const uint8_t *const block =
+            source + sub_size * (r * source_stride_ + c);
+        const int expected = sub_size == 8 ?
+            ReferenceAverage8x8(block, source_stride_) :
+            ReferenceAverage4x4(block, source_stride_);
+        EXPECT_EQ(expected, actual[r * blocks + c])
+            << "block " << r << "," << c;
+      }
+    }
+  }
+};
+
 typedef void (*IntProRowFunc)(int16_t hbuf[16], uint8_t const *ref,
                               const int ref_stride, const int height);
 
@@ -195,6 +231,278 @@ class IntProColTest
 };
 
 
+typedef void (*HadamardFunc)(int16_t const *src_diff, int src_stride,
+                             int16_t *coeff);
+
+// Block size, function, whether each 8x8 sub-block of the output is
+// transposed relative to the C code.
+typedef std::tr1::tuple<int, HadamardFunc, bool> HadamardParam;
+
+class HadamardTest : public ::testing::TestWithParam<HadamardParam> {
+ public:
+  virtual void SetUp() {
+    size_ = GET_PARAM(0);
+    func_ = GET_PARAM(1);
+    transposed_ = GET_PARAM(2);
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+  }
+
+  virtual void TearDown() {
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  static const int kStride = 40;
+
+  // Residuals in [-255, 255], or only the extremes of that range.
+  void RunComparison(bool extremes) {
+    DECLARE_ALIGNED(16, int16_t, src_diff[32 * kStride]);
+    DECLARE_ALIGNED(16, int16_t, coeff_c[32 * 32]);
+    DECLARE_ALIGNED(16, int16_t, coeff[32 * 32]);
+    HadamardFunc c_func = vp9_hadamard_8x8_c;
+    if (size_ == 16)
+      c_func = vp9_hadamard_16x16_c;
+    else if (size_ == 32)
+      c_func = vp9_hadamard_32x32_c;
+
+    for (int i = 0; i < 32 * kStride; ++i) {
+      src_diff[i] = extremes ? (rnd_.Rand8() & 1 ? 255 : -255)
+                             : rnd_.Rand8() - rnd_.Rand8();
+    }
+    c_func(src_diff, kStride, coeff_c);
+    ASM_REGISTER_STATE_CHECK(func_(src_diff, kStride, coeff));
+
+    // The quantizer in block_yrd() treats coeff[0] as the DC. It and the DC
+    // terms of the other 8x8 sub-blocks are at the same place in every
+    // version.
+    for (int i = 0; i < size_ * size_; i += 64)
+      EXPECT_EQ(coeff_c[i], coeff[i]) << "DC mismatch at " << i;
+
+    // The SIMD versions don't transpose the 8x8 sub-blocks back to the order
+    // of the C code. Otherwise the layouts match.
+    int mismatches = 0;
+    for (int b = 0; b < size_ * size_; b += 64) {
+      for (int r = 0; r < 8; ++r) {
+        for (int c = 0; c < 8; ++c) {
+          const int ref = transposed_ ? b + c * 8 + r : b + r * 8 + c;
+          mismatches += coeff_c[ref] != coeff[b + r * 8 + c];
+        }
+      }
+    }
+    EXPECT_EQ(0, mismatches) << "Output mismatch";
+  }
+
+  int size_;
+  HadamardFunc func_;
+  bool transposed_;
+  ACMRandom rnd_;
+};
+
+typedef int (*SatdFunc)(const int16_t *coeff, int length);
+
+class SatdTest : public ::testing::TestWithParam<SatdFunc> {
+ public:
+  virtual void SetUp() {
+    func_ = GetParam();
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+  }
+
+  virtual void TearDown() {
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  // Coefficients in the [-32640, 32640] range of the Hadamard transforms.
+  void RunComparison(int length, bool extremes) {
+    DECLARE_ALIGNED(16, int16_t, coeff[32 * 32]);
+    int satd_c, satd;
+
+    for (int i = 0; i < length; ++i) {
+      coeff[i] = extremes ? (rnd_.Rand8() & 1 ? 32640 : -32640)
+                          : rnd_(2 * 32640 + 1) - 32640;
+    }
+    satd_c = vp9_satd_c(coeff, length);
+    ASM_REGISTER_STATE_CHECK(satd = func_(coeff, length));
+    EXPECT_EQ(satd_c, satd) << "length: " << length;
+  }
+
+  SatdFunc func_;
+  ACMRandom rnd_;
+};
+
+typedef int (*VectorVarFunc)(int16_t const *ref, int16_t const *src,
+                             const int bwl);
+
+// bwl, function to test, reference function.
+typedef std::tr1::tuple<int, VectorVarFunc, VectorVarFunc> VectorVarParam;
+
+class VectorVarTest : public ::testing::TestWithParam<VectorVarParam> {
+ public:
+  virtual void SetUp() {
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+  }
+
+  virtual void TearDown() {
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  // The projections compared by the integer motion search are in [0, 510].
+  // The reference starts at an arbitrary offset into a longer buffer.
+  void RunComparison(int offset, bool extremes) {
+    DECLARE_ALIGNED(16, int16_t, ref[64 + 16]);
+    DECLARE_ALIGNED(16, int16_t, src[64]);
+    const int bwl = GET_PARAM(0);
+    int var_c, var;
+
+    for (int i = 0; i < 64 + 16; ++i)
+      ref[i] = extremes ? 510 : rnd_(511);
+    for (int i = 0; i < 64; ++i)
+      src[i] = extremes ? 0 : rnd_(511);
+    var_c = GET_PARAM(2)(ref + offset, src, bwl);
+    ASM_REGISTER_STATE_CHECK(var = GET_PARAM(1)(ref + offset, src, bwl));
+    EXPECT_EQ(var_c, var) << "offset: " << offset;
+  }
+
+  ACMRandom rnd_;
+};
+
+
+typedef void (*MinMaxFunc)(const uint8_t *s, int p, const uint8_t *d, int dp,
+                           int *min, int *max);
+
+// Bit depth, function to test, reference function.
+typedef std::tr1::tuple<int, MinMaxFunc, MinMaxFunc> MinMaxParam;
+
+class MinMaxTest : public ::testing::TestWithParam<MinMaxParam> {
+ public:
+  virtual void SetUp() {
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+  }
+
+  virtual void TearDown() {
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  static const int kStride = 24;
+
+  // Random pixels, only the extremes of the pixel range, or the source in
+  // the bottom and the prediction in the top quarter of the range, so that
+  // the minimum is large.
+  enum FillMode { kRandom, kExtremes, kFarApart };
+
+  void RunComparison(int offset, FillMode mode) {
+    DECLARE_ALIGNED(16, uint8_t, src8[8 * kStride]);
+    DECLARE_ALIGNED(16, uint8_t, pred8[8 * kStride]);
+#if CONFIG_VP9_HIGHBITDEPTH
+    DECLARE_ALIGNED(16, uint16_t, src16[8 * kStride]);
+    DECLARE_ALIGNED(16, uint16_t, pred16[8 * kStride]);
+#endif
+    const int bd = GET_PARAM(0);
+    const int mask = (1 << bd) - 1;
+    int min_c, max_c, min, max;
+
+    for (int i = 0; i < 8 * kStride; ++i) {
+      int s = rnd_.Rand16() & mask;
+      int d = rnd_.Rand16() & mask;
+      if (mode == kExtremes) {
+        s = (s & 1) ? mask : 0;
+        d = (d & 1) ? mask : 0;
+      } else if (mode == kFarApart) {
+        s >>= 2;
+        d = mask - (d >> 2);
+      }
+      src8[i] = s;
+      pred8[i] = d;
+#if CONFIG_VP9_HIGHBITDEPTH
+      src16[i] = s;
+      pred16[i] = d;
+#endif
+    }
+
+    const uint8_t *src = src8 + offset;
+    const uint8_t *pred = pred8 + offset;
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (bd != 8) {
+      src = CONVERT_TO_BYTEPTR(src16 + offset);
+      pred = CONVERT_TO_BYTEPTR(pred16 + offset);
+    }
+#endif
+    GET_PARAM(2)(src, kStride, pred, kStride, &min_c, &max_c);
+    ASM_REGISTER_STATE_CHECK(GET_PARAM(1)(src, kStride, pred, kStride, &min,
+                                          &max));
+    EXPECT_EQ(min_c, min) << "offset: " << offset;
+    EXPECT_EQ(max_c, max) << "offset: " << offset;
+  }
+
+  ACMRandom rnd_;
+};
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// 12 bit blocks at an arbitrary offset, compared to the C version.
+class HighbdAverageTestBase : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    rnd_.Reset(ACMRandom::DeterministicSeed());
+  }
+
+  virtual void TearDown() {
+    libvpx_test::ClearSystemState();
+  }
+
+ protected:
+  static const int kStride = 64 + 16;
+
+  void Fill(bool extremes) {
+    for (int i = 0; i < 64 * kStride; ++i)
+      source_[i] = extremes ? 4095 : rnd_.Rand16() & 4095;
+  }
+
+  const uint8_t *Source(int offset) {
+    return CONVERT_TO_BYTEPTR(source_ + offset);
+  }
+
+  uint16_t source_[64 * kStride];
+  ACMRandom rnd_;
+};
+
+// Function to test, reference function.
+typedef std::tr1::tuple<AverageFunction, AverageFunction> HighbdAvgParam;
+
+class HighbdAverageTest
+    : public HighbdAverageTestBase,
+      public ::testing::WithParamInterface<HighbdAvgParam> {
+ protected:
+  void RunComparison(int offset) {
+    unsigned int expected, actual;
+    expected = GET_PARAM(1)(Source(offset), kStride);
+    ASM_REGISTER_STATE_CHECK(actual = GET_PARAM(0)(Source(offset), kStride));
+    EXPECT_EQ(expected, actual) << "offset: " << offset;
+  }
+};
+
+// Function to test, reference function.
+typedef std::tr1::tuple<AverageBlockFunction, AverageBlockFunction>
+    HighbdAvgBlockParam;
+
+class HighbdAverageBlockTest
+    : public HighbdAverageTestBase,
+      public ::testing::WithParamInterface<HighbdAvgBlockParam> {
+ protected:
+  void RunComparison(int offset) {
+    int expected[64], actual[64];
+    GET_PARAM(1)(Source(offset), kStride, expected);
+    ASM_REGISTER_STATE_CHECK(GET_PARAM(0)(Source(offset), kStride, actual));
+    // The 4x4 versions only write the first 16 entries.
+    const int count = GET_PARAM(1) == &vp9_highbd_avg_4x4_16x16_c ? 16 : 64;
+    EXPECT_EQ(0, memcmp(expected, actual, sizeof(*actual) * count))
+        << "offset: " << offset;
+  }
+};
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+
 uint8_t* AverageTestBase::source_data_ = NULL;
 
 TEST_P(AverageTest, MinValue) {
@@ -216,6 +524,23 @@ TEST_P(AverageTest, Random) {
   }
 }
 
+TEST_P(AverageBlockTest, MinValue) {
+  FillConstant(0);
+  CheckAverages();
+}
+
+TEST_P(AverageBlockTest, MaxValue) {
+  FillConstant(255);
+  CheckAverages();
+}
+
+TEST_P(AverageBlockTest, Random) {
+  for (int i = 0; i < 100; i++) {
+    FillRandom();
+    CheckAverages();
+  }
+}
+
 TEST_P(IntProRowTest, MinValue) {
   FillConstant(0);
   RunComparison();
@@ -246,6 +571,79 @@ TEST_P(IntProColTest, Random) {
   RunComparison();
 }
 
+TEST_P(HadamardTest, Random) {
+  for (int i = 0; i < 100; ++i)
+    RunComparison(false);
+}
+
+TEST_P(HadamardTest, Extremes) {
+  for (int i = 0; i < 100; ++i)
+    RunComparison(true);
+}
+
+TEST_P(SatdTest, Random) {
+  for (int length = 16; length <= 1024; length *= 4)
+    RunComparison(length, false);
+}
+
+TEST_P(SatdTest, Extremes) {
+  for (int length = 16; length <= 1024; length *= 4)
+    RunComparison(length, true);
+}
+
+TEST_P(VectorVarTest, Random) {
+  for (int i = 0; i < 100; ++i)
+    RunComparison(i % 16, false);
+}
+
+TEST_P(VectorVarTest, Extremes) {
+  RunComparison(0, true);
+  RunComparison(3, true);
+}
+
+TEST_P(MinMaxTest, Random) {
+  for (int i = 0; i < 100; ++i)
+    RunComparison(i % 16, kRandom);
+}
+
+TEST_P(MinMaxTest, Extremes) {
+  for (int i = 0; i < 100; ++i)
+    RunComparison(i % 16, kExtremes);
+}
+
+TEST_P(MinMaxTest, FarApart) {
+  for (int i = 0; i < 100; ++i)
+    RunComparison(i % 16, kFarApart);
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+TEST_P(HighbdAverageTest, Random) {
+  for (int i = 0; i < 100; ++i) {
+    Fill(false);
+    RunComparison(i % 16);
+  }
+}
+
+TEST_P(HighbdAverageTest, MaxValue) {
+  Fill(true);
+  RunComparison(0);
+  RunComparison(5);
+}
+
+TEST_P(HighbdAverageBlockTest, Random) {
+  for (int i = 0; i < 100; ++i) {
+    Fill(false);
+    RunComparison(i % 16);
+  }
+}
+
+TEST_P(HighbdAverageBlockTest, MaxValue) {
+  Fill(true);
+  RunComparison(0);
+  RunComparison(5);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
 using std::tr1::make_tuple;
 
 INSTANTIATE_TEST_CASE_P(
@@ -254,6 +652,21 @@ INSTANTIATE_TEST_CASE_P(
         make_tuple(16, 16, 1, 8, &vp9_avg_8x8_c),
         make_tuple(16, 16, 1, 4, &vp9_avg_4x4_c)));
 
+INSTANTIATE_TEST_CASE_P(
+    C, AverageBlockTest,
+    ::testing::Values(
+        make_tuple(64, 0, &vp9_avg_8x8_64x64_c),
+        make_tuple(16, 0, &vp9_avg_4x4_16x16_c)));
+
+INSTANTIATE_TEST_CASE_P(
+    C, HadamardTest,
+    ::testing::Values(
+        make_tuple(8, &vp9_hadamard_8x8_c, false),
+        make_tuple(16, &vp9_hadamard_16x16_c, false),
+        make_tuple(32, &vp9_hadamard_32x32_c, false)));
+
+INSTANTIATE_TEST_CASE_P(C, SatdTest, ::testing::Values(&vp9_satd_c));
+
 #if HAVE_SSE2
 INSTANTIATE_TEST_CASE_P(
     SSE2, AverageTest,
@@ -265,6 +678,14 @@ INSTANTIATE_TEST_CASE_P(
         make_tuple(16, 16, 5, 4, &vp9_avg_4x4_sse2),
         make_tuple(32, 32, 15, 4, &vp9_avg_4x4_sse2)));
 
+INSTANTIATE_TEST_CASE_P(
+    SSE2, AverageBlockTest,
+    ::testing::Values(
+        make_tuple(64, 0, &vp9_avg_8x8_64x64_sse2),
+        make_tuple(64, 5, &vp9_avg_8x8_64x64_sse2),
+        make_tuple(16, 0, &vp9_avg_4x4_16x16_sse2),
+        make_tuple(16, 15, &vp9_avg_4x4_16x16_sse2)));
+
 INSTANTIATE_TEST_CASE_P(
     SSE2, IntProRowTest, ::testing::Values(
         make_tuple(16, &vp9_int_pro_row_sse2, &vp9_int_pro_row_c),
@@ -276,6 +697,89 @@ INSTANTIATE_TEST_CASE_P(
         make_tuple(16, &vp9_int_pro_col_sse2, &vp9_int_pro_col_c),
         make_tuple(32, &vp9_int_pro_col_sse2, &vp9_int_pro_col_c),
         make_tuple(64, &vp9_int_pro_col_sse2, &vp9_int_pro_col_c)));
+
+INSTANTIATE_TEST_CASE_P(
+    SSE2, HadamardTest,
+    ::testing::Values(
+        make_tuple(8, &vp9_hadamard_8x8_sse2, true),
+        make_tuple(16, &vp9_hadamard_16x16_sse2, true),
+        make_tuple(32, &vp9_hadamard_32x32_sse2, true)));
+
+INSTANTIATE_TEST_CASE_P(SSE2, SatdTest, ::testing::Values(&vp9_satd_sse2));
+
+INSTANTIATE_TEST_CASE_P(
+    SSE2, VectorVarTest, ::testing::Values(
+        make_tuple(2, &vp9_vector_var_sse2, &vp9_vector_var_c),
+        make_tuple(3, &vp9_vector_var_sse2, &vp9_vector_var_c),
+        make_tuple(4, &vp9_vector_var_sse2, &vp9_vector_var_c)));
+
+INSTANTIATE_TEST_CASE_P(
+    SSE2, MinMaxTest,
+    ::testing::Values(
+        make_tuple(8, &vp9_minmax_8x8_sse2, &vp9_minmax_8x8_c)));
+#endif
+
+#if HAVE_SSE4_1 && CONFIG_VP9_HIGHBITDEPTH
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, MinMaxTest,
+    ::testing::Values(
+        make_tuple(12, &vp9_highbd_minmax_8x8_sse4_1,
+                   &vp9_highbd_minmax_8x8_c)));
+
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, HighbdAverageTest,
+    ::testing::Values(
+        make_tuple(&vp9_highbd_avg_8x8_sse4_1, &vp9_highbd_avg_8x8_c),
+        make_tuple(&vp9_highbd_avg_4x4_sse4_1, &vp9_highbd_avg_4x4_c)));
+
+INSTANTIATE_TEST_CASE_P(
+    SSE4_1, HighbdAverageBlockTest,
+    ::testing::Values(
+        make_tuple(&vp9_highbd_avg_8x8_64x64_sse4_1,
+                   &vp9_highbd_avg_8x8_64x64_c),
+        make_tuple(&vp9_highbd_avg_4x4_16x16_sse4_1,
+                   &vp9_highbd_avg_4x4_16x16_c)));
+#endif  // HAVE_SSE4_1 && CONFIG_VP9_HIGHBITDEPTH
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, AverageBlockTest,
+    ::testing::Values(
+        make_tuple(64, 0, &vp9_avg_8x8_64x64_avx2),
+        make_tuple(64, 5, &vp9_avg_8x8_64x64_avx2),
+        make_tuple(16, 0, &vp9_avg_4x4_16x16_avx2),
+        make_tuple(16, 15, &vp9_avg_4x4_16x16_avx2)));
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, MinMaxTest,
+    ::testing::Values(
+        make_tuple(8, &vp9_minmax_8x8_avx2, &vp9_minmax_8x8_c)));
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, HadamardTest,
+    ::testing::Values(
+        make_tuple(16, &vp9_hadamard_16x16_avx2, true),
+        make_tuple(32, &vp9_hadamard_32x32_avx2, true)));
+
+INSTANTIATE_TEST_CASE_P(AVX2, SatdTest, ::testing::Values(&vp9_satd_avx2));
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, IntProRowTest, ::testing::Values(
+        make_tuple(16, &vp9_int_pro_row_avx2, &vp9_int_pro_row_c),
+        make_tuple(32, &vp9_int_pro_row_avx2, &vp9_int_pro_row_c),
+        make_tuple(64, &vp9_int_pro_row_avx2, &vp9_int_pro_row_c)));
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, IntProColTest, ::testing::Values(
+        make_tuple(16, &vp9_int_pro_col_avx2, &vp9_int_pro_col_c),
+        make_tuple(32, &vp9_int_pro_col_avx2, &vp9_int_pro_col_c),
+        make_tuple(64, &vp9_int_pro_col_avx2, &vp9_int_pro_col_c)));
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VectorVarTest, ::testing::Values(
+        make_tuple(2, &vp9_vector_var_avx2, &vp9_vector_var_c),
+        make_tuple(3, &vp9_vector_var_avx2, &vp9_vector_var_c),
+        make_tuple(4, &vp9_vector_var_avx2, &vp9_vector_var_c)));
 #endif
 
 #if HAVE_NEON
@@ -297,6 +801,12 @@ INSTANTIATE_TEST_CASE_P(
         make_tuple(16, &vp9_int_pro_col_neon, &vp9_int_pro_col_c),
         make_tuple(32, &vp9_int_pro_col_neon, &vp9_int_pro_col_c),
         make_tuple(64, &vp9_int_pro_col_neon, &vp9_int_pro_col_c)));
+
+INSTANTIATE_TEST_CASE_P(
+    NEON, VectorVarTest, ::testing::Values(
+        make_tuple(2, &vp9_vector_var_neon, &vp9_vector_var_c),
+        make_tuple(3, &vp9_vector_var_neon, &vp9_vector_var_c),
+        make_tuple(4, &vp9_vector_var_neon, &vp9_vector_var_c)));
 #endif
 
 #if HAVE_MSA
@@ -29,17 +29,29 @@ using libvpx_test::ACMRandom;
 namespace {
 
 const int kNumPixels = 64 * 64;
-class VP9DenoiserTest : public ::testing::TestWithParam<BLOCK_SIZE> {
+
+typedef int (*Vp9DenoiserFilterFunc)(const uint8_t *sig, int sig_stride,
+                                     const uint8_t *mc_avg, int mc_avg_stride,
+                                     uint8_t *avg, int avg_stride,
+                                     int increase_denoising, BLOCK_SIZE bs,
+                                     int motion_magnitude);
+typedef std::tr1::tuple<Vp9DenoiserFilterFunc, BLOCK_SIZE>
+    VP9DenoiserTestParam;
+
+class VP9DenoiserTest
+    : public ::testing::TestWithParam<VP9DenoiserTestParam> {
  public:
   virtual ~VP9DenoiserTest() {}
 
   virtual void SetUp() {
-    bs_ = GetParam();
+    filter_op_ = GET_PARAM(0);
+    bs_ = GET_PARAM(1);
   }
 
   virtual void TearDown() { libvpx_test::ClearSystemState(); }
 
  protected:
+  Vp9DenoiserFilterFunc filter_op_;
   BLOCK_SIZE bs_;
 };
 
@@ -78,7 +90,7 @@ TEST_P(VP9DenoiserTest, BitexactCheck) {
         sig_block, 64, mc_avg_block, 64, avg_block_c,
         64, 0, bs_, motion_magnitude_random));
 
-    ASM_REGISTER_STATE_CHECK(vp9_denoiser_filter_sse2(
+    ASM_REGISTER_STATE_CHECK(filter_op_(
         sig_block, 64, mc_avg_block, 64, avg_block_sse2,
         64, 0, bs_, motion_magnitude_random));
 
@@ -91,11 +103,22 @@ TEST_P(VP9DenoiserTest, BitexactCheck) {
   }
 }
 
+const BLOCK_SIZE kBlockSizes[] = {
+  BLOCK_4X4, BLOCK_4X8, BLOCK_8X4, BLOCK_8X8, BLOCK_8X16, BLOCK_16X8,
+  BLOCK_16X16, BLOCK_16X32, BLOCK_32X16, BLOCK_32X32, BLOCK_32X64,
+  BLOCK_64X32, BLOCK_64X64
+};
+
 // Test for all block size.
 INSTANTIATE_TEST_CASE_P(
     SSE2, VP9DenoiserTest,
-    ::testing::Values(BLOCK_4X4, BLOCK_4X8, BLOCK_8X4, BLOCK_8X8,
-                      BLOCK_8X16, BLOCK_16X8, BLOCK_16X16, BLOCK_16X32,
-                      BLOCK_32X16, BLOCK_32X32, BLOCK_32X64, BLOCK_64X32,
-                      BLOCK_64X64));
+    ::testing::Combine(::testing::Values(&vp9_denoiser_filter_sse2),
+                       ::testing::ValuesIn(kBlockSizes)));
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP9DenoiserTest,
+    ::testing::Combine(::testing::Values(&vp9_denoiser_filter_avx2),
+                       ::testing::ValuesIn(kBlockSizes)));
+#endif  // HAVE_AVX2
 }  // namespace
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vp9_rtcd.h"
+#include "./vpx_config.h"
+#include "./vpx_dsp_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "test/util.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+
+// Checks that the optimized high bitdepth inverse transforms match the C code
+// exactly, including for coefficients large enough to take their C fallbacks.
+
+typedef void (*HighbdInvTxfmFunc)(const tran_low_t *in, uint8_t *dst,
+                                  int stride, int tx_type, int bd);
+// Reference and optimized functions, block size and number of tx_types.
+typedef std::tr1::tuple<HighbdInvTxfmFunc, HighbdInvTxfmFunc, int,
+                        int> HighbdInvTxfmFuncs;
+typedef std::tr1::tuple<HighbdInvTxfmFuncs, int> HighbdInvTxfmParam;
+
+const int kStride = 40;
+
+class HighbdInvTxfmTest
+    : public ::testing::TestWithParam<HighbdInvTxfmParam> {
+ public:
+  virtual ~HighbdInvTxfmTest() {}
+  virtual void SetUp() {
+    const HighbdInvTxfmFuncs funcs = GET_PARAM(0);
+    ref_txfm_ = std::tr1::get<0>(funcs);
+    txfm_ = std::tr1::get<1>(funcs);
+    size_ = std::tr1::get<2>(funcs);
+    num_tx_types_ = std::tr1::get<3>(funcs);
+    bit_depth_ = GET_PARAM(1);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  HighbdInvTxfmFunc ref_txfm_;
+  HighbdInvTxfmFunc txfm_;
+  int size_;
+  int num_tx_types_;
+  int bit_depth_;
+};
+
+TEST_P(HighbdInvTxfmTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, tran_low_t, coeff[32 * 32]);
+  DECLARE_ALIGNED(16, uint16_t, ref_dst[32 * kStride]);
+  DECLARE_ALIGNED(16, uint16_t, dst[32 * kStride]);
+  const int mask = (1 << bit_depth_) - 1;
+  const int kCountTestBlock = 5000;
+
+  for (int i = 0; i < kCountTestBlock; ++i) {
+    // Cycle through sparse blocks of small, medium and full range
+    // coefficients, and DC only blocks.
+    const int range = i % 4 == 0 ? 64 : i % 4 == 1 ? 2048 :
+                      i % 4 == 2 ? (1 << (bit_depth_ + 7)) : 16384;
+    const int tx_type = i % num_tx_types_;
+    memset(coeff, 0, sizeof(coeff));
+    if (i % 4 == 3) {
+      coeff[0] = rnd(2 * range + 1) - range;
+    } else {
+      for (int j = 0; j < size_ * size_; ++j) {
+        if (rnd(4) == 0)
+          coeff[j] = rnd(2 * range + 1) - range;
+      }
+    }
+    for (int j = 0; j < 32 * kStride; ++j)
+      ref_dst[j] = dst[j] = rnd.Rand16() & mask;
+
+    ref_txfm_(coeff, CONVERT_TO_BYTEPTR(ref_dst), kStride, tx_type,
+              bit_depth_);
+    ASM_REGISTER_STATE_CHECK(txfm_(coeff, CONVERT_TO_BYTEPTR(dst), kStride,
+                                   tx_type, bit_depth_));
+    for (int j = 0; j < 32 * kStride; ++j) {
+      ASSERT_EQ(ref_dst[j], dst[j])
+          << "Mismatch at " << j << " in block " << i << " tx_type "
+          << tx_type;
+    }
+  }
+}
+
+using std::tr1::make_tuple;
+
+#if HAVE_SSE2 && CONFIG_VP9_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+#define DC_ONLY_WRAPPER(name) \
+void name##_wrapper(const tran_low_t *in, uint8_t *dst, int stride, \
+                    int tx_type, int bd) { \
+  (void)tx_type; \
+  name(in, dst, stride, bd); \
+}
+
+DC_ONLY_WRAPPER(vpx_highbd_idct4x4_1_add_c)
+DC_ONLY_WRAPPER(vpx_highbd_idct4x4_1_add_sse2)
+DC_ONLY_WRAPPER(vpx_highbd_idct8x8_1_add_c)
+DC_ONLY_WRAPPER(vpx_highbd_idct8x8_1_add_sse2)
+DC_ONLY_WRAPPER(vpx_highbd_idct16x16_1_add_c)
+DC_ONLY_WRAPPER(vpx_highbd_idct16x16_1_add_sse2)
+DC_ONLY_WRAPPER(vpx_highbd_idct32x32_1_add_c)
+DC_ONLY_WRAPPER(vpx_highbd_idct32x32_1_add_sse2)
+
+INSTANTIATE_TEST_CASE_P(
+    SSE2, HighbdInvTxfmTest,
+    ::testing::Combine(
+        ::testing::Values(make_tuple(&vp9_highbd_iht4x4_16_add_c,
+                                     &vp9_highbd_iht4x4_16_add_sse2, 4, 4),
+                          make_tuple(&vp9_highbd_iht8x8_64_add_c,
+                                     &vp9_highbd_iht8x8_64_add_sse2, 8, 4),
+                          make_tuple(&vp9_highbd_iht16x16_256_add_c,
+                                     &vp9_highbd_iht16x16_256_add_sse2, 16,
+                                     4),
+                          make_tuple(&vpx_highbd_idct4x4_1_add_c_wrapper,
+                                     &vpx_highbd_idct4x4_1_add_sse2_wrapper,
+                                     4, 1),
+                          make_tuple(&vpx_highbd_idct8x8_1_add_c_wrapper,
+                                     &vpx_highbd_idct8x8_1_add_sse2_wrapper,
+                                     8, 1),
+                          make_tuple(&vpx_highbd_idct16x16_1_add_c_wrapper,
+                                     &vpx_highbd_idct16x16_1_add_sse2_wrapper,
+                                     16, 1),
+                          make_tuple(&vpx_highbd_idct32x32_1_add_c_wrapper,
+                                     &vpx_highbd_idct32x32_1_add_sse2_wrapper,
+                                     32, 1)),
+        ::testing::Values(8, 10, 12)));
+#endif  // HAVE_SSE2 && CONFIG_VP9_HIGHBITDEPTH && !CONFIG_EMULATE_HARDWARE
+}  // namespace
@@ -0,0 +1,291 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "test/acm_random.h"
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+#include "test/video_source.h"
+#include "vpx/vp8cx.h"
+
+namespace {
+
+const int kWidth = 176;
+const int kHeight = 144;
+const int kBorder = 160;
+const unsigned int kFrames = 20;
+// Never a pixel value of the test pattern.
+const uint8_t kPadding = 0xff;
+
+// Returns whether the padding left of and above the first visible luma pixel
+// still holds kPadding.
+bool PaddingUntouched(const vpx_image_t *img) {
+  const uint8_t *const y = img->planes[0];
+  return y[-1] == kPadding && y[-kBorder] == kPadding &&
+         y[-img->stride[0]] == kPadding;
+}
+
+// Returns whether the encoder has extended the borders of the frame in the
+// application's buffer, which it only does for a frame it has not copied.
+// The source frames are extended by 16 pixels.
+bool BordersExtended(const vpx_image_t *img) {
+  const uint8_t *const y = img->planes[0];
+  return y[-1] == y[0] && y[-16] == y[0] && y[-16 * img->stride[0]] == y[0];
+}
+
+// Hands out a freshly allocated image with kBorder pixels of padding for
+// every frame, so frames referenced by the encoder stay intact until they are
+// released. The md5 of each frame's visible area is kept to check that the
+// encoder does not modify it.
+class PaddedVideoSource : public ::libvpx_test::VideoSource {
+ public:
+  PaddedVideoSource() : img_(NULL), frame_(0), rnd_(0) {}
+
+  virtual ~PaddedVideoSource() {
+    for (size_t i = 0; i < buffers_.size(); ++i)
+      delete[] buffers_[i];
+    for (size_t i = 0; i < images_.size(); ++i)
+      delete images_[i];
+  }
+
+  virtual void Begin() {
+    frame_ = 0;
+    rnd_.Reset(::libvpx_test::ACMRandom::DeterministicSeed());
+    FillFrame();
+  }
+
+  virtual void Next() {
+    ++frame_;
+    FillFrame();
+  }
+
+  virtual vpx_image_t *img() const { return frame_ < kFrames ? img_ : NULL; }
+  virtual vpx_codec_pts_t pts() const { return frame_; }
+  virtual unsigned long duration() const { return 1; }
+  virtual vpx_rational_t timebase() const {
+    const vpx_rational_t t = { 1, 30 };
+    return t;
+  }
+  virtual unsigned int frame() const { return frame_; }
+  virtual unsigned int limit() const { return kFrames; }
+
+  const std::string &md5(unsigned int frame) const { return md5_[frame]; }
+
+  // Returns whether the padding of every image handed out is intact.
+  bool AllPaddingUntouched() const {
+    for (size_t i = 0; i < images_.size(); ++i) {
+      if (!PaddingUntouched(images_[i]))
+        return false;
+    }
+    return true;
+  }
+
+ private:
+  void FillFrame() {
+    if (frame_ >= kFrames)
+      return;
+    const int w = kWidth + 2 * kBorder;
+    const int h = kHeight + 2 * kBorder;
+    uint8_t *const buf = new uint8_t[w * h * 3 / 2];
+    memset(buf, kPadding, w * h * 3 / 2);
+    buffers_.push_back(buf);
+    img_ = new vpx_image_t;
+    images_.push_back(img_);
+    vpx_img_wrap(img_, VPX_IMG_FMT_I420, w, h, 1, buf);
+    vpx_img_set_rect(img_, kBorder, kBorder, kWidth, kHeight);
+    img_->user_priv = reinterpret_cast<void *>(static_cast<intptr_t>(frame_));
+
+    // A pattern moving by a few pixels per frame on top of some noise, so
+    // that motion search and the temporal filter have something to find.
+    for (int plane = 0; plane < 3; ++plane) {
+      const int pw = plane ? kWidth / 2 : kWidth;
+      const int ph = plane ? kHeight / 2 : kHeight;
+      uint8_t *row = img_->planes[plane];
+      for (int y = 0; y < ph; ++y) {
+        for (int x = 0; x < pw; ++x) {
+          const int f = static_cast<int>(frame_);
+          const int v = ((x + 3 * f) ^ (y + f)) & 0x7f;
+          row[x] = v + (rnd_.Rand8() & 0x0f);
+        }
+        row += img_->stride[plane];
+      }
+    }
+
+    ::libvpx_test::MD5 md5;
+    md5.Add(img_);
+    if (md5_.size() <= frame_)
+      md5_.resize(frame_ + 1);
+    md5_[frame_] = md5.Get();
+  }
+
+  vpx_image_t *img_;
+  unsigned int frame_;
+  ::libvpx_test::ACMRandom rnd_;
+  std::vector<uint8_t *> buffers_;
+  std::vector<vpx_image_t *> images_;
+  std::vector<std::string> md5_;
+};
+
+class InputFrameRefTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWithParam<libvpx_test::TestMode> {
+ protected:
+  InputFrameRefTest()
+      : EncoderTest(GET_PARAM(0)),
+        encoding_mode_(GET_PARAM(1)),
+        use_ref_(false),
+        async_(false),
+        released_(0),
+        submitted_(0),
+        encoding_frame_(0) {}
+
+  virtual ~InputFrameRefTest() {}
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(encoding_mode_);
+    cfg_.g_lag_in_frames = encoding_mode_ == ::libvpx_test::kRealTime ? 0 : 10;
+    cfg_.rc_target_bitrate = 300;
+  }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, 4);
+      if (encoding_mode_ != ::libvpx_test::kRealTime) {
+        encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
+        encoder->Control(VP8E_SET_ARNR_MAXFRAMES, 7);
+      }
+      if (use_ref_) {
+        vpx_input_frame_ref_t ref;
+        ref.release_cb = ReleaseFrame;
+        ref.cb_priv = this;
+        ref.border = kBorder;
+        encoder->Control(VP9E_SET_INPUT_FRAME_REF, &ref);
+      }
+      if (async_) {
+        vpx_codec_priv_output_cx_pkt_cb_pair_t cb;
+        cb.output_cx_pkt = OutputPacket;
+        cb.user_priv = this;
+        encoder->Control(VP9E_SET_ASYNC_ENCODE, &cb);
+      }
+    }
+    if (video->img() != NULL)
+      ++submitted_;
+    encoding_frame_ = video->frame();
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    if (cfg_.g_pass == VPX_RC_FIRST_PASS)
+      return;
+    AddPacket(pkt);
+  }
+
+  static void OutputPacket(vpx_codec_cx_pkt_t *pkt, void *user_priv) {
+    InputFrameRefTest *const test =
+        reinterpret_cast<InputFrameRefTest *>(user_priv);
+    if (pkt->kind == VPX_CODEC_CX_FRAME_PKT)
+      test->AddPacket(pkt);
+  }
+
+  void AddPacket(const vpx_codec_cx_pkt_t *pkt) {
+    ::libvpx_test::MD5 md5;
+    md5.Add(reinterpret_cast<const uint8_t *>(pkt->data.frame.buf),
+            pkt->data.frame.sz);
+    frame_md5_.push_back(md5.Get());
+    const unsigned int frame = static_cast<unsigned int>(pkt->data.frame.pts);
+    if (encoded_.size() <= frame)
+      encoded_.resize(frame + 1);
+    encoded_[frame] = true;
+  }
+
+  static void ReleaseFrame(void *cb_priv, const vpx_image_t *img) {
+    InputFrameRefTest *const test =
+        reinterpret_cast<InputFrameRefTest *>(cb_priv);
+    const unsigned int frame =
+        static_cast<unsigned int>(reinterpret_cast<intptr_t>(img->user_priv));
+    ::libvpx_test::MD5 md5;
+    md5.Add(img);
+    EXPECT_EQ(test->video_.md5(frame), md5.Get()) << "frame " << frame;
+    // The encoder worked on the application's buffer rather than a copy.
+    EXPECT_TRUE(BordersExtended(img)) << "frame " << frame << " was copied";
+    // With a lag the frame is held until it has been encoded, which is never
+    // during the call that submitted it.
+    if (test->cfg_.g_lag_in_frames > 0) {
+      EXPECT_GT(test->encoding_frame_, frame)
+          << "frame " << frame << " released on submission";
+    }
+    if (test->cfg_.g_pass != VPX_RC_FIRST_PASS) {
+      EXPECT_TRUE(frame < test->encoded_.size() && test->encoded_[frame])
+          << "frame " << frame << " released before it was encoded";
+    }
+    ++test->released_;
+  }
+
+  std::vector<std::string> Encode(bool use_ref, bool async) {
+    use_ref_ = use_ref;
+    async_ = async;
+    released_ = 0;
+    submitted_ = 0;
+    frame_md5_.clear();
+    encoded_.clear();
+    EXPECT_NO_FATAL_FAILURE(RunLoop(&video_));
+    return frame_md5_;
+  }
+
+  ::libvpx_test::TestMode encoding_mode_;
+  PaddedVideoSource video_;
+  bool use_ref_;
+  bool async_;
+  unsigned int released_;
+  unsigned int submitted_;
+  unsigned int encoding_frame_;
+  std::vector<std::string> frame_md5_;
+  std::vector<bool> encoded_;
+};
+
+TEST_P(InputFrameRefTest, MatchesCopiedInput) {
+  const std::vector<std::string> copied = Encode(false, false);
+  EXPECT_EQ(0u, released_);
+  EXPECT_TRUE(video_.AllPaddingUntouched());
+
+  const std::vector<std::string> referenced = Encode(true, false);
+  EXPECT_EQ(submitted_, released_);
+  ASSERT_EQ(copied.size(), referenced.size());
+  for (size_t i = 0; i < copied.size(); ++i)
+    EXPECT_EQ(copied[i], referenced[i]) << "frame " << i;
+}
+
+// The borders of referenced frames are extended ahead of time by the
+// asynchronous encoder's staging thread.
+TEST_P(InputFrameRefTest, MatchesCopiedInputAsync) {
+  // First pass statistics would only come through the callback.
+  if (encoding_mode_ == ::libvpx_test::kTwoPassGood)
+    return;
+  const std::vector<std::string> copied = Encode(false, false);
+  const std::vector<std::string> referenced = Encode(true, true);
+  EXPECT_EQ(submitted_, released_);
+  ASSERT_EQ(copied.size(), referenced.size());
+  for (size_t i = 0; i < copied.size(); ++i)
+    EXPECT_EQ(copied[i], referenced[i]) << "frame " << i;
+}
+
+VP9_INSTANTIATE_TEST_CASE(InputFrameRefTest,
+                          ::testing::Values(::libvpx_test::kOnePassGood,
+                                            ::libvpx_test::kTwoPassGood,
+                                            ::libvpx_test::kRealTime));
+}  // namespace
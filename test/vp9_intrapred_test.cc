@@ -296,6 +296,147 @@ INSTANTIATE_TEST_CASE_P(SSE2_TO_C_12, VP9IntraPredTest,
                                        &vpx_highbd_tm_predictor_8x8_c, 8, 12)));
 #endif  // !ARCH_X86_64
 #endif  // CONFIG_USE_X86INC
+
+INSTANTIATE_TEST_CASE_P(SSE2_INTRIN_TO_C_8, VP9IntraPredTest,
+                        ::testing::Values(
+                            make_tuple(&vpx_highbd_h_predictor_4x4_sse2,
+                                       &vpx_highbd_h_predictor_4x4_c, 4, 8),
+                            make_tuple(&vpx_highbd_h_predictor_8x8_sse2,
+                                       &vpx_highbd_h_predictor_8x8_c, 8, 8),
+                            make_tuple(&vpx_highbd_h_predictor_16x16_sse2,
+                                       &vpx_highbd_h_predictor_16x16_c, 16, 8),
+                            make_tuple(&vpx_highbd_h_predictor_32x32_sse2,
+                                       &vpx_highbd_h_predictor_32x32_c, 32, 8),
+                            make_tuple(&vpx_highbd_dc_top_predictor_4x4_sse2,
+                                       &vpx_highbd_dc_top_predictor_4x4_c, 4,
+                                       8),
+                            make_tuple(&vpx_highbd_dc_top_predictor_8x8_sse2,
+                                       &vpx_highbd_dc_top_predictor_8x8_c, 8,
+                                       8),
+                            make_tuple(&vpx_highbd_dc_top_predictor_16x16_sse2,
+                                       &vpx_highbd_dc_top_predictor_16x16_c, 16,
+                                       8),
+                            make_tuple(&vpx_highbd_dc_top_predictor_32x32_sse2,
+                                       &vpx_highbd_dc_top_predictor_32x32_c, 32,
+                                       8),
+                            make_tuple(&vpx_highbd_dc_left_predictor_4x4_sse2,
+                                       &vpx_highbd_dc_left_predictor_4x4_c, 4,
+                                       8),
+                            make_tuple(&vpx_highbd_dc_left_predictor_8x8_sse2,
+                                       &vpx_highbd_dc_left_predictor_8x8_c, 8,
+                                       8),
+                            make_tuple(&vpx_highbd_dc_left_predictor_16x16_sse2,
+                                       &vpx_highbd_dc_left_predictor_16x16_c,
+                                       16, 8),
+                            make_tuple(&vpx_highbd_dc_left_predictor_32x32_sse2,
+                                       &vpx_highbd_dc_left_predictor_32x32_c,
+                                       32, 8),
+                            make_tuple(&vpx_highbd_dc_128_predictor_4x4_sse2,
+                                       &vpx_highbd_dc_128_predictor_4x4_c, 4,
+                                       8),
+                            make_tuple(&vpx_highbd_dc_128_predictor_8x8_sse2,
+                                       &vpx_highbd_dc_128_predictor_8x8_c, 8,
+                                       8),
+                            make_tuple(&vpx_highbd_dc_128_predictor_16x16_sse2,
+                                       &vpx_highbd_dc_128_predictor_16x16_c, 16,
+                                       8),
+                            make_tuple(&vpx_highbd_dc_128_predictor_32x32_sse2,
+                                       &vpx_highbd_dc_128_predictor_32x32_c, 32,
+                                       8)));
+
+INSTANTIATE_TEST_CASE_P(SSE2_INTRIN_TO_C_10, VP9IntraPredTest,
+                        ::testing::Values(
+                            make_tuple(&vpx_highbd_h_predictor_4x4_sse2,
+                                       &vpx_highbd_h_predictor_4x4_c, 4, 10),
+                            make_tuple(&vpx_highbd_h_predictor_8x8_sse2,
+                                       &vpx_highbd_h_predictor_8x8_c, 8, 10),
+                            make_tuple(&vpx_highbd_h_predictor_16x16_sse2,
+                                       &vpx_highbd_h_predictor_16x16_c, 16, 10),
+                            make_tuple(&vpx_highbd_h_predictor_32x32_sse2,
+                                       &vpx_highbd_h_predictor_32x32_c, 32, 10),
+                            make_tuple(&vpx_highbd_dc_top_predictor_4x4_sse2,
+                                       &vpx_highbd_dc_top_predictor_4x4_c, 4,
+                                       10),
+                            make_tuple(&vpx_highbd_dc_top_predictor_8x8_sse2,
+                                       &vpx_highbd_dc_top_predictor_8x8_c, 8,
+                                       10),
+                            make_tuple(&vpx_highbd_dc_top_predictor_16x16_sse2,
+                                       &vpx_highbd_dc_top_predictor_16x16_c, 16,
+                                       10),
+                            make_tuple(&vpx_highbd_dc_top_predictor_32x32_sse2,
+                                       &vpx_highbd_dc_top_predictor_32x32_c, 32,
+                                       10),
+                            make_tuple(&vpx_highbd_dc_left_predictor_4x4_sse2,
+                                       &vpx_highbd_dc_left_predictor_4x4_c, 4,
+                                       10),
+                            make_tuple(&vpx_highbd_dc_left_predictor_8x8_sse2,
+                                       &vpx_highbd_dc_left_predictor_8x8_c, 8,
+                                       10),
+                            make_tuple(&vpx_highbd_dc_left_predictor_16x16_sse2,
+                                       &vpx_highbd_dc_left_predictor_16x16_c,
+                                       16, 10),
+                            make_tuple(&vpx_highbd_dc_left_predictor_32x32_sse2,
+                                       &vpx_highbd_dc_left_predictor_32x32_c,
+                                       32, 10),
+                            make_tuple(&vpx_highbd_dc_128_predictor_4x4_sse2,
+                                       &vpx_highbd_dc_128_predictor_4x4_c, 4,
+                                       10),
+                            make_tuple(&vpx_highbd_dc_128_predictor_8x8_sse2,
+                                       &vpx_highbd_dc_128_predictor_8x8_c, 8,
+                                       10),
+                            make_tuple(&vpx_highbd_dc_128_predictor_16x16_sse2,
+                                       &vpx_highbd_dc_128_predictor_16x16_c, 16,
+                                       10),
+                            make_tuple(&vpx_highbd_dc_128_predictor_32x32_sse2,
+                                       &vpx_highbd_dc_128_predictor_32x32_c, 32,
+                                       10)));
+
+INSTANTIATE_TEST_CASE_P(SSE2_INTRIN_TO_C_12, VP9IntraPredTest,
+                        ::testing::Values(
+                            make_tuple(&vpx_highbd_h_predictor_4x4_sse2,
+                                       &vpx_highbd_h_predictor_4x4_c, 4, 12),
+                            make_tuple(&vpx_highbd_h_predictor_8x8_sse2,
+                                       &vpx_highbd_h_predictor_8x8_c, 8, 12),
+                            make_tuple(&vpx_highbd_h_predictor_16x16_sse2,
+                                       &vpx_highbd_h_predictor_16x16_c, 16, 12),
+                            make_tuple(&vpx_highbd_h_predictor_32x32_sse2,
+                                       &vpx_highbd_h_predictor_32x32_c, 32, 12),
+                            make_tuple(&vpx_highbd_dc_top_predictor_4x4_sse2,
+                                       &vpx_highbd_dc_top_predictor_4x4_c, 4,
+                                       12),
+                            make_tuple(&vpx_highbd_dc_top_predictor_8x8_sse2,
+                                       &vpx_highbd_dc_top_predictor_8x8_c, 8,
+                                       12),
+                            make_tuple(&vpx_highbd_dc_top_predictor_16x16_sse2,
+                                       &vpx_highbd_dc_top_predictor_16x16_c, 16,
+                                       12),
+                            make_tuple(&vpx_highbd_dc_top_predictor_32x32_sse2,
+                                       &vpx_highbd_dc_top_predictor_32x32_c, 32,
+                                       12),
+                            make_tuple(&vpx_highbd_dc_left_predictor_4x4_sse2,
+                                       &vpx_highbd_dc_left_predictor_4x4_c, 4,
+                                       12),
+                            make_tuple(&vpx_highbd_dc_left_predictor_8x8_sse2,
+                                       &vpx_highbd_dc_left_predictor_8x8_c, 8,
+                                       12),
+                            make_tuple(&vpx_highbd_dc_left_predictor_16x16_sse2,
+                                       &vpx_highbd_dc_left_predictor_16x16_c,
+                                       16, 12),
+                            make_tuple(&vpx_highbd_dc_left_predictor_32x32_sse2,
+                                       &vpx_highbd_dc_left_predictor_32x32_c,
+                                       32, 12),
+                            make_tuple(&vpx_highbd_dc_128_predictor_4x4_sse2,
+                                       &vpx_highbd_dc_128_predictor_4x4_c, 4,
+                                       12),
+                            make_tuple(&vpx_highbd_dc_128_predictor_8x8_sse2,
+                                       &vpx_highbd_dc_128_predictor_8x8_c, 8,
+                                       12),
+                            make_tuple(&vpx_highbd_dc_128_predictor_16x16_sse2,
+                                       &vpx_highbd_dc_128_predictor_16x16_c, 16,
+                                       12),
+                            make_tuple(&vpx_highbd_dc_128_predictor_32x32_sse2,
+                                       &vpx_highbd_dc_128_predictor_32x32_c, 32,
+                                       12)));
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 #endif  // HAVE_SSE2
 }  // namespace
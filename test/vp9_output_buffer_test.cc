@@ -0,0 +1,178 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "test/codec_factory.h"
+#include "test/encode_test_driver.h"
+#include "test/md5_helper.h"
+#include "test/util.h"
+#include "test/video_source.h"
+#include "vpx/vp8cx.h"
+
+namespace {
+
+const unsigned int kFrames = 40;
+
+class OutputBufferTest
+    : public ::libvpx_test::EncoderTest,
+      public ::libvpx_test::CodecTestWithParam<libvpx_test::TestMode> {
+ protected:
+  OutputBufferTest()
+      : EncoderTest(GET_PARAM(0)),
+        encoding_mode_(GET_PARAM(1)),
+        use_cb_(false),
+        superframes_(0),
+        released_count_(0) {}
+
+  virtual ~OutputBufferTest() { CheckAndFreeBuffers(); }
+
+  virtual void SetUp() {
+    InitializeConfig();
+    SetMode(encoding_mode_);
+    cfg_.g_lag_in_frames = encoding_mode_ == ::libvpx_test::kRealTime ? 0 : 10;
+    cfg_.rc_target_bitrate = 300;
+  }
+
+  // The previous pass's encoder has been destroyed by now.
+  virtual void BeginPassHook(unsigned int /*pass*/) { CheckAndFreeBuffers(); }
+
+  virtual void PreEncodeFrameHook(::libvpx_test::VideoSource *video,
+                                  ::libvpx_test::Encoder *encoder) {
+    if (video->frame() == 0) {
+      encoder->Control(VP8E_SET_CPUUSED, 4);
+      if (encoding_mode_ != ::libvpx_test::kRealTime) {
+        encoder->Control(VP8E_SET_ENABLEAUTOALTREF, 1);
+        encoder->Control(VP8E_SET_ARNR_MAXFRAMES, 7);
+      }
+      if (use_cb_) {
+        vpx_output_buffer_cb_t cb;
+        cb.get_buffer = GetBuffer;
+        cb.release_buffer = ReleaseBuffer;
+        cb.cb_priv = this;
+        encoder->Control(VP9E_SET_OUTPUT_BUFFER_CB, &cb);
+      }
+    }
+  }
+
+  virtual void FramePktHook(const vpx_codec_cx_pkt_t *pkt) {
+    if (cfg_.g_pass == VPX_RC_FIRST_PASS)
+      return;
+    const uint8_t *const buf =
+        reinterpret_cast<const uint8_t *>(pkt->data.frame.buf);
+    if (use_cb_) {
+      // Every packet starts a buffer of its own that was never handed out
+      // before.
+      bool found = false;
+      for (size_t i = 0; i < buffers_.size(); ++i) {
+        if (buffers_[i] == buf) {
+          EXPECT_FALSE(used_[i]) << "buffer " << i << " reused";
+          EXPECT_FALSE(released_[i]) << "buffer " << i << " used after release";
+          EXPECT_LE(pkt->data.frame.sz, sizes_[i]);
+          used_[i] = true;
+          found = true;
+        }
+      }
+      EXPECT_TRUE(found) << "packet not written to an application buffer";
+    }
+    const uint8_t marker = buf[pkt->data.frame.sz - 1];
+    if ((marker & 0xe0) == 0xc0)
+      ++superframes_;
+    ::libvpx_test::MD5 md5;
+    md5.Add(buf, pkt->data.frame.sz);
+    frame_md5_.push_back(md5.Get());
+  }
+
+  static void *GetBuffer(void *cb_priv, size_t min_sz) {
+    OutputBufferTest *const test =
+        reinterpret_cast<OutputBufferTest *>(cb_priv);
+    uint8_t *const buf = new uint8_t[min_sz];
+    test->buffers_.push_back(buf);
+    test->sizes_.push_back(min_sz);
+    test->used_.push_back(false);
+    test->released_.push_back(false);
+    return buf;
+  }
+
+  static void ReleaseBuffer(void *cb_priv, void *buf) {
+    OutputBufferTest *const test =
+        reinterpret_cast<OutputBufferTest *>(cb_priv);
+    bool found = false;
+    for (size_t i = 0; i < test->buffers_.size(); ++i) {
+      if (test->buffers_[i] == buf) {
+        EXPECT_FALSE(test->used_[i]) << "buffer " << i << " released after use";
+        EXPECT_FALSE(test->released_[i]) << "buffer " << i << " released twice";
+        test->released_[i] = true;
+        found = true;
+      }
+    }
+    EXPECT_TRUE(found) << "released buffer was not handed out";
+  }
+
+  // Every buffer handed out to an encoder that has been destroyed must have
+  // been returned in a packet or released.
+  void CheckAndFreeBuffers() {
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+      EXPECT_TRUE(used_[i] || released_[i]) << "buffer " << i << " leaked";
+      released_count_ += released_[i];
+      delete[] buffers_[i];
+    }
+    buffers_.clear();
+    sizes_.clear();
+    used_.clear();
+    released_.clear();
+  }
+
+  std::vector<std::string> Encode(bool use_cb) {
+    ::libvpx_test::RandomVideoSource video;
+    video.SetSize(176, 144);
+    video.set_limit(kFrames);
+    use_cb_ = use_cb;
+    superframes_ = 0;
+    released_count_ = 0;
+    frame_md5_.clear();
+    EXPECT_NO_FATAL_FAILURE(RunLoop(&video));
+    CheckAndFreeBuffers();
+    return frame_md5_;
+  }
+
+  ::libvpx_test::TestMode encoding_mode_;
+  bool use_cb_;
+  int superframes_;
+  int released_count_;
+  std::vector<uint8_t *> buffers_;
+  std::vector<size_t> sizes_;
+  std::vector<bool> used_;
+  std::vector<bool> released_;
+  std::vector<std::string> frame_md5_;
+};
+
+TEST_P(OutputBufferTest, MatchesInternalBuffer) {
+  const std::vector<std::string> internal = Encode(false);
+  const int internal_superframes = superframes_;
+
+  const std::vector<std::string> external = Encode(true);
+  EXPECT_EQ(internal_superframes, superframes_);
+  // Each encoder releases at most the one buffer it held for a frame that
+  // was not produced.
+  EXPECT_LE(released_count_, cfg_.g_pass == VPX_RC_LAST_PASS ? 2 : 1);
+  ASSERT_EQ(internal.size(), external.size());
+  for (size_t i = 0; i < internal.size(); ++i)
+    EXPECT_EQ(internal[i], external[i]) << "frame " << i;
+}
+
+VP9_INSTANTIATE_TEST_CASE(OutputBufferTest,
+                          ::testing::Values(::libvpx_test::kOnePassGood,
+                                            ::libvpx_test::kTwoPassGood,
+                                            ::libvpx_test::kRealTime));
+}  // namespace
@@ -0,0 +1,142 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "test/acm_random.h"
+#include "vpx/vp8cx.h"
+#include "vpx/vp8dx.h"
+#include "vpx/vpx_decoder.h"
+#include "vpx/vpx_encoder.h"
+
+namespace {
+
+using libvpx_test::ACMRandom;
+
+const int kWidth = 176;
+const int kHeight = 144;
+const unsigned int kFrames = 10;
+
+class PerfStatsTest : public ::testing::TestWithParam<int> {
+ protected:
+  PerfStatsTest() : rnd_(ACMRandom::DeterministicSeed()) {}
+
+  virtual void SetUp() {
+    vpx_codec_enc_cfg_t cfg;
+    vpx_codec_dec_cfg_t dec_cfg = vpx_codec_dec_cfg_t();
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_enc_config_default(vpx_codec_vp9_cx(), &cfg, 0));
+    cfg.g_w = kWidth;
+    cfg.g_h = kHeight;
+    cfg.g_threads = GetParam();
+    cfg.g_lag_in_frames = 0;
+    cfg.rc_target_bitrate = 300;
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_enc_init(&encoder_, vpx_codec_vp9_cx(), &cfg, 0));
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&encoder_, VP8E_SET_CPUUSED, 6));
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_control(&encoder_, VP9E_SET_TILE_COLUMNS, 1));
+    dec_cfg.threads = GetParam();
+    ASSERT_EQ(VPX_CODEC_OK,
+              vpx_codec_dec_init(&decoder_, vpx_codec_vp9_dx(), &dec_cfg, 0));
+    ASSERT_TRUE(vpx_img_alloc(&img_, VPX_IMG_FMT_I420, kWidth, kHeight, 32) !=
+                NULL);
+  }
+
+  virtual void TearDown() {
+    vpx_img_free(&img_);
+    vpx_codec_destroy(&decoder_);
+    vpx_codec_destroy(&encoder_);
+  }
+
+  // Encodes and decodes kFrames frames of noise.
+  void EncodeAndDecode() {
+    for (unsigned int frame = 0; frame < kFrames; ++frame) {
+      for (int plane = 0; plane < 3; ++plane) {
+        const int h = plane ? (kHeight + 1) / 2 : kHeight;
+        const int w = plane ? (kWidth + 1) / 2 : kWidth;
+        for (int r = 0; r < h; ++r) {
+          uint8_t *const row = img_.planes[plane] + r * img_.stride[plane];
+          for (int c = 0; c < w; ++c)
+            row[c] = rnd_.Rand8();
+        }
+      }
+      ASSERT_EQ(VPX_CODEC_OK,
+                vpx_codec_encode(&encoder_, &img_, frame, 1, 0,
+                                 VPX_DL_REALTIME));
+      vpx_codec_iter_t iter = NULL;
+      const vpx_codec_cx_pkt_t *pkt;
+      while ((pkt = vpx_codec_get_cx_data(&encoder_, &iter)) != NULL) {
+        if (pkt->kind != VPX_CODEC_CX_FRAME_PKT)
+          continue;
+        ASSERT_EQ(VPX_CODEC_OK,
+                  vpx_codec_decode(&decoder_,
+                                   static_cast<const uint8_t *>(
+                                       pkt->data.frame.buf),
+                                   static_cast<unsigned int>(
+                                       pkt->data.frame.sz), NULL, 0));
+      }
+    }
+  }
+
+  ACMRandom rnd_;
+  vpx_codec_ctx_t encoder_;
+  vpx_codec_ctx_t decoder_;
+  vpx_image_t img_;
+};
+
+TEST_P(PerfStatsTest, EncoderStats) {
+  ASSERT_NO_FATAL_FAILURE(EncodeAndDecode());
+  vpx_enc_perf_stats_t stats;
+  memset(&stats, 0, sizeof(stats));
+#if CONFIG_PERF_STATS
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_control(&encoder_, VP9E_GET_PERF_STATS, &stats));
+  EXPECT_EQ(kFrames, stats.frames);
+  EXPECT_GT(stats.total.motion_searches, 0);
+  EXPECT_GT(stats.total.tokens, 0);
+  EXPECT_GE(stats.last_frame.frame_us,
+            stats.last_frame.encode_us + stats.last_frame.pack_us);
+  EXPECT_GE(stats.last_frame.encode_us, stats.last_frame.thread_wait_us);
+  EXPECT_GE(stats.total.frame_us, stats.last_frame.frame_us);
+  EXPECT_EQ(0, stats.total.first_pass_us);
+  EXPECT_EQ(VPX_CODEC_INVALID_PARAM,
+            vpx_codec_control(&encoder_, VP9E_GET_PERF_STATS,
+                              static_cast<vpx_enc_perf_stats_t *>(NULL)));
+#else
+  EXPECT_EQ(VPX_CODEC_INCAPABLE,
+            vpx_codec_control(&encoder_, VP9E_GET_PERF_STATS, &stats));
+#endif
+}
+
+TEST_P(PerfStatsTest, DecoderStats) {
+  ASSERT_NO_FATAL_FAILURE(EncodeAndDecode());
+  vpx_dec_perf_stats_t stats;
+  memset(&stats, 0, sizeof(stats));
+#if CONFIG_PERF_STATS
+  ASSERT_EQ(VPX_CODEC_OK,
+            vpx_codec_control(&decoder_, VP9D_GET_PERF_STATS, &stats));
+  EXPECT_EQ(kFrames, stats.frames);
+  EXPECT_GE(stats.last_frame.frame_us,
+            stats.last_frame.header_us + stats.last_frame.tiles_us +
+            stats.last_frame.loopfilter_us);
+  EXPECT_GE(stats.total.frame_us, stats.last_frame.frame_us);
+#else
+  EXPECT_EQ(VPX_CODEC_INCAPABLE,
+            vpx_codec_control(&decoder_, VP9D_GET_PERF_STATS, &stats));
+#endif
+}
+
+INSTANTIATE_TEST_CASE_P(VP9, PerfStatsTest, ::testing::Values(1, 2));
+}  // namespace
@@ -0,0 +1,217 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstdlib>
+#include <cstring>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "./vp9_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "vp9/common/vp9_postproc.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+const int kNumIterations = 200;
+const int kMaxRows = 48;
+const int kMaxCols = 64;
+// Room for the taps above, below and on each side of the block, with the
+// rows 16 byte aligned for the SSE2 versions.
+const int kBorder = 16;
+const int kSrcStride = kMaxCols + 2 * kBorder;
+const int kDstStride = kSrcStride + 32;
+const int kBufRows = kMaxRows + 2 * kBorder;
+
+// Flat areas with some noise and some edges, so that both sides of the
+// filter thresholds are taken.
+void FillImage(ACMRandom *rnd, uint8_t *buf, int size) {
+  const int base = rnd->Rand8();
+  for (int i = 0; i < size; ++i) {
+    if (rnd->Rand8() < 16)
+      buf[i] = rnd->Rand8();
+    else
+      buf[i] = clip_pixel(base + rnd->Rand8() % 9 - 4);
+  }
+}
+
+typedef void (*DownAndAcrossFunc)(const uint8_t *src_ptr, uint8_t *dst_ptr,
+                                  int src_pixels_per_line,
+                                  int dst_pixels_per_line, int rows, int cols,
+                                  int flimit);
+
+class VP9PostProcDownAndAcrossTest
+    : public ::testing::TestWithParam<DownAndAcrossFunc> {
+ public:
+  virtual ~VP9PostProcDownAndAcrossTest() {}
+  virtual void SetUp() { func_ = GetParam(); }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  DownAndAcrossFunc func_;
+};
+
+TEST_P(VP9PostProcDownAndAcrossTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  uint8_t src[kBufRows * kSrcStride];
+  uint8_t ref_dst[kBufRows * kDstStride];
+  uint8_t dst[kBufRows * kDstStride];
+  const int src_offset = kBorder * kSrcStride + kBorder;
+  const int dst_offset = kBorder * kDstStride + kBorder;
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    // The C version needs at least 8 columns.
+    const int rows = 1 + rnd(kMaxRows);
+    const int cols = 8 + rnd(kMaxCols - 7);
+    const int flimit = rnd(32);
+
+    FillImage(&rnd, src, sizeof(src));
+    FillImage(&rnd, ref_dst, sizeof(ref_dst));
+    memcpy(dst, ref_dst, sizeof(dst));
+
+    vp9_post_proc_down_and_across_c(src + src_offset, ref_dst + dst_offset,
+                                     kSrcStride, kDstStride, rows, cols,
+                                     flimit);
+    ASM_REGISTER_STATE_CHECK(func_(src + src_offset, dst + dst_offset,
+                                   kSrcStride, kDstStride, rows, cols,
+                                   flimit));
+    ASSERT_EQ(0, memcmp(ref_dst, dst, sizeof(dst)))
+        << "rows: " << rows << " cols: " << cols << " flimit: " << flimit;
+  }
+}
+
+typedef void (*MbPostProcDownFunc)(uint8_t *dst, int pitch, int rows,
+                                   int cols, int flimit);
+
+// vp9_mbpost_proc_down_c() on whole groups of 8 columns, as filtered by the
+// SIMD versions.
+void ReferenceMbPostProcDown(uint8_t *dst, int pitch, int rows, int cols,
+                             int flimit) {
+  for (int c = 0; c < ((cols + 7) & ~7); ++c) {
+    uint8_t *s = &dst[c];
+    int sumsq = 0;
+    int sum = 0;
+    uint8_t d[16];
+
+    for (int i = -8; i <= 6; ++i) {
+      sumsq += s[i * pitch] * s[i * pitch];
+      sum += s[i * pitch];
+    }
+
+    for (int r = 0; r < rows + 8; ++r) {
+      sumsq += s[7 * pitch] * s[7 * pitch] - s[-8 * pitch] * s[-8 * pitch];
+      sum += s[7 * pitch] - s[-8 * pitch];
+      d[r & 15] = s[0];
+
+      if (sumsq * 15 - sum * sum < flimit) {
+        const int v = (vp9_rv[(r & 127) + (c & 7)] + sum + s[0]) >> 4;
+        d[r & 15] = v > 255 ? 255 : v;
+      }
+
+      if (r >= 8)
+        s[-8 * pitch] = d[(r - 8) & 15];
+      s += pitch;
+    }
+  }
+}
+
+class VP9MbPostProcDownTest
+    : public ::testing::TestWithParam<MbPostProcDownFunc> {
+ public:
+  virtual ~VP9MbPostProcDownTest() {}
+  virtual void SetUp() { func_ = GetParam(); }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  MbPostProcDownFunc func_;
+};
+
+TEST_P(VP9MbPostProcDownTest, MatchesReference) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  uint8_t ref_dst[kBufRows * kDstStride];
+  uint8_t dst[kBufRows * kDstStride];
+  const int offset = kBorder * kDstStride + kBorder;
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    const int rows = 1 + rnd(kMaxRows);
+    const int cols = 1 + rnd(kMaxCols);
+    const int flimit = rnd(5000);
+
+    FillImage(&rnd, ref_dst, sizeof(ref_dst));
+    memcpy(dst, ref_dst, sizeof(dst));
+
+    ReferenceMbPostProcDown(ref_dst + offset, kDstStride, rows, cols, flimit);
+    ASM_REGISTER_STATE_CHECK(func_(dst + offset, kDstStride, rows, cols,
+                                   flimit));
+    // The SSE2 version also writes the 8 rows above the block.
+    ASSERT_EQ(0, memcmp(ref_dst + kBorder * kDstStride,
+                        dst + kBorder * kDstStride, rows * kDstStride))
+        << "rows: " << rows << " cols: " << cols << " flimit: " << flimit;
+  }
+}
+
+typedef void (*FilterByWeightFunc)(const uint8_t *src, int src_stride,
+                                   uint8_t *dst, int dst_stride,
+                                   int src_weight);
+
+class VP9FilterByWeightTest
+    : public ::testing::TestWithParam<FilterByWeightFunc> {
+ public:
+  virtual ~VP9FilterByWeightTest() {}
+  virtual void SetUp() { func_ = GetParam(); }
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  FilterByWeightFunc func_;
+};
+
+TEST_P(VP9FilterByWeightTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint8_t, src[16 * kSrcStride]);
+  DECLARE_ALIGNED(16, uint8_t, ref_dst[16 * kDstStride]);
+  DECLARE_ALIGNED(16, uint8_t, dst[16 * kDstStride]);
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    const int weight = rnd(1 + (1 << MFQE_PRECISION));
+
+    for (int k = 0; k < 16 * kSrcStride; ++k)
+      src[k] = rnd.Rand8();
+    for (int k = 0; k < 16 * kDstStride; ++k)
+      ref_dst[k] = dst[k] = rnd.Rand8();
+
+    vp9_filter_by_weight16x16_c(src, kSrcStride, ref_dst, kDstStride, weight);
+    ASM_REGISTER_STATE_CHECK(func_(src, kSrcStride, dst, kDstStride, weight));
+    ASSERT_EQ(0, memcmp(ref_dst, dst, sizeof(dst))) << "weight: " << weight;
+  }
+}
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(SSE2, VP9MbPostProcDownTest,
+                        ::testing::Values(&vp9_mbpost_proc_down_xmm));
+INSTANTIATE_TEST_CASE_P(SSE2, VP9FilterByWeightTest,
+                        ::testing::Values(&vp9_filter_by_weight16x16_sse2));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, VP9PostProcDownAndAcrossTest,
+                        ::testing::Values(
+                            &vp9_post_proc_down_and_across_avx2));
+INSTANTIATE_TEST_CASE_P(AVX2, VP9MbPostProcDownTest,
+                        ::testing::Values(&vp9_mbpost_proc_down_avx2));
+INSTANTIATE_TEST_CASE_P(AVX2, VP9FilterByWeightTest,
+                        ::testing::Values(&vp9_filter_by_weight16x16_avx2));
+#endif  // HAVE_AVX2
+}  // namespace
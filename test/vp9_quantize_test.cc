@@ -15,22 +15,22 @@
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vpx_config.h"
+#include "./vp9_rtcd.h"
 #include "./vpx_dsp_rtcd.h"
 #include "test/acm_random.h"
 #include "test/clear_system_state.h"
 #include "test/register_state_check.h"
 #include "test/util.h"
 #include "vp9/common/vp9_entropy.h"
+#include "vp9/common/vp9_quant_common.h"
 #include "vp9/common/vp9_scan.h"
 #include "vpx/vpx_codec.h"
 #include "vpx/vpx_integer.h"
+#include "vpx_ports/vpx_timer.h"
 
 using libvpx_test::ACMRandom;
 
 namespace {
-#if CONFIG_VP9_HIGHBITDEPTH
-const int number_of_iterations = 100;
-
 typedef void (*QuantizeFunc)(const tran_low_t *coeff, intptr_t count,
                              int skip_block, const int16_t *zbin,
                              const int16_t *round, const int16_t *quant,
@@ -39,6 +39,10 @@ typedef void (*QuantizeFunc)(const tran_low_t *coeff, intptr_t count,
                              const int16_t *dequant,
                              uint16_t *eob, const int16_t *scan,
                              const int16_t *iscan);
+
+#if CONFIG_VP9_HIGHBITDEPTH
+const int number_of_iterations = 100;
+
 typedef std::tr1::tuple<QuantizeFunc, QuantizeFunc, vpx_bit_depth_t>
     QuantizeParam;
 
@@ -325,8 +329,145 @@ TEST_P(VP9Quantize32Test, EOBCheck) {
       << "Error: Quantization Test, C output doesn't match SSE2 output. "
       << "First failed at test case " << first_failure;
 }
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+// Compares against the C code with the tables vp9_init_quantizer() builds for
+// a random q index, rather than random ones. The third parameter is TX_32X32
+// for the 32x32 functions and otherwise the largest size tested, and the
+// fourth selects the tables of vp9_quantize_fp().
+typedef std::tr1::tuple<QuantizeFunc, QuantizeFunc, TX_SIZE, bool,
+                        vpx_bit_depth_t> QuantizeTableParam;
+
+class VP9QuantizeTableTest
+    : public ::testing::TestWithParam<QuantizeTableParam> {
+ public:
+  virtual ~VP9QuantizeTableTest() {}
+  virtual void SetUp() {
+    quantize_op_ = GET_PARAM(0);
+    ref_quantize_op_ = GET_PARAM(1);
+    tx_size_ = GET_PARAM(2);
+    is_fp_ = GET_PARAM(3);
+    bit_depth_ = GET_PARAM(4);
+  }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  // Fills the y plane tables for |q| the way vp9_init_quantizer() does.
+  void InitQuantizer(int q, int16_t *zbin, int16_t *round, int16_t *quant,
+                     int16_t *quant_shift, int16_t *dequant) const {
+    const int dc_quant = vp9_dc_quant(q, 0, bit_depth_);
+    const int zbin_factor =
+        q == 0 ? 64 : (dc_quant < (148 << (bit_depth_ - 8)) ? 84 : 80);
+    for (int i = 0; i < 8; ++i) {
+      const int x = i == 0 ? dc_quant : vp9_ac_quant(q, 0, bit_depth_);
+      int l = 0;
+      while ((x >> (l + 1)) > 0) ++l;
+      dequant[i] = x;
+      zbin[i] = ROUND_POWER_OF_TWO(zbin_factor * x, 7);
+      if (is_fp_) {
+        quant[i] = (1 << 16) / x;
+        round[i] = ((q == 0 ? 64 : (i == 0 ? 48 : 42)) * x) >> 7;
+      } else {
+        quant[i] = static_cast<int16_t>(1 + (1 << (16 + l)) / x - (1 << 16));
+        round[i] = ((q == 0 ? 64 : 48) * x) >> 7;
+      }
+      quant_shift[i] = 1 << (16 - l);
+    }
+  }
+
+  QuantizeFunc quantize_op_;
+  QuantizeFunc ref_quantize_op_;
+  TX_SIZE tx_size_;
+  bool is_fp_;
+  vpx_bit_depth_t bit_depth_;
+};
+
+TEST_P(VP9QuantizeTableTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, tran_low_t, coeff[1024]);
+  DECLARE_ALIGNED(16, int16_t, zbin[8]);
+  DECLARE_ALIGNED(16, int16_t, round[8]);
+  DECLARE_ALIGNED(16, int16_t, quant[8]);
+  DECLARE_ALIGNED(16, int16_t, quant_shift[8]);
+  DECLARE_ALIGNED(16, int16_t, dequant[8]);
+  DECLARE_ALIGNED(16, tran_low_t, qcoeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, dqcoeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_qcoeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, ref_dqcoeff[1024]);
+  uint16_t eob, ref_eob;
+
+  for (int i = 0; i < 2000; ++i) {
+    const int skip_block = i % 100 == 0;
+    const TX_SIZE sz =
+        tx_size_ == TX_32X32 ? TX_32X32 : (TX_SIZE)rnd(tx_size_ + 1);
+    const TX_TYPE tx_type = sz == TX_32X32 ? DCT_DCT : (TX_TYPE)rnd(4);
+    const scan_order *const so = &vp9_scan_orders[sz][tx_type];
+    const int count = (4 << sz) * (4 << sz);
+    const int q = rnd(QINDEX_RANGE);
+    // Blocks range from mostly inside the zero bin to mostly large values.
+    const int range = 1 << rnd(bit_depth_ + 6);
+
+    InitQuantizer(q, zbin, round, quant, quant_shift, dequant);
+    for (int j = 0; j < count; ++j)
+      coeff[j] = rnd(2 * range + 1) - range;
+    memset(qcoeff, 0x55, sizeof(qcoeff));
+    memset(dqcoeff, 0x55, sizeof(dqcoeff));
+
+    ref_quantize_op_(coeff, count, skip_block, zbin, round, quant,
+                     quant_shift, ref_qcoeff, ref_dqcoeff, dequant, &ref_eob,
+                     so->scan, so->iscan);
+    ASM_REGISTER_STATE_CHECK(quantize_op_(coeff, count, skip_block, zbin,
+                                          round, quant, quant_shift, qcoeff,
+                                          dqcoeff, dequant, &eob, so->scan,
+                                          so->iscan));
+    ASSERT_EQ(ref_eob, eob) << "q: " << q << " iteration: " << i;
+    for (int j = 0; j < count; ++j) {
+      ASSERT_EQ(ref_qcoeff[j], qcoeff[j])
+          << "q: " << q << " iteration: " << i << " position: " << j;
+      ASSERT_EQ(ref_dqcoeff[j], dqcoeff[j])
+          << "q: " << q << " iteration: " << i << " position: " << j;
+    }
+  }
+}
+
+TEST_P(VP9QuantizeTableTest, DISABLED_Speed) {
+  static const int kNumBlocks = 200000;
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, tran_low_t, coeff[1024]);
+  DECLARE_ALIGNED(16, int16_t, zbin[8]);
+  DECLARE_ALIGNED(16, int16_t, round[8]);
+  DECLARE_ALIGNED(16, int16_t, quant[8]);
+  DECLARE_ALIGNED(16, int16_t, quant_shift[8]);
+  DECLARE_ALIGNED(16, int16_t, dequant[8]);
+  DECLARE_ALIGNED(16, tran_low_t, qcoeff[1024]);
+  DECLARE_ALIGNED(16, tran_low_t, dqcoeff[1024]);
+  const scan_order *const so = &vp9_scan_orders[tx_size_][DCT_DCT];
+  const int count = (4 << tx_size_) * (4 << tx_size_);
+  const int range = 64 << (bit_depth_ - 8);
+  uint16_t eob;
+
+  InitQuantizer(100, zbin, round, quant, quant_shift, dequant);
+  for (int j = 0; j < count; ++j)
+    coeff[j] = rnd(2 * range + 1) - range;
+
+  for (int k = 0; k < 2; ++k) {
+    const QuantizeFunc func = k == 0 ? ref_quantize_op_ : quantize_op_;
+    vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+    for (int i = 0; i < kNumBlocks; ++i)
+      func(coeff, count, 0, zbin, round, quant, quant_shift, qcoeff, dqcoeff,
+           dequant, &eob, so->scan, so->iscan);
+    vpx_usec_timer_mark(&timer);
+    printf("%s, %d coefficients: %6.2f us/block\n", k == 0 ? "C" : "Test",
+           count,
+           static_cast<double>(vpx_usec_timer_elapsed(&timer)) / kNumBlocks);
+  }
+}
+
 using std::tr1::make_tuple;
 
+#if CONFIG_VP9_HIGHBITDEPTH
 #if HAVE_SSE2
 INSTANTIATE_TEST_CASE_P(
     SSE2, VP9QuantizeTest,
@@ -346,6 +487,68 @@ INSTANTIATE_TEST_CASE_P(
                    &vpx_highbd_quantize_b_32x32_c, VPX_BITS_10),
         make_tuple(&vpx_highbd_quantize_b_32x32_sse2,
                    &vpx_highbd_quantize_b_32x32_c, VPX_BITS_12)));
+INSTANTIATE_TEST_CASE_P(
+    SSE2, VP9QuantizeTableTest,
+    ::testing::Values(
+        make_tuple(&vpx_highbd_quantize_b_sse2, &vpx_highbd_quantize_b_c,
+                   TX_16X16, false, VPX_BITS_8),
+        make_tuple(&vpx_highbd_quantize_b_sse2, &vpx_highbd_quantize_b_c,
+                   TX_16X16, false, VPX_BITS_10),
+        make_tuple(&vpx_highbd_quantize_b_sse2, &vpx_highbd_quantize_b_c,
+                   TX_16X16, false, VPX_BITS_12)));
 #endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP9QuantizeTest,
+    ::testing::Values(
+        make_tuple(&vpx_highbd_quantize_b_avx2,
+                   &vpx_highbd_quantize_b_c, VPX_BITS_8),
+        make_tuple(&vpx_highbd_quantize_b_avx2,
+                   &vpx_highbd_quantize_b_c, VPX_BITS_10),
+        make_tuple(&vpx_highbd_quantize_b_avx2,
+                   &vpx_highbd_quantize_b_c, VPX_BITS_12)));
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP9Quantize32Test,
+    ::testing::Values(
+        make_tuple(&vpx_highbd_quantize_b_32x32_avx2,
+                   &vpx_highbd_quantize_b_32x32_c, VPX_BITS_8),
+        make_tuple(&vpx_highbd_quantize_b_32x32_avx2,
+                   &vpx_highbd_quantize_b_32x32_c, VPX_BITS_10),
+        make_tuple(&vpx_highbd_quantize_b_32x32_avx2,
+                   &vpx_highbd_quantize_b_32x32_c, VPX_BITS_12)));
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP9QuantizeTableTest,
+    ::testing::Values(
+        make_tuple(&vpx_highbd_quantize_b_avx2, &vpx_highbd_quantize_b_c,
+                   TX_16X16, false, VPX_BITS_8),
+        make_tuple(&vpx_highbd_quantize_b_avx2, &vpx_highbd_quantize_b_c,
+                   TX_16X16, false, VPX_BITS_10),
+        make_tuple(&vpx_highbd_quantize_b_avx2, &vpx_highbd_quantize_b_c,
+                   TX_16X16, false, VPX_BITS_12),
+        make_tuple(&vpx_highbd_quantize_b_32x32_avx2,
+                   &vpx_highbd_quantize_b_32x32_c, TX_32X32, false,
+                   VPX_BITS_8),
+        make_tuple(&vpx_highbd_quantize_b_32x32_avx2,
+                   &vpx_highbd_quantize_b_32x32_c, TX_32X32, false,
+                   VPX_BITS_10),
+        make_tuple(&vpx_highbd_quantize_b_32x32_avx2,
+                   &vpx_highbd_quantize_b_32x32_c, TX_32X32, false,
+                   VPX_BITS_12)));
+#endif  // HAVE_AVX2
+#else
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(
+    AVX2, VP9QuantizeTableTest,
+    ::testing::Values(
+        make_tuple(&vpx_quantize_b_avx2, &vpx_quantize_b_c, TX_16X16, false,
+                   VPX_BITS_8),
+        make_tuple(&vpx_quantize_b_32x32_avx2, &vpx_quantize_b_32x32_c,
+                   TX_32X32, false, VPX_BITS_8),
+        make_tuple(&vp9_quantize_fp_avx2, &vp9_quantize_fp_c, TX_16X16, true,
+                   VPX_BITS_8),
+        make_tuple(&vp9_quantize_fp_32x32_avx2, &vp9_quantize_fp_32x32_c,
+                   TX_32X32, true, VPX_BITS_8)));
+#endif  // HAVE_AVX2
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 }  // namespace
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstring>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "./vpx_config.h"
+#include "./vp9_rtcd.h"
+#include "test/acm_random.h"
+#include "test/clear_system_state.h"
+#include "test/register_state_check.h"
+#include "vp9/encoder/vp9_resize.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+using libvpx_test::ACMRandom;
+
+namespace {
+const int kNumIterations = 1000;
+const int kMaxWidth = 256;
+
+typedef void (*ResizeFilterFunc)(const uint8_t *const src[8],
+                                 const int16_t *filter, uint8_t *dst,
+                                 int width);
+
+class ResizeFilterTest : public ::testing::TestWithParam<ResizeFilterFunc> {
+ public:
+  virtual ~ResizeFilterTest() {}
+  virtual void SetUp() { filter_op_ = GetParam(); }
+
+  virtual void TearDown() { libvpx_test::ClearSystemState(); }
+
+ protected:
+  ResizeFilterFunc filter_op_;
+};
+
+TEST_P(ResizeFilterTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  DECLARE_ALIGNED(16, uint8_t, rows[8][kMaxWidth]);
+  DECLARE_ALIGNED(16, uint8_t, ref_dst[kMaxWidth]);
+  DECLARE_ALIGNED(16, uint8_t, dst[kMaxWidth]);
+  const uint8_t *src[8];
+  int16_t filter[8];
+
+  for (int i = 0; i < kNumIterations; ++i) {
+    const int width = 1 + rnd(kMaxWidth);
+    int sum = 0;
+    // Alternate between random pixels and ones near 0 or 255, which with the
+    // negative taps push the sums out of the pixel range in both directions.
+    for (int k = 0; k < 8; ++k) {
+      src[k] = rows[k];
+      for (int x = 0; x < kMaxWidth; ++x)
+        rows[k][x] = (i & 1) ? rnd.Rand8() : rnd.Rand8Extremes();
+    }
+    for (int k = 0; k < 7; ++k) {
+      filter[k] = rnd(96) - 32;
+      sum += filter[k];
+    }
+    filter[7] = 128 - sum;
+    memset(ref_dst, 0, sizeof(ref_dst));
+    memset(dst, 0, sizeof(dst));
+
+    vp9_resize_filter_8tap_c(src, filter, ref_dst, width);
+    ASM_REGISTER_STATE_CHECK(filter_op_(src, filter, dst, width));
+    ASSERT_EQ(0, memcmp(ref_dst, dst, sizeof(dst)))
+        << "width: " << width << " iteration: " << i;
+  }
+}
+
+// The two passes of vp9_resize_plane() run on bands of the plane give the
+// same result as the whole plane at once.
+TEST(ResizePlaneTest, BandsMatchWholePlane) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kSizes[][4] = {
+    { 176, 144, 88, 72 }, { 99, 67, 75, 51 }, { 64, 64, 43, 43 },
+    { 120, 90, 160, 120 }, { 61, 37, 16, 10 },
+  };
+  const int kNumBands = 3;
+
+  for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); ++s) {
+    const int width = kSizes[s][0];
+    const int height = kSizes[s][1];
+    const int width2 = kSizes[s][2];
+    const int height2 = kSizes[s][3];
+    uint8_t *const input = new uint8_t[width * height];
+    uint8_t *const intbuf = new uint8_t[width2 * height];
+    uint8_t *const ref_output = new uint8_t[width2 * height2];
+    uint8_t *const output = new uint8_t[width2 * height2];
+
+    for (int i = 0; i < width * height; ++i)
+      input[i] = rnd.Rand8();
+    vp9_resize_plane(input, height, width, width, ref_output, height2, width2,
+                     width2);
+    for (int b = 0; b < kNumBands; ++b)
+      vp9_resize_plane_horiz(input, height, width, width, intbuf, width2,
+                             height * b / kNumBands,
+                             height * (b + 1) / kNumBands);
+    for (int b = 0; b < kNumBands; ++b)
+      vp9_resize_plane_vert(intbuf, height, width2, output, height2, width2,
+                            width2 * b / kNumBands,
+                            width2 * (b + 1) / kNumBands);
+    EXPECT_EQ(0, memcmp(ref_output, output, width2 * height2))
+        << width << "x" << height << " -> " << width2 << "x" << height2;
+
+    delete[] input;
+    delete[] intbuf;
+    delete[] ref_output;
+    delete[] output;
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(C, ResizeFilterTest,
+                        ::testing::Values(&vp9_resize_filter_8tap_c));
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(SSE2, ResizeFilterTest,
+                        ::testing::Values(&vp9_resize_filter_8tap_sse2));
+#endif  // HAVE_SSE2
+
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, ResizeFilterTest,
+                        ::testing::Values(&vp9_resize_filter_8tap_avx2));
+#endif  // HAVE_AVX2
+}  // namespace
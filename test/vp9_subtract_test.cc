@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <cstring>
+
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vp9_rtcd.h"
@@ -18,6 +20,7 @@
 #include "test/register_state_check.h"
 #include "vp9/common/vp9_blockd.h"
 #include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/mem.h"
 
 typedef void (*SubtractFunc)(int rows, int cols,
                              int16_t *diff_ptr, ptrdiff_t diff_stride,
@@ -97,6 +100,10 @@ INSTANTIATE_TEST_CASE_P(C, VP9SubtractBlockTest,
 INSTANTIATE_TEST_CASE_P(SSE2, VP9SubtractBlockTest,
                         ::testing::Values(vpx_subtract_block_sse2));
 #endif
+#if HAVE_AVX2
+INSTANTIATE_TEST_CASE_P(AVX2, VP9SubtractBlockTest,
+                        ::testing::Values(vpx_subtract_block_avx2));
+#endif
 #if HAVE_NEON
 INSTANTIATE_TEST_CASE_P(NEON, VP9SubtractBlockTest,
                         ::testing::Values(vpx_subtract_block_neon));
@@ -106,4 +113,76 @@ INSTANTIATE_TEST_CASE_P(MSA, VP9SubtractBlockTest,
                         ::testing::Values(vpx_subtract_block_msa));
 #endif
 
+#if CONFIG_VP9_HIGHBITDEPTH
+typedef void (*HighbdSubtractFunc)(int rows, int cols,
+                                   int16_t *diff_ptr, ptrdiff_t diff_stride,
+                                   const uint8_t *src_ptr,
+                                   ptrdiff_t src_stride,
+                                   const uint8_t *pred_ptr,
+                                   ptrdiff_t pred_stride, int bd);
+
+class VP9HighbdSubtractBlockTest
+    : public ::testing::TestWithParam<HighbdSubtractFunc> {
+ public:
+  virtual void TearDown() {
+    libvpx_test::ClearSystemState();
+  }
+};
+
+TEST_P(VP9HighbdSubtractBlockTest, MatchesC) {
+  ACMRandom rnd(ACMRandom::DeterministicSeed());
+  const int kStride = 2 * 64 + 8;
+  uint16_t *src = reinterpret_cast<uint16_t *>(
+      vpx_memalign(16, sizeof(*src) * 64 * kStride));
+  uint16_t *pred = reinterpret_cast<uint16_t *>(
+      vpx_memalign(16, sizeof(*pred) * 64 * kStride));
+  int16_t *ref_diff = reinterpret_cast<int16_t *>(
+      vpx_memalign(16, sizeof(*ref_diff) * 64 * kStride));
+  int16_t *diff = reinterpret_cast<int16_t *>(
+      vpx_memalign(16, sizeof(*diff) * 64 * kStride));
+
+  for (BLOCK_SIZE bsize = BLOCK_4X4; bsize < BLOCK_SIZES;
+       bsize = static_cast<BLOCK_SIZE>(static_cast<int>(bsize) + 1)) {
+    const int block_width = 4 * num_4x4_blocks_wide_lookup[bsize];
+    const int block_height = 4 * num_4x4_blocks_high_lookup[bsize];
+
+    for (int n = 0; n < 100; n++) {
+      // Unaligned rows, and every other iteration 12 bit extremes.
+      const int offset = n % 8;
+      for (int i = 0; i < 64 * kStride; ++i) {
+        if (n & 1) {
+          src[i] = rnd.Rand16() & 0xfff;
+          pred[i] = rnd.Rand16() & 0xfff;
+        } else {
+          src[i] = (rnd.Rand8() & 1) ? 0xfff : 0;
+          pred[i] = (rnd.Rand8() & 1) ? 0xfff : 0;
+        }
+        ref_diff[i] = diff[i] = rnd.Rand16();
+      }
+
+      vpx_highbd_subtract_block_c(block_height, block_width,
+                                  ref_diff + offset, kStride,
+                                  CONVERT_TO_BYTEPTR(src + offset), kStride,
+                                  CONVERT_TO_BYTEPTR(pred + offset), kStride,
+                                  12);
+      ASM_REGISTER_STATE_CHECK(
+          GetParam()(block_height, block_width, diff + offset, kStride,
+                     CONVERT_TO_BYTEPTR(src + offset), kStride,
+                     CONVERT_TO_BYTEPTR(pred + offset), kStride, 12));
+      ASSERT_EQ(0, memcmp(ref_diff, diff, sizeof(*diff) * 64 * kStride))
+          << "bs = " << bsize << ", offset = " << offset;
+    }
+  }
+  vpx_free(src);
+  vpx_free(pred);
+  vpx_free(ref_diff);
+  vpx_free(diff);
+}
+
+#if HAVE_SSE2
+INSTANTIATE_TEST_CASE_P(SSE2, VP9HighbdSubtractBlockTest,
+                        ::testing::Values(vpx_highbd_subtract_block_sse2));
+#endif
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
 }  // namespace vp9
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "third_party/googletest/src/include/gtest/gtest.h"
+
+#include "test/acm_random.h"
+#include "vp9/common/vp9_onyxc_int.h"
+#include "vp9/encoder/vp9_rd.h"
+#include "vpx_ports/vpx_timer.h"
+
+namespace {
+
+using libvpx_test::ACMRandom;
+
+typedef vp9_coeff_probs_model CoeffProbs[TX_SIZES][PLANE_TYPES];
+
+const int kNumModelProbs =
+    static_cast<int>(sizeof(CoeffProbs) / sizeof(vpx_prob));
+
+// The token cost and model probability tables are too large for the stack.
+class TokenCostTest : public ::testing::Test {
+ protected:
+  TokenCostTest() : rnd_(ACMRandom::DeterministicSeed()) {}
+
+  virtual void SetUp() {
+    costs_ = new vp9_coeff_cost[TX_SIZES];
+    ref_costs_ = new vp9_coeff_cost[TX_SIZES];
+    probs_ = new CoeffProbs[1];
+    last_ = new CoeffProbs[1];
+    ref_last_ = new CoeffProbs[1];
+    memset(costs_, 0, sizeof(vp9_coeff_cost) * TX_SIZES);
+    memset(ref_costs_, 0, sizeof(vp9_coeff_cost) * TX_SIZES);
+    memset(last_, 0, sizeof(CoeffProbs));
+    vpx_prob *const p = &probs_[0][0][0][0][0][0][0];
+    for (int i = 0; i < kNumModelProbs; ++i)
+      p[i] = RandomProb();
+  }
+
+  virtual void TearDown() {
+    delete[] costs_;
+    delete[] ref_costs_;
+    delete[] probs_;
+    delete[] last_;
+    delete[] ref_last_;
+  }
+
+  vpx_prob RandomProb() { return 1 + rnd_(255); }
+
+  // Changes roughly one in |period| model probabilities.
+  void PerturbProbs(int period) {
+    vpx_prob *const p = &probs_[0][0][0][0][0][0][0];
+    for (int i = 0; i < kNumModelProbs; ++i)
+      if (rnd_(period) == 0)
+        p[i] = RandomProb();
+  }
+
+  void FillFromScratch() {
+    memset(ref_last_, 0, sizeof(CoeffProbs));
+    vp9_fill_token_costs(ref_costs_, ref_last_[0], probs_[0]);
+  }
+
+  void FillIncremental() {
+    vp9_fill_token_costs(costs_, last_[0], probs_[0]);
+  }
+
+  ACMRandom rnd_;
+  vp9_coeff_cost *costs_;
+  vp9_coeff_cost *ref_costs_;
+  CoeffProbs *probs_;
+  CoeffProbs *last_;
+  CoeffProbs *ref_last_;
+};
+
+TEST_F(TokenCostTest, IncrementalMatchesFull) {
+  for (int frame = 0; frame < 100; ++frame) {
+    if (frame)
+      PerturbProbs(1 + frame % 40);
+    FillIncremental();
+    FillFromScratch();
+    ASSERT_EQ(0, memcmp(costs_, ref_costs_, sizeof(vp9_coeff_cost) * TX_SIZES))
+        << "frame " << frame;
+  }
+}
+
+TEST_F(TokenCostTest, DISABLED_Speed) {
+  const int kFrames = 10000;
+  // A backward adapted frame typically touches only a small fraction of the
+  // coefficient model probabilities.
+  const int kPeriods[] = { 1, 10, 50 };
+  for (size_t i = 0; i < sizeof(kPeriods) / sizeof(kPeriods[0]); ++i) {
+    vpx_usec_timer full_timer, incremental_timer;
+    int64_t full_time = 0, incremental_time = 0;
+    FillIncremental();
+    for (int frame = 0; frame < kFrames; ++frame) {
+      PerturbProbs(kPeriods[i]);
+      vpx_usec_timer_start(&full_timer);
+      FillFromScratch();
+      vpx_usec_timer_mark(&full_timer);
+      full_time += vpx_usec_timer_elapsed(&full_timer);
+
+      vpx_usec_timer_start(&incremental_timer);
+      FillIncremental();
+      vpx_usec_timer_mark(&incremental_timer);
+      incremental_time += vpx_usec_timer_elapsed(&incremental_timer);
+    }
+    printf("1/%-3d probs changed: full %6.2f us/frame, incremental %6.2f "
+           "us/frame\n", kPeriods[i],
+           static_cast<double>(full_time) / kFrames,
+           static_cast<double>(incremental_time) / kFrames);
+  }
+}
+
+}  // namespace
@@ -8,13 +8,19 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <stdio.h>
+
+#include <algorithm>
+
 #include "third_party/googletest/src/include/gtest/gtest.h"
 
 #include "./vpx_config.h"
 #include "./vpx_scale_rtcd.h"
 #include "test/clear_system_state.h"
 #include "test/register_state_check.h"
+#include "test/util.h"
 #include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/vpx_timer.h"
 #include "vpx_scale/yv12config.h"
 
 namespace {
@@ -29,12 +35,11 @@ class VpxScaleBase {
     libvpx_test::ClearSystemState();
   }
 
-  void ResetImage(int width, int height) {
+  void ResetImage(int width, int height, int border = VP8BORDERINPIXELS) {
     width_ = width;
     height_ = height;
     memset(&img_, 0, sizeof(img_));
-    ASSERT_EQ(0, vp8_yv12_alloc_frame_buffer(&img_, width_, height_,
-                                             VP8BORDERINPIXELS));
+    ASSERT_EQ(0, vp8_yv12_alloc_frame_buffer(&img_, width_, height_, border));
     memset(img_.buffer_alloc, kBufFiller, img_.frame_size);
     FillPlane(img_.y_buffer, img_.y_crop_width, img_.y_crop_height,
               img_.y_stride);
@@ -45,12 +50,12 @@ class VpxScaleBase {
 
     memset(&ref_img_, 0, sizeof(ref_img_));
     ASSERT_EQ(0, vp8_yv12_alloc_frame_buffer(&ref_img_, width_, height_,
-                                             VP8BORDERINPIXELS));
+                                             border));
     memset(ref_img_.buffer_alloc, kBufFiller, ref_img_.frame_size);
 
     memset(&cpy_img_, 0, sizeof(cpy_img_));
     ASSERT_EQ(0, vp8_yv12_alloc_frame_buffer(&cpy_img_, width_, height_,
-                                             VP8BORDERINPIXELS));
+                                             border));
     memset(cpy_img_.buffer_alloc, kBufFiller, cpy_img_.frame_size);
     ReferenceCopyFrame();
   }
@@ -112,27 +117,39 @@ class VpxScaleBase {
   }
 
   void ReferenceExtendBorder() {
+    ReferenceExtendBorder(ref_img_.border);
+  }
+
+  // Extends the borders of ref_img_ by |extension| pixels, which may be less
+  // than the allocated border.
+  void ReferenceExtendBorder(int extension) {
     ExtendPlane(ref_img_.y_buffer,
                 ref_img_.y_crop_width, ref_img_.y_crop_height,
                 ref_img_.y_width, ref_img_.y_height,
                 ref_img_.y_stride,
-                ref_img_.border);
+                extension);
     ExtendPlane(ref_img_.u_buffer,
                 ref_img_.uv_crop_width, ref_img_.uv_crop_height,
                 ref_img_.uv_width, ref_img_.uv_height,
                 ref_img_.uv_stride,
-                ref_img_.border / 2);
+                extension / 2);
     ExtendPlane(ref_img_.v_buffer,
                 ref_img_.uv_crop_width, ref_img_.uv_crop_height,
                 ref_img_.uv_width, ref_img_.uv_height,
                 ref_img_.uv_stride,
-                ref_img_.border / 2);
+                extension / 2);
   }
 
   void ReferenceCopyFrame() {
+    ReferenceCopyFrame(ref_img_.border);
+  }
+
+  void ReferenceCopyFrame(int extension) {
     // Copy img_ to ref_img_ and extend frame borders. This will be used for
-    // verifying extend_fn_ as well as copy_frame_fn_.
+    // verifying extend_fn_ as well as copy_frame_fn_. The part of the border
+    // beyond |extension| keeps the filler.
     EXPECT_EQ(ref_img_.frame_size, img_.frame_size);
+    memset(ref_img_.buffer_alloc, kBufFiller, ref_img_.frame_size);
     for (int y = 0; y < img_.y_crop_height; ++y) {
       for (int x = 0; x < img_.y_crop_width; ++x) {
         ref_img_.y_buffer[x + y * ref_img_.y_stride] =
@@ -149,7 +166,7 @@ class VpxScaleBase {
       }
     }
 
-    ReferenceExtendBorder();
+    ReferenceExtendBorder(extension);
   }
 
   void CompareImages(const YV12_BUFFER_CONFIG actual) {
@@ -165,22 +182,27 @@ class VpxScaleBase {
   int height_;
 };
 
+// The function and whether it only extends the inner VP9INNERBORDERINPIXELS
+// of the border.
+typedef std::tr1::tuple<ExtendFrameBorderFunc, int> ExtendBorderParam;
+
 class ExtendBorderTest
     : public VpxScaleBase,
-      public ::testing::TestWithParam<ExtendFrameBorderFunc> {
+      public ::testing::TestWithParam<ExtendBorderParam> {
  public:
   virtual ~ExtendBorderTest() {}
 
  protected:
   virtual void SetUp() {
-    extend_fn_ = GetParam();
+    extend_fn_ = GET_PARAM(0);
+    inner_ = GET_PARAM(1);
   }
 
   void ExtendBorder() {
     ASM_REGISTER_STATE_CHECK(extend_fn_(&img_));
   }
 
-  void RunTest() {
+  void RunTest(int border) {
 #if ARCH_ARM
     // Some arm devices OOM when trying to allocate the largest buffers.
     static const int kNumSizesToTest = 6;
@@ -188,11 +210,13 @@ class ExtendBorderTest
     static const int kNumSizesToTest = 7;
 #endif
     static const int kSizesToTest[] = {1, 15, 33, 145, 512, 1025, 16383};
+    const int extension =
+        inner_ ? std::min(border, VP9INNERBORDERINPIXELS) : border;
     for (int h = 0; h < kNumSizesToTest; ++h) {
       for (int w = 0; w < kNumSizesToTest; ++w) {
-        ResetImage(kSizesToTest[w], kSizesToTest[h]);
+        ResetImage(kSizesToTest[w], kSizesToTest[h], border);
         ExtendBorder();
-        ReferenceExtendBorder();
+        ReferenceCopyFrame(extension);
         CompareImages(img_);
         DeallocImage();
       }
@@ -200,14 +224,52 @@ class ExtendBorderTest
   }
 
   ExtendFrameBorderFunc extend_fn_;
+  int inner_;
 };
 
 TEST_P(ExtendBorderTest, ExtendBorder) {
-  ASSERT_NO_FATAL_FAILURE(RunTest());
+  ASSERT_NO_FATAL_FAILURE(RunTest(VP8BORDERINPIXELS));
 }
 
+// The encoder border is wider than the inner border, which the inner
+// extension leaves partly untouched.
+TEST_P(ExtendBorderTest, ExtendEncoderBorder) {
+  ASSERT_NO_FATAL_FAILURE(RunTest(VP9_ENC_BORDER_IN_PIXELS));
+}
+
+TEST_P(ExtendBorderTest, DISABLED_Speed) {
+  static const int kNumFrames = 1000;
+  ASSERT_NO_FATAL_FAILURE(ResetImage(1920, 1080, VP9_ENC_BORDER_IN_PIXELS));
+  vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+  for (int i = 0; i < kNumFrames; ++i)
+    extend_fn_(&img_);
+  vpx_usec_timer_mark(&timer);
+  printf("1920x1080, %d pixel border: %6.2f us/frame\n",
+         VP9_ENC_BORDER_IN_PIXELS,
+         static_cast<double>(vpx_usec_timer_elapsed(&timer)) / kNumFrames);
+  DeallocImage();
+}
+
+using std::tr1::make_tuple;
+
+const ExtendBorderParam kExtendBorderFuncs_c[] = {
+  make_tuple(vp8_yv12_extend_frame_borders_c, 0),
+#if CONFIG_VP9 || CONFIG_VP10
+  make_tuple(vpx_extend_frame_borders_c, 0),
+  make_tuple(vpx_extend_frame_inner_borders_c, 1),
+#endif
+};
+
 INSTANTIATE_TEST_CASE_P(C, ExtendBorderTest,
-                        ::testing::Values(vp8_yv12_extend_frame_borders_c));
+                        ::testing::ValuesIn(kExtendBorderFuncs_c));
+
+#if HAVE_AVX2 && (CONFIG_VP9 || CONFIG_VP10)
+INSTANTIATE_TEST_CASE_P(
+    AVX2, ExtendBorderTest,
+    ::testing::Values(make_tuple(vpx_extend_frame_borders_avx2, 0),
+                      make_tuple(vpx_extend_frame_inner_borders_avx2, 1)));
+#endif
 
 class CopyFrameTest
     : public VpxScaleBase,
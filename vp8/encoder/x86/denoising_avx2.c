@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "vp8/encoder/denoising.h"
+#include "vp8/common/reconinter.h"
+#include "vpx/vpx_integer.h"
+#include "vp8_rtcd.h"
+
+#include <immintrin.h>
+
+/* The SSE2 luma filter with two rows per iteration, row r in the low 128 bit
+ * lane and row r + 1 in the high one. Each byte of acc_diff then sums 8 rows
+ * instead of 16, which no more saturates than the SSE2 version does, so the
+ * decisions are the same.
+ */
+
+static INLINE __m256i load_2x16(const unsigned char *p, int stride) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p)),
+      _mm_loadu_si128((const __m128i *)(p + stride)), 1);
+}
+
+static INLINE void store_2x16(unsigned char *p, int stride, __m256i v) {
+  _mm_storeu_si128((__m128i *)p, _mm256_castsi256_si128(v));
+  _mm_storeu_si128((__m128i *)(p + stride), _mm256_extracti128_si256(v, 1));
+}
+
+/* Compute the sum of all pixel differences of this MB. */
+static INLINE unsigned int abs_sum_diff_32x1(__m256i acc_diff) {
+  const __m256i k_1 = _mm256_set1_epi16(1);
+  const __m256i acc_diff_lo = _mm256_srai_epi16(
+      _mm256_unpacklo_epi8(acc_diff, acc_diff), 8);
+  const __m256i acc_diff_hi = _mm256_srai_epi16(
+      _mm256_unpackhi_epi8(acc_diff, acc_diff), 8);
+  const __m256i sum_8 = _mm256_madd_epi16(
+      _mm256_add_epi16(acc_diff_lo, acc_diff_hi), k_1);
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(sum_8),
+                              _mm256_extracti128_si256(sum_8, 1));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+  return abs(_mm_cvtsi128_si32(sum));
+}
+
+int vp8_denoiser_filter_avx2(unsigned char *mc_running_avg_y,
+                             int mc_avg_y_stride,
+                             unsigned char *running_avg_y, int avg_y_stride,
+                             unsigned char *sig, int sig_stride,
+                             unsigned int motion_magnitude,
+                             int increase_denoising)
+{
+    unsigned char *running_avg_y_start = running_avg_y;
+    unsigned char *sig_start = sig;
+    unsigned int sum_diff_thresh;
+    int r;
+    int shift_inc  = (increase_denoising &&
+        motion_magnitude <= MOTION_MAGNITUDE_THRESHOLD) ? 1 : 0;
+    __m256i acc_diff = _mm256_setzero_si256();
+    const __m256i k_0 = _mm256_setzero_si256();
+    const __m256i k_4 = _mm256_set1_epi8(4 + shift_inc);
+    const __m256i k_8 = _mm256_set1_epi8(8);
+    const __m256i k_16 = _mm256_set1_epi8(16);
+    /* Modify each level's adjustment according to motion_magnitude. */
+    const __m256i l3 = _mm256_set1_epi8(
+                       (motion_magnitude <= MOTION_MAGNITUDE_THRESHOLD) ?
+                        7 + shift_inc : 6);
+    /* Difference between level 3 and level 2 is 2. */
+    const __m256i l32 = _mm256_set1_epi8(2);
+    /* Difference between level 2 and level 1 is 1. */
+    const __m256i l21 = _mm256_set1_epi8(1);
+
+    for (r = 0; r < 16; r += 2)
+    {
+        /* Calculate differences */
+        const __m256i v_sig = load_2x16(sig, sig_stride);
+        const __m256i v_mc_running_avg_y = load_2x16(mc_running_avg_y,
+                                                     mc_avg_y_stride);
+        const __m256i pdiff = _mm256_subs_epu8(v_mc_running_avg_y, v_sig);
+        const __m256i ndiff = _mm256_subs_epu8(v_sig, v_mc_running_avg_y);
+        /* Obtain the sign. FF if diff is negative. */
+        const __m256i diff_sign = _mm256_cmpeq_epi8(pdiff, k_0);
+        /* Clamp absolute difference to 16 to be used to get mask. */
+        const __m256i clamped_absdiff = _mm256_min_epu8(
+                                        _mm256_or_si256(pdiff, ndiff), k_16);
+        /* Get masks for l2 l1 and l0 adjustments */
+        const __m256i mask2 = _mm256_cmpgt_epi8(k_16, clamped_absdiff);
+        const __m256i mask1 = _mm256_cmpgt_epi8(k_8, clamped_absdiff);
+        const __m256i mask0 = _mm256_cmpgt_epi8(k_4, clamped_absdiff);
+        /* Combine the adjustments for l2, l1 and l0 and get absolute
+         * adjustments.
+         */
+        const __m256i adj2 = _mm256_add_epi8(_mm256_and_si256(mask2, l32),
+                                             _mm256_and_si256(mask1, l21));
+        const __m256i adj = _mm256_or_si256(
+            _mm256_andnot_si256(mask0, _mm256_sub_epi8(l3, adj2)),
+            _mm256_and_si256(mask0, clamped_absdiff));
+        /* Restore the sign and get positive and negative adjustments. */
+        const __m256i padj = _mm256_andnot_si256(diff_sign, adj);
+        const __m256i nadj = _mm256_and_si256(diff_sign, adj);
+
+        /* Calculate filtered value. */
+        store_2x16(running_avg_y, avg_y_stride,
+                   _mm256_subs_epu8(_mm256_adds_epu8(v_sig, padj), nadj));
+
+        /* Adjustments <=7, and each element in acc_diff can fit in signed
+         * char.
+         */
+        acc_diff = _mm256_adds_epi8(acc_diff, padj);
+        acc_diff = _mm256_subs_epi8(acc_diff, nadj);
+
+        /* Update pointers for next iteration. */
+        sig += 2 * sig_stride;
+        mc_running_avg_y += 2 * mc_avg_y_stride;
+        running_avg_y += 2 * avg_y_stride;
+    }
+
+    {
+        /* Compute the sum of all pixel differences of this MB. */
+        unsigned int abs_sum_diff = abs_sum_diff_32x1(acc_diff);
+        sum_diff_thresh = SUM_DIFF_THRESHOLD;
+        if (increase_denoising) sum_diff_thresh = SUM_DIFF_THRESHOLD_HIGH;
+        if (abs_sum_diff > sum_diff_thresh) {
+          /* See vp8_denoiser_filter_sse2() for the weaker filter applied
+           * here.
+           */
+          int delta = ((abs_sum_diff - sum_diff_thresh) >> 8) + 1;
+          /* Only apply the adjustment for max delta up to 3. */
+          if (delta < 4) {
+            const __m256i k_delta = _mm256_set1_epi8(delta);
+            sig -= sig_stride * 16;
+            mc_running_avg_y -= mc_avg_y_stride * 16;
+            running_avg_y -= avg_y_stride * 16;
+            for (r = 0; r < 16; r += 2) {
+              const __m256i v_running_avg_y = load_2x16(running_avg_y,
+                                                        avg_y_stride);
+              const __m256i v_sig = load_2x16(sig, sig_stride);
+              const __m256i v_mc_running_avg_y =
+                  load_2x16(mc_running_avg_y, mc_avg_y_stride);
+              const __m256i pdiff = _mm256_subs_epu8(v_mc_running_avg_y,
+                                                     v_sig);
+              const __m256i ndiff = _mm256_subs_epu8(v_sig,
+                                                     v_mc_running_avg_y);
+              /* Obtain the sign. FF if diff is negative. */
+              const __m256i diff_sign = _mm256_cmpeq_epi8(pdiff, k_0);
+              /* Clamp absolute difference to delta to get the adjustment. */
+              const __m256i adj =
+                  _mm256_min_epu8(_mm256_or_si256(pdiff, ndiff), k_delta);
+              /* Restore the sign and get positive and negative
+               * adjustments.
+               */
+              const __m256i padj = _mm256_andnot_si256(diff_sign, adj);
+              const __m256i nadj = _mm256_and_si256(diff_sign, adj);
+
+              /* Calculate filtered value. */
+              store_2x16(running_avg_y, avg_y_stride,
+                         _mm256_adds_epu8(
+                             _mm256_subs_epu8(v_running_avg_y, padj), nadj));
+
+              /* Accumulate the adjustments. */
+              acc_diff = _mm256_subs_epi8(acc_diff, padj);
+              acc_diff = _mm256_adds_epi8(acc_diff, nadj);
+
+              /* Update pointers for next iteration. */
+              sig += 2 * sig_stride;
+              mc_running_avg_y += 2 * mc_avg_y_stride;
+              running_avg_y += 2 * avg_y_stride;
+            }
+            abs_sum_diff = abs_sum_diff_32x1(acc_diff);
+            if (abs_sum_diff > sum_diff_thresh) {
+              return COPY_BLOCK;
+            }
+          } else {
+            return COPY_BLOCK;
+          }
+        }
+    }
+
+    vp8_copy_mem16x16(running_avg_y_start, avg_y_stride, sig_start, sig_stride);
+    return FILTER_BLOCK;
+}
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h> /* AVX2 */
+
+#include "./vp8_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+/* The modifier is computed in 32 bits, one pixel per lane, so unlike the
+ * SSE2 version this matches the C code for any difference and strength.
+ */
+void vp8_temporal_filter_apply_avx2(unsigned char *frame1, unsigned int stride,
+                                    unsigned char *frame2,
+                                    unsigned int block_size, int strength,
+                                    int filter_weight,
+                                    unsigned int *accumulator,
+                                    unsigned short *count) {
+  const __m256i rounding =
+      _mm256_set1_epi32(strength > 0 ? 1 << (strength - 1) : 0);
+  const __m128i shift = _mm_cvtsi32_si128(strength);
+  const __m256i weight = _mm256_set1_epi32(filter_weight);
+  const __m256i sixteen = _mm256_set1_epi32(16);
+  unsigned int i, j;
+
+  for (i = 0; i < block_size; ++i) {
+    for (j = 0; j < block_size; j += 8) {
+      const __m128i a = _mm_loadl_epi64((const __m128i *)(frame1 + j));
+      const __m128i b = _mm_loadl_epi64((const __m128i *)frame2);
+      const __m256i abs_diff = _mm256_cvtepu8_epi32(
+          _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a)));
+      const __m256i pixel = _mm256_cvtepu8_epi32(b);
+      /* The high 16 bits of each lane are clear, so madd_epi16 multiplies. */
+      __m256i modifier = _mm256_madd_epi16(
+          abs_diff,
+          _mm256_add_epi32(abs_diff, _mm256_add_epi32(abs_diff, abs_diff)));
+      __m128i count_8;
+
+      modifier = _mm256_srl_epi32(_mm256_add_epi32(modifier, rounding), shift);
+      modifier = _mm256_sub_epi32(sixteen, _mm256_min_epu32(modifier, sixteen));
+      modifier = _mm256_madd_epi16(modifier, weight);
+
+      count_8 = _mm_add_epi16(
+          _mm_loadu_si128((const __m128i *)count),
+          _mm_packus_epi32(_mm256_castsi256_si128(modifier),
+                           _mm256_extracti128_si256(modifier, 1)));
+      _mm_storeu_si128((__m128i *)count, count_8);
+      _mm256_storeu_si256(
+          (__m256i *)accumulator,
+          _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)accumulator),
+                           _mm256_madd_epi16(modifier, pixel)));
+
+      frame2 += 8;
+      accumulator += 8;
+      count += 8;
+    }
+    frame1 += stride;
+  }
+}
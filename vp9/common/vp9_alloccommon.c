@@ -103,6 +103,9 @@ void vp9_free_postproc_buffers(VP9_COMMON *cm) {
 #if CONFIG_VP9_POSTPROC
   vpx_free_frame_buffer(&cm->post_proc_buffer);
   vpx_free_frame_buffer(&cm->post_proc_buffer_int);
+  vpx_free(cm->postproc_state.bands);
+  cm->postproc_state.bands = NULL;
+  cm->postproc_state.num_bands = 0;
 #else
   (void)cm;
 #endif
@@ -125,9 +125,9 @@ static void copy_mem64x64(const uint8_t *src, int src_stride,
   copy_mem32x32(src, src_stride, dst, dst_stride);
   copy_mem32x32(src + 32, src_stride, dst + 32, dst_stride);
   copy_mem32x32(src + src_stride * 32, src_stride,
-                dst + src_stride * 32, dst_stride);
+                dst + dst_stride * 32, dst_stride);
   copy_mem32x32(src + src_stride * 32 + 32, src_stride,
-                dst + src_stride * 32 + 32, dst_stride);
+                dst + dst_stride * 32 + 32, dst_stride);
 }
 
 static void copy_block(const uint8_t *y, const uint8_t *u, const uint8_t *v,
@@ -165,20 +165,26 @@ static void mfqe_block(BLOCK_SIZE bs, const uint8_t *y, const uint8_t *u,
                        const uint8_t *v, int y_stride, int uv_stride,
                        uint8_t *yd, uint8_t *ud, uint8_t *vd, int yd_stride,
                        int uvd_stride, int qdiff) {
-  int sad, sad_thr, vdiff, vdiff_thr;
+  int sad, sad_thr, vdiff = 0, vdiff_thr;
   uint32_t sse;
 
   get_thr(bs, qdiff, &sad_thr, &vdiff_thr);
 
+  // The variance is only needed when the blocks differ, which in static
+  // areas they mostly do not.
   if (bs == BLOCK_16X16) {
-    vdiff = (vpx_variance16x16(y, y_stride, yd, yd_stride, &sse) + 128) >> 8;
     sad = (vpx_sad16x16(y, y_stride, yd, yd_stride) + 128) >> 8;
+    if (sad > 1)
+      vdiff = (vpx_variance16x16(y, y_stride, yd, yd_stride, &sse) + 128) >> 8;
   } else if (bs == BLOCK_32X32) {
-    vdiff = (vpx_variance32x32(y, y_stride, yd, yd_stride, &sse) + 512) >> 10;
     sad = (vpx_sad32x32(y, y_stride, yd, yd_stride) + 512) >> 10;
+    if (sad > 1)
+      vdiff = (vpx_variance32x32(y, y_stride, yd, yd_stride, &sse) + 512) >> 10;
   } else /* if (bs == BLOCK_64X64) */ {
-    vdiff = (vpx_variance64x64(y, y_stride, yd, yd_stride, &sse) + 2048) >> 12;
     sad = (vpx_sad64x64(y, y_stride, yd, yd_stride) + 2048) >> 12;
+    if (sad > 1)
+      vdiff = (vpx_variance64x64(y, y_stride, yd, yd_stride, &sse) + 2048)
+              >> 12;
   }
 
   // vdiff > sad * 3 means vdiff should not be too small, otherwise,
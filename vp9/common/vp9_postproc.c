@@ -93,7 +93,6 @@ void vp9_post_proc_down_and_across_c(const uint8_t *src_ptr,
   int row, col, i, v, kernel;
   int pitch = src_pixels_per_line;
   uint8_t d[8];
-  (void)dst_pixels_per_line;
 
   for (row = 0; row < rows; row++) {
     /* post_proc_down for one row */
@@ -150,7 +149,7 @@ void vp9_post_proc_down_and_across_c(const uint8_t *src_ptr,
 
     /* next row */
     src_ptr += pitch;
-    dst_ptr += pitch;
+    dst_ptr += dst_pixels_per_line;
   }
 }
 
@@ -265,7 +264,8 @@ void vp9_mbpost_proc_across_ip_c(uint8_t *src, int pitch,
         d[c & 15] = (8 + sum + s[c]) >> 4;
       }
 
-      s[c - 8] = d[(c - 8) & 15];
+      if (c >= 8)
+        s[c - 8] = d[(c - 8) & 15];
     }
     s += pitch;
   }
@@ -303,7 +303,8 @@ void vp9_highbd_mbpost_proc_across_ip_c(uint16_t *src, int pitch,
         d[c & 15] = (8 + sum + s[c]) >> 4;
       }
 
-      s[c - 8] = d[(c - 8) & 15];
+      if (c >= 8)
+        s[c - 8] = d[(c - 8) & 15];
     }
 
     s += pitch;
@@ -311,17 +312,19 @@ void vp9_highbd_mbpost_proc_across_ip_c(uint16_t *src, int pitch,
 }
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
+// The dither of column c is taken from vp9_rv[(r & 127) + (c & 7)], as in the
+// SIMD versions, rather than from rand(). The output then does not depend on
+// how the columns are split across threads.
 void vp9_mbpost_proc_down_c(uint8_t *dst, int pitch,
                             int rows, int cols, int flimit) {
   int r, c, i;
-  const short *rv3 = &vp9_rv[63 & rand()]; // NOLINT
 
   for (c = 0; c < cols; c++) {
     uint8_t *s = &dst[c];
     int sumsq = 0;
     int sum   = 0;
     uint8_t d[16];
-    const int16_t *rv2 = rv3 + ((c * 17) & 127);
+    const int16_t *rv2 = &vp9_rv[c & 7];
 
     for (i = -8; i <= 6; i++) {
       sumsq += s[i * pitch] * s[i * pitch];
@@ -337,7 +340,8 @@ void vp9_mbpost_proc_down_c(uint8_t *dst, int pitch,
         d[r & 15] = (rv2[r & 127] + sum + s[0]) >> 4;
       }
 
-      s[-8 * pitch] = d[(r - 8) & 15];
+      if (r >= 8)
+        s[-8 * pitch] = d[(r - 8) & 15];
       s += pitch;
     }
   }
@@ -347,14 +351,13 @@ void vp9_mbpost_proc_down_c(uint8_t *dst, int pitch,
 void vp9_highbd_mbpost_proc_down_c(uint16_t *dst, int pitch,
                                    int rows, int cols, int flimit) {
   int r, c, i;
-  const int16_t *rv3 = &vp9_rv[63 & rand()];  // NOLINT
 
   for (c = 0; c < cols; c++) {
     uint16_t *s = &dst[c];
     int sumsq = 0;
     int sum = 0;
     uint16_t d[16];
-    const int16_t *rv2 = rv3 + ((c * 17) & 127);
+    const int16_t *rv2 = &vp9_rv[c & 7];
 
     for (i = -8; i <= 6; i++) {
       sumsq += s[i * pitch] * s[i * pitch];
@@ -370,91 +373,28 @@ void vp9_highbd_mbpost_proc_down_c(uint16_t *dst, int pitch,
         d[r & 15] = (rv2[r & 127] + sum + s[0]) >> 4;
       }
 
-      s[-8 * pitch] = d[(r - 8) & 15];
+      if (r >= 8)
+        s[-8 * pitch] = d[(r - 8) & 15];
       s += pitch;
     }
   }
 }
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
-static void deblock_and_de_macro_block(YV12_BUFFER_CONFIG   *source,
-                                       YV12_BUFFER_CONFIG   *post,
-                                       int                   q,
-                                       int                   low_var_thresh,
-                                       int                   flag) {
-  double level = 6.0e-05 * q * q * q - .0067 * q * q + .306 * q + .0065;
-  int ppl = (int)(level + .5);
-  (void) low_var_thresh;
-  (void) flag;
-
-#if CONFIG_VP9_HIGHBITDEPTH
-  if (source->flags & YV12_FLAG_HIGHBITDEPTH) {
-    vp9_highbd_post_proc_down_and_across(CONVERT_TO_SHORTPTR(source->y_buffer),
-                                         CONVERT_TO_SHORTPTR(post->y_buffer),
-                                         source->y_stride, post->y_stride,
-                                         source->y_height, source->y_width,
-                                         ppl);
-
-    vp9_highbd_mbpost_proc_across_ip(CONVERT_TO_SHORTPTR(post->y_buffer),
-                                     post->y_stride, post->y_height,
-                                     post->y_width, q2mbl(q));
-
-    vp9_highbd_mbpost_proc_down(CONVERT_TO_SHORTPTR(post->y_buffer),
-                                post->y_stride, post->y_height,
-                                post->y_width, q2mbl(q));
-
-    vp9_highbd_post_proc_down_and_across(CONVERT_TO_SHORTPTR(source->u_buffer),
-                                         CONVERT_TO_SHORTPTR(post->u_buffer),
-                                         source->uv_stride, post->uv_stride,
-                                         source->uv_height, source->uv_width,
-                                         ppl);
-    vp9_highbd_post_proc_down_and_across(CONVERT_TO_SHORTPTR(source->v_buffer),
-                                         CONVERT_TO_SHORTPTR(post->v_buffer),
-                                         source->uv_stride, post->uv_stride,
-                                         source->uv_height, source->uv_width,
-                                         ppl);
-  } else {
-    vp9_post_proc_down_and_across(source->y_buffer, post->y_buffer,
-                                  source->y_stride, post->y_stride,
-                                  source->y_height, source->y_width, ppl);
-
-    vp9_mbpost_proc_across_ip(post->y_buffer, post->y_stride, post->y_height,
-                              post->y_width, q2mbl(q));
-
-    vp9_mbpost_proc_down(post->y_buffer, post->y_stride, post->y_height,
-                         post->y_width, q2mbl(q));
-
-    vp9_post_proc_down_and_across(source->u_buffer, post->u_buffer,
-                                  source->uv_stride, post->uv_stride,
-                                  source->uv_height, source->uv_width, ppl);
-    vp9_post_proc_down_and_across(source->v_buffer, post->v_buffer,
-                                  source->uv_stride, post->uv_stride,
-                                  source->uv_height, source->uv_width, ppl);
-  }
-#else
-  vp9_post_proc_down_and_across(source->y_buffer, post->y_buffer,
-                                source->y_stride, post->y_stride,
-                                source->y_height, source->y_width, ppl);
-
-  vp9_mbpost_proc_across_ip(post->y_buffer, post->y_stride, post->y_height,
-                            post->y_width, q2mbl(q));
-
-  vp9_mbpost_proc_down(post->y_buffer, post->y_stride, post->y_height,
-                       post->y_width, q2mbl(q));
-
-  vp9_post_proc_down_and_across(source->u_buffer, post->u_buffer,
-                                source->uv_stride, post->uv_stride,
-                                source->uv_height, source->uv_width, ppl);
-  vp9_post_proc_down_and_across(source->v_buffer, post->v_buffer,
-                                source->uv_stride, post->uv_stride,
-                                source->uv_height, source->uv_width, ppl);
-#endif  // CONFIG_VP9_HIGHBITDEPTH
-}
-
-void vp9_deblock(const YV12_BUFFER_CONFIG *src, YV12_BUFFER_CONFIG *dst,
-                 int q) {
-  const int ppl = (int)(6.0e-05 * q * q * q - 0.0067 * q * q + 0.306 * q
-                        + 0.0065 + 0.5);
+// The rows [start, stop) of the luma plane, and the matching chroma rows, or
+// for vp9_mbpost_proc_down() the luma columns [start, stop).
+typedef struct PostProcBand {
+  const YV12_BUFFER_CONFIG *src;
+  YV12_BUFFER_CONFIG *dst;
+  int ppl;
+  int mbl;  // 0 to deblock only.
+  int start;
+  int stop;
+} PostProcBand;
+
+static int deblock_rows_worker(PostProcBand *const band, void *unused) {
+  const YV12_BUFFER_CONFIG *const src = band->src;
+  YV12_BUFFER_CONFIG *const dst = band->dst;
   int i;
 
   const uint8_t *const srcs[3] = {src->y_buffer, src->u_buffer, src->v_buffer};
@@ -464,33 +404,165 @@ void vp9_deblock(const YV12_BUFFER_CONFIG *src, YV12_BUFFER_CONFIG *dst,
 
   uint8_t *const dsts[3] = {dst->y_buffer, dst->u_buffer, dst->v_buffer};
   const int dst_strides[3] = {dst->y_stride, dst->uv_stride, dst->uv_stride};
+  (void)unused;
 
   for (i = 0; i < MAX_MB_PLANE; ++i) {
+    const int ss_y = i ? src->subsampling_y : 0;
+    const int row = band->start >> ss_y;
+    const int stop = band->stop == src->y_height ? src_heights[i]
+                                                 : band->stop >> ss_y;
 #if CONFIG_VP9_HIGHBITDEPTH
     assert((src->flags & YV12_FLAG_HIGHBITDEPTH) ==
            (dst->flags & YV12_FLAG_HIGHBITDEPTH));
     if (src->flags & YV12_FLAG_HIGHBITDEPTH) {
-      vp9_highbd_post_proc_down_and_across(CONVERT_TO_SHORTPTR(srcs[i]),
-                                           CONVERT_TO_SHORTPTR(dsts[i]),
-                                           src_strides[i], dst_strides[i],
-                                           src_heights[i], src_widths[i], ppl);
+      vp9_highbd_post_proc_down_and_across(
+          CONVERT_TO_SHORTPTR(srcs[i]) + row * src_strides[i],
+          CONVERT_TO_SHORTPTR(dsts[i]) + row * dst_strides[i],
+          src_strides[i], dst_strides[i], stop - row, src_widths[i],
+          band->ppl);
     } else {
-      vp9_post_proc_down_and_across(srcs[i], dsts[i],
+      vp9_post_proc_down_and_across(srcs[i] + row * src_strides[i],
+                                    dsts[i] + row * dst_strides[i],
                                     src_strides[i], dst_strides[i],
-                                    src_heights[i], src_widths[i], ppl);
+                                    stop - row, src_widths[i], band->ppl);
     }
 #else
-    vp9_post_proc_down_and_across(srcs[i], dsts[i],
+    vp9_post_proc_down_and_across(srcs[i] + row * src_strides[i],
+                                  dsts[i] + row * dst_strides[i],
                                   src_strides[i], dst_strides[i],
-                                  src_heights[i], src_widths[i], ppl);
+                                  stop - row, src_widths[i], band->ppl);
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  }
+
+  // The source of MFQE may have more rows than the destination.
+  if (band->mbl && band->start < dst->y_height) {
+    const int rows = VPXMIN(band->stop, dst->y_height) - band->start;
+#if CONFIG_VP9_HIGHBITDEPTH
+    if (dst->flags & YV12_FLAG_HIGHBITDEPTH) {
+      vp9_highbd_mbpost_proc_across_ip(
+          CONVERT_TO_SHORTPTR(dst->y_buffer) + band->start * dst->y_stride,
+          dst->y_stride, rows, dst->y_width, band->mbl);
+    } else {
+      vp9_mbpost_proc_across_ip(dst->y_buffer + band->start * dst->y_stride,
+                                dst->y_stride, rows, dst->y_width, band->mbl);
+    }
+#else
+    vp9_mbpost_proc_across_ip(dst->y_buffer + band->start * dst->y_stride,
+                              dst->y_stride, rows, dst->y_width, band->mbl);
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  }
+  return 1;
+}
+
+static int mbpost_proc_down_worker(PostProcBand *const band, void *unused) {
+  YV12_BUFFER_CONFIG *const dst = band->dst;
+  (void)unused;
+
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (dst->flags & YV12_FLAG_HIGHBITDEPTH) {
+    vp9_highbd_mbpost_proc_down(CONVERT_TO_SHORTPTR(dst->y_buffer) +
+                                    band->start,
+                                dst->y_stride, dst->y_height,
+                                band->stop - band->start, band->mbl);
+  } else {
+    vp9_mbpost_proc_down(dst->y_buffer + band->start, dst->y_stride,
+                         dst->y_height, band->stop - band->start, band->mbl);
+  }
+#else
+  vp9_mbpost_proc_down(dst->y_buffer + band->start, dst->y_stride,
+                       dst->y_height, band->stop - band->start, band->mbl);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
+  return 1;
+}
+
+// Splits [0, size) into bands of multiples of |align| across the workers and
+// runs |hook| on each of them. Returns 0, having run nothing, if the band data
+// can not be allocated. This runs outside of any setjmp() of cm->error.
+static int run_bands(VP9_COMMON *cm, VPxWorker *workers, int num_workers,
+                     VPxWorkerHook hook, const PostProcBand *band, int size,
+                     int align) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  struct postproc_state *const ppstate = &cm->postproc_state;
+  const int units = (size + align - 1) / align;
+  const int n = VPXMIN(num_workers, units);
+  int i;
+
+  if (n > ppstate->num_bands) {
+    vpx_free(ppstate->bands);
+    ppstate->bands = (PostProcBand *)vpx_calloc(n, sizeof(*ppstate->bands));
+    ppstate->num_bands = ppstate->bands != NULL ? n : 0;
+    if (ppstate->bands == NULL)
+      return 0;
+  }
+
+  for (i = 0; i < n; ++i) {
+    VPxWorker *const worker = &workers[i];
+    PostProcBand *const data = &ppstate->bands[i];
+
+    *data = *band;
+    data->start = VPXMIN(units * i / n * align, size);
+    data->stop = VPXMIN(units * (i + 1) / n * align, size);
+    worker->hook = hook;
+    worker->data1 = data;
+    worker->data2 = NULL;
+
+    if (i == n - 1) {
+      winterface->execute(worker);
+    } else {
+      winterface->launch(worker);
+    }
   }
+
+  for (i = 0; i < n; ++i) {
+    winterface->sync(&workers[i]);
+  }
+  return 1;
+}
+
+// vp9_mbpost_proc_down() reads the deblocked rows above and below, so it runs
+// once all the bands of rows are done. Either pass falls back to a single
+// band on the calling thread if the bands can not be set up.
+static void deblock_frame(VP9_COMMON *cm, const YV12_BUFFER_CONFIG *src,
+                          YV12_BUFFER_CONFIG *dst, int ppl, int mbl,
+                          VPxWorker *workers, int num_workers) {
+  PostProcBand band;
+
+  band.src = src;
+  band.dst = dst;
+  band.ppl = ppl;
+  band.mbl = mbl;
+
+  band.start = 0;
+
+  if (num_workers <= 1 ||
+      !run_bands(cm, workers, num_workers, (VPxWorkerHook)deblock_rows_worker,
+                 &band, src->y_height, 16)) {
+    band.stop = src->y_height;
+    deblock_rows_worker(&band, NULL);
+  }
+  if (mbl &&
+      (num_workers <= 1 ||
+       !run_bands(cm, workers, num_workers,
+                  (VPxWorkerHook)mbpost_proc_down_worker, &band, dst->y_width,
+                  16))) {
+    band.stop = dst->y_width;
+    mbpost_proc_down_worker(&band, NULL);
+  }
+}
+
+static int q2ppl(int q) {
+  return (int)(6.0e-05 * q * q * q - 0.0067 * q * q + 0.306 * q + 0.0065 +
+               0.5);
+}
+
+void vp9_deblock(const YV12_BUFFER_CONFIG *src, YV12_BUFFER_CONFIG *dst,
+                 int q) {
+  deblock_frame(NULL, src, dst, q2ppl(q), 0, NULL, 0);
 }
 
 void vp9_denoise(const YV12_BUFFER_CONFIG *src, YV12_BUFFER_CONFIG *dst,
                  int q) {
-  const int ppl = (int)(6.0e-05 * q * q * q - 0.0067 * q * q + 0.306 * q
-                        + 0.0065 + 0.5);
+  const int ppl = q2ppl(q);
   int i;
 
   const uint8_t *const srcs[3] = {src->y_buffer, src->u_buffer, src->v_buffer};
@@ -625,8 +697,10 @@ static void swap_mi_and_prev_mi(VP9_COMMON *cm) {
 }
 
 int vp9_post_proc_frame(struct VP9Common *cm,
-                        YV12_BUFFER_CONFIG *dest, vp9_ppflags_t *ppflags) {
+                        YV12_BUFFER_CONFIG *dest, vp9_ppflags_t *ppflags,
+                        VPxWorker *workers, int num_workers) {
   const int q = VPXMIN(105, cm->lf.filter_level * 2);
+  const int mb_q = q + (ppflags->deblocking_level - 5) * 10;
   const int flags = ppflags->post_proc_flag;
   YV12_BUFFER_CONFIG *const ppbuf = &cm->post_proc_buffer;
   struct postproc_state *const ppstate = &cm->postproc_state;
@@ -700,19 +774,20 @@ int vp9_post_proc_frame(struct VP9Common *cm,
       vp8_yv12_copy_frame(ppbuf, &cm->post_proc_buffer_int);
     }
     if ((flags & VP9D_DEMACROBLOCK) && cm->post_proc_buffer_int.buffer_alloc) {
-      deblock_and_de_macro_block(&cm->post_proc_buffer_int, ppbuf,
-                                 q + (ppflags->deblocking_level - 5) * 10,
-                                 1, 0);
+      deblock_frame(cm, &cm->post_proc_buffer_int, ppbuf, q2ppl(mb_q),
+                    q2mbl(mb_q), workers, num_workers);
     } else if (flags & VP9D_DEBLOCK) {
-      vp9_deblock(&cm->post_proc_buffer_int, ppbuf, q);
+      deblock_frame(cm, &cm->post_proc_buffer_int, ppbuf, q2ppl(q), 0,
+                    workers, num_workers);
     } else {
       vp8_yv12_copy_frame(&cm->post_proc_buffer_int, ppbuf);
     }
   } else if (flags & VP9D_DEMACROBLOCK) {
-    deblock_and_de_macro_block(cm->frame_to_show, ppbuf,
-                               q + (ppflags->deblocking_level - 5) * 10, 1, 0);
+    deblock_frame(cm, cm->frame_to_show, ppbuf, q2ppl(mb_q), q2mbl(mb_q),
+                  workers, num_workers);
   } else if (flags & VP9D_DEBLOCK) {
-    vp9_deblock(cm->frame_to_show, ppbuf, q);
+    deblock_frame(cm, cm->frame_to_show, ppbuf, q2ppl(q), 0, workers,
+                  num_workers);
   } else {
     vp8_yv12_copy_frame(cm->frame_to_show, ppbuf);
   }
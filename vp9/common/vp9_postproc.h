@@ -14,6 +14,7 @@
 
 #include "vpx_ports/mem.h"
 #include "vpx_scale/yv12config.h"
+#include "vpx_util/vpx_thread.h"
 #include "vp9/common/vp9_blockd.h"
 #include "vp9/common/vp9_mfqe.h"
 #include "vp9/common/vp9_ppflags.h"
@@ -22,6 +23,8 @@
 extern "C" {
 #endif
 
+struct PostProcBand;
+
 struct postproc_state {
   int last_q;
   int last_noise;
@@ -30,6 +33,9 @@ struct postproc_state {
   int last_frame_valid;
   MODE_INFO *prev_mip;
   MODE_INFO *prev_mi;
+  // Per worker data for threaded post-processing.
+  struct PostProcBand *bands;
+  int num_bands;
   DECLARE_ALIGNED(16, char, blackclamp[16]);
   DECLARE_ALIGNED(16, char, whiteclamp[16]);
   DECLARE_ALIGNED(16, char, bothclamp[16]);
@@ -39,8 +45,13 @@ struct VP9Common;
 
 #define MFQE_PRECISION 4
 
+extern const int16_t vp9_rv[];
+
+// Deblocking and demacroblocking are split into bands of rows, and of
+// columns, across |workers| when num_workers > 1. The workers must be idle.
 int vp9_post_proc_frame(struct VP9Common *cm,
-                        YV12_BUFFER_CONFIG *dest, vp9_ppflags_t *flags);
+                        YV12_BUFFER_CONFIG *dest, vp9_ppflags_t *flags,
+                        VPxWorker *workers, int num_workers);
 
 void vp9_denoise(const YV12_BUFFER_CONFIG *src, YV12_BUFFER_CONFIG *dst, int q);
 
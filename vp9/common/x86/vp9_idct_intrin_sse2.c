@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include "./vp9_rtcd.h"
+#include "vp9/common/vp9_enums.h"
 #include "vpx_dsp/x86/inv_txfm_sse2.h"
 #include "vpx_dsp/x86/txfm_common_sse2.h"
 #include "vpx_ports/mem.h"
@@ -178,3 +180,157 @@ void vp9_iht16x16_256_add_sse2(const tran_low_t *input, uint8_t *dest,
   dest += 8;
   write_buffer_8x16(dest, in1, stride);
 }
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// The 8-bit transforms above give exact results for high bitdepth input as
+// long as no intermediate value overflows 16 bits. This holds when the input
+// of each pass is within the limits below, which are the smaller of the idct
+// and iadst limits found by searching the extreme inputs. Other blocks are
+// handed to the C code.
+#define HIGHBD_IHT4_LIMIT 10922
+#define HIGHBD_IHT8_LIMIT 6198
+#define HIGHBD_IHT16_LIMIT 3152
+
+// Packs 8 coefficients to 16 bits. The saturation keeps out of range
+// coefficients out of range for highbd_in_range().
+static INLINE __m128i highbd_load_input(const tran_low_t *input) {
+  return _mm_packs_epi32(_mm_loadu_si128((const __m128i *)input),
+                         _mm_loadu_si128((const __m128i *)(input + 4)));
+}
+
+static INLINE int highbd_in_range(const __m128i *in, int n, int limit) {
+  const __m128i max = _mm_set1_epi16(limit);
+  const __m128i min = _mm_set1_epi16(-limit);
+  __m128i hi = in[0];
+  __m128i lo = in[0];
+  int i;
+
+  for (i = 1; i < n; i++) {
+    hi = _mm_max_epi16(hi, in[i]);
+    lo = _mm_min_epi16(lo, in[i]);
+  }
+  return !_mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi16(hi, max),
+                                         _mm_cmplt_epi16(lo, min)));
+}
+
+// Rounds the residual |in| by |shift| bits, adds it to the pixels |d| and
+// clamps the result to |bd| bits.
+static INLINE __m128i highbd_recon(__m128i d, __m128i in, int shift, int bd) {
+  const __m128i rounding = _mm_set1_epi16(1 << (shift - 1));
+  const __m128i max = _mm_set1_epi16((1 << bd) - 1);
+  in = _mm_sra_epi16(_mm_add_epi16(in, rounding), _mm_cvtsi32_si128(shift));
+  d = _mm_add_epi16(d, in);
+  return _mm_min_epi16(_mm_max_epi16(d, _mm_setzero_si128()), max);
+}
+
+void vp9_highbd_iht4x4_16_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                   int stride, int tx_type, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  __m128i in[2], d0, d2;
+
+  in[0] = highbd_load_input(input);
+  in[1] = highbd_load_input(input + 8);
+  if (!highbd_in_range(in, 2, HIGHBD_IHT4_LIMIT)) {
+    vp9_highbd_iht4x4_16_add_c(input, dest8, stride, tx_type, bd);
+    return;
+  }
+
+  if (tx_type == DCT_DCT || tx_type == ADST_DCT)
+    idct4_sse2(in);
+  else
+    iadst4_sse2(in);
+  if (!highbd_in_range(in, 2, HIGHBD_IHT4_LIMIT)) {
+    vp9_highbd_iht4x4_16_add_c(input, dest8, stride, tx_type, bd);
+    return;
+  }
+  if (tx_type == DCT_DCT || tx_type == DCT_ADST)
+    idct4_sse2(in);
+  else
+    iadst4_sse2(in);
+
+  d0 = _mm_unpacklo_epi64(
+      _mm_loadl_epi64((const __m128i *)dest),
+      _mm_loadl_epi64((const __m128i *)(dest + stride)));
+  d2 = _mm_unpacklo_epi64(
+      _mm_loadl_epi64((const __m128i *)(dest + stride * 2)),
+      _mm_loadl_epi64((const __m128i *)(dest + stride * 3)));
+  d0 = highbd_recon(d0, in[0], 4, bd);
+  d2 = highbd_recon(d2, in[1], 4, bd);
+  _mm_storel_epi64((__m128i *)dest, d0);
+  _mm_storel_epi64((__m128i *)(dest + stride), _mm_srli_si128(d0, 8));
+  _mm_storel_epi64((__m128i *)(dest + stride * 2), d2);
+  _mm_storel_epi64((__m128i *)(dest + stride * 3), _mm_srli_si128(d2, 8));
+}
+
+void vp9_highbd_iht8x8_64_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                   int stride, int tx_type, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  __m128i in[8];
+  int i;
+
+  for (i = 0; i < 8; i++)
+    in[i] = highbd_load_input(input + 8 * i);
+  if (!highbd_in_range(in, 8, HIGHBD_IHT8_LIMIT)) {
+    vp9_highbd_iht8x8_64_add_c(input, dest8, stride, tx_type, bd);
+    return;
+  }
+
+  if (tx_type == DCT_DCT || tx_type == ADST_DCT)
+    idct8_sse2(in);
+  else
+    iadst8_sse2(in);
+  if (!highbd_in_range(in, 8, HIGHBD_IHT8_LIMIT)) {
+    vp9_highbd_iht8x8_64_add_c(input, dest8, stride, tx_type, bd);
+    return;
+  }
+  if (tx_type == DCT_DCT || tx_type == DCT_ADST)
+    idct8_sse2(in);
+  else
+    iadst8_sse2(in);
+
+  for (i = 0; i < 8; i++) {
+    const __m128i d = _mm_loadu_si128((const __m128i *)(dest + stride * i));
+    _mm_storeu_si128((__m128i *)(dest + stride * i),
+                     highbd_recon(d, in[i], 5, bd));
+  }
+}
+
+void vp9_highbd_iht16x16_256_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                      int stride, int tx_type, int bd) {
+  uint16_t *dest = CONVERT_TO_SHORTPTR(dest8);
+  __m128i in0[16], in1[16];
+  int i;
+
+  for (i = 0; i < 16; i++) {
+    in0[i] = highbd_load_input(input + 16 * i);
+    in1[i] = highbd_load_input(input + 16 * i + 8);
+  }
+  if (!highbd_in_range(in0, 16, HIGHBD_IHT16_LIMIT) ||
+      !highbd_in_range(in1, 16, HIGHBD_IHT16_LIMIT)) {
+    vp9_highbd_iht16x16_256_add_c(input, dest8, stride, tx_type, bd);
+    return;
+  }
+
+  if (tx_type == DCT_DCT || tx_type == ADST_DCT)
+    idct16_sse2(in0, in1);
+  else
+    iadst16_sse2(in0, in1);
+  if (!highbd_in_range(in0, 16, HIGHBD_IHT16_LIMIT) ||
+      !highbd_in_range(in1, 16, HIGHBD_IHT16_LIMIT)) {
+    vp9_highbd_iht16x16_256_add_c(input, dest8, stride, tx_type, bd);
+    return;
+  }
+  if (tx_type == DCT_DCT || tx_type == DCT_ADST)
+    idct16_sse2(in0, in1);
+  else
+    iadst16_sse2(in0, in1);
+
+  for (i = 0; i < 16; i++) {
+    uint16_t *const row = dest + stride * i;
+    const __m128i d0 = _mm_loadu_si128((const __m128i *)row);
+    const __m128i d1 = _mm_loadu_si128((const __m128i *)(row + 8));
+    _mm_storeu_si128((__m128i *)row, highbd_recon(d0, in0[i], 6, bd));
+    _mm_storeu_si128((__m128i *)(row + 8), highbd_recon(d1, in1[i], 6, bd));
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
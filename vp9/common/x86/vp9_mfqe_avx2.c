@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vp9/common/vp9_postproc.h"
+
+static INLINE __m256i load_2_rows(const uint8_t *p, int stride) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p)),
+      _mm_loadu_si128((const __m128i *)(p + stride)), 1);
+}
+
+// Two rows per iteration. The src and dst pixels are interleaved so that
+// _mm256_maddubs_epi16() computes src * src_weight + dst * dst_weight.
+void vp9_filter_by_weight16x16_avx2(const uint8_t *src, int src_stride,
+                                    uint8_t *dst, int dst_stride,
+                                    int src_weight) {
+  const int dst_weight = (1 << MFQE_PRECISION) - src_weight;
+  const __m256i weights =
+      _mm256_set1_epi16((int16_t)(src_weight | (dst_weight << 8)));
+  const __m256i rounding = _mm256_set1_epi16(1 << (MFQE_PRECISION - 1));
+  int r;
+
+  for (r = 0; r < 16; r += 2) {
+    const __m256i s = load_2_rows(src, src_stride);
+    const __m256i d = load_2_rows(dst, dst_stride);
+    __m256i lo = _mm256_maddubs_epi16(_mm256_unpacklo_epi8(s, d), weights);
+    __m256i hi = _mm256_maddubs_epi16(_mm256_unpackhi_epi8(s, d), weights);
+    __m256i out;
+
+    lo = _mm256_srli_epi16(_mm256_add_epi16(lo, rounding), MFQE_PRECISION);
+    hi = _mm256_srli_epi16(_mm256_add_epi16(hi, rounding), MFQE_PRECISION);
+    out = _mm256_packus_epi16(lo, hi);
+    _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(out));
+    _mm_storeu_si128((__m128i *)(dst + dst_stride),
+                     _mm256_extracti128_si256(out, 1));
+    src += 2 * src_stride;
+    dst += 2 * dst_stride;
+  }
+}
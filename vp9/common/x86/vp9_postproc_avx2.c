@@ -0,0 +1,207 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+#include <stdlib.h>
+#include <string.h>
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vp9/common/vp9_postproc.h"
+
+// 16 pixels per iteration in 16 bit lanes. vp9_post_proc_down_and_across()
+// matches the C code, with the columns past the last multiple of 16 done in
+// C. vp9_mbpost_proc_down() matches the SSE2 version, which takes the dither
+// of column c from vp9_rv[(row & 127) + (c & 7)] rather than from rand().
+
+static INLINE __m256i load_u8_16(const uint8_t *p) {
+  return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)p));
+}
+
+static INLINE __m128i pack_u8_16(const __m256i v) {
+  return _mm_packus_epi16(_mm256_castsi256_si128(v),
+                          _mm256_extracti128_si256(v, 1));
+}
+
+// Returns the mask of the lanes where |a - b| > flimit.
+static INLINE __m256i over_limit(const __m256i a, const __m256i b,
+                                 const __m256i flimit) {
+  return _mm256_cmpgt_epi16(_mm256_abs_epi16(_mm256_sub_epi16(a, b)), flimit);
+}
+
+// The filter of the C code on the 16 pixels at p, with taps step apart: the
+// weighted mean of the 5 taps, or p[0] where any of them differs from it by
+// more than flimit.
+static INLINE __m128i filter5_16(const uint8_t *p, int step,
+                                 const __m256i flimit) {
+  const __m256i pm2 = load_u8_16(p - 2 * step);
+  const __m256i pm1 = load_u8_16(p - step);
+  const __m256i p0 = load_u8_16(p);
+  const __m256i p1 = load_u8_16(p + step);
+  const __m256i p2 = load_u8_16(p + 2 * step);
+  __m256i sum, mask;
+
+  sum = _mm256_add_epi16(_mm256_slli_epi16(p0, 2), _mm256_set1_epi16(4));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(pm2, pm1));
+  sum = _mm256_add_epi16(sum, _mm256_add_epi16(p1, p2));
+  mask = _mm256_or_si256(over_limit(p0, pm2, flimit),
+                         over_limit(p0, pm1, flimit));
+  mask = _mm256_or_si256(mask, over_limit(p0, p1, flimit));
+  mask = _mm256_or_si256(mask, over_limit(p0, p2, flimit));
+  return pack_u8_16(
+      _mm256_blendv_epi8(_mm256_srli_epi16(sum, 3), p0, mask));
+}
+
+static INLINE uint8_t filter5_c(const uint8_t *p, int step, int flimit) {
+  int kernel = 4 + 3 * p[0];
+  int i;
+  for (i = -2; i <= 2; i++) {
+    if (abs(p[0] - p[i * step]) > flimit)
+      return p[0];
+    kernel += p[i * step];
+  }
+  return kernel >> 3;
+}
+
+void vp9_post_proc_down_and_across_avx2(const uint8_t *src_ptr,
+                                        uint8_t *dst_ptr,
+                                        int src_pixels_per_line,
+                                        int dst_pixels_per_line,
+                                        int rows, int cols, int flimit) {
+  const __m256i limit = _mm256_set1_epi16(flimit);
+  uint8_t tail[16];
+  int row, col, i;
+
+  for (row = 0; row < rows; row++) {
+    __m128i prev = _mm_setzero_si128();
+
+    for (col = 0; col + 16 <= cols; col += 16) {
+      _mm_storeu_si128((__m128i *)(dst_ptr + col),
+                       filter5_16(src_ptr + col, src_pixels_per_line, limit));
+    }
+    for (; col < cols; col++)
+      dst_ptr[col] = filter5_c(src_ptr + col, src_pixels_per_line, flimit);
+
+    // The across filter reads the 2 pixels on each side of a group, so each
+    // group is stored once the next one has been filtered.
+    for (col = 0; col + 16 <= cols; col += 16) {
+      const __m128i out = filter5_16(dst_ptr + col, 1, limit);
+      if (col)
+        _mm_storeu_si128((__m128i *)(dst_ptr + col - 16), prev);
+      prev = out;
+    }
+    for (i = 0; col + i < cols; i++)
+      tail[i] = filter5_c(dst_ptr + col + i, 1, flimit);
+    if (col)
+      _mm_storeu_si128((__m128i *)(dst_ptr + col - 16), prev);
+    memcpy(dst_ptr + col, tail, i);
+
+    src_ptr += src_pixels_per_line;
+    dst_ptr += dst_pixels_per_line;
+  }
+}
+
+static INLINE __m256i load_cols(const uint8_t *p, int width) {
+  if (width == 16)
+    return load_u8_16(p);
+  return _mm256_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)p));
+}
+
+static INLINE void store_cols(uint8_t *p, const __m128i v, int width) {
+  if (width == 16)
+    _mm_storeu_si128((__m128i *)p, v);
+  else
+    _mm_storel_epi64((__m128i *)p, v);
+}
+
+// Adds the squares of the 16 bit lanes of |v| to the 32 bit lanes of |lo|
+// and |hi|, or subtracts them when |sub| is set.
+static INLINE void add_squares(const __m256i v, int sub, __m256i *lo,
+                               __m256i *hi) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i sq = _mm256_mullo_epi16(v, v);
+  if (sub) {
+    *lo = _mm256_sub_epi32(*lo, _mm256_unpacklo_epi16(sq, zero));
+    *hi = _mm256_sub_epi32(*hi, _mm256_unpackhi_epi16(sq, zero));
+  } else {
+    *lo = _mm256_add_epi32(*lo, _mm256_unpacklo_epi16(sq, zero));
+    *hi = _mm256_add_epi32(*hi, _mm256_unpackhi_epi16(sq, zero));
+  }
+}
+
+// Returns the mask of the 16 bit lanes where sumsq * 15 - sum * sum < flimit,
+// with sumsq split as in add_squares().
+static INLINE __m256i low_variance(const __m256i sum, const __m256i sumsq_lo,
+                                   const __m256i sumsq_hi,
+                                   const __m256i flimit) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i sum_lo = _mm256_unpacklo_epi16(sum, zero);
+  const __m256i sum_hi = _mm256_unpackhi_epi16(sum, zero);
+  const __m256i var_lo = _mm256_sub_epi32(
+      _mm256_sub_epi32(_mm256_slli_epi32(sumsq_lo, 4), sumsq_lo),
+      _mm256_mullo_epi32(sum_lo, sum_lo));
+  const __m256i var_hi = _mm256_sub_epi32(
+      _mm256_sub_epi32(_mm256_slli_epi32(sumsq_hi, 4), sumsq_hi),
+      _mm256_mullo_epi32(sum_hi, sum_hi));
+  return _mm256_packs_epi32(_mm256_cmpgt_epi32(flimit, var_lo),
+                            _mm256_cmpgt_epi32(flimit, var_hi));
+}
+
+// Filters |width| columns, 8 or 16, at dst in place.
+static INLINE void mbpost_proc_down_cols(uint8_t *dst, int pitch, int rows,
+                                         int width, const __m256i flimit) {
+  uint8_t *s = dst;
+  __m256i sum = _mm256_setzero_si256();
+  __m256i sumsq_lo = _mm256_setzero_si256();
+  __m256i sumsq_hi = _mm256_setzero_si256();
+  // The filtered rows r - 7 to r, stored 8 rows late.
+  __m128i d[8];
+  int r, i;
+
+  for (i = -8; i <= 6; i++) {
+    const __m256i v = load_cols(s + i * pitch, width);
+    sum = _mm256_add_epi16(sum, v);
+    add_squares(v, 0, &sumsq_lo, &sumsq_hi);
+  }
+
+  for (r = 0; r < rows + 8; r++) {
+    const __m256i above = load_cols(s - 8 * pitch, width);
+    const __m256i below = load_cols(s + 7 * pitch, width);
+    const __m256i v = load_cols(s, width);
+    const __m256i rv = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)&vp9_rv[r & 127]));
+    __m256i filtered, mask;
+
+    sum = _mm256_add_epi16(sum, _mm256_sub_epi16(below, above));
+    add_squares(below, 0, &sumsq_lo, &sumsq_hi);
+    add_squares(above, 1, &sumsq_lo, &sumsq_hi);
+
+    filtered = _mm256_add_epi16(_mm256_add_epi16(rv, sum), v);
+    filtered = _mm256_srai_epi16(filtered, 4);
+    mask = low_variance(sum, sumsq_lo, sumsq_hi, flimit);
+
+    if (r >= 8)
+      store_cols(s - 8 * pitch, d[r & 7], width);
+    d[r & 7] = pack_u8_16(_mm256_blendv_epi8(v, filtered, mask));
+    s += pitch;
+  }
+}
+
+void vp9_mbpost_proc_down_avx2(uint8_t *dst, int pitch, int rows, int cols,
+                               int flimit) {
+  const __m256i limit = _mm256_set1_epi32(flimit);
+  int c;
+
+  for (c = 0; c + 16 <= cols; c += 16)
+    mbpost_proc_down_cols(dst + c, pitch, rows, 16, limit);
+  // As in the SSE2 version, a partial group of 8 is filtered in full.
+  for (; c < cols; c += 8)
+    mbpost_proc_down_cols(dst + c, pitch, rows, 8, limit);
+}
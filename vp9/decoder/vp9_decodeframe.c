@@ -21,6 +21,7 @@
 #include "vpx_mem/vpx_mem.h"
 #include "vpx_ports/mem.h"
 #include "vpx_ports/mem_ops.h"
+#include "vpx_ports/vpx_timer.h"
 #include "vpx_scale/vpx_scale.h"
 #include "vpx_util/vpx_thread.h"
 
@@ -1429,6 +1430,34 @@ static void get_tile_buffers(VP9Decoder *pbi,
   }
 }
 
+// Waits for the loop filter thread to finish its rows.
+static void sync_lf_worker(VP9Decoder *pbi,
+                           const VPxWorkerInterface *winterface) {
+#if CONFIG_PERF_STATS
+  struct vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+  winterface->sync(&pbi->lf_worker);
+  vpx_usec_timer_mark(&timer);
+  pbi->perf_frame.thread_wait_us += vpx_usec_timer_elapsed(&timer);
+#else
+  winterface->sync(&pbi->lf_worker);
+#endif
+}
+
+// Loop filters the rows set up in the loop filter data on this thread.
+static void execute_lf_worker(VP9Decoder *pbi,
+                              const VPxWorkerInterface *winterface) {
+#if CONFIG_PERF_STATS
+  struct vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+  winterface->execute(&pbi->lf_worker);
+  vpx_usec_timer_mark(&timer);
+  pbi->perf_frame.loopfilter_us += vpx_usec_timer_elapsed(&timer);
+#else
+  winterface->execute(&pbi->lf_worker);
+#endif
+}
+
 static const uint8_t *decode_tiles(VP9Decoder *pbi,
                                    const uint8_t *data,
                                    const uint8_t *data_end) {
@@ -1538,13 +1567,13 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi,
         // decoding has completed: finish up the loop filter in this thread.
         if (mi_row + MI_BLOCK_SIZE >= cm->mi_rows) continue;
 
-        winterface->sync(&pbi->lf_worker);
+        sync_lf_worker(pbi, winterface);
         lf_data->start = lf_start;
         lf_data->stop = mi_row;
         if (pbi->max_threads > 1) {
           winterface->launch(&pbi->lf_worker);
         } else {
-          winterface->execute(&pbi->lf_worker);
+          execute_lf_worker(pbi, winterface);
         }
       }
       // After loopfiltering, the last 7 row pixels in each superblock row may
@@ -1559,10 +1588,10 @@ static const uint8_t *decode_tiles(VP9Decoder *pbi,
   // Loopfilter remaining rows in the frame.
   if (cm->lf.filter_level && !cm->skip_loop_filter) {
     LFWorkerData *const lf_data = (LFWorkerData*)pbi->lf_worker.data1;
-    winterface->sync(&pbi->lf_worker);
+    sync_lf_worker(pbi, winterface);
     lf_data->start = lf_data->stop;
     lf_data->stop = cm->mi_rows;
-    winterface->execute(&pbi->lf_worker);
+    execute_lf_worker(pbi, winterface);
   }
 
   // Get last tile data.
@@ -1711,6 +1740,9 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
   n = 0;
   while (n < tile_cols) {
     int i;
+#if CONFIG_PERF_STATS
+    struct vpx_usec_timer timer;
+#endif
     for (i = 0; i < num_workers && n < tile_cols; ++i) {
       VPxWorker *const worker = &pbi->tile_workers[i];
       TileWorkerData *const tile_data = (TileWorkerData*)worker->data1;
@@ -1738,6 +1770,9 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
       ++n;
     }
 
+#if CONFIG_PERF_STATS
+    vpx_usec_timer_start(&timer);
+#endif
     for (; i > 0; --i) {
       VPxWorker *const worker = &pbi->tile_workers[i - 1];
       // TODO(jzern): The tile may have specific error data associated with
@@ -1746,6 +1781,10 @@ static const uint8_t *decode_tiles_mt(VP9Decoder *pbi,
       // detected, there's no point in continuing to decode tiles.
       pbi->mb.corrupted |= !winterface->sync(worker);
     }
+#if CONFIG_PERF_STATS
+    vpx_usec_timer_mark(&timer);
+    pbi->perf_frame.thread_wait_us += vpx_usec_timer_elapsed(&timer);
+#endif
     if (final_worker > -1) {
       TileWorkerData *const tile_data =
           (TileWorkerData*)pbi->tile_workers[final_worker].data1;
@@ -2163,6 +2202,10 @@ void vp9_decode_frame(VP9Decoder *pbi,
   struct vpx_read_bit_buffer rb;
   int context_updated = 0;
   uint8_t clear_data[MAX_VP9_HEADER_SIZE];
+#if CONFIG_PERF_STATS
+  struct vpx_usec_timer timer;
+  int64_t nested_us;
+#endif
   const size_t first_partition_size = read_uncompressed_header(pbi,
       init_read_bit_buffer(pbi, &rb, data, data_end, clear_data));
   const int tile_rows = 1 << cm->log2_tile_rows;
@@ -2207,6 +2250,11 @@ void vp9_decode_frame(VP9Decoder *pbi,
     vp9_loop_filter_frame_init(cm, cm->lf.filter_level);
   }
 
+#if CONFIG_PERF_STATS
+  vpx_usec_timer_mark(&pbi->frame_timer);
+  pbi->perf_frame.header_us = vpx_usec_timer_elapsed(&pbi->frame_timer);
+#endif
+
   // If encoded in frame parallel mode, frame context is ready after decoding
   // the frame header.
   if (pbi->frame_parallel_decode && cm->frame_parallel_decoding_mode) {
@@ -2225,16 +2273,28 @@ void vp9_decode_frame(VP9Decoder *pbi,
     vp9_frameworker_unlock_stats(worker);
   }
 
+#if CONFIG_PERF_STATS
+  nested_us = pbi->perf_frame.loopfilter_us + pbi->perf_frame.thread_wait_us;
+  vpx_usec_timer_start(&timer);
+#endif
   if (pbi->max_threads > 1 && tile_rows == 1 && tile_cols > 1) {
     // Multi-threaded tile decoder
     *p_data_end = decode_tiles_mt(pbi, data + first_partition_size, data_end);
     if (!xd->corrupted) {
       if (!cm->skip_loop_filter) {
+#if CONFIG_PERF_STATS
+        struct vpx_usec_timer lf_timer;
+        vpx_usec_timer_start(&lf_timer);
+#endif
         // If multiple threads are used to decode tiles, then we use those
         // threads to do parallel loopfiltering.
         vp9_loop_filter_frame_mt(new_fb, cm, pbi->mb.plane,
                                  cm->lf.filter_level, 0, 0, pbi->tile_workers,
                                  pbi->num_tile_workers, &pbi->lf_row_sync);
+#if CONFIG_PERF_STATS
+        vpx_usec_timer_mark(&lf_timer);
+        pbi->perf_frame.loopfilter_us += vpx_usec_timer_elapsed(&lf_timer);
+#endif
       }
     } else {
       vpx_internal_error(&cm->error, VPX_CODEC_CORRUPT_FRAME,
@@ -2243,15 +2303,30 @@ void vp9_decode_frame(VP9Decoder *pbi,
   } else {
     *p_data_end = decode_tiles(pbi, data + first_partition_size, data_end);
   }
+#if CONFIG_PERF_STATS
+  vpx_usec_timer_mark(&timer);
+  // Loop filtering and waiting done within the tile decode are not counted
+  // twice.
+  pbi->perf_frame.tiles_us = vpx_usec_timer_elapsed(&timer) -
+      (pbi->perf_frame.loopfilter_us + pbi->perf_frame.thread_wait_us -
+       nested_us);
+#endif
 
   if (!xd->corrupted) {
     if (!cm->error_resilient_mode && !cm->frame_parallel_decoding_mode) {
+#if CONFIG_PERF_STATS
+      vpx_usec_timer_start(&timer);
+#endif
       vp9_adapt_coef_probs(cm);
 
       if (!frame_is_intra_only(cm)) {
         vp9_adapt_mode_probs(cm);
         vp9_adapt_mv_probs(cm, cm->allow_high_precision_mv);
       }
+#if CONFIG_PERF_STATS
+      vpx_usec_timer_mark(&timer);
+      pbi->perf_frame.adapt_us = vpx_usec_timer_elapsed(&timer);
+#endif
     } else {
       debug_check_frame_counts(cm);
     }
@@ -271,6 +271,23 @@ static void swap_frame_buffers(VP9Decoder *pbi) {
     cm->frame_refs[ref_index].idx = -1;
 }
 
+#if CONFIG_PERF_STATS
+// Closes the statistics of the frame just decoded.
+static void update_perf_stats(VP9Decoder *pbi) {
+  const vpx_dec_frame_perf_t *const f = &pbi->perf_frame;
+  vpx_dec_frame_perf_t *const t = &pbi->perf_stats.total;
+
+  t->header_us += f->header_us;
+  t->tiles_us += f->tiles_us;
+  t->loopfilter_us += f->loopfilter_us;
+  t->thread_wait_us += f->thread_wait_us;
+  t->adapt_us += f->adapt_us;
+  t->frame_us += f->frame_us;
+  pbi->perf_stats.last_frame = *f;
+  ++pbi->perf_stats.frames;
+}
+#endif
+
 int vp9_receive_compressed_data(VP9Decoder *pbi,
                                 size_t size, const uint8_t **psource) {
   VP9_COMMON *volatile const cm = &pbi->common;
@@ -280,6 +297,11 @@ int vp9_receive_compressed_data(VP9Decoder *pbi,
   int retcode = 0;
   cm->error.error_code = VPX_CODEC_OK;
 
+#if CONFIG_PERF_STATS
+  vp9_zero(pbi->perf_frame);
+  vpx_usec_timer_start(&pbi->frame_timer);
+#endif
+
   if (size == 0) {
     // This is used to signal that we are missing frames.
     // We do not know if the missing frame(s) was supposed to update
@@ -408,6 +430,12 @@ int vp9_receive_compressed_data(VP9Decoder *pbi,
     }
   }
 
+#if CONFIG_PERF_STATS
+  vpx_usec_timer_mark(&pbi->frame_timer);
+  pbi->perf_frame.frame_us = vpx_usec_timer_elapsed(&pbi->frame_timer);
+  update_perf_stats(pbi);
+#endif
+
   cm->error.setjmp = 0;
   return retcode;
 }
@@ -433,7 +461,10 @@ int vp9_get_raw_frame(VP9Decoder *pbi, YV12_BUFFER_CONFIG *sd,
 
 #if CONFIG_VP9_POSTPROC
   if (!cm->show_existing_frame) {
-    ret = vp9_post_proc_frame(cm, sd, flags);
+    // As for the loop filter, no more workers than tile columns are used.
+    ret = vp9_post_proc_frame(cm, sd, flags, pbi->tile_workers,
+                              VPXMIN(pbi->num_tile_workers,
+                                     1 << cm->log2_tile_cols));
   } else {
     *sd = *cm->frame_to_show;
     ret = 0;
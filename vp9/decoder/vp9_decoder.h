@@ -13,8 +13,10 @@
 
 #include "./vpx_config.h"
 
+#include "vpx/vp8dx.h"
 #include "vpx/vpx_codec.h"
 #include "vpx_dsp/bitreader.h"
+#include "vpx_ports/vpx_timer.h"
 #include "vpx_scale/yv12config.h"
 #include "vpx_util/vpx_thread.h"
 
@@ -79,6 +81,14 @@ typedef struct VP9Decoder {
   int inv_tile_order;
   int need_resync;  // wait for key/intra-only frame.
   int hold_ref_buf;  // hold the reference buffer.
+
+#if CONFIG_PERF_STATS
+  // Stage timings of the frame being decoded, and the statistics returned by
+  // VP9D_GET_PERF_STATS. frame_timer runs from the start of the frame.
+  struct vpx_usec_timer frame_timer;
+  vpx_dec_frame_perf_t perf_frame;
+  vpx_dec_perf_stats_t perf_stats;
+#endif
 } VP9Decoder;
 
 int vp9_receive_compressed_data(struct VP9Decoder *pbi,
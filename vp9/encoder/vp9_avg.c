@@ -29,6 +29,22 @@ unsigned int vp9_avg_4x4_c(const uint8_t *s, int p) {
   return (sum + 8) >> 4;
 }
 
+// Averages of all 8x8 blocks of a 64x64 block, in raster order.
+void vp9_avg_8x8_64x64_c(const uint8_t *s, int p, int *avg) {
+  int r, c;
+  for (r = 0; r < 8; ++r)
+    for (c = 0; c < 8; ++c)
+      avg[r * 8 + c] = vp9_avg_8x8_c(s + 8 * (r * p + c), p);
+}
+
+// Averages of all 4x4 blocks of a 16x16 block, in raster order.
+void vp9_avg_4x4_16x16_c(const uint8_t *s, int p, int *avg) {
+  int r, c;
+  for (r = 0; r < 4; ++r)
+    for (c = 0; c < 4; ++c)
+      avg[r * 4 + c] = vp9_avg_4x4_c(s + 4 * (r * p + c), p);
+}
+
 // src_diff: first pass, 9 bit, dynamic range [-255, 255]
 //           second pass, 12 bit, dynamic range [-2040, 2040]
 static void hadamard_col8(const int16_t *src_diff, int src_stride,
@@ -115,16 +131,49 @@ void vp9_hadamard_16x16_c(int16_t const *src_diff, int src_stride,
   }
 }
 
+// In place 32x32 2D Hadamard transform. The output has the scale of
+// vpx_fdct32x32(), half that of the smaller transforms.
+void vp9_hadamard_32x32_c(int16_t const *src_diff, int src_stride,
+                          int16_t *coeff) {
+  int idx;
+  for (idx = 0; idx < 4; ++idx) {
+    // src_diff: 9 bit, dynamic range [-255, 255]
+    int16_t const *src_ptr = src_diff + (idx >> 1) * 16 * src_stride
+                                + (idx & 0x01) * 16;
+    vp9_hadamard_16x16_c(src_ptr, src_stride, coeff + idx * 256);
+  }
+
+  // coeff: 16 bit, dynamic range [-32640, 32640]
+  for (idx = 0; idx < 256; ++idx) {
+    int16_t a0 = coeff[0];
+    int16_t a1 = coeff[256];
+    int16_t a2 = coeff[512];
+    int16_t a3 = coeff[768];
+
+    int16_t b0 = (a0 + a1) >> 2;  // (a0 + a1): 17 bit, [-65280, 65280]
+    int16_t b1 = (a0 - a1) >> 2;  // b0-b3: 15 bit, dynamic range
+    int16_t b2 = (a2 + a3) >> 2;  // [-16320, 16320]
+    int16_t b3 = (a2 - a3) >> 2;
+
+    coeff[0]   = b0 + b2;  // 16 bit, [-32640, 32640]
+    coeff[256] = b1 + b3;
+    coeff[512] = b0 - b2;
+    coeff[768] = b1 - b3;
+
+    ++coeff;
+  }
+}
+
 // coeff: 16 bits, dynamic range [-32640, 32640].
 // length: value range {16, 64, 256, 1024}.
-int16_t vp9_satd_c(const int16_t *coeff, int length) {
+int vp9_satd_c(const int16_t *coeff, int length) {
   int i;
   int satd = 0;
   for (i = 0; i < length; ++i)
     satd += abs(coeff[i]);
 
-  // satd: 26 bits, dynamic range [-32640 * 1024, 32640 * 1024]
-  return (int16_t)satd;
+  // satd: 26 bits, dynamic range [0, 32640 * 1024]
+  return satd;
 }
 
 // Integer projection onto row vectors.
@@ -210,6 +259,20 @@ unsigned int vp9_highbd_avg_4x4_c(const uint8_t *s8, int p) {
   return (sum + 8) >> 4;
 }
 
+void vp9_highbd_avg_8x8_64x64_c(const uint8_t *s8, int p, int *avg) {
+  int r, c;
+  for (r = 0; r < 8; ++r)
+    for (c = 0; c < 8; ++c)
+      avg[r * 8 + c] = vp9_highbd_avg_8x8_c(s8 + 8 * (r * p + c), p);
+}
+
+void vp9_highbd_avg_4x4_16x16_c(const uint8_t *s8, int p, int *avg) {
+  int r, c;
+  for (r = 0; r < 4; ++r)
+    for (c = 0; c < 4; ++c)
+      avg[r * 4 + c] = vp9_highbd_avg_4x4_c(s8 + 4 * (r * p + c), p);
+}
+
 void vp9_highbd_minmax_8x8_c(const uint8_t *s8, int p, const uint8_t *d8,
                              int dp, int *min, int *max) {
   int i, j;
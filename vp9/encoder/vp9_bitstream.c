@@ -18,6 +18,7 @@
 #include "vpx_mem/vpx_mem.h"
 #include "vpx_ports/mem_ops.h"
 #include "vpx_ports/system_state.h"
+#include "vpx_ports/vpx_timer.h"
 
 #include "vp9/common/vp9_entropy.h"
 #include "vp9/common/vp9_entropymode.h"
@@ -1234,6 +1235,10 @@ void vp9_pack_bitstream(VP9_COMP *cpi, uint8_t *dest, size_t *size) {
   size_t first_part_size, uncompressed_hdr_size;
   struct vpx_write_bit_buffer wb = {data, 0};
   struct vpx_write_bit_buffer saved_wb;
+#if CONFIG_PERF_STATS
+  struct vpx_usec_timer timer;
+  vpx_usec_timer_start(&timer);
+#endif
 
   write_uncompressed_header(cpi, &wb);
   saved_wb = wb;
@@ -1252,4 +1257,8 @@ void vp9_pack_bitstream(VP9_COMP *cpi, uint8_t *dest, size_t *size) {
   data += encode_tiles(cpi, data);
 
   *size = data - dest;
+#if CONFIG_PERF_STATS
+  vpx_usec_timer_mark(&timer);
+  cpi->perf_frame.pack_us += vpx_usec_timer_elapsed(&timer);
+#endif
 }
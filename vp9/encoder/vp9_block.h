@@ -52,6 +52,35 @@ typedef struct {
   uint8_t mode_context[MAX_REF_FRAMES];
 } MB_MODE_INFO_EXT;
 
+#define MODEL_RD_CACHE_SIZE 32
+
+// Model rd results of the inter predictors already evaluated for the current
+// block. Entries are keyed by reference frames, motion vectors and
+// interpolation filter, so modes that end up with the same motion vector
+// (e.g. NEARMV equal to NEARESTMV) do not rebuild and re-model the predictor.
+typedef struct {
+  MV_REFERENCE_FRAME ref_frame[2];
+  int_mv mv[2];
+  INTERP_FILTER interp_filter;
+  int rate;
+  int64_t dist;
+  int skip_txfm_sb;
+  int64_t skip_sse_sb;
+  unsigned int pred_sse;
+  uint8_t skip_txfm[MAX_MB_PLANE << 2];
+  int64_t bsse[MAX_MB_PLANE << 2];
+} MODEL_RD_CACHE_ENTRY;
+
+typedef struct {
+  MODEL_RD_CACHE_ENTRY entry[MODEL_RD_CACHE_SIZE];
+  int count;
+  int next;
+#if CONFIG_INTERNAL_STATS
+  int64_t lookups;
+  int64_t hits;
+#endif
+} MODEL_RD_CACHE;
+
 typedef struct macroblock MACROBLOCK;
 struct macroblock {
   struct macroblock_plane plane[MAX_MB_PLANE];
@@ -135,6 +164,20 @@ struct macroblock {
   // the visual quality at the boundary of moving color objects.
   uint8_t color_sensitivity[2];
 
+  MODEL_RD_CACHE model_rd_cache;
+
+#if CONFIG_INTERNAL_STATS
+  // Inter modes evaluated by the real-time mode decision, and how many of
+  // those were modelled directly on the reference frame without building a
+  // prediction.
+  int64_t rt_mode_evals[INTER_MODES];
+  int64_t rt_mode_in_place[INTER_MODES];
+#endif
+
+#if CONFIG_PERF_STATS
+  int64_t motion_searches;
+#endif
+
   void (*fwd_txm4x4)(const int16_t *input, tran_low_t *output, int stride);
   void (*itxm_add)(const tran_low_t *input, uint8_t *dest, int stride, int eob);
 #if CONFIG_VP9_HIGHBITDEPTH
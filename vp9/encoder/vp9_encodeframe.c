@@ -570,53 +570,65 @@ static int compute_minmax_8x8(const uint8_t *s, int sp, const uint8_t *d,
   return (minmax_max - minmax_min);
 }
 
-static void fill_variance_4x4avg(const uint8_t *s, int sp, const uint8_t *d,
-                                 int dp, int x8_idx, int y8_idx, v8x8 *vst,
+// Averages of the 8x8 blocks of a 64x64 block, or of the 4x4 blocks of a
+// 16x16 block, computed for the whole block in one pass.
+static void avg_8x8_64x64(const uint8_t *s, int p,
 #if CONFIG_VP9_HIGHBITDEPTH
-                                 int highbd_flag,
+                          int highbd_flag,
 #endif
-                                 int pixels_wide,
-                                 int pixels_high,
-                                 int is_key_frame) {
-  int k;
-  for (k = 0; k < 4; k++) {
-    int x4_idx = x8_idx + ((k & 1) << 2);
-    int y4_idx = y8_idx + ((k >> 1) << 2);
-    unsigned int sse = 0;
-    int sum = 0;
-    if (x4_idx < pixels_wide && y4_idx < pixels_high) {
-      int s_avg;
-      int d_avg = 128;
+                          int *avg) {
 #if CONFIG_VP9_HIGHBITDEPTH
-      if (highbd_flag & YV12_FLAG_HIGHBITDEPTH) {
-        s_avg = vp9_highbd_avg_4x4(s + y4_idx * sp + x4_idx, sp);
-        if (!is_key_frame)
-          d_avg = vp9_highbd_avg_4x4(d + y4_idx * dp + x4_idx, dp);
-      } else {
-        s_avg = vp9_avg_4x4(s + y4_idx * sp + x4_idx, sp);
-        if (!is_key_frame)
-          d_avg = vp9_avg_4x4(d + y4_idx * dp + x4_idx, dp);
-      }
+  if (highbd_flag & YV12_FLAG_HIGHBITDEPTH)
+    vp9_highbd_avg_8x8_64x64(s, p, avg);
+  else
+    vp9_avg_8x8_64x64(s, p, avg);
 #else
-      s_avg = vp9_avg_4x4(s + y4_idx * sp + x4_idx, sp);
-      if (!is_key_frame)
-        d_avg = vp9_avg_4x4(d + y4_idx * dp + x4_idx, dp);
+  vp9_avg_8x8_64x64(s, p, avg);
 #endif
-      sum = s_avg - d_avg;
-      sse = sum * sum;
-    }
-    fill_variance(sse, sum, 0, &vst->split[k].part_variances.none);
-  }
 }
 
-static void fill_variance_8x8avg(const uint8_t *s, int sp, const uint8_t *d,
-                                 int dp, int x16_idx, int y16_idx, v16x16 *vst,
+static void avg_4x4_16x16(const uint8_t *s, int p,
+#if CONFIG_VP9_HIGHBITDEPTH
+                          int highbd_flag,
+#endif
+                          int *avg) {
 #if CONFIG_VP9_HIGHBITDEPTH
-                                 int highbd_flag,
+  if (highbd_flag & YV12_FLAG_HIGHBITDEPTH)
+    vp9_highbd_avg_4x4_16x16(s, p, avg);
+  else
+    vp9_avg_4x4_16x16(s, p, avg);
+#else
+  vp9_avg_4x4_16x16(s, p, avg);
 #endif
+}
+
+// s_avg and d_avg hold the 4x4 averages of the 16x16 block at (x16_idx,
+// y16_idx); d_avg is NULL when the source is compared against a flat 128.
+static void fill_variance_4x4avg(const int *s_avg, const int *d_avg,
+                                 int x16_idx, int y16_idx, v16x16 *vst,
+                                 int pixels_wide, int pixels_high) {
+  int k, m;
+  for (k = 0; k < 4; k++) {
+    for (m = 0; m < 4; m++) {
+      const int col = ((k & 1) << 1) + (m & 1);
+      const int row = ((k >> 1) << 1) + (m >> 1);
+      unsigned int sse = 0;
+      int sum = 0;
+      if (x16_idx + (col << 2) < pixels_wide &&
+          y16_idx + (row << 2) < pixels_high) {
+        sum = s_avg[row * 4 + col] - (d_avg ? d_avg[row * 4 + col] : 128);
+        sse = sum * sum;
+      }
+      fill_variance(sse, sum, 0, &vst->split[k].split[m].part_variances.none);
+    }
+  }
+}
+
+// s_avg and d_avg hold the 8x8 averages of the whole 64x64 block.
+static void fill_variance_8x8avg(const int *s_avg, const int *d_avg,
+                                 int x16_idx, int y16_idx, v16x16 *vst,
                                  int pixels_wide,
-                                 int pixels_high,
-                                 int is_key_frame) {
+                                 int pixels_high) {
   int k;
   for (k = 0; k < 4; k++) {
     int x8_idx = x16_idx + ((k & 1) << 3);
@@ -624,24 +636,8 @@ static void fill_variance_8x8avg(const uint8_t *s, int sp, const uint8_t *d,
     unsigned int sse = 0;
     int sum = 0;
     if (x8_idx < pixels_wide && y8_idx < pixels_high) {
-      int s_avg;
-      int d_avg = 128;
-#if CONFIG_VP9_HIGHBITDEPTH
-      if (highbd_flag & YV12_FLAG_HIGHBITDEPTH) {
-        s_avg = vp9_highbd_avg_8x8(s + y8_idx * sp + x8_idx, sp);
-        if (!is_key_frame)
-          d_avg = vp9_highbd_avg_8x8(d + y8_idx * dp + x8_idx, dp);
-      } else {
-        s_avg = vp9_avg_8x8(s + y8_idx * sp + x8_idx, sp);
-        if (!is_key_frame)
-          d_avg = vp9_avg_8x8(d + y8_idx * dp + x8_idx, dp);
-      }
-#else
-      s_avg = vp9_avg_8x8(s + y8_idx * sp + x8_idx, sp);
-      if (!is_key_frame)
-        d_avg = vp9_avg_8x8(d + y8_idx * dp + x8_idx, dp);
-#endif
-      sum = s_avg - d_avg;
+      const int idx = (y8_idx >> 3) * 8 + (x8_idx >> 3);
+      sum = s_avg[idx] - d_avg[idx];
       sse = sum * sum;
     }
     fill_variance(sse, sum, 0, &vst->split[k].part_variances.none);
@@ -673,6 +669,7 @@ static int choose_partitioning(VP9_COMP *cpi,
   const int use_4x4_partition = is_key_frame;
   const int low_res = (cm->width <= 352 && cm->height <= 288);
   int variance4x4downsample[16];
+  int s_avg8[64], d_avg8[64];
 
   int segment_id = CR_SEGMENT_ID_BASE;
   if (cpi->oxcf.aq_mode == CYCLIC_REFRESH_AQ && cm->seg.enabled) {
@@ -801,6 +798,19 @@ static int choose_partitioning(VP9_COMP *cpi,
 #endif  // CONFIG_VP9_HIGHBITDEPTH
   }
 
+  if (!is_key_frame) {
+    avg_8x8_64x64(s, sp,
+#if CONFIG_VP9_HIGHBITDEPTH
+                  xd->cur_buf->flags,
+#endif
+                  s_avg8);
+    avg_8x8_64x64(d, dp,
+#if CONFIG_VP9_HIGHBITDEPTH
+                  xd->cur_buf->flags,
+#endif
+                  d_avg8);
+  }
+
   // Index for force_split: 0 for 64x64, 1-4 for 32x32 blocks,
   // 5-20 for the 16x16 blocks.
   force_split[0] = 0;
@@ -819,13 +829,8 @@ static int choose_partitioning(VP9_COMP *cpi,
       force_split[split_index] = 0;
       variance4x4downsample[i2 + j] = 0;
       if (!is_key_frame) {
-        fill_variance_8x8avg(s, sp, d, dp, x16_idx, y16_idx, vst,
-#if CONFIG_VP9_HIGHBITDEPTH
-                            xd->cur_buf->flags,
-#endif
-                            pixels_wide,
-                            pixels_high,
-                            is_key_frame);
+        fill_variance_8x8avg(s_avg8, d_avg8, x16_idx, y16_idx, vst,
+                             pixels_wide, pixels_high);
         fill_variance_tree(&vt.split[i].split[j], BLOCK_16X16);
         get_variance(&vt.split[i].split[j].part_variances.none);
         if (vt.split[i].split[j].part_variances.none.variance >
@@ -858,22 +863,25 @@ static int choose_partitioning(VP9_COMP *cpi,
       if (is_key_frame || (low_res && !cpi->use_svc &&
           vt.split[i].split[j].part_variances.none.variance >
           (thresholds[1] << 1))) {
+        int s_avg4[16], d_avg4[16];
         force_split[split_index] = 0;
         // Go down to 4x4 down-sampling for variance.
         variance4x4downsample[i2 + j] = 1;
-        for (k = 0; k < 4; k++) {
-          int x8_idx = x16_idx + ((k & 1) << 3);
-          int y8_idx = y16_idx + ((k >> 1) << 3);
-          v8x8 *vst2 = is_key_frame ? &vst->split[k] :
-              &vt2[i2 + j].split[k];
-          fill_variance_4x4avg(s, sp, d, dp, x8_idx, y8_idx, vst2,
+        avg_4x4_16x16(s + y16_idx * sp + x16_idx, sp,
 #if CONFIG_VP9_HIGHBITDEPTH
-                               xd->cur_buf->flags,
+                      xd->cur_buf->flags,
 #endif
-                               pixels_wide,
-                               pixels_high,
-                               is_key_frame);
-        }
+                      s_avg4);
+        if (!is_key_frame)
+          avg_4x4_16x16(d + y16_idx * dp + x16_idx, dp,
+#if CONFIG_VP9_HIGHBITDEPTH
+                        xd->cur_buf->flags,
+#endif
+                        d_avg4);
+        fill_variance_4x4avg(s_avg4, is_key_frame ? NULL : d_avg4,
+                             x16_idx, y16_idx,
+                             is_key_frame ? vst : &vt2[i2 + j],
+                             pixels_wide, pixels_high);
       }
     }
   }
@@ -3939,6 +3947,9 @@ static void encode_frame_internal(VP9_COMP *cpi) {
   {
     struct vpx_usec_timer emr_timer;
     vpx_usec_timer_start(&emr_timer);
+#if CONFIG_PERF_STATS
+    x->motion_searches = 0;
+#endif
 
 #if CONFIG_FP_MB_STATS
   if (cpi->use_fp_mb_stats) {
@@ -3955,6 +3966,16 @@ static void encode_frame_internal(VP9_COMP *cpi) {
 
     vpx_usec_timer_mark(&emr_timer);
     cpi->time_encode_sb_row += vpx_usec_timer_elapsed(&emr_timer);
+#if CONFIG_PERF_STATS
+    cpi->perf_frame.encode_us += vpx_usec_timer_elapsed(&emr_timer);
+    cpi->perf_frame.motion_searches += x->motion_searches;
+    {
+      int tile_row, tile_col;
+      for (tile_row = 0; tile_row < 1 << cm->log2_tile_rows; ++tile_row)
+        for (tile_col = 0; tile_col < 1 << cm->log2_tile_cols; ++tile_col)
+          cpi->perf_frame.tokens += cpi->tok_count[tile_row][tile_col];
+    }
+#endif
   }
 
   sf->skip_encode_frame = sf->skip_encode_sb ?
@@ -1721,6 +1721,11 @@ VP9_COMP *vp9_create_compressor(VP9EncoderConfig *oxcf,
 
   cpi->psnrhvs.worst = 100.0;
 
+  vpx_get_worker_interface()->init(&cpi->metrics_worker);
+  if (!vpx_get_worker_interface()->reset(&cpi->metrics_worker))
+    vpx_internal_error(&cm->error, VPX_CODEC_ERROR,
+                       "Metrics thread creation failed");
+
   if (cpi->b_calculate_blockiness) {
     cpi->total_blockiness = 0;
     cpi->worst_blockiness = 0.0;
@@ -1943,6 +1948,13 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
     return;
 
   cm = &cpi->common;
+#if CONFIG_INTERNAL_STATS
+  // Wait for the metrics of the last frame.
+  vpx_get_worker_interface()->end(&cpi->metrics_worker);
+  vpx_free_frame_buffer(&cpi->metrics_source);
+  vpx_free_frame_buffer(&cpi->metrics_recon);
+#endif
+
   if (cm->current_video_frame > 0) {
 #if CONFIG_INTERNAL_STATS
     vpx_clear_system_state();
@@ -2013,6 +2025,23 @@ void vp9_remove_compressor(VP9_COMP *cpi) {
         fprintf(f, "%s\t%8.0f\n", results, total_encode_time);
       }
 
+      // The tile workers' counts are added to cpi->td after each frame.
+      fprintf(f, "Model rd cache: %"PRId64" hits / %"PRId64" lookups\n",
+              cpi->td.mb.model_rd_cache.hits,
+              cpi->td.mb.model_rd_cache.lookups);
+
+      if (cpi->sf.use_nonrd_pick_mode) {
+        static const char *const mode_names[INTER_MODES] = {
+          "NEARESTMV", "NEARMV", "ZEROMV", "NEWMV"
+        };
+        int m;
+        for (m = 0; m < INTER_MODES; ++m) {
+          fprintf(f, "RT %-9s: %"PRId64" evaluated, %"PRId64" in place\n",
+                  mode_names[m], cpi->td.mb.rt_mode_evals[m],
+                  cpi->td.mb.rt_mode_in_place[m]);
+        }
+      }
+
       fclose(f);
     }
 
@@ -2530,12 +2559,78 @@ void vp9_write_yuv_rec_frame(VP9_COMMON *cm) {
 }
 #endif
 
+// The frame scaling below is split between the tile encoding workers, when
+// there are any, by bands of rows or columns. |start| of each worker's
+// EncWorkerData picks its band.
+typedef struct ScaleJob {
+  const YV12_BUFFER_CONFIG *src;
+  YV12_BUFFER_CONFIG *dst;
+  uint8_t *intbufs[MAX_MB_PLANE];
+#if CONFIG_VP9_HIGHBITDEPTH
+  int bd;
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+} ScaleJob;
+
+static int scale_nonnormative_horiz_worker(EncWorkerData *const thread_data,
+                                           ScaleJob *const job) {
+  const YV12_BUFFER_CONFIG *const src = job->src;
+  const YV12_BUFFER_CONFIG *const dst = job->dst;
+  const int band = thread_data->start;
+  const int num_bands = thread_data->cpi->num_workers;
+  int i;
+
+  for (i = 0; i < MAX_MB_PLANE; ++i) {
+    const int is_uv = i > 0;
+    const int height = is_uv ? src->uv_crop_height : src->y_crop_height;
+    vp9_resize_plane_horiz(is_uv ? (i == 1 ? src->u_buffer : src->v_buffer) :
+                                   src->y_buffer,
+                           height,
+                           is_uv ? src->uv_crop_width : src->y_crop_width,
+                           is_uv ? src->uv_stride : src->y_stride,
+                           job->intbufs[i],
+                           is_uv ? dst->uv_crop_width : dst->y_crop_width,
+                           height * band / num_bands,
+                           height * (band + 1) / num_bands);
+  }
+  return 1;
+}
+
+static int scale_nonnormative_vert_worker(EncWorkerData *const thread_data,
+                                          ScaleJob *const job) {
+  const YV12_BUFFER_CONFIG *const src = job->src;
+  const YV12_BUFFER_CONFIG *const dst = job->dst;
+  const int band = thread_data->start;
+  const int num_bands = thread_data->cpi->num_workers;
+  int i;
+
+  for (i = 0; i < MAX_MB_PLANE; ++i) {
+    const int is_uv = i > 0;
+    const int width2 = is_uv ? dst->uv_crop_width : dst->y_crop_width;
+    // Keep the column bands a multiple of 32 pixels wide for the SIMD
+    // filters.
+    const int band_width =
+        ALIGN_POWER_OF_TWO((width2 + num_bands - 1) / num_bands, 5);
+    const int col_start = VPXMIN(band * band_width, width2);
+    vp9_resize_plane_vert(job->intbufs[i],
+                          is_uv ? src->uv_crop_height : src->y_crop_height,
+                          width2,
+                          is_uv ? (i == 1 ? dst->u_buffer : dst->v_buffer) :
+                                  dst->y_buffer,
+                          is_uv ? dst->uv_crop_height : dst->y_crop_height,
+                          is_uv ? dst->uv_stride : dst->y_stride,
+                          col_start, VPXMIN(col_start + band_width, width2));
+  }
+  return 1;
+}
+
 #if CONFIG_VP9_HIGHBITDEPTH
-static void scale_and_extend_frame_nonnormative(const YV12_BUFFER_CONFIG *src,
+static void scale_and_extend_frame_nonnormative(VP9_COMP *cpi,
+                                                const YV12_BUFFER_CONFIG *src,
                                                 YV12_BUFFER_CONFIG *dst,
                                                 int bd) {
 #else
-static void scale_and_extend_frame_nonnormative(const YV12_BUFFER_CONFIG *src,
+static void scale_and_extend_frame_nonnormative(VP9_COMP *cpi,
+                                                const YV12_BUFFER_CONFIG *src,
                                                 YV12_BUFFER_CONFIG *dst) {
 #endif  // CONFIG_VP9_HIGHBITDEPTH
   // TODO(dkovalev): replace YV12_BUFFER_CONFIG with vpx_image_t
@@ -2553,31 +2648,46 @@ static void scale_and_extend_frame_nonnormative(const YV12_BUFFER_CONFIG *src,
   const int dst_heights[3] = {dst->y_crop_height, dst->uv_crop_height,
                               dst->uv_crop_height};
 
-  for (i = 0; i < MAX_MB_PLANE; ++i) {
 #if CONFIG_VP9_HIGHBITDEPTH
-    if (src->flags & YV12_FLAG_HIGHBITDEPTH) {
+  if (src->flags & YV12_FLAG_HIGHBITDEPTH) {
+    for (i = 0; i < MAX_MB_PLANE; ++i)
       vp9_highbd_resize_plane(srcs[i], src_heights[i], src_widths[i],
                               src_strides[i], dsts[i], dst_heights[i],
                               dst_widths[i], dst_strides[i], bd);
-    } else {
+    vpx_extend_frame_borders(dst);
+    return;
+  }
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+  if (cpi->num_workers > 1) {
+    // All the rows have to be resized horizontally before any column can be
+    // resized vertically, so the two passes are run one after the other.
+    VP9_COMMON *const cm = &cpi->common;
+    ScaleJob job;
+    job.src = src;
+    job.dst = dst;
+    for (i = 0; i < MAX_MB_PLANE; ++i)
+      CHECK_MEM_ERROR(cm, job.intbufs[i],
+                      vpx_malloc(sizeof(*job.intbufs[i]) * dst_widths[i] *
+                                 src_heights[i]));
+    vp9_run_enc_workers(cpi, (VPxWorkerHook)scale_nonnormative_horiz_worker,
+                        &job);
+    vp9_run_enc_workers(cpi, (VPxWorkerHook)scale_nonnormative_vert_worker,
+                        &job);
+    for (i = 0; i < MAX_MB_PLANE; ++i)
+      vpx_free(job.intbufs[i]);
+  } else {
+    for (i = 0; i < MAX_MB_PLANE; ++i)
       vp9_resize_plane(srcs[i], src_heights[i], src_widths[i], src_strides[i],
                        dsts[i], dst_heights[i], dst_widths[i], dst_strides[i]);
-    }
-#else
-    vp9_resize_plane(srcs[i], src_heights[i], src_widths[i], src_strides[i],
-                     dsts[i], dst_heights[i], dst_widths[i], dst_strides[i]);
-#endif  // CONFIG_VP9_HIGHBITDEPTH
   }
   vpx_extend_frame_borders(dst);
 }
 
-#if CONFIG_VP9_HIGHBITDEPTH
-static void scale_and_extend_frame(const YV12_BUFFER_CONFIG *src,
-                                   YV12_BUFFER_CONFIG *dst, int bd) {
-#else
-static void scale_and_extend_frame(const YV12_BUFFER_CONFIG *src,
-                                   YV12_BUFFER_CONFIG *dst) {
-#endif  // CONFIG_VP9_HIGHBITDEPTH
+// Scales the rows of 16x16 luma blocks from |start| on, stepping by |step|.
+static void scale_frame_rows(const ScaleJob *const job, int start, int step) {
+  const YV12_BUFFER_CONFIG *const src = job->src;
+  const YV12_BUFFER_CONFIG *const dst = job->dst;
   const int src_w = src->y_crop_width;
   const int src_h = src->y_crop_height;
   const int dst_w = dst->y_crop_width;
@@ -2589,7 +2699,7 @@ static void scale_and_extend_frame(const YV12_BUFFER_CONFIG *src,
   const InterpKernel *const kernel = vp9_filter_kernels[EIGHTTAP];
   int x, y, i;
 
-  for (y = 0; y < dst_h; y += 16) {
+  for (y = 16 * start; y < dst_h; y += 16 * step) {
     for (x = 0; x < dst_w; x += 16) {
       for (i = 0; i < MAX_MB_PLANE; ++i) {
         const int factor = (i == 0 || i == 3 ? 1 : 2);
@@ -2606,7 +2716,7 @@ static void scale_and_extend_frame(const YV12_BUFFER_CONFIG *src,
           vpx_highbd_convolve8(src_ptr, src_stride, dst_ptr, dst_stride,
                                kernel[x_q4 & 0xf], 16 * src_w / dst_w,
                                kernel[y_q4 & 0xf], 16 * src_h / dst_h,
-                               16 / factor, 16 / factor, bd);
+                               16 / factor, 16 / factor, job->bd);
         } else {
           vpx_scaled_2d(src_ptr, src_stride, dst_ptr, dst_stride,
                         kernel[x_q4 & 0xf], 16 * src_w / dst_w,
@@ -2622,6 +2732,36 @@ static void scale_and_extend_frame(const YV12_BUFFER_CONFIG *src,
       }
     }
   }
+}
+
+static int scale_frame_worker(EncWorkerData *const thread_data,
+                              ScaleJob *const job) {
+  scale_frame_rows(job, thread_data->start, thread_data->cpi->num_workers);
+  return 1;
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+static void scale_and_extend_frame(VP9_COMP *cpi,
+                                   const YV12_BUFFER_CONFIG *src,
+                                   YV12_BUFFER_CONFIG *dst, int bd) {
+#else
+static void scale_and_extend_frame(VP9_COMP *cpi,
+                                   const YV12_BUFFER_CONFIG *src,
+                                   YV12_BUFFER_CONFIG *dst) {
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+  ScaleJob job;
+  job.src = src;
+  job.dst = dst;
+#if CONFIG_VP9_HIGHBITDEPTH
+  job.bd = bd;
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+
+  // Each block reads only the source frame, so the rows of blocks can be
+  // scaled in any order.
+  if (cpi->num_workers > 1)
+    vp9_run_enc_workers(cpi, (VPxWorkerHook)scale_frame_worker, &job);
+  else
+    scale_frame_rows(&job, 0, 1);
 
   vpx_extend_frame_borders(dst);
 }
@@ -2764,12 +2904,11 @@ void vp9_update_reference_frames(VP9_COMP *cpi) {
 static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
   MACROBLOCKD *xd = &cpi->td.mb.e_mbd;
   struct loopfilter *lf = &cm->lf;
+  struct vpx_usec_timer timer;
 
   if (xd->lossless) {
       lf->filter_level = 0;
   } else {
-    struct vpx_usec_timer timer;
-
     vpx_clear_system_state();
 
     vpx_usec_timer_start(&timer);
@@ -2778,8 +2917,14 @@ static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
 
     vpx_usec_timer_mark(&timer);
     cpi->time_pick_lpf += vpx_usec_timer_elapsed(&timer);
+#if CONFIG_PERF_STATS
+    cpi->perf_frame.loopfilter_pick_us += vpx_usec_timer_elapsed(&timer);
+#endif
   }
 
+#if CONFIG_PERF_STATS
+  vpx_usec_timer_start(&timer);
+#endif
   if (lf->filter_level > 0) {
     vp9_build_mask_frame(cm, lf->filter_level, 0);
 
@@ -2791,8 +2936,17 @@ static void loopfilter_frame(VP9_COMP *cpi, VP9_COMMON *cm) {
     else
       vp9_loop_filter_frame(cm->frame_to_show, cm, xd, lf->filter_level, 0, 0);
   }
+#if CONFIG_PERF_STATS
+  vpx_usec_timer_mark(&timer);
+  cpi->perf_frame.loopfilter_us += vpx_usec_timer_elapsed(&timer);
+  vpx_usec_timer_start(&timer);
+#endif
 
   vpx_extend_frame_inner_borders(cm->frame_to_show);
+#if CONFIG_PERF_STATS
+  vpx_usec_timer_mark(&timer);
+  cpi->perf_frame.extend_us += vpx_usec_timer_elapsed(&timer);
+#endif
 }
 
 static INLINE void alloc_frame_mvs(const VP9_COMMON *cm,
@@ -2848,7 +3002,8 @@ void vp9_scale_references(VP9_COMP *cpi) {
                                    cm->use_highbitdepth,
                                    VP9_ENC_BORDER_IN_PIXELS, cm->byte_alignment,
                                    NULL, NULL, NULL);
-          scale_and_extend_frame(ref, &new_fb_ptr->buf, (int)cm->bit_depth);
+          scale_and_extend_frame(cpi, ref, &new_fb_ptr->buf,
+                                 (int)cm->bit_depth);
           cpi->scaled_ref_idx[ref_frame - 1] = new_fb;
           alloc_frame_mvs(cm, new_fb);
         }
@@ -2872,7 +3027,7 @@ void vp9_scale_references(VP9_COMP *cpi) {
                                    cm->subsampling_x, cm->subsampling_y,
                                    VP9_ENC_BORDER_IN_PIXELS, cm->byte_alignment,
                                    NULL, NULL, NULL);
-          scale_and_extend_frame(ref, &new_fb_ptr->buf);
+          scale_and_extend_frame(cpi, ref, &new_fb_ptr->buf);
           cpi->scaled_ref_idx[ref_frame - 1] = new_fb;
           alloc_frame_mvs(cm, new_fb);
         }
@@ -3207,7 +3362,7 @@ static void encode_without_recode_loop(VP9_COMP *cpi,
 
   set_frame_size(cpi);
 
-  cpi->Source = vp9_scale_if_required(cm,
+  cpi->Source = vp9_scale_if_required(cpi,
                                       cpi->un_scaled_source,
                                       &cpi->scaled_source,
                                       (cpi->oxcf.pass == 0));
@@ -3218,7 +3373,7 @@ static void encode_without_recode_loop(VP9_COMP *cpi,
   if (cpi->unscaled_last_source != NULL &&
       (cpi->oxcf.content == VP9E_CONTENT_SCREEN ||
       cpi->sf.partition_search_type == SOURCE_VAR_BASED_PARTITION))
-    cpi->Last_Source = vp9_scale_if_required(cm,
+    cpi->Last_Source = vp9_scale_if_required(cpi,
                                              cpi->unscaled_last_source,
                                              &cpi->scaled_last_source,
                                              (cpi->oxcf.pass == 0));
@@ -3352,12 +3507,12 @@ static void encode_with_recode_loop(VP9_COMP *cpi,
                                        &frame_over_shoot_limit);
     }
 
-    cpi->Source = vp9_scale_if_required(cm, cpi->un_scaled_source,
+    cpi->Source = vp9_scale_if_required(cpi, cpi->un_scaled_source,
                                       &cpi->scaled_source,
                                       (cpi->oxcf.pass == 0));
 
     if (cpi->unscaled_last_source != NULL)
-      cpi->Last_Source = vp9_scale_if_required(cm, cpi->unscaled_last_source,
+      cpi->Last_Source = vp9_scale_if_required(cpi, cpi->unscaled_last_source,
                                                &cpi->scaled_last_source,
                                                (cpi->oxcf.pass == 0));
 
@@ -3608,22 +3763,24 @@ static void set_ext_overrides(VP9_COMP *cpi) {
   }
 }
 
-YV12_BUFFER_CONFIG *vp9_scale_if_required(VP9_COMMON *cm,
+YV12_BUFFER_CONFIG *vp9_scale_if_required(VP9_COMP *cpi,
                                           YV12_BUFFER_CONFIG *unscaled,
                                           YV12_BUFFER_CONFIG *scaled,
                                           int use_normative_scaler) {
+  VP9_COMMON *const cm = &cpi->common;
   if (cm->mi_cols * MI_SIZE != unscaled->y_width ||
       cm->mi_rows * MI_SIZE != unscaled->y_height) {
 #if CONFIG_VP9_HIGHBITDEPTH
     if (use_normative_scaler)
-      scale_and_extend_frame(unscaled, scaled, (int)cm->bit_depth);
+      scale_and_extend_frame(cpi, unscaled, scaled, (int)cm->bit_depth);
     else
-      scale_and_extend_frame_nonnormative(unscaled, scaled, (int)cm->bit_depth);
+      scale_and_extend_frame_nonnormative(cpi, unscaled, scaled,
+                                          (int)cm->bit_depth);
 #else
     if (use_normative_scaler)
-      scale_and_extend_frame(unscaled, scaled);
+      scale_and_extend_frame(cpi, unscaled, scaled);
     else
-      scale_and_extend_frame_nonnormative(unscaled, scaled);
+      scale_and_extend_frame_nonnormative(cpi, unscaled, scaled);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
     return scaled;
   } else {
@@ -4000,10 +4157,14 @@ static void setup_denoiser_buffer(VP9_COMP *cpi) {
 
 int vp9_receive_raw_frame(VP9_COMP *cpi, unsigned int frame_flags,
                           YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
-                          int64_t end_time) {
+                          int64_t end_time,
+                          const struct lookahead_ext_frame *ext) {
   VP9_COMMON *cm = &cpi->common;
   struct vpx_usec_timer timer;
   int res = 0;
+  // The denoiser writes back into the source frame, so frames it may touch
+  // are always copied.
+  const int reference_ext = ext != NULL && cpi->oxcf.noise_sensitivity == 0;
   const int subsampling_x = sd->subsampling_x;
   const int subsampling_y = sd->subsampling_y;
 #if CONFIG_VP9_HIGHBITDEPTH
@@ -4022,10 +4183,15 @@ int vp9_receive_raw_frame(VP9_COMP *cpi, unsigned int frame_flags,
 #if CONFIG_VP9_HIGHBITDEPTH
                          use_highbitdepth,
 #endif  // CONFIG_VP9_HIGHBITDEPTH
-                         frame_flags))
+                         frame_flags, reference_ext ? ext : NULL))
     res = -1;
+  if (ext != NULL && !reference_ext)
+    ext->release_cb(ext->cb_priv, &ext->img);
   vpx_usec_timer_mark(&timer);
   cpi->time_receive_data += vpx_usec_timer_elapsed(&timer);
+#if CONFIG_PERF_STATS
+  cpi->perf_frame.lookahead_us += vpx_usec_timer_elapsed(&timer);
+#endif
 
   if ((cm->profile == PROFILE_0 || cm->profile == PROFILE_2) &&
       (subsampling_x != 1 || subsampling_y != 1)) {
@@ -4043,6 +4209,27 @@ int vp9_receive_raw_frame(VP9_COMP *cpi, unsigned int frame_flags,
   return res;
 }
 
+int vp9_stage_raw_frame(VP9_COMP *cpi, YV12_BUFFER_CONFIG *sd,
+                        const struct lookahead_ext_frame *ext) {
+  // Same choice between referencing and copying as vp9_receive_raw_frame().
+  const int reference_ext = ext != NULL && cpi->oxcf.noise_sensitivity == 0;
+
+  if (cpi->lookahead == NULL)
+    return -1;
+  if (vp9_lookahead_stage(cpi->lookahead, sd,
+#if CONFIG_VP9_HIGHBITDEPTH
+                          sd->flags & YV12_FLAG_HIGHBITDEPTH,
+#endif  // CONFIG_VP9_HIGHBITDEPTH
+                          reference_ext ? ext : NULL))
+    return -1;
+  return 0;
+}
+
+void vp9_drop_staged_frame(VP9_COMP *cpi) {
+  if (cpi->lookahead != NULL)
+    vp9_lookahead_unstage(cpi->lookahead);
+}
+
 
 static int frame_is_reference(const VP9_COMP *cpi) {
   const VP9_COMMON *cm = &cpi->common;
@@ -4150,8 +4337,91 @@ static void adjust_image_stat(double y, double u, double v, double all,
   s->stat[ALL] += all;
   s->worst = VPXMIN(s->worst, all);
 }
+
+// Copies the visible area of |src| to |dst|, reallocating it as needed.
+static void copy_metrics_frame(VP9_COMMON *cm, const YV12_BUFFER_CONFIG *src,
+                               YV12_BUFFER_CONFIG *dst) {
+  int row;
+
+  if (vpx_realloc_frame_buffer(dst, src->y_crop_width, src->y_crop_height,
+                               cm->subsampling_x, cm->subsampling_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+                               0,
+#endif
+                               VP9_ENC_BORDER_IN_PIXELS, cm->byte_alignment,
+                               NULL, NULL, NULL))
+    vpx_internal_error(&cm->error, VPX_CODEC_MEM_ERROR,
+                       "Failed to allocate metrics frame buffer");
+
+  for (row = 0; row < src->y_crop_height; ++row) {
+    memcpy(dst->y_buffer + row * dst->y_stride,
+           src->y_buffer + row * src->y_stride, src->y_crop_width);
+  }
+  for (row = 0; row < src->uv_crop_height; ++row) {
+    memcpy(dst->u_buffer + row * dst->uv_stride,
+           src->u_buffer + row * src->uv_stride, src->uv_crop_width);
+    memcpy(dst->v_buffer + row * dst->uv_stride,
+           src->v_buffer + row * src->uv_stride, src->uv_crop_width);
+  }
+}
+
+static int metrics_worker_hook(VP9_COMP *cpi, void *unused) {
+  double y, u, v, frame_all;
+  (void)unused;
+
+  frame_all = vpx_calc_fastssim(&cpi->metrics_source, &cpi->metrics_recon,
+                                &y, &u, &v);
+  adjust_image_stat(y, u, v, frame_all, &cpi->fastssim);
+  /* TODO(JBB): add 10/12 bit support */
+
+  frame_all = vpx_psnrhvs(&cpi->metrics_source, &cpi->metrics_recon,
+                          &y, &u, &v);
+  adjust_image_stat(y, u, v, frame_all, &cpi->psnrhvs);
+  return 1;
+}
+
+// Starts the FastSSIM and PSNR-HVS of the frame just shown on
+// metrics_worker, after the previous frame's are done with the copies.
+static void launch_metrics_worker(VP9_COMP *cpi) {
+  VP9_COMMON *const cm = &cpi->common;
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  VPxWorker *const worker = &cpi->metrics_worker;
+
+  winterface->sync(worker);
+  copy_metrics_frame(cm, cpi->Source, &cpi->metrics_source);
+  copy_metrics_frame(cm, cm->frame_to_show, &cpi->metrics_recon);
+
+  worker->hook = (VPxWorkerHook)metrics_worker_hook;
+  worker->data1 = cpi;
+  worker->data2 = NULL;
+  winterface->launch(worker);
+}
 #endif  // CONFIG_INTERNAL_STATS
 
+#if CONFIG_PERF_STATS
+// Closes the statistics of the frame just coded.
+static void update_perf_stats(VP9_COMP *cpi) {
+  const vpx_enc_frame_perf_t *const f = &cpi->perf_frame;
+  vpx_enc_frame_perf_t *const t = &cpi->perf_stats.total;
+
+  t->lookahead_us += f->lookahead_us;
+  t->first_pass_us += f->first_pass_us;
+  t->temporal_filter_us += f->temporal_filter_us;
+  t->encode_us += f->encode_us;
+  t->thread_wait_us += f->thread_wait_us;
+  t->loopfilter_pick_us += f->loopfilter_pick_us;
+  t->loopfilter_us += f->loopfilter_us;
+  t->extend_us += f->extend_us;
+  t->pack_us += f->pack_us;
+  t->frame_us += f->frame_us;
+  t->motion_searches += f->motion_searches;
+  t->tokens += f->tokens;
+  cpi->perf_stats.last_frame = *f;
+  ++cpi->perf_stats.frames;
+  vp9_zero(cpi->perf_frame);
+}
+#endif
+
 int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
                             size_t *size, uint8_t *dest,
                             int64_t *time_stamp, int64_t *time_end, int flush) {
@@ -4230,8 +4500,16 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
 
       if (oxcf->arnr_max_frames > 0) {
         // Produce the filtered ARF frame.
+#if CONFIG_PERF_STATS
+        struct vpx_usec_timer timer;
+        vpx_usec_timer_start(&timer);
+#endif
         vp9_temporal_filter(cpi, arf_src_index);
         vpx_extend_frame_borders(&cpi->alt_ref_buffer);
+#if CONFIG_PERF_STATS
+        vpx_usec_timer_mark(&timer);
+        cpi->perf_frame.temporal_filter_us += vpx_usec_timer_elapsed(&timer);
+#endif
         force_src_buffer = &cpi->alt_ref_buffer;
       }
 
@@ -4370,7 +4648,17 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
     cpi->td.mb.fwd_txm4x4 = lossless ? vp9_fwht4x4 : vpx_fdct4x4;
 #endif  // CONFIG_VP9_HIGHBITDEPTH
     cpi->td.mb.itxm_add = lossless ? vp9_iwht4x4_add : vp9_idct4x4_add;
+#if CONFIG_PERF_STATS
+    {
+      struct vpx_usec_timer timer;
+      vpx_usec_timer_start(&timer);
+      vp9_first_pass(cpi, source);
+      vpx_usec_timer_mark(&timer);
+      cpi->perf_frame.first_pass_us += vpx_usec_timer_elapsed(&timer);
+    }
+#else
     vp9_first_pass(cpi, source);
+#endif
   } else if (oxcf->pass == 2 &&
       (!cpi->use_svc || is_two_pass_svc(cpi))) {
     Pass2Encode(cpi, size, dest, frame_flags);
@@ -4403,6 +4691,10 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
 
   vpx_usec_timer_mark(&cmptimer);
   cpi->time_compress_data += vpx_usec_timer_elapsed(&cmptimer);
+#if CONFIG_PERF_STATS
+  cpi->perf_frame.frame_us = vpx_usec_timer_elapsed(&cmptimer);
+  update_perf_stats(cpi);
+#endif
 
   if (cpi->b_calculate_psnr && oxcf->pass != 1 && cm->show_frame)
     generate_psnr_packet(cpi);
@@ -4560,21 +4852,7 @@ int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
 #if CONFIG_VP9_HIGHBITDEPTH
       if (!cm->use_highbitdepth)
 #endif
-      {
-        double y, u, v, frame_all;
-        frame_all = vpx_calc_fastssim(cpi->Source, cm->frame_to_show, &y, &u,
-                                      &v);
-        adjust_image_stat(y, u, v, frame_all, &cpi->fastssim);
-        /* TODO(JBB): add 10/12 bit support */
-      }
-#if CONFIG_VP9_HIGHBITDEPTH
-      if (!cm->use_highbitdepth)
-#endif
-      {
-        double y, u, v, frame_all;
-        frame_all = vpx_psnrhvs(cpi->Source, cm->frame_to_show, &y, &u, &v);
-        adjust_image_stat(y, u, v, frame_all, &cpi->psnrhvs);
-      }
+        launch_metrics_worker(cpi);
     }
   }
 
@@ -4617,7 +4895,7 @@ int vp9_get_preview_raw_frame(VP9_COMP *cpi, YV12_BUFFER_CONFIG *dest,
   } else {
     int ret;
 #if CONFIG_VP9_POSTPROC
-    ret = vp9_post_proc_frame(cm, dest, flags);
+    ret = vp9_post_proc_frame(cm, dest, flags, NULL, 0);
 #else
     if (cm->frame_to_show) {
       *dest = *cm->frame_to_show;
@@ -396,6 +396,13 @@ typedef struct VP9_COMP {
   uint64_t time_pick_lpf;
   uint64_t time_encode_sb_row;
 
+#if CONFIG_PERF_STATS
+  // Stage timings and counters of the frame being coded, and the statistics
+  // returned by VP9E_GET_PERF_STATS.
+  vpx_enc_frame_perf_t perf_frame;
+  vpx_enc_perf_stats_t perf_stats;
+#endif
+
 #if CONFIG_FP_MB_STATS
   int use_fp_mb_stats;
 #endif
@@ -432,6 +439,13 @@ typedef struct VP9_COMP {
   ImageStat fastssim;
   ImageStat psnrhvs;
 
+  // FastSSIM and PSNR-HVS are computed on metrics_worker, off the encoding
+  // thread, from copies of the source and reconstruction of the last shown
+  // frame. Both stats are only valid after the worker is synced.
+  VPxWorker metrics_worker;
+  YV12_BUFFER_CONFIG metrics_source;
+  YV12_BUFFER_CONFIG metrics_recon;
+
   int b_calculate_ssimg;
   int b_calculate_blockiness;
 
@@ -514,10 +528,22 @@ void vp9_remove_compressor(VP9_COMP *cpi);
 void vp9_change_config(VP9_COMP *cpi, const VP9EncoderConfig *oxcf);
 
   // receive a frames worth of data. caller can assume that a copy of this
-  // frame is made and not just a copy of the pointer..
+  // frame is made and not just a copy of the pointer, unless ext is non-NULL:
+  // then the frame may be referenced until ext's release callback is called.
 int vp9_receive_raw_frame(VP9_COMP *cpi, unsigned int frame_flags,
                           YV12_BUFFER_CONFIG *sd, int64_t time_stamp,
-                          int64_t end_time_stamp);
+                          int64_t end_time_stamp,
+                          const struct lookahead_ext_frame *ext);
+
+  // Copies the frame passed to the next vp9_receive_raw_frame() call into
+  // the lookahead ahead of time. Touches nothing the encoder uses, so it may
+  // run while the previous frame is being encoded. Frames that arrive before
+  // the lookahead is allocated are not staged.
+int vp9_stage_raw_frame(VP9_COMP *cpi, YV12_BUFFER_CONFIG *sd,
+                        const struct lookahead_ext_frame *ext);
+
+  // Drops the staged frame when it is not going to be received.
+void vp9_drop_staged_frame(VP9_COMP *cpi);
 
 int vp9_get_compressed_data(VP9_COMP *cpi, unsigned int *frame_flags,
                             size_t *size, uint8_t *dest,
@@ -614,7 +640,7 @@ void vp9_update_reference_frames(VP9_COMP *cpi);
 
 void vp9_set_high_precision_mv(VP9_COMP *cpi, int allow_high_precision_mv);
 
-YV12_BUFFER_CONFIG *vp9_scale_if_required(VP9_COMMON *cm,
+YV12_BUFFER_CONFIG *vp9_scale_if_required(VP9_COMP *cpi,
                                           YV12_BUFFER_CONFIG *unscaled,
                                           YV12_BUFFER_CONFIG *scaled,
                                           int use_normative_scaler);
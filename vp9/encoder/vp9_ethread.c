@@ -12,6 +12,7 @@
 #include "vp9/encoder/vp9_encoder.h"
 #include "vp9/encoder/vp9_ethread.h"
 #include "vpx_dsp/vpx_dsp_common.h"
+#include "vpx_ports/vpx_timer.h"
 
 static void accumulate_rd_opt(ThreadData *td, ThreadData *td_t) {
   int i, j, k, l, m, n;
@@ -142,6 +143,14 @@ void vp9_encode_tiles_mt(VP9_COMP *cpi) {
     if (thread_data->td != &cpi->td) {
       thread_data->td->mb = cpi->td.mb;
       thread_data->td->rd_counts = cpi->td.rd_counts;
+#if CONFIG_INTERNAL_STATS
+      // The worker counts this frame only; its counts are added to the
+      // totals in cpi->td after the sync.
+      thread_data->td->mb.model_rd_cache.lookups = 0;
+      thread_data->td->mb.model_rd_cache.hits = 0;
+      vp9_zero(thread_data->td->mb.rt_mode_evals);
+      vp9_zero(thread_data->td->mb.rt_mode_in_place);
+#endif
     }
     if (thread_data->td->counts != &cpi->common.counts) {
       memcpy(thread_data->td->counts, &cpi->common.counts,
@@ -181,9 +190,19 @@ void vp9_encode_tiles_mt(VP9_COMP *cpi) {
   }
 
   // Encoding ends.
-  for (i = 0; i < num_workers; i++) {
-    VPxWorker *const worker = &cpi->workers[i];
-    winterface->sync(worker);
+  {
+#if CONFIG_PERF_STATS
+    struct vpx_usec_timer timer;
+    vpx_usec_timer_start(&timer);
+#endif
+    for (i = 0; i < num_workers; i++) {
+      VPxWorker *const worker = &cpi->workers[i];
+      winterface->sync(worker);
+    }
+#if CONFIG_PERF_STATS
+    vpx_usec_timer_mark(&timer);
+    cpi->perf_frame.thread_wait_us += vpx_usec_timer_elapsed(&timer);
+#endif
   }
 
   for (i = 0; i < num_workers; i++) {
@@ -194,6 +213,45 @@ void vp9_encode_tiles_mt(VP9_COMP *cpi) {
     if (i < cpi->num_workers - 1) {
       vp9_accumulate_frame_counts(&cm->counts, thread_data->td->counts, 0);
       accumulate_rd_opt(&cpi->td, thread_data->td);
+#if CONFIG_PERF_STATS
+      cpi->td.mb.motion_searches += thread_data->td->mb.motion_searches;
+#endif
+#if CONFIG_INTERNAL_STATS
+      cpi->td.mb.model_rd_cache.lookups +=
+          thread_data->td->mb.model_rd_cache.lookups;
+      cpi->td.mb.model_rd_cache.hits += thread_data->td->mb.model_rd_cache.hits;
+      {
+        int m;
+        for (m = 0; m < INTER_MODES; ++m) {
+          cpi->td.mb.rt_mode_evals[m] += thread_data->td->mb.rt_mode_evals[m];
+          cpi->td.mb.rt_mode_in_place[m] +=
+              thread_data->td->mb.rt_mode_in_place[m];
+        }
+      }
+#endif
     }
   }
 }
+
+void vp9_run_enc_workers(VP9_COMP *cpi, VPxWorkerHook hook, void *data) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  int i;
+
+  for (i = 0; i < cpi->num_workers; i++) {
+    VPxWorker *const worker = &cpi->workers[i];
+    EncWorkerData *const thread_data = &cpi->tile_thr_data[i];
+
+    thread_data->start = i;
+    worker->hook = hook;
+    worker->data1 = thread_data;
+    worker->data2 = data;
+
+    if (i == cpi->num_workers - 1)
+      winterface->execute(worker);
+    else
+      winterface->launch(worker);
+  }
+
+  for (i = 0; i < cpi->num_workers; i++)
+    winterface->sync(&cpi->workers[i]);
+}
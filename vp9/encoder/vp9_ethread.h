@@ -11,6 +11,8 @@
 #ifndef VP9_ENCODER_VP9_ETHREAD_H_
 #define VP9_ENCODER_VP9_ETHREAD_H_
 
+#include "vpx_util/vpx_thread.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -26,6 +28,12 @@ typedef struct EncWorkerData {
 
 void vp9_encode_tiles_mt(struct VP9_COMP *cpi);
 
+// Runs |hook| on each of the cpi->num_workers tile encoding workers, the last
+// one on the calling thread, and waits for them all. Each call gets its
+// EncWorkerData, with |start| set to the worker index, and |data|.
+void vp9_run_enc_workers(struct VP9_COMP *cpi, VPxWorkerHook hook,
+                         void *data);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -31,16 +31,42 @@ static struct lookahead_entry *pop(struct lookahead_ctx *ctx,
   return buf;
 }
 
+/* Hand an application-owned frame back once it is no longer referenced. The
+ * entry is left without a buffer; one is allocated when it is next copied
+ * into.
+ */
+static void release_external(struct lookahead_entry *buf) {
+  if (buf->external) {
+    buf->ext.release_cb(buf->ext.cb_priv, &buf->ext.img);
+    memset(&buf->img, 0, sizeof(buf->img));
+    buf->external = 0;
+  }
+}
+
+/* Referenced frames get the same border extension as copied ones, done in
+ * place the first time the frame is handed out.
+ */
+static struct lookahead_entry *prepare(struct lookahead_entry *buf) {
+  if (buf != NULL && buf->external && !buf->borders_extended) {
+    vp9_copy_and_extend_frame(&buf->img, &buf->img);
+    buf->borders_extended = 1;
+  }
+  return buf;
+}
+
 
 void vp9_lookahead_destroy(struct lookahead_ctx *ctx) {
   if (ctx) {
     if (ctx->buf) {
       unsigned int i;
 
-      for (i = 0; i < ctx->max_sz; i++)
+      for (i = 0; i < ctx->max_sz; i++) {
+        release_external(&ctx->buf[i]);
         vpx_free_frame_buffer(&ctx->buf[i].img);
+      }
       free(ctx->buf);
     }
+    vpx_free_frame_buffer(&ctx->stage_img);
     free(ctx);
   }
 }
@@ -89,41 +115,135 @@ struct lookahead_ctx *vp9_lookahead_init(unsigned int width,
 
 #define USE_PARTIAL_COPY 0
 
+/* Describe an application-owned frame as a queue buffer, without copying
+ * it. */
+static void reference_frame(YV12_BUFFER_CONFIG *img,
+                            const YV12_BUFFER_CONFIG *src) {
+  const int aligned_width = (src->y_crop_width + 7) & ~7;
+  const int aligned_height = (src->y_crop_height + 7) & ~7;
+
+  *img = *src;
+  img->y_width = aligned_width;
+  img->y_height = aligned_height;
+  img->uv_width = aligned_width >> src->subsampling_x;
+  img->uv_height = aligned_height >> src->subsampling_y;
+  img->border = VP9_ENC_BORDER_IN_PIXELS;
+}
+
+/* Make img large enough for src, reallocating it only if it is too small. */
+static int resize_frame(YV12_BUFFER_CONFIG *img, const YV12_BUFFER_CONFIG *src
+#if CONFIG_VP9_HIGHBITDEPTH
+                        , int use_highbitdepth
+#endif
+                        ) {
+  const int new_dimensions = src->y_crop_width != img->y_crop_width ||
+                             src->y_crop_height != img->y_crop_height ||
+                             src->uv_crop_width != img->uv_crop_width ||
+                             src->uv_crop_height != img->uv_crop_height;
+  const int larger_dimensions = src->y_crop_width > img->y_width ||
+                                src->y_crop_height > img->y_height ||
+                                src->uv_crop_width > img->uv_width ||
+                                src->uv_crop_height > img->uv_height;
+  assert(!larger_dimensions || new_dimensions);
+
+  if (larger_dimensions) {
+    YV12_BUFFER_CONFIG new_img;
+    memset(&new_img, 0, sizeof(new_img));
+    if (vpx_alloc_frame_buffer(&new_img,
+                               src->y_crop_width, src->y_crop_height,
+                               src->subsampling_x, src->subsampling_y,
+#if CONFIG_VP9_HIGHBITDEPTH
+                               use_highbitdepth,
+#endif
+                               VP9_ENC_BORDER_IN_PIXELS,
+                               0))
+      return 1;
+    vpx_free_frame_buffer(img);
+    *img = new_img;
+  } else if (new_dimensions) {
+    img->y_crop_width = src->y_crop_width;
+    img->y_crop_height = src->y_crop_height;
+    img->uv_crop_width = src->uv_crop_width;
+    img->uv_crop_height = src->uv_crop_height;
+    img->subsampling_x = src->subsampling_x;
+    img->subsampling_y = src->subsampling_y;
+  }
+  return 0;
+}
+
+int vp9_lookahead_stage(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
+#if CONFIG_VP9_HIGHBITDEPTH
+                        int use_highbitdepth,
+#endif
+                        const struct lookahead_ext_frame *ext) {
+  ctx->staged = 0;
+  if (ext != NULL && ext->border >= VP9_ENC_BORDER_IN_PIXELS) {
+    YV12_BUFFER_CONFIG img;
+    reference_frame(&img, src);
+    vp9_copy_and_extend_frame(&img, &img);
+    ctx->staged_in_place = 1;
+  } else {
+    if (resize_frame(&ctx->stage_img, src
+#if CONFIG_VP9_HIGHBITDEPTH
+                     , use_highbitdepth
+#endif
+                     ))
+      return 1;
+    vp9_copy_and_extend_frame(src, &ctx->stage_img);
+    ctx->staged_in_place = 0;
+  }
+  ctx->staged = 1;
+  return 0;
+}
+
+void vp9_lookahead_unstage(struct lookahead_ctx *ctx) {
+  ctx->staged = 0;
+}
+
 int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG   *src,
                        int64_t ts_start, int64_t ts_end,
 #if CONFIG_VP9_HIGHBITDEPTH
                        int use_highbitdepth,
 #endif
-                       unsigned int flags) {
+                       unsigned int flags,
+                       const struct lookahead_ext_frame *ext) {
   struct lookahead_entry *buf;
+  const int staged = ctx->staged;
 #if USE_PARTIAL_COPY
   int row, col, active_end;
   int mb_rows = (src->y_height + 15) >> 4;
   int mb_cols = (src->y_width + 15) >> 4;
 #endif
-  int width = src->y_crop_width;
-  int height = src->y_crop_height;
-  int uv_width = src->uv_crop_width;
-  int uv_height = src->uv_crop_height;
-  int subsampling_x = src->subsampling_x;
-  int subsampling_y = src->subsampling_y;
-  int larger_dimensions, new_dimensions;
-
-  if (ctx->sz + 1  + MAX_PRE_FRAMES > ctx->max_sz)
+
+  ctx->staged = 0;
+  if (ctx->sz + 1  + MAX_PRE_FRAMES > ctx->max_sz) {
+    if (ext != NULL)
+      ext->release_cb(ext->cb_priv, &ext->img);
     return 1;
+  }
   ctx->sz++;
   buf = pop(ctx, &ctx->write_idx);
+  release_external(buf);
+
+  if (ext != NULL && ext->border >= VP9_ENC_BORDER_IN_PIXELS) {
+    vpx_free_frame_buffer(&buf->img);
+    reference_frame(&buf->img, src);
+    buf->external = 1;
+    buf->borders_extended = staged && ctx->staged_in_place;
+    buf->ext = *ext;
+
+    buf->ts_start = ts_start;
+    buf->ts_end = ts_end;
+    buf->flags = flags;
+    return 0;
+  }
 
-  new_dimensions = width != buf->img.y_crop_width ||
-                   height != buf->img.y_crop_height ||
-                   uv_width != buf->img.uv_crop_width ||
-                   uv_height != buf->img.uv_crop_height;
-  larger_dimensions = width > buf->img.y_width ||
-                      height > buf->img.y_height ||
-                      uv_width > buf->img.uv_width ||
-                      uv_height > buf->img.uv_height;
-  assert(!larger_dimensions || new_dimensions);
-
+  if (staged && !ctx->staged_in_place) {
+    // Already copied by vp9_lookahead_stage(), so just swap the copy in.
+    const YV12_BUFFER_CONFIG img = buf->img;
+    buf->img = ctx->stage_img;
+    ctx->stage_img = img;
+  } else {
 #if USE_PARTIAL_COPY
   // TODO(jkoleszar): This is disabled for now, as
   // vp9_copy_and_extend_frame_with_rect is not subsampling/alpha aware.
@@ -132,6 +252,10 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG   *src,
   // 1. Lookahead queue has has size of 1.
   // 2. Active map is provided.
   // 3. This is not a key frame, golden nor altref frame.
+  const int new_dimensions = src->y_crop_width != buf->img.y_crop_width ||
+                             src->y_crop_height != buf->img.y_crop_height ||
+                             src->uv_crop_width != buf->img.uv_crop_width ||
+                             src->uv_crop_height != buf->img.uv_crop_height;
   if (!new_dimensions && ctx->max_sz == 1 && active_map && !flags) {
     for (row = 0; row < mb_rows; ++row) {
       col = 0;
@@ -169,37 +293,29 @@ int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG   *src,
     }
   } else {
 #endif
-    if (larger_dimensions) {
-      YV12_BUFFER_CONFIG new_img;
-      memset(&new_img, 0, sizeof(new_img));
-      if (vpx_alloc_frame_buffer(&new_img,
-                                 width, height, subsampling_x, subsampling_y,
+    if (resize_frame(&buf->img, src
 #if CONFIG_VP9_HIGHBITDEPTH
-                                 use_highbitdepth,
+                     , use_highbitdepth
 #endif
-                                 VP9_ENC_BORDER_IN_PIXELS,
-                                 0))
-          return 1;
-      vpx_free_frame_buffer(&buf->img);
-      buf->img = new_img;
-    } else if (new_dimensions) {
-      buf->img.y_crop_width = src->y_crop_width;
-      buf->img.y_crop_height = src->y_crop_height;
-      buf->img.uv_crop_width = src->uv_crop_width;
-      buf->img.uv_crop_height = src->uv_crop_height;
-      buf->img.subsampling_x = src->subsampling_x;
-      buf->img.subsampling_y = src->subsampling_y;
-    }
+                     ))
+      goto bail;
     // Partial copy not implemented yet
     vp9_copy_and_extend_frame(src, &buf->img);
 #if USE_PARTIAL_COPY
   }
 #endif
+  }
 
   buf->ts_start = ts_start;
   buf->ts_end = ts_end;
   buf->flags = flags;
+  if (ext != NULL)
+    ext->release_cb(ext->cb_priv, &ext->img);
   return 0;
+ bail:
+  if (ext != NULL)
+    ext->release_cb(ext->cb_priv, &ext->img);
+  return 1;
 }
 
 
@@ -211,7 +327,7 @@ struct lookahead_entry *vp9_lookahead_pop(struct lookahead_ctx *ctx,
     buf = pop(ctx, &ctx->read_idx);
     ctx->sz--;
   }
-  return buf;
+  return prepare(buf);
 }
 
 
@@ -237,7 +353,7 @@ struct lookahead_entry *vp9_lookahead_peek(struct lookahead_ctx *ctx,
     }
   }
 
-  return buf;
+  return prepare(buf);
 }
 
 unsigned int vp9_lookahead_depth(struct lookahead_ctx *ctx) {
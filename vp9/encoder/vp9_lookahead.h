@@ -12,12 +12,9 @@
 #define VP9_ENCODER_VP9_LOOKAHEAD_H_
 
 #include "vpx_scale/yv12config.h"
-#include "vpx/vpx_integer.h"
-
-#if CONFIG_SPATIAL_SVC
 #include "vpx/vp8cx.h"
 #include "vpx/vpx_encoder.h"
-#endif
+#include "vpx/vpx_integer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,11 +22,25 @@ extern "C" {
 
 #define MAX_LAG_BUFFERS 25
 
+// An application-owned input frame that may be referenced by the queue
+// rather than copied into it.
+struct lookahead_ext_frame {
+  vpx_image_t                      img;
+  vpx_release_input_frame_cb_fn_t  release_cb;
+  void                            *cb_priv;
+  unsigned int                     border;
+};
+
 struct lookahead_entry {
   YV12_BUFFER_CONFIG  img;
   int64_t             ts_start;
   int64_t             ts_end;
   unsigned int        flags;
+  // Set when img points at the planes of ext rather than at a buffer owned
+  // by the queue. Borders of such frames are extended on first access.
+  int                 external;
+  int                 borders_extended;
+  struct lookahead_ext_frame ext;
 };
 
 // The max of past frames we want to keep in the queue.
@@ -41,6 +52,9 @@ struct lookahead_ctx {
   unsigned int read_idx;       /* Read index */
   unsigned int write_idx;      /* Write index */
   struct lookahead_entry *buf; /* Buffer list */
+  YV12_BUFFER_CONFIG stage_img; /* Copy of the next frame, made ahead */
+  int staged;                  /* The next frame has been staged */
+  int staged_in_place;         /* ...by extending the borders of ext */
 };
 
 /**\brief Initializes the lookahead stage
@@ -68,22 +82,51 @@ void vp9_lookahead_destroy(struct lookahead_ctx *ctx);
  * This function will copy the source image into a new framebuffer with
  * the expected stride/border.
  *
- * If active_map is non-NULL and there is only one frame in the queue, then copy
- * only active macroblocks.
+ * If ext is non-NULL and its planes have enough padding, the entry
+ * references them instead of making a copy. The queue then owns ext: its
+ * release callback is invoked once the frame is no longer referenced, which
+ * is immediately if it had to be copied or could not be enqueued.
+ *
+ * A frame staged with vp9_lookahead_stage() is not copied again.
  *
  * \param[in] ctx         Pointer to the lookahead context
  * \param[in] src         Pointer to the image to enqueue
  * \param[in] ts_start    Timestamp for the start of this frame
  * \param[in] ts_end      Timestamp for the end of this frame
  * \param[in] flags       Flags set on this frame
- * \param[in] active_map  Map that specifies which macroblock is active
+ * \param[in] ext         Application-owned frame backing src, or NULL
  */
 int vp9_lookahead_push(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
                        int64_t ts_start, int64_t ts_end,
 #if CONFIG_VP9_HIGHBITDEPTH
                        int use_highbitdepth,
 #endif
-                       unsigned int flags);
+                       unsigned int flags,
+                       const struct lookahead_ext_frame *ext);
+
+
+/**\brief Prepare the next source buffer ahead of its push
+ *
+ * Does the copy and border extension of vp9_lookahead_push() for the frame
+ * that is pushed next, so that the push itself only has to swap a buffer
+ * in. Neither the queued frames nor the queue indices are touched, so this
+ * may run while the queued frames are being encoded, but not concurrently
+ * with vp9_lookahead_push(). ext must be what the push is passed.
+ *
+ * \param[in] ctx         Pointer to the lookahead context
+ * \param[in] src         Pointer to the image to be pushed next
+ * \param[in] ext         Application-owned frame backing src, or NULL
+ */
+int vp9_lookahead_stage(struct lookahead_ctx *ctx, YV12_BUFFER_CONFIG *src,
+#if CONFIG_VP9_HIGHBITDEPTH
+                        int use_highbitdepth,
+#endif
+                        const struct lookahead_ext_frame *ext);
+
+
+/**\brief Drop a staged frame that is not going to be pushed
+ */
+void vp9_lookahead_unstage(struct lookahead_ctx *ctx);
 
 
 /**\brief Get the next source buffer to encode
@@ -2338,6 +2338,9 @@ int vp9_full_pixel_search(VP9_COMP *cpi, MACROBLOCK *x,
   const SEARCH_METHODS method = sf->mv.search_method;
   vp9_variance_fn_ptr_t *fn_ptr = &cpi->fn_ptr[bsize];
   int var = 0;
+#if CONFIG_PERF_STATS
+  ++x->motion_searches;
+#endif
   if (cost_list) {
     cost_list[0] = INT_MAX;
     cost_list[1] = INT_MAX;
@@ -612,7 +612,7 @@ static void block_yrd(VP9_COMP *cpi, MACROBLOCK *x, int *rate, int64_t *dist,
 
         switch (tx_size) {
           case TX_32X32:
-            vpx_fdct32x32_rd(src_diff, coeff, diff_stride);
+            vp9_hadamard_32x32(src_diff, diff_stride, (int16_t *)coeff);
             vp9_quantize_fp_32x32(coeff, 1024, x->skip_block, p->zbin,
                                   p->round_fp, p->quant_fp, p->quant_shift,
                                   qcoeff, dqcoeff, pd->dequant, eob,
@@ -650,9 +650,12 @@ static void block_yrd(VP9_COMP *cpi, MACROBLOCK *x, int *rate, int64_t *dist,
     }
   }
 
+  // The 32x32 transform has half the scale of the smaller ones, which the
+  // shift of the block error makes up for, so the pixel domain sse is scaled
+  // by 16 for all transform sizes.
   if (*skippable && *sse < INT64_MAX) {
     *rate = 0;
-    *dist = (*sse << 6) >> shift;
+    *dist = *sse << 4;
     *sse = *dist;
     return;
   }
@@ -661,7 +664,7 @@ static void block_yrd(VP9_COMP *cpi, MACROBLOCK *x, int *rate, int64_t *dist,
   *rate = 0;
   *dist = 0;
   if (*sse < INT64_MAX)
-    *sse = (*sse << 6) >> shift;
+    *sse = *sse << 4;
   for (r = 0; r < max_blocks_high; r += block_step) {
     for (c = 0; c < num_4x4_w; c += block_step) {
       if (c < max_blocks_wide) {
@@ -673,7 +676,7 @@ static void block_yrd(VP9_COMP *cpi, MACROBLOCK *x, int *rate, int64_t *dist,
         if (*eob == 1)
           *rate += (int)abs(qcoeff[0]);
         else if (*eob > 1)
-          *rate += (int)vp9_satd((const int16_t *)qcoeff, step << 4);
+          *rate += vp9_satd((const int16_t *)qcoeff, step << 4);
 
         *dist += vp9_block_error_fp(coeff, dqcoeff, step << 4) >> shift;
       }
@@ -771,6 +774,29 @@ static void free_pred_buffer(PRED_BUFFER *p) {
     p->in_use = 0;
 }
 
+// A full-pel motion vector into an unscaled reference makes the luma
+// prediction a plain copy of the reference frame. In that case point |view|
+// at the reference pixels so the mode can be modelled without building it.
+static int get_pred_in_place(const MACROBLOCKD *xd, BLOCK_SIZE bsize,
+                             PRED_BUFFER *view) {
+  const struct macroblockd_plane *const pd = &xd->plane[0];
+  const int bw = 4 * num_4x4_blocks_wide_lookup[bsize];
+  const int bh = 4 * num_4x4_blocks_high_lookup[bsize];
+  const MV mv_q4 = clamp_mv_to_umv_border_sb(xd, &xd->mi[0]->mbmi.mv[0].as_mv,
+                                             bw, bh, pd->subsampling_x,
+                                             pd->subsampling_y);
+
+  if (vp9_is_scaled(&xd->block_refs[0]->sf) ||
+      ((mv_q4.row | mv_q4.col) & SUBPEL_MASK))
+    return 0;
+
+  view->data = pd->pre[0].buf + (mv_q4.row >> SUBPEL_BITS) * pd->pre[0].stride +
+               (mv_q4.col >> SUBPEL_BITS);
+  view->stride = pd->pre[0].stride;
+  view->in_use = 0;
+  return 1;
+}
+
 static void encode_breakout_test(VP9_COMP *cpi, MACROBLOCK *x,
                                  BLOCK_SIZE bsize, int mi_row, int mi_col,
                                  MV_REFERENCE_FRAME ref_frame,
@@ -1115,6 +1141,9 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
   // process.
   // tmp[3] points to dst buffer, and the other 3 point to allocated buffers.
   PRED_BUFFER tmp[4];
+  // Full-pel predictions read straight from the reference frame; two views
+  // so the best one so far survives while the next mode is evaluated.
+  PRED_BUFFER ref_view[2];
   DECLARE_ALIGNED(16, uint8_t, pred_buf[3 * 64 * 64]);
 #if CONFIG_VP9_HIGHBITDEPTH
   DECLARE_ALIGNED(16, uint16_t, pred_buf_16[3 * 64 * 64]);
@@ -1223,6 +1252,8 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
     int64_t this_sse;
     int is_skippable;
     int this_early_term = 0;
+    int filter_search, in_place;
+    PRED_BUFFER *const view = &ref_view[best_pred == &ref_view[0]];
     PREDICTION_MODE this_mode = ref_mode_set[idx].pred_mode;
     if (cpi->use_svc)
       this_mode = ref_mode_set_svc[idx].pred_mode;
@@ -1337,7 +1368,24 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
     // Search for the best prediction filter type, when the resulting
     // motion vector is at sub-pixel accuracy level for luma component, i.e.,
     // the last three bits are all zeros.
-    if (reuse_inter_pred) {
+    filter_search = (this_mode == NEWMV || filter_ref == SWITCHABLE) &&
+                    pred_filter_search &&
+                    (ref_frame == LAST_FRAME ||
+                     (ref_frame == GOLDEN_FRAME && cpi->use_svc)) &&
+                    (((mbmi->mv[0].as_mv.row | mbmi->mv[0].as_mv.col) & 0x07)
+                        != 0);
+    in_place = !filter_search && get_pred_in_place(xd, bsize, view);
+#if CONFIG_INTERNAL_STATS
+    ++x->rt_mode_evals[INTER_OFFSET(this_mode)];
+    x->rt_mode_in_place[INTER_OFFSET(this_mode)] += in_place;
+#endif
+
+    if (in_place) {
+      if (reuse_inter_pred)
+        this_mode_pred = view;
+      pd->dst.buf = view->data;
+      pd->dst.stride = view->stride;
+    } else if (reuse_inter_pred) {
       if (!this_mode_pred) {
         this_mode_pred = &tmp[3];
       } else {
@@ -1345,12 +1393,11 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
         pd->dst.buf = this_mode_pred->data;
         pd->dst.stride = bw;
       }
+    } else {
+      pd->dst = orig_dst;
     }
 
-    if ((this_mode == NEWMV || filter_ref == SWITCHABLE) && pred_filter_search
-        && (ref_frame == LAST_FRAME ||
-            (ref_frame == GOLDEN_FRAME && cpi->use_svc))
-        && (((mbmi->mv[0].as_mv.row | mbmi->mv[0].as_mv.col) & 0x07) != 0)) {
+    if (filter_search) {
       int pf_rate[3];
       int64_t pf_dist[3];
       unsigned int pf_var[3];
@@ -1405,7 +1452,8 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
       }
     } else {
       mbmi->interp_filter = (filter_ref == SWITCHABLE) ? EIGHTTAP : filter_ref;
-      vp9_build_inter_predictors_sby(xd, mi_row, mi_col, bsize);
+      if (!in_place)
+        vp9_build_inter_predictors_sby(xd, mi_row, mi_col, bsize);
 
       // For large partition blocks, extra testing is done.
       if (bsize > BLOCK_32X32 &&
@@ -1423,7 +1471,7 @@ void vp9_pick_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
     if (!this_early_term) {
       this_sse = (int64_t)sse_y;
       block_yrd(cpi, x, &this_rdc.rate, &this_rdc.dist, &is_skippable,
-                &this_sse, 0, bsize, VPXMIN(mbmi->tx_size, TX_16X16));
+                &this_sse, 0, bsize, mbmi->tx_size);
       x->skip_txfm[0] = is_skippable;
       if (is_skippable) {
         this_rdc.rate = vp9_cost_bit(vp9_get_skip_prob(cm, xd), 1);
@@ -11,6 +11,7 @@
 #include <assert.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "./vp9_rtcd.h"
 
@@ -86,8 +87,9 @@ static void fill_mode_costs(VP9_COMP *cpi) {
                     fc->switchable_interp_prob[i], vp9_switchable_interp_tree);
 }
 
-static void fill_token_costs(vp9_coeff_cost *c,
-                             vp9_coeff_probs_model (*p)[PLANE_TYPES]) {
+void vp9_fill_token_costs(vp9_coeff_cost *c,
+                          vp9_coeff_probs_model (*last)[PLANE_TYPES],
+                          vp9_coeff_probs_model (*p)[PLANE_TYPES]) {
   int i, j, k, l;
   TX_SIZE t;
   for (t = TX_4X4; t <= TX_32X32; ++t)
@@ -96,6 +98,13 @@ static void fill_token_costs(vp9_coeff_cost *c,
         for (k = 0; k < COEF_BANDS; ++k)
           for (l = 0; l < BAND_COEFF_CONTEXTS(k); ++l) {
             vpx_prob probs[ENTROPY_NODES];
+            // Most contexts keep their probabilities from one frame to the
+            // next, so only the costs of the ones that changed are rebuilt.
+            if (!memcmp(last[t][i][j][k][l], p[t][i][j][k][l],
+                        sizeof(last[t][i][j][k][l])))
+              continue;
+            memcpy(last[t][i][j][k][l], p[t][i][j][k][l],
+                   sizeof(last[t][i][j][k][l]));
             vp9_model_to_full_probs(p[t][i][j][k][l], probs);
             vp9_cost_tokens((int *)c[t][i][j][k][0][l], probs,
                             vp9_coef_tree);
@@ -287,7 +296,8 @@ void vp9_initialize_rd_consts(VP9_COMP *cpi) {
   set_partition_probs(cm, xd);
 
   if (!cpi->sf.use_nonrd_pick_mode || cm->frame_type == KEY_FRAME)
-    fill_token_costs(x->token_costs, cm->fc->coef_probs);
+    vp9_fill_token_costs(x->token_costs, rd->token_cost_probs,
+                         cm->fc->coef_probs);
 
   if (cpi->sf.partition_search_type != VAR_BASED_PARTITION ||
       cm->frame_type == KEY_FRAME) {
@@ -106,6 +106,10 @@ typedef struct RD_OPT {
 
   int64_t filter_threshes[MAX_REF_FRAMES][SWITCHABLE_FILTER_CONTEXTS];
 
+  // Model probabilities the token costs were last computed from. All zero
+  // (never a valid probability) until the first call fills every context.
+  vp9_coeff_probs_model token_cost_probs[TX_SIZES][PLANE_TYPES];
+
   int RDMULT;
   int RDDIV;
 } RD_OPT;
@@ -130,6 +134,12 @@ int vp9_compute_rd_mult(const struct VP9_COMP *cpi, int qindex);
 
 void vp9_initialize_rd_consts(struct VP9_COMP *cpi);
 
+// Recomputes the token costs of the coefficient contexts whose model
+// probabilities in p differ from last, and copies them into last.
+void vp9_fill_token_costs(vp9_coeff_cost *c,
+                          vp9_coeff_probs_model (*last)[PLANE_TYPES],
+                          vp9_coeff_probs_model (*p)[PLANE_TYPES]);
+
 void vp9_initialize_me_consts(struct VP9_COMP *cpi, MACROBLOCK *x, int qindex);
 
 void vp9_model_rd_from_var_lapndz(unsigned int var, unsigned int n,
@@ -269,6 +269,74 @@ static void model_rd_for_sb(VP9_COMP *cpi, BLOCK_SIZE bsize,
   *out_dist_sum = dist_sum << 4;
 }
 
+static void model_rd_cache_reset(MODEL_RD_CACHE *cache) {
+  cache->count = 0;
+  cache->next = 0;
+}
+
+// Looks up the model rd of the current inter prediction, as given by the
+// reference frames, motion vectors and interpolation filter in mbmi. On a hit
+// the side results of model_rd_for_sb() are restored into x and 1 is
+// returned; the predictor itself is not built.
+static int model_rd_cache_lookup(MACROBLOCK *x,
+                                 int *rate, int64_t *dist,
+                                 int *skip_txfm_sb, int64_t *skip_sse_sb) {
+  MODEL_RD_CACHE *const cache = &x->model_rd_cache;
+  const MB_MODE_INFO *const mbmi = &x->e_mbd.mi[0]->mbmi;
+  const int is_comp_pred = has_second_ref(mbmi);
+  int i;
+
+#if CONFIG_INTERNAL_STATS
+  ++cache->lookups;
+#endif
+  for (i = 0; i < cache->count; ++i) {
+    const MODEL_RD_CACHE_ENTRY *const entry = &cache->entry[i];
+    if (entry->interp_filter == mbmi->interp_filter &&
+        entry->ref_frame[0] == mbmi->ref_frame[0] &&
+        entry->ref_frame[1] == mbmi->ref_frame[1] &&
+        entry->mv[0].as_int == mbmi->mv[0].as_int &&
+        (!is_comp_pred || entry->mv[1].as_int == mbmi->mv[1].as_int)) {
+      *rate = entry->rate;
+      *dist = entry->dist;
+      *skip_txfm_sb = entry->skip_txfm_sb;
+      *skip_sse_sb = entry->skip_sse_sb;
+      x->pred_sse[mbmi->ref_frame[0]] = entry->pred_sse;
+      memcpy(x->skip_txfm, entry->skip_txfm, sizeof(x->skip_txfm));
+      memcpy(x->bsse, entry->bsse, sizeof(x->bsse));
+#if CONFIG_INTERNAL_STATS
+      ++cache->hits;
+#endif
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void model_rd_cache_store(MACROBLOCK *x,
+                                 int rate, int64_t dist,
+                                 int skip_txfm_sb, int64_t skip_sse_sb) {
+  MODEL_RD_CACHE *const cache = &x->model_rd_cache;
+  const MB_MODE_INFO *const mbmi = &x->e_mbd.mi[0]->mbmi;
+  MODEL_RD_CACHE_ENTRY *const entry = &cache->entry[cache->next];
+
+  entry->ref_frame[0] = mbmi->ref_frame[0];
+  entry->ref_frame[1] = mbmi->ref_frame[1];
+  entry->mv[0].as_int = mbmi->mv[0].as_int;
+  entry->mv[1].as_int = mbmi->mv[1].as_int;
+  entry->interp_filter = mbmi->interp_filter;
+  entry->rate = rate;
+  entry->dist = dist;
+  entry->skip_txfm_sb = skip_txfm_sb;
+  entry->skip_sse_sb = skip_sse_sb;
+  entry->pred_sse = x->pred_sse[mbmi->ref_frame[0]];
+  memcpy(entry->skip_txfm, x->skip_txfm, sizeof(entry->skip_txfm));
+  memcpy(entry->bsse, x->bsse, sizeof(entry->bsse));
+
+  cache->next = (cache->next + 1) % MODEL_RD_CACHE_SIZE;
+  if (cache->count < MODEL_RD_CACHE_SIZE)
+    ++cache->count;
+}
+
 int64_t vp9_block_error_c(const tran_low_t *coeff, const tran_low_t *dqcoeff,
                           intptr_t block_size, int64_t *ssz) {
   int i;
@@ -754,7 +822,7 @@ static int64_t rd_pick_intra4x4block(VP9_COMP *cpi, MACROBLOCK *x,
   const int src_stride = p->src.stride;
   const int dst_stride = pd->dst.stride;
   const uint8_t *src_init = &p->src.buf[row * 4 * src_stride + col * 4];
-  uint8_t *dst_init = &pd->dst.buf[row * 4 * src_stride + col * 4];
+  uint8_t *dst_init = &pd->dst.buf[row * 4 * dst_stride + col * 4];
   ENTROPY_CONTEXT ta[2], tempa[2];
   ENTROPY_CONTEXT tl[2], templ[2];
   const int num_4x4_blocks_wide = num_4x4_blocks_wide_lookup[bsize];
@@ -2389,6 +2457,7 @@ static int64_t handle_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
   DECLARE_ALIGNED(16, uint8_t, tmp_buf[MAX_MB_PLANE * 64 * 64]);
 #endif  // CONFIG_VP9_HIGHBITDEPTH
   int pred_exists = 0;
+  int pred_cached = 0;
   int intpel_mv;
   int64_t rd, tmp_rd, best_rd = INT64_MAX;
   int best_needs_copy = 0;
@@ -2540,18 +2609,21 @@ static int64_t handle_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
       int newbest;
       int tmp_rate_sum = 0;
       int64_t tmp_dist_sum = 0;
+      int tmp_pred_cached = 0;
 
       for (i = 0; i < SWITCHABLE_FILTERS; ++i) {
         int j;
         int64_t rs_rd;
         int tmp_skip_sb = 0;
         int64_t tmp_skip_sse = INT64_MAX;
+        int this_pred_cached = 0;
 
         mbmi->interp_filter = i;
         rs = vp9_get_switchable_rate(cpi, xd);
         rs_rd = RDCOST(x->rdmult, x->rddiv, rs, 0);
 
         if (i > 0 && intpel_mv) {
+          this_pred_cached = tmp_pred_cached;
           rd = RDCOST(x->rdmult, x->rddiv, tmp_rate_sum, tmp_dist_sum);
           filter_cache[i] = rd;
           filter_cache[SWITCHABLE_FILTERS] =
@@ -2569,21 +2641,28 @@ static int64_t handle_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
             continue;
           }
 
-          if ((cm->interp_filter == SWITCHABLE &&
-               (!i || best_needs_copy)) ||
-              (cm->interp_filter != SWITCHABLE &&
-               (cm->interp_filter == mbmi->interp_filter ||
-                (i == 0 && intpel_mv)))) {
-            restore_dst_buf(xd, orig_dst, orig_dst_stride);
-          } else {
-            for (j = 0; j < MAX_MB_PLANE; j++) {
-              xd->plane[j].dst.buf = tmp_buf + j * 64 * 64;
-              xd->plane[j].dst.stride = 64;
+          this_pred_cached = model_rd_cache_lookup(x, &rate_sum, &dist_sum,
+                                                   &tmp_skip_sb,
+                                                   &tmp_skip_sse);
+          if (!this_pred_cached) {
+            if ((cm->interp_filter == SWITCHABLE &&
+                 (!i || best_needs_copy)) ||
+                (cm->interp_filter != SWITCHABLE &&
+                 (cm->interp_filter == mbmi->interp_filter ||
+                  (i == 0 && intpel_mv)))) {
+              restore_dst_buf(xd, orig_dst, orig_dst_stride);
+            } else {
+              for (j = 0; j < MAX_MB_PLANE; j++) {
+                xd->plane[j].dst.buf = tmp_buf + j * 64 * 64;
+                xd->plane[j].dst.stride = 64;
+              }
             }
+            vp9_build_inter_predictors_sb(xd, mi_row, mi_col, bsize);
+            model_rd_for_sb(cpi, bsize, x, xd, &rate_sum, &dist_sum,
+                            &tmp_skip_sb, &tmp_skip_sse);
+            model_rd_cache_store(x, rate_sum, dist_sum,
+                                 tmp_skip_sb, tmp_skip_sse);
           }
-          vp9_build_inter_predictors_sb(xd, mi_row, mi_col, bsize);
-          model_rd_for_sb(cpi, bsize, x, xd, &rate_sum, &dist_sum,
-                          &tmp_skip_sb, &tmp_skip_sse);
 
           rd = RDCOST(x->rdmult, x->rddiv, rate_sum, dist_sum);
           filter_cache[i] = rd;
@@ -2596,6 +2675,7 @@ static int64_t handle_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
           if (i == 0 && intpel_mv) {
             tmp_rate_sum = rate_sum;
             tmp_dist_sum = dist_sum;
+            tmp_pred_cached = this_pred_cached;
           }
         }
 
@@ -2610,7 +2690,10 @@ static int64_t handle_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
         if (newbest) {
           best_rd = rd;
           best_filter = mbmi->interp_filter;
-          if (cm->interp_filter == SWITCHABLE && i && !intpel_mv)
+          // A predictor taken from the cache was not built into either
+          // buffer, so the buffer holding the best predictor is unchanged.
+          if (cm->interp_filter == SWITCHABLE && i && !intpel_mv &&
+              !this_pred_cached)
             best_needs_copy = !best_needs_copy;
         }
 
@@ -2618,6 +2701,7 @@ static int64_t handle_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
             (cm->interp_filter != SWITCHABLE &&
              cm->interp_filter == mbmi->interp_filter)) {
           pred_exists = 1;
+          pred_cached = this_pred_cached;
           tmp_rd = best_rd;
 
           skip_txfm_sb = tmp_skip_sb;
@@ -2635,7 +2719,11 @@ static int64_t handle_inter_mode(VP9_COMP *cpi, MACROBLOCK *x,
   rs = cm->interp_filter == SWITCHABLE ? vp9_get_switchable_rate(cpi, xd) : 0;
 
   if (pred_exists) {
-    if (best_needs_copy) {
+    if (pred_cached) {
+      // The model rd of the chosen filter came from the cache, so its
+      // predictor still has to be built into the destination buffer.
+      vp9_build_inter_predictors_sb(xd, mi_row, mi_col, bsize);
+    } else if (best_needs_copy) {
       // again temporarily set the buffers to local memory to prevent a memcpy
       for (i = 0; i < MAX_MB_PLANE; i++) {
         xd->plane[i].dst.buf = tmp_buf + i * 64 * 64;
@@ -2979,6 +3067,8 @@ void vp9_rd_pick_inter_mode_sb(VP9_COMP *cpi,
   for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
     filter_cache[i] = INT64_MAX;
 
+  model_rd_cache_reset(&x->model_rd_cache);
+
   estimate_ref_frame_costs(cm, xd, segment_id, ref_costs_single, ref_costs_comp,
                            &comp_mode_p);
 
@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "./vp9_rtcd.h"
 #if CONFIG_VP9_HIGHBITDEPTH
 #include "vpx_dsp/vpx_dsp_common.h"
 #endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -212,9 +213,6 @@ static const interp_kernel filteredinterp_filters1000[(1 << SUBPEL_BITS)] = {
 };
 
 // Filters for factor of 2 downsampling.
-static const int16_t vp9_down2_symeven_half_filter[] = {56, 12, -3, -1};
-static const int16_t vp9_down2_symodd_half_filter[] = {64, 35, 0, -3};
-
 static const interp_kernel *choose_interp_filter(int inlength, int outlength) {
   int outlength16 = outlength * 16;
   if (outlength16 >= inlength * 16)
@@ -313,114 +311,24 @@ static void interpolate(const uint8_t *const input, int inlength,
   }
 }
 
-static void down2_symeven(const uint8_t *const input, int length,
-                          uint8_t *output) {
-  // Actual filter len = 2 * filter_len_half.
-  const int16_t *filter = vp9_down2_symeven_half_filter;
-  const int filter_len_half = sizeof(vp9_down2_symeven_half_filter) / 2;
-  int i, j;
-  uint8_t *optr = output;
-  int l1 = filter_len_half;
-  int l2 = (length - filter_len_half);
-  l1 += (l1 & 1);
-  l2 += (l2 & 1);
-  if (l1 > l2) {
-    // Short input length.
-    for (i = 0; i < length; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1));
-      for (j = 0; j < filter_len_half; ++j) {
-        sum += (input[(i - j < 0 ? 0 : i - j)] +
-                input[(i + 1 + j >= length ? length - 1 : i + 1 + j)]) *
-            filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel(sum);
-    }
-  } else {
-    // Initial part.
-    for (i = 0; i < l1; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1));
-      for (j = 0; j < filter_len_half; ++j) {
-        sum += (input[(i - j < 0 ? 0 : i - j)] + input[i + 1 + j]) * filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel(sum);
-    }
-    // Middle part.
-    for (; i < l2; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1));
-      for (j = 0; j < filter_len_half; ++j) {
-        sum += (input[i - j] + input[i + 1 + j]) * filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel(sum);
-    }
-    // End part.
-    for (; i < length; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1));
-      for (j = 0; j < filter_len_half; ++j) {
-        sum += (input[i - j] +
-                input[(i + 1 + j >= length ? length - 1 : i + 1 + j)]) *
-            filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel(sum);
-    }
-  }
-}
+// The down2 filters above as 8-tap filters over input[2 * i - 3] to
+// input[2 * i + 4] for output i.
+static const int16_t vp9_down2_symeven_filter[INTERP_TAPS] = {
+  -1, -3, 12, 56, 56, 12, -3, -1
+};
+static const int16_t vp9_down2_symodd_filter[INTERP_TAPS] = {
+  -3, 0, 35, 64, 35, 0, -3, 0
+};
 
-static void down2_symodd(const uint8_t *const input, int length,
-                         uint8_t *output) {
-  // Actual filter len = 2 * filter_len_half - 1.
-  const int16_t *filter = vp9_down2_symodd_half_filter;
-  const int filter_len_half = sizeof(vp9_down2_symodd_half_filter) / 2;
-  int i, j;
-  uint8_t *optr = output;
-  int l1 = filter_len_half - 1;
-  int l2 = (length - filter_len_half + 1);
-  l1 += (l1 & 1);
-  l2 += (l2 & 1);
-  if (l1 > l2) {
-    // Short input length.
-    for (i = 0; i < length; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1)) + input[i] * filter[0];
-      for (j = 1; j < filter_len_half; ++j) {
-        sum += (input[(i - j < 0 ? 0 : i - j)] +
-                input[(i + j >= length ? length - 1 : i + j)]) *
-            filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel(sum);
-    }
-  } else {
-    // Initial part.
-    for (i = 0; i < l1; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1)) + input[i] * filter[0];
-      for (j = 1; j < filter_len_half; ++j) {
-        sum += (input[(i - j < 0 ? 0 : i - j)] + input[i + j]) * filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel(sum);
-    }
-    // Middle part.
-    for (; i < l2; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1)) + input[i] * filter[0];
-      for (j = 1; j < filter_len_half; ++j) {
-        sum += (input[i - j] + input[i + j]) * filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel(sum);
-    }
-    // End part.
-    for (; i < length; i += 2) {
-      int sum = (1 << (FILTER_BITS - 1)) + input[i] * filter[0];
-      for (j = 1; j < filter_len_half; ++j) {
-        sum += (input[i - j] + input[(i + j >= length ? length - 1 : i + j)]) *
-            filter[j];
-      }
-      sum >>= FILTER_BITS;
-      *optr++ = clip_pixel(sum);
-    }
+void vp9_resize_filter_8tap_c(const uint8_t *const src[INTERP_TAPS],
+                              const int16_t *filter, uint8_t *dst,
+                              int width) {
+  int x, k;
+  for (x = 0; x < width; ++x) {
+    int sum = 0;
+    for (k = 0; k < INTERP_TAPS; ++k)
+      sum += filter[k] * src[k][x];
+    dst[x] = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
   }
 }
 
@@ -441,70 +349,180 @@ static int get_down2_steps(int in_length, int out_length) {
   return steps;
 }
 
-static void resize_multistep(const uint8_t *const input,
-                             int length,
-                             uint8_t *output,
-                             int olength,
-                             uint8_t *buf) {
-  int steps;
+// Halves the |length| pixels at |input| as the down2_symeven() and
+// down2_symodd() filters do. The even and odd input pixels are split into
+// |even| and |odd|, which need room for (length + 1) / 2 + 4 pixels each, so
+// that each tap of the filter reads a contiguous run of them.
+static void down2_row(const uint8_t *const input, int length, uint8_t *output,
+                      uint8_t *even, uint8_t *odd) {
+  const int16_t *const filter = length & 1 ? vp9_down2_symodd_filter :
+                                             vp9_down2_symeven_filter;
+  const int olength = get_down2_length(length, 1);
+  const uint8_t *src[INTERP_TAPS];
+  int m;
+
+  // even[m + 2] = input[2 * m] and odd[m + 2] = input[2 * m + 1] for m from
+  // -2 to olength + 1, with the positions clamped to the row.
+  for (m = -2; m < 0; ++m) {
+    even[m + 2] = input[0];
+    odd[m + 2] = input[0];
+  }
+  for (m = 0; m < length / 2; ++m) {
+    even[m + 2] = input[2 * m];
+    odd[m + 2] = input[2 * m + 1];
+  }
+  for (; m < olength + 2; ++m) {
+    even[m + 2] = input[VPXMIN(2 * m, length - 1)];
+    odd[m + 2] = input[VPXMIN(2 * m + 1, length - 1)];
+  }
+
+  src[0] = odd;
+  src[1] = even + 1;
+  src[2] = odd + 1;
+  src[3] = even + 2;
+  src[4] = odd + 2;
+  src[5] = even + 3;
+  src[6] = odd + 3;
+  src[7] = even + 4;
+  vp9_resize_filter_8tap(src, filter, output, olength);
+}
+
+// Resizes one row: halves it while that keeps it at least |olength| long and
+// then interpolates to |olength|. |buf| needs room for 2 * length + 10 pixels.
+static void resize_row(const uint8_t *const input, int length,
+                       uint8_t *output, int olength, uint8_t *buf) {
+  const int steps = get_down2_steps(length, olength);
+  const int half = get_down2_length(length, 1);
+  uint8_t *const even = buf;
+  uint8_t *const odd = even + half + 4;
+  uint8_t *const tmp[2] = { odd + half + 4, odd + 2 * half + 4 };
+  const uint8_t *in = input;
+  int s;
+
   if (length == olength) {
     memcpy(output, input, sizeof(output[0]) * length);
     return;
   }
-  steps = get_down2_steps(length, olength);
+  for (s = 0; s < steps; ++s) {
+    const int proj_length = get_down2_length(length, 1);
+    uint8_t *const out = s == steps - 1 && proj_length == olength ?
+                         output : tmp[s & 1];
+    down2_row(in, length, out, even, odd);
+    in = out;
+    length = proj_length;
+  }
+  if (length != olength)
+    interpolate(in, length, output, olength);
+}
 
-  if (steps > 0) {
-    int s;
-    uint8_t *out = NULL;
-    uint8_t *tmpbuf = NULL;
-    uint8_t *otmp, *otmp2;
-    int filteredlength = length;
-    if (!tmpbuf) {
-      tmpbuf = (uint8_t *)malloc(sizeof(uint8_t) * length);
-      otmp = tmpbuf;
-    } else {
-      otmp = buf;
-    }
-    otmp2 = otmp + get_down2_length(length, 1);
-    for (s = 0; s < steps; ++s) {
-      const int proj_filteredlength = get_down2_length(filteredlength, 1);
-      const uint8_t *const in = (s == 0 ? input : out);
-      if (s == steps - 1 && proj_filteredlength == olength)
-        out = output;
-      else
-        out = (s & 1 ? otmp2 : otmp);
-      if (filteredlength & 1)
-        down2_symodd(in, filteredlength, out);
-      else
-        down2_symeven(in, filteredlength, out);
-      filteredlength = proj_filteredlength;
-    }
-    if (filteredlength != olength) {
-      interpolate(out, filteredlength, output, olength);
-    }
-    if (tmpbuf)
-      free(tmpbuf);
-  } else {
-    interpolate(input, length, output, olength);
+// Filters the |width| pixel rows of |input| vertically into the |width| pixel
+// rows of |output|: output row i is |filters[i]| applied to input rows
+// first_tap[i] to first_tap[i] + 7, clamped to the |length| rows there are.
+static void filter_rows(const uint8_t *input, int in_stride, int length,
+                        uint8_t *output, int out_stride, int olength,
+                        int width, const int *first_tap,
+                        const int16_t *const *filters) {
+  const uint8_t *src[INTERP_TAPS];
+  int i, k;
+  for (i = 0; i < olength; ++i) {
+    for (k = 0; k < INTERP_TAPS; ++k)
+      src[k] = input + clamp(first_tap[i] + k, 0, length - 1) * in_stride;
+    vp9_resize_filter_8tap(src, filters[i], output + i * out_stride, width);
   }
 }
 
-static void fill_col_to_arr(uint8_t *img, int stride, int len, uint8_t *arr) {
-  int i;
-  uint8_t *iptr = img;
-  uint8_t *aptr = arr;
-  for (i = 0; i < len; ++i, iptr += stride) {
-    *aptr++ = *iptr;
+// Finds the first input position and the filter of each of the |outlength|
+// outputs of interpolate().
+static void get_interp_taps(int inlength, int outlength, int *first_tap,
+                            const int16_t **filters) {
+  const int64_t delta = (((uint64_t)inlength << 32) + outlength / 2) /
+      outlength;
+  const int64_t offset = inlength > outlength ?
+      (((int64_t)(inlength - outlength) << 31) + outlength / 2) / outlength :
+      -(((int64_t)(outlength - inlength) << 31) + outlength / 2) / outlength;
+  const interp_kernel *interp_filters =
+      choose_interp_filter(inlength, outlength);
+  int x;
+  int64_t y;
+
+  for (x = 0, y = offset; x < outlength; ++x, y += delta) {
+    const int int_pel = (int)(y >> INTERP_PRECISION_BITS);
+    const int sub_pel =
+        (int)((y >> (INTERP_PRECISION_BITS - SUBPEL_BITS)) & SUBPEL_MASK);
+    first_tap[x] = int_pel - INTERP_TAPS / 2 + 1;
+    filters[x] = interp_filters[sub_pel];
   }
 }
 
-static void fill_arr_to_col(uint8_t *img, int stride, int len, uint8_t *arr) {
+void vp9_resize_plane_horiz(const uint8_t *const input, int height, int width,
+                            int in_stride, uint8_t *intbuf, int width2,
+                            int row_start, int row_end) {
+  uint8_t *const buf = (uint8_t *)malloc(sizeof(uint8_t) * (2 * width + 10));
   int i;
-  uint8_t *iptr = img;
-  uint8_t *aptr = arr;
-  for (i = 0; i < len; ++i, iptr += stride) {
-    *iptr = *aptr++;
+  (void)height;
+  assert(width > 0);
+  assert(height > 0);
+  assert(width2 > 0);
+  assert(row_start >= 0 && row_end <= height);
+  for (i = row_start; i < row_end; ++i)
+    resize_row(input + in_stride * i, width, intbuf + width2 * i, width2, buf);
+  free(buf);
+}
+
+void vp9_resize_plane_vert(const uint8_t *const intbuf, int height,
+                           int width2, uint8_t *output, int height2,
+                           int out_stride, int col_start, int col_end) {
+  const int width = col_end - col_start;
+  const int steps = get_down2_steps(height, height2);
+  const int half = get_down2_length(height, 1);
+  const int taps_len = VPXMAX(half, height2);
+  uint8_t *const tmpbuf =
+      (uint8_t *)malloc(sizeof(uint8_t) * 2 * half * VPXMAX(width, 1));
+  int *const first_tap = (int *)malloc(sizeof(*first_tap) * taps_len);
+  const int16_t **const filters =
+      (const int16_t **)malloc(sizeof(*filters) * taps_len);
+  const uint8_t *in = intbuf + col_start;
+  int in_stride = width2;
+  int length = height;
+  int i, s;
+
+  assert(height > 0);
+  assert(height2 > 0);
+  assert(col_start >= 0 && col_end <= width2);
+
+  if (width <= 0) {
+    // Nothing to do for an empty band.
+  } else if (height == height2) {
+    for (i = 0; i < height; ++i)
+      memcpy(output + i * out_stride + col_start, in + i * in_stride, width);
+  } else {
+    for (s = 0; s < steps; ++s) {
+      const int proj_length = get_down2_length(length, 1);
+      const int16_t *const filter = length & 1 ? vp9_down2_symodd_filter :
+                                                 vp9_down2_symeven_filter;
+      const int last = s == steps - 1 && proj_length == height2;
+      uint8_t *const out = last ? output + col_start :
+                                  tmpbuf + (s & 1) * half * width;
+      const int stride = last ? out_stride : width;
+      for (i = 0; i < proj_length; ++i) {
+        first_tap[i] = 2 * i - INTERP_TAPS / 2 + 1;
+        filters[i] = filter;
+      }
+      filter_rows(in, in_stride, length, out, stride, proj_length, width,
+                  first_tap, filters);
+      in = out;
+      in_stride = stride;
+      length = proj_length;
+    }
+    if (length != height2) {
+      get_interp_taps(length, height2, first_tap, filters);
+      filter_rows(in, in_stride, length, output + col_start, out_stride,
+                  height2, width, first_tap, filters);
+    }
   }
+  free(tmpbuf);
+  free(first_tap);
+  free(filters);
 }
 
 void vp9_resize_plane(const uint8_t *const input,
@@ -515,29 +533,18 @@ void vp9_resize_plane(const uint8_t *const input,
                       int height2,
                       int width2,
                       int out_stride) {
-  int i;
   uint8_t *intbuf = (uint8_t *)malloc(sizeof(uint8_t) * width2 * height);
-  uint8_t *tmpbuf = (uint8_t *)malloc(sizeof(uint8_t) *
-                                      (width < height ? height : width));
-  uint8_t *arrbuf = (uint8_t *)malloc(sizeof(uint8_t) * (height + height2));
-  assert(width > 0);
-  assert(height > 0);
-  assert(width2 > 0);
-  assert(height2 > 0);
-  for (i = 0; i < height; ++i)
-    resize_multistep(input + in_stride * i, width,
-                        intbuf + width2 * i, width2, tmpbuf);
-  for (i = 0; i < width2; ++i) {
-    fill_col_to_arr(intbuf + i, width2, height, arrbuf);
-    resize_multistep(arrbuf, height, arrbuf + height, height2, tmpbuf);
-    fill_arr_to_col(output + i, out_stride, height2, arrbuf + height);
-  }
+  vp9_resize_plane_horiz(input, height, width, in_stride, intbuf, width2, 0,
+                         height);
+  vp9_resize_plane_vert(intbuf, height, width2, output, height2, out_stride,
+                        0, width2);
   free(intbuf);
-  free(tmpbuf);
-  free(arrbuf);
 }
 
 #if CONFIG_VP9_HIGHBITDEPTH
+static const int16_t vp9_down2_symeven_half_filter[] = {56, 12, -3, -1};
+static const int16_t vp9_down2_symodd_half_filter[] = {64, 35, 0, -3};
+
 static void highbd_interpolate(const uint16_t *const input, int inlength,
                                uint16_t *output, int outlength, int bd) {
   const int64_t delta =
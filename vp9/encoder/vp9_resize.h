@@ -26,6 +26,28 @@ void vp9_resize_plane(const uint8_t *const input,
                       int height2,
                       int width2,
                       int out_stride);
+
+// The two passes of vp9_resize_plane(), which can be run on separate bands of
+// the plane. vp9_resize_plane_horiz() resizes rows |row_start| to |row_end|
+// of |input| to |width2| pixels in |intbuf|, a width2 x height buffer.
+// vp9_resize_plane_vert() then resizes columns |col_start| to |col_end| of
+// |intbuf| to |height2| rows in |output|.
+void vp9_resize_plane_horiz(const uint8_t *const input,
+                            int height,
+                            int width,
+                            int in_stride,
+                            uint8_t *intbuf,
+                            int width2,
+                            int row_start,
+                            int row_end);
+void vp9_resize_plane_vert(const uint8_t *const intbuf,
+                           int height,
+                           int width2,
+                           uint8_t *output,
+                           int height2,
+                           int out_stride,
+                           int col_start,
+                           int col_end);
 void vp9_resize_frame420(const uint8_t *const y,
                          int y_stride,
                          const uint8_t *const u,
@@ -36,6 +36,7 @@ static void temporal_filter_predictors_mb_c(MACROBLOCKD *xd,
                                             uint8_t *u_mb_ptr,
                                             uint8_t *v_mb_ptr,
                                             int stride,
+                                            int uv_stride,
                                             int uv_block_width,
                                             int uv_block_height,
                                             int mv_row,
@@ -48,15 +49,8 @@ static void temporal_filter_predictors_mb_c(MACROBLOCKD *xd,
   const InterpKernel *const kernel =
     vp9_filter_kernels[xd->mi[0]->mbmi.interp_filter];
 
-  enum mv_precision mv_precision_uv;
-  int uv_stride;
-  if (uv_block_width == 8) {
-    uv_stride = (stride + 1) >> 1;
-    mv_precision_uv = MV_PRECISION_Q4;
-  } else {
-    uv_stride = stride;
-    mv_precision_uv = MV_PRECISION_Q3;
-  }
+  const enum mv_precision mv_precision_uv =
+      uv_block_width == 8 ? MV_PRECISION_Q4 : MV_PRECISION_Q3;
 
 #if CONFIG_VP9_HIGHBITDEPTH
   if (xd->cur_buf->flags & YV12_FLAG_HIGHBITDEPTH) {
@@ -213,6 +207,7 @@ void vp9_highbd_temporal_filter_apply_c(uint8_t *frame1_8,
 
 static int temporal_filter_find_matching_mb_c(VP9_COMP *cpi,
                                               uint8_t *arf_frame_buf,
+                                              int arf_stride,
                                               uint8_t *frame_ptr_buf,
                                               int stride) {
   MACROBLOCK *const x = &cpi->td.mb;
@@ -239,7 +234,7 @@ static int temporal_filter_find_matching_mb_c(VP9_COMP *cpi,
 
   // Setup frame pointers
   x->plane[0].src.buf = arf_frame_buf;
-  x->plane[0].src.stride = stride;
+  x->plane[0].src.stride = arf_stride;
   xd->plane[0].pre[0].buf = frame_ptr_buf;
   xd->plane[0].pre[0].stride = stride;
 
@@ -332,6 +327,13 @@ static void temporal_filter_iterate_c(VP9_COMP *cpi,
     for (mb_col = 0; mb_col < mb_cols; mb_col++) {
       int i, j, k;
       int stride;
+      // Lookahead frames may live in application buffers, so every frame
+      // and the alt ref buffer are addressed with their own strides.
+      const int dst_y_offset = mb_row * 16 * cpi->alt_ref_buffer.y_stride +
+                               mb_col * 16;
+      const int dst_uv_offset =
+          mb_row * mb_uv_height * cpi->alt_ref_buffer.uv_stride +
+          mb_col * mb_uv_width;
 
       memset(accumulator, 0, 16 * 16 * 3 * sizeof(accumulator[0]));
       memset(count, 0, 16 * 16 * 3 * sizeof(count[0]));
@@ -343,10 +345,15 @@ static void temporal_filter_iterate_c(VP9_COMP *cpi,
       for (frame = 0; frame < frame_count; frame++) {
         const int thresh_low  = 10000;
         const int thresh_high = 20000;
+        int y_offset, uv_offset;
 
         if (frames[frame] == NULL)
           continue;
 
+        y_offset = mb_row * 16 * frames[frame]->y_stride + mb_col * 16;
+        uv_offset = mb_row * mb_uv_height * frames[frame]->uv_stride +
+                    mb_col * mb_uv_width;
+
         mbd->mi[0]->bmi[0].as_mv[0].as_mv.row = 0;
         mbd->mi[0]->bmi[0].as_mv[0].as_mv.col = 0;
 
@@ -356,7 +363,8 @@ static void temporal_filter_iterate_c(VP9_COMP *cpi,
           // Find best match in this frame by MC
           int err = temporal_filter_find_matching_mb_c(cpi,
               frames[alt_ref_index]->y_buffer + mb_y_offset,
-              frames[frame]->y_buffer + mb_y_offset,
+              frames[alt_ref_index]->y_stride,
+              frames[frame]->y_buffer + y_offset,
               frames[frame]->y_stride);
 
           // Assign higher weight to matching MB if it's error
@@ -369,10 +377,10 @@ static void temporal_filter_iterate_c(VP9_COMP *cpi,
         if (filter_weight != 0) {
           // Construct the predictors
           temporal_filter_predictors_mb_c(mbd,
-              frames[frame]->y_buffer + mb_y_offset,
-              frames[frame]->u_buffer + mb_uv_offset,
-              frames[frame]->v_buffer + mb_uv_offset,
-              frames[frame]->y_stride,
+              frames[frame]->y_buffer + y_offset,
+              frames[frame]->u_buffer + uv_offset,
+              frames[frame]->v_buffer + uv_offset,
+              frames[frame]->y_stride, frames[frame]->uv_stride,
               mb_uv_width, mb_uv_height,
               mbd->mi[0]->bmi[0].as_mv[0].as_mv.row,
               mbd->mi[0]->bmi[0].as_mv[0].as_mv.col,
@@ -444,7 +452,7 @@ static void temporal_filter_iterate_c(VP9_COMP *cpi,
         dst1 = cpi->alt_ref_buffer.y_buffer;
         dst1_16 = CONVERT_TO_SHORTPTR(dst1);
         stride = cpi->alt_ref_buffer.y_stride;
-        byte = mb_y_offset;
+        byte = dst_y_offset;
         for (i = 0, k = 0; i < 16; i++) {
           for (j = 0; j < 16; j++, k++) {
             unsigned int pval = accumulator[k] + (count[k] >> 1);
@@ -465,7 +473,7 @@ static void temporal_filter_iterate_c(VP9_COMP *cpi,
         dst1_16 = CONVERT_TO_SHORTPTR(dst1);
         dst2_16 = CONVERT_TO_SHORTPTR(dst2);
         stride = cpi->alt_ref_buffer.uv_stride;
-        byte = mb_uv_offset;
+        byte = dst_uv_offset;
         for (i = 0, k = 256; i < mb_uv_height; i++) {
           for (j = 0; j < mb_uv_width; j++, k++) {
             int m = k + 256;
@@ -492,7 +500,7 @@ static void temporal_filter_iterate_c(VP9_COMP *cpi,
         // Normalize filter output to produce AltRef frame
         dst1 = cpi->alt_ref_buffer.y_buffer;
         stride = cpi->alt_ref_buffer.y_stride;
-        byte = mb_y_offset;
+        byte = dst_y_offset;
         for (i = 0, k = 0; i < 16; i++) {
           for (j = 0; j < 16; j++, k++) {
             unsigned int pval = accumulator[k] + (count[k] >> 1);
@@ -510,7 +518,7 @@ static void temporal_filter_iterate_c(VP9_COMP *cpi,
         dst1 = cpi->alt_ref_buffer.u_buffer;
         dst2 = cpi->alt_ref_buffer.v_buffer;
         stride = cpi->alt_ref_buffer.uv_stride;
-        byte = mb_uv_offset;
+        byte = dst_uv_offset;
         for (i = 0, k = 256; i < mb_uv_height; i++) {
           for (j = 0; j < mb_uv_width; j++, k++) {
             int m = k + 256;
@@ -537,7 +545,7 @@ static void temporal_filter_iterate_c(VP9_COMP *cpi,
       // Normalize filter output to produce AltRef frame
       dst1 = cpi->alt_ref_buffer.y_buffer;
       stride = cpi->alt_ref_buffer.y_stride;
-      byte = mb_y_offset;
+      byte = dst_y_offset;
       for (i = 0, k = 0; i < 16; i++) {
         for (j = 0; j < 16; j++, k++) {
           unsigned int pval = accumulator[k] + (count[k] >> 1);
@@ -555,7 +563,7 @@ static void temporal_filter_iterate_c(VP9_COMP *cpi,
       dst1 = cpi->alt_ref_buffer.u_buffer;
       dst2 = cpi->alt_ref_buffer.v_buffer;
       stride = cpi->alt_ref_buffer.uv_stride;
-      byte = mb_uv_offset;
+      byte = dst_uv_offset;
       for (i = 0, k = 256; i < mb_uv_height; i++) {
         for (j = 0; j < mb_uv_width; j++, k++) {
           int m = k + 256;
@@ -721,7 +729,7 @@ void vp9_temporal_filter(VP9_COMP *cpi, int distance) {
                                "Failed to reallocate alt_ref_buffer");
           }
           frames[frame] = vp9_scale_if_required(
-              cm, frames[frame], &cpi->svc.scaled_frames[frame_used], 0);
+              cpi, frames[frame], &cpi->svc.scaled_frames[frame_used], 0);
           ++frame_used;
         }
       }
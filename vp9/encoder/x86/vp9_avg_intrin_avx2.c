@@ -0,0 +1,375 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// The Hadamard transforms work on two horizontally adjacent 8x8 blocks at a
+// time, one in each 128 bit lane. The in-lane unpacks of the SSE2 transpose
+// carry over unchanged, so a single 8x8 block has no AVX2 version.
+
+static void hadamard_col8x2_avx2(__m256i *in, int iter) {
+  __m256i a0 = in[0];
+  __m256i a1 = in[1];
+  __m256i a2 = in[2];
+  __m256i a3 = in[3];
+  __m256i a4 = in[4];
+  __m256i a5 = in[5];
+  __m256i a6 = in[6];
+  __m256i a7 = in[7];
+
+  __m256i b0 = _mm256_add_epi16(a0, a1);
+  __m256i b1 = _mm256_sub_epi16(a0, a1);
+  __m256i b2 = _mm256_add_epi16(a2, a3);
+  __m256i b3 = _mm256_sub_epi16(a2, a3);
+  __m256i b4 = _mm256_add_epi16(a4, a5);
+  __m256i b5 = _mm256_sub_epi16(a4, a5);
+  __m256i b6 = _mm256_add_epi16(a6, a7);
+  __m256i b7 = _mm256_sub_epi16(a6, a7);
+
+  a0 = _mm256_add_epi16(b0, b2);
+  a1 = _mm256_add_epi16(b1, b3);
+  a2 = _mm256_sub_epi16(b0, b2);
+  a3 = _mm256_sub_epi16(b1, b3);
+  a4 = _mm256_add_epi16(b4, b6);
+  a5 = _mm256_add_epi16(b5, b7);
+  a6 = _mm256_sub_epi16(b4, b6);
+  a7 = _mm256_sub_epi16(b5, b7);
+
+  if (iter == 0) {
+    b0 = _mm256_add_epi16(a0, a4);
+    b7 = _mm256_add_epi16(a1, a5);
+    b3 = _mm256_add_epi16(a2, a6);
+    b4 = _mm256_add_epi16(a3, a7);
+    b2 = _mm256_sub_epi16(a0, a4);
+    b6 = _mm256_sub_epi16(a1, a5);
+    b1 = _mm256_sub_epi16(a2, a6);
+    b5 = _mm256_sub_epi16(a3, a7);
+
+    a0 = _mm256_unpacklo_epi16(b0, b1);
+    a1 = _mm256_unpacklo_epi16(b2, b3);
+    a2 = _mm256_unpackhi_epi16(b0, b1);
+    a3 = _mm256_unpackhi_epi16(b2, b3);
+    a4 = _mm256_unpacklo_epi16(b4, b5);
+    a5 = _mm256_unpacklo_epi16(b6, b7);
+    a6 = _mm256_unpackhi_epi16(b4, b5);
+    a7 = _mm256_unpackhi_epi16(b6, b7);
+
+    b0 = _mm256_unpacklo_epi32(a0, a1);
+    b1 = _mm256_unpacklo_epi32(a4, a5);
+    b2 = _mm256_unpackhi_epi32(a0, a1);
+    b3 = _mm256_unpackhi_epi32(a4, a5);
+    b4 = _mm256_unpacklo_epi32(a2, a3);
+    b5 = _mm256_unpacklo_epi32(a6, a7);
+    b6 = _mm256_unpackhi_epi32(a2, a3);
+    b7 = _mm256_unpackhi_epi32(a6, a7);
+
+    in[0] = _mm256_unpacklo_epi64(b0, b1);
+    in[1] = _mm256_unpackhi_epi64(b0, b1);
+    in[2] = _mm256_unpacklo_epi64(b2, b3);
+    in[3] = _mm256_unpackhi_epi64(b2, b3);
+    in[4] = _mm256_unpacklo_epi64(b4, b5);
+    in[5] = _mm256_unpackhi_epi64(b4, b5);
+    in[6] = _mm256_unpacklo_epi64(b6, b7);
+    in[7] = _mm256_unpackhi_epi64(b6, b7);
+  } else {
+    in[0] = _mm256_add_epi16(a0, a4);
+    in[7] = _mm256_add_epi16(a1, a5);
+    in[3] = _mm256_add_epi16(a2, a6);
+    in[4] = _mm256_add_epi16(a3, a7);
+    in[2] = _mm256_sub_epi16(a0, a4);
+    in[6] = _mm256_sub_epi16(a1, a5);
+    in[1] = _mm256_sub_epi16(a2, a6);
+    in[5] = _mm256_sub_epi16(a3, a7);
+  }
+}
+
+// Transforms the 8x16 strip at |src_diff|: lane 0 of |out| holds the left
+// 8x8 block and lane 1 the right one.
+static INLINE void hadamard_8x8x2_avx2(int16_t const *src_diff,
+                                       int src_stride, __m256i *out) {
+  int i;
+  for (i = 0; i < 8; ++i)
+    out[i] = _mm256_loadu_si256((const __m256i *)(src_diff + i * src_stride));
+
+  hadamard_col8x2_avx2(out, 0);
+  hadamard_col8x2_avx2(out, 1);
+}
+
+// The 16x16 transform keeps the four 8x8 outputs in registers: rows of the
+// top and bottom strips are paired up so that each add and subtract of the
+// combining stage handles two of the blocks.
+void vp9_hadamard_16x16_avx2(int16_t const *src_diff, int src_stride,
+                             int16_t *coeff) {
+  __m256i top[8], bottom[8];
+  int i;
+
+  hadamard_8x8x2_avx2(src_diff, src_stride, top);
+  hadamard_8x8x2_avx2(src_diff + 8 * src_stride, src_stride, bottom);
+
+  for (i = 0; i < 8; ++i) {
+    // Row i of blocks 0 and 2, and of blocks 1 and 3.
+    const __m256i a02 = _mm256_permute2x128_si256(top[i], bottom[i], 0x20);
+    const __m256i a13 = _mm256_permute2x128_si256(top[i], bottom[i], 0x31);
+    const __m256i b02 = _mm256_srai_epi16(_mm256_add_epi16(a02, a13), 1);
+    const __m256i b13 = _mm256_srai_epi16(_mm256_sub_epi16(a02, a13), 1);
+    // (b0, b1) and (b2, b3).
+    const __m256i b01 = _mm256_permute2x128_si256(b02, b13, 0x20);
+    const __m256i b23 = _mm256_permute2x128_si256(b02, b13, 0x31);
+    const __m256i sum = _mm256_add_epi16(b01, b23);
+    const __m256i diff = _mm256_sub_epi16(b01, b23);
+
+    _mm_storeu_si128((__m128i *)(coeff + i * 8),
+                     _mm256_castsi256_si128(sum));
+    _mm_storeu_si128((__m128i *)(coeff + 64 + i * 8),
+                     _mm256_extracti128_si256(sum, 1));
+    _mm_storeu_si128((__m128i *)(coeff + 128 + i * 8),
+                     _mm256_castsi256_si128(diff));
+    _mm_storeu_si128((__m128i *)(coeff + 192 + i * 8),
+                     _mm256_extracti128_si256(diff, 1));
+  }
+}
+
+// floor((a + b) / 4) and floor((a - b) / 4) without the 17 bit intermediate
+// sum, as in the SSE2 version.
+static INLINE __m256i quarter_sum_avx2(const __m256i a, const __m256i b) {
+  const __m256i carry =
+      _mm256_and_si256(_mm256_and_si256(a, b), _mm256_set1_epi16(1));
+  return _mm256_srai_epi16(
+      _mm256_add_epi16(_mm256_add_epi16(_mm256_srai_epi16(a, 1),
+                                        _mm256_srai_epi16(b, 1)), carry), 1);
+}
+
+static INLINE __m256i quarter_diff_avx2(const __m256i a, const __m256i b) {
+  const __m256i borrow =
+      _mm256_andnot_si256(a, _mm256_and_si256(b, _mm256_set1_epi16(1)));
+  return _mm256_srai_epi16(
+      _mm256_sub_epi16(_mm256_sub_epi16(_mm256_srai_epi16(a, 1),
+                                        _mm256_srai_epi16(b, 1)), borrow), 1);
+}
+
+void vp9_hadamard_32x32_avx2(int16_t const *src_diff, int src_stride,
+                             int16_t *coeff) {
+  int idx;
+  for (idx = 0; idx < 4; ++idx) {
+    int16_t const *src_ptr = src_diff + (idx >> 1) * 16 * src_stride
+                                + (idx & 0x01) * 16;
+    vp9_hadamard_16x16_avx2(src_ptr, src_stride, coeff + idx * 256);
+  }
+
+  for (idx = 0; idx < 256; idx += 16) {
+    __m256i coeff0 = _mm256_loadu_si256((const __m256i *)coeff);
+    __m256i coeff1 = _mm256_loadu_si256((const __m256i *)(coeff + 256));
+    __m256i coeff2 = _mm256_loadu_si256((const __m256i *)(coeff + 512));
+    __m256i coeff3 = _mm256_loadu_si256((const __m256i *)(coeff + 768));
+
+    __m256i b0 = quarter_sum_avx2(coeff0, coeff1);
+    __m256i b1 = quarter_diff_avx2(coeff0, coeff1);
+    __m256i b2 = quarter_sum_avx2(coeff2, coeff3);
+    __m256i b3 = quarter_diff_avx2(coeff2, coeff3);
+
+    coeff0 = _mm256_add_epi16(b0, b2);
+    coeff1 = _mm256_add_epi16(b1, b3);
+    _mm256_storeu_si256((__m256i *)coeff, coeff0);
+    _mm256_storeu_si256((__m256i *)(coeff + 256), coeff1);
+
+    coeff2 = _mm256_sub_epi16(b0, b2);
+    coeff3 = _mm256_sub_epi16(b1, b3);
+    _mm256_storeu_si256((__m256i *)(coeff + 512), coeff2);
+    _mm256_storeu_si256((__m256i *)(coeff + 768), coeff3);
+
+    coeff += 16;
+  }
+}
+
+// Returns the sum of the 8 32 bit lanes of |v|.
+static INLINE int hsum_epi32(const __m256i v) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v),
+                              _mm256_extracti128_si256(v, 1));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+  return _mm_cvtsi128_si32(sum);
+}
+
+int vp9_satd_avx2(const int16_t *coeff, int length) {
+  const __m256i one = _mm256_set1_epi16(1);
+  __m256i sum = _mm256_setzero_si256();
+  int i;
+
+  for (i = 0; i < length; i += 16) {
+    const __m256i src_line = _mm256_loadu_si256((const __m256i *)coeff);
+    sum = _mm256_add_epi32(sum,
+                           _mm256_madd_epi16(_mm256_abs_epi16(src_line), one));
+    coeff += 16;
+  }
+
+  return hsum_epi32(sum);
+}
+
+// The column sums of 64 rows are at most 16320, so they are accumulated with
+// plain 16 bit adds in two chains.
+void vp9_int_pro_row_avx2(int16_t *hbuf, uint8_t const *ref,
+                          const int ref_stride, const int height) {
+  __m256i s0 = _mm256_setzero_si256();
+  __m256i s1 = _mm256_setzero_si256();
+  int idx;
+
+  for (idx = 0; idx < height; idx += 2) {
+    s0 = _mm256_add_epi16(s0, _mm256_cvtepu8_epi16(
+        _mm_loadu_si128((const __m128i *)ref)));
+    s1 = _mm256_add_epi16(s1, _mm256_cvtepu8_epi16(
+        _mm_loadu_si128((const __m128i *)(ref + ref_stride))));
+    ref += 2 * ref_stride;
+  }
+  s0 = _mm256_add_epi16(s0, s1);
+
+  if (height == 64)
+    s0 = _mm256_srai_epi16(s0, 5);
+  else if (height == 32)
+    s0 = _mm256_srai_epi16(s0, 4);
+  else
+    s0 = _mm256_srai_epi16(s0, 3);
+
+  _mm256_storeu_si256((__m256i *)hbuf, s0);
+}
+
+int16_t vp9_int_pro_col_avx2(uint8_t const *ref, const int width) {
+  __m128i sum;
+  int i;
+
+  if (width == 16) {
+    sum = _mm_sad_epu8(_mm_loadu_si128((const __m128i *)ref),
+                       _mm_setzero_si128());
+  } else {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i s0 = _mm256_setzero_si256();
+    for (i = 0; i < width; i += 32) {
+      s0 = _mm256_add_epi64(s0, _mm256_sad_epu8(
+          _mm256_loadu_si256((const __m256i *)(ref + i)), zero));
+    }
+    sum = _mm_add_epi64(_mm256_castsi256_si128(s0),
+                        _mm256_extracti128_si256(s0, 1));
+  }
+  sum = _mm_add_epi64(sum, _mm_srli_si128(sum, 8));
+
+  return (int16_t)_mm_cvtsi128_si32(sum);
+}
+
+int vp9_vector_var_avx2(int16_t const *ref, int16_t const *src,
+                        const int bwl) {
+  const __m256i one = _mm256_set1_epi16(1);
+  const int width = 4 << bwl;
+  __m256i sum = _mm256_setzero_si256();
+  __m256i sse = _mm256_setzero_si256();
+  int idx, mean;
+
+  for (idx = 0; idx < width; idx += 16) {
+    const __m256i v0 = _mm256_loadu_si256((const __m256i *)(ref + idx));
+    const __m256i v1 = _mm256_loadu_si256((const __m256i *)(src + idx));
+    const __m256i diff = _mm256_subs_epi16(v0, v1);
+    sum = _mm256_add_epi16(sum, diff);
+    sse = _mm256_add_epi32(sse, _mm256_madd_epi16(diff, diff));
+  }
+
+  mean = hsum_epi32(_mm256_madd_epi16(sum, one));
+
+  return hsum_epi32(sse) - ((mean * mean) >> (bwl + 2));
+}
+
+// Each row of a strip of 8 blocks is two 32 pixel loads, whose SADs against
+// zero give the row sums of the blocks in the 64 bit lanes.
+void vp9_avg_8x8_64x64_avx2(const uint8_t *s, int p, int *avg) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i rounding = _mm256_set1_epi32(32);
+  const __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  int r, i;
+
+  for (r = 0; r < 8; ++r) {
+    __m256i lo = zero;
+    __m256i hi = zero;
+    __m256i sum;
+    for (i = 0; i < 8; ++i) {
+      lo = _mm256_add_epi32(
+          lo, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i *)s), zero));
+      hi = _mm256_add_epi32(
+          hi, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i *)(s + 32)),
+                              zero));
+      s += p;
+    }
+    // The sums fit in the low halves of the 64 bit lanes. Interleave blocks
+    // 0-3 and 4-7, then put them back in order.
+    sum = _mm256_or_si256(lo, _mm256_slli_epi64(hi, 32));
+    sum = _mm256_permutevar8x32_epi32(sum, order);
+    sum = _mm256_srli_epi32(_mm256_add_epi32(sum, rounding), 6);
+    _mm256_storeu_si256((__m256i *)(avg + 8 * r), sum);
+  }
+}
+
+// Two strips of 4 blocks at a time, one in each 128 bit lane.
+void vp9_avg_4x4_16x16_avx2(const uint8_t *s, int p, int *avg) {
+  const __m256i one8 = _mm256_set1_epi8(1);
+  const __m256i one16 = _mm256_set1_epi16(1);
+  const __m256i rounding = _mm256_set1_epi32(8);
+  int r, i;
+
+  for (r = 0; r < 16; r += 8) {
+    __m256i sum = _mm256_setzero_si256();
+    for (i = 0; i < 4; ++i) {
+      const __m256i v = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(s + i * p))),
+          _mm_loadu_si128((const __m128i *)(s + (i + 4) * p)), 1);
+      sum = _mm256_add_epi16(sum, _mm256_maddubs_epi16(v, one8));
+    }
+    sum = _mm256_madd_epi16(sum, one16);
+    sum = _mm256_srli_epi32(_mm256_add_epi32(sum, rounding), 4);
+    _mm256_storeu_si256((__m256i *)(avg + r), sum);
+    s += 8 * p;
+  }
+}
+
+// Loads 4 rows of 8 pixels, one per 64 bit lane.
+static INLINE __m256i load_8x4(const uint8_t *s, int p) {
+  const __m128i r01 =
+      _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)s),
+                         _mm_loadl_epi64((const __m128i *)(s + p)));
+  const __m128i r23 =
+      _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(s + 2 * p)),
+                         _mm_loadl_epi64((const __m128i *)(s + 3 * p)));
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(r01), r23, 1);
+}
+
+// The absolute differences fit in 8 bits. The final 8 lanes are widened for
+// _mm_minpos_epu16(), which also gives the maximum of the inverted values.
+void vp9_minmax_8x8_avx2(const uint8_t *s, int p, const uint8_t *d, int dp,
+                         int *min, int *max) {
+  const __m256i s0 = load_8x4(s, p);
+  const __m256i s1 = load_8x4(s + 4 * p, p);
+  const __m256i d0 = load_8x4(d, dp);
+  const __m256i d1 = load_8x4(d + 4 * dp, dp);
+  const __m256i absdiff0 = _mm256_or_si256(_mm256_subs_epu8(s0, d0),
+                                           _mm256_subs_epu8(d0, s0));
+  const __m256i absdiff1 = _mm256_or_si256(_mm256_subs_epu8(s1, d1),
+                                           _mm256_subs_epu8(d1, s1));
+  const __m256i maxabsdiff = _mm256_max_epu8(absdiff0, absdiff1);
+  const __m256i minabsdiff = _mm256_min_epu8(absdiff0, absdiff1);
+  __m128i mx = _mm_max_epu8(_mm256_castsi256_si128(maxabsdiff),
+                            _mm256_extracti128_si256(maxabsdiff, 1));
+  __m128i mn = _mm_min_epu8(_mm256_castsi256_si128(minabsdiff),
+                            _mm256_extracti128_si256(minabsdiff, 1));
+
+  mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 8));
+  mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 8));
+  mx = _mm_xor_si128(_mm_cvtepu8_epi16(mx), _mm_set1_epi16(255));
+  *max = 255 - (_mm_cvtsi128_si32(_mm_minpos_epu16(mx)) & 0xffff);
+  *min = _mm_cvtsi128_si32(_mm_minpos_epu16(_mm_cvtepu8_epi16(mn))) & 0xffff;
+}
@@ -136,6 +136,52 @@ unsigned int vp9_avg_4x4_sse2(const uint8_t *s, int p) {
   return (avg + 8) >> 4;
 }
 
+void vp9_avg_8x8_64x64_sse2(const uint8_t *s, int p, int *avg) {
+  const __m128i zero = _mm_setzero_si128();
+  int r, c, i;
+  for (r = 0; r < 8; ++r, s += 8 * p, avg += 8) {
+    // Each sad against zero sums the two 8 pixel halves of a 16 pixel row,
+    // so one register accumulates two horizontally adjacent 8x8 blocks.
+    __m128i sum[4];
+    for (c = 0; c < 4; ++c)
+      sum[c] = zero;
+    for (i = 0; i < 8; ++i) {
+      for (c = 0; c < 4; ++c) {
+        const __m128i row =
+            _mm_loadu_si128((const __m128i *)(s + i * p + 16 * c));
+        sum[c] = _mm_add_epi32(sum[c], _mm_sad_epu8(row, zero));
+      }
+    }
+    for (c = 0; c < 4; ++c) {
+      avg[2 * c] = (_mm_cvtsi128_si32(sum[c]) + 32) >> 6;
+      avg[2 * c + 1] =
+          (_mm_cvtsi128_si32(_mm_srli_si128(sum[c], 8)) + 32) >> 6;
+    }
+  }
+}
+
+void vp9_avg_4x4_16x16_sse2(const uint8_t *s, int p, int *avg) {
+  const __m128i zero = _mm_setzero_si128();
+  // Selects pixels 0-3 and 8-11 of a row; the complement selects 4-7 and
+  // 12-15.
+  const __m128i mask = _mm_set_epi32(0, -1, 0, -1);
+  int r, i;
+  for (r = 0; r < 4; ++r, s += 4 * p, avg += 4) {
+    __m128i even = zero, odd = zero;
+    for (i = 0; i < 4; ++i) {
+      const __m128i row = _mm_loadu_si128((const __m128i *)(s + i * p));
+      even = _mm_add_epi32(even,
+                           _mm_sad_epu8(_mm_and_si128(row, mask), zero));
+      odd = _mm_add_epi32(odd,
+                          _mm_sad_epu8(_mm_andnot_si128(mask, row), zero));
+    }
+    avg[0] = (_mm_cvtsi128_si32(even) + 8) >> 4;
+    avg[1] = (_mm_cvtsi128_si32(odd) + 8) >> 4;
+    avg[2] = (_mm_cvtsi128_si32(_mm_srli_si128(even, 8)) + 8) >> 4;
+    avg[3] = (_mm_cvtsi128_si32(_mm_srli_si128(odd, 8)) + 8) >> 4;
+  }
+}
+
 static void hadamard_col8_sse2(__m128i *in, int iter) {
   __m128i a0 = in[0];
   __m128i a1 = in[1];
@@ -283,31 +329,78 @@ void vp9_hadamard_16x16_sse2(int16_t const *src_diff, int src_stride,
   }
 }
 
-int16_t vp9_satd_sse2(const int16_t *coeff, int length) {
+// floor((a + b) / 4) and floor((a - b) / 4) without the 17 bit intermediate
+// sum: the halves of a and b are added with the bit lost when both are odd,
+// or subtracted with the bit borrowed when only b is odd.
+static INLINE __m128i quarter_sum_sse2(const __m128i a, const __m128i b) {
+  const __m128i carry =
+      _mm_and_si128(_mm_and_si128(a, b), _mm_set1_epi16(1));
+  return _mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(a, 1),
+                                                    _mm_srai_epi16(b, 1)),
+                                      carry), 1);
+}
+
+static INLINE __m128i quarter_diff_sse2(const __m128i a, const __m128i b) {
+  const __m128i borrow = _mm_andnot_si128(a, _mm_and_si128(b,
+                                                   _mm_set1_epi16(1)));
+  return _mm_srai_epi16(_mm_sub_epi16(_mm_sub_epi16(_mm_srai_epi16(a, 1),
+                                                    _mm_srai_epi16(b, 1)),
+                                      borrow), 1);
+}
+
+void vp9_hadamard_32x32_sse2(int16_t const *src_diff, int src_stride,
+                             int16_t *coeff) {
+  int idx;
+  for (idx = 0; idx < 4; ++idx) {
+    int16_t const *src_ptr = src_diff + (idx >> 1) * 16 * src_stride
+                                + (idx & 0x01) * 16;
+    vp9_hadamard_16x16_sse2(src_ptr, src_stride, coeff + idx * 256);
+  }
+
+  for (idx = 0; idx < 256; idx += 8) {
+    __m128i coeff0 = _mm_load_si128((const __m128i *)coeff);
+    __m128i coeff1 = _mm_load_si128((const __m128i *)(coeff + 256));
+    __m128i coeff2 = _mm_load_si128((const __m128i *)(coeff + 512));
+    __m128i coeff3 = _mm_load_si128((const __m128i *)(coeff + 768));
+
+    __m128i b0 = quarter_sum_sse2(coeff0, coeff1);
+    __m128i b1 = quarter_diff_sse2(coeff0, coeff1);
+    __m128i b2 = quarter_sum_sse2(coeff2, coeff3);
+    __m128i b3 = quarter_diff_sse2(coeff2, coeff3);
+
+    coeff0 = _mm_add_epi16(b0, b2);
+    coeff1 = _mm_add_epi16(b1, b3);
+    _mm_store_si128((__m128i *)coeff, coeff0);
+    _mm_store_si128((__m128i *)(coeff + 256), coeff1);
+
+    coeff2 = _mm_sub_epi16(b0, b2);
+    coeff3 = _mm_sub_epi16(b1, b3);
+    _mm_store_si128((__m128i *)(coeff + 512), coeff2);
+    _mm_store_si128((__m128i *)(coeff + 768), coeff3);
+
+    coeff += 8;
+  }
+}
+
+int vp9_satd_sse2(const int16_t *coeff, int length) {
   int i;
-  __m128i sum = _mm_load_si128((const __m128i *)coeff);
-  __m128i sign = _mm_srai_epi16(sum, 15);
-  __m128i val = _mm_xor_si128(sum, sign);
-  sum = _mm_sub_epi16(val, sign);
-  coeff += 8;
+  const __m128i one = _mm_set1_epi16(1);
+  __m128i sum = _mm_setzero_si128();
 
-  for (i = 8; i < length; i += 8) {
-    __m128i src_line = _mm_load_si128((const __m128i *)coeff);
-    sign = _mm_srai_epi16(src_line, 15);
-    val = _mm_xor_si128(src_line, sign);
+  for (i = 0; i < length; i += 8) {
+    const __m128i src_line = _mm_load_si128((const __m128i *)coeff);
+    const __m128i sign = _mm_srai_epi16(src_line, 15);
+    __m128i val = _mm_xor_si128(src_line, sign);
     val = _mm_sub_epi16(val, sign);
-    sum = _mm_add_epi16(sum, val);
+    // Widen to 32 bits, as the sum of a 32x32 block overflows 16 bits.
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(val, one));
     coeff += 8;
   }
 
-  val = _mm_srli_si128(sum, 8);
-  sum = _mm_add_epi16(sum, val);
-  val = _mm_srli_epi64(sum, 32);
-  sum = _mm_add_epi16(sum, val);
-  val = _mm_srli_epi32(sum, 16);
-  sum = _mm_add_epi16(sum, val);
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
 
-  return _mm_extract_epi16(sum, 0);
+  return _mm_cvtsi128_si32(sum);
 }
 
 void vp9_int_pro_row_sse2(int16_t *hbuf, uint8_t const*ref,
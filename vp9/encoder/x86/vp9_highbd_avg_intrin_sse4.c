@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>  // SSE4.1
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// The pixels are at most 12 bits, so the column sums of up to 8 rows fit in
+// the unsigned 16 bit lanes.
+
+// Returns the sums of the pairs of 16 bit lanes of |v|.
+static INLINE __m128i add_pairs_epu16(const __m128i v) {
+  return _mm_add_epi32(_mm_blend_epi16(v, _mm_setzero_si128(), 0xaa),
+                       _mm_srli_epi32(v, 16));
+}
+
+static INLINE int hsum_epi32(__m128i v) {
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+  v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+  return _mm_cvtsi128_si32(v);
+}
+
+// Returns 4 partial sums of the 8x8 block at s.
+static INLINE __m128i sum_8x8(const uint16_t *s, int p) {
+  __m128i sum = _mm_loadu_si128((const __m128i *)s);
+  int i;
+  for (i = 1; i < 8; ++i)
+    sum = _mm_add_epi16(sum, _mm_loadu_si128((const __m128i *)(s + i * p)));
+  return add_pairs_epu16(sum);
+}
+
+unsigned int vp9_highbd_avg_8x8_sse4_1(const uint8_t *s8, int p) {
+  return (hsum_epi32(sum_8x8(CONVERT_TO_SHORTPTR(s8), p)) + 32) >> 6;
+}
+
+unsigned int vp9_highbd_avg_4x4_sse4_1(const uint8_t *s8, int p) {
+  const uint16_t *s = CONVERT_TO_SHORTPTR(s8);
+  const __m128i r01 =
+      _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)s),
+                         _mm_loadl_epi64((const __m128i *)(s + p)));
+  const __m128i r23 =
+      _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(s + 2 * p)),
+                         _mm_loadl_epi64((const __m128i *)(s + 3 * p)));
+  return (hsum_epi32(add_pairs_epu16(_mm_add_epi16(r01, r23))) + 8) >> 4;
+}
+
+void vp9_highbd_avg_8x8_64x64_sse4_1(const uint8_t *s8, int p, int *avg) {
+  const __m128i rounding = _mm_set1_epi32(32);
+  const uint16_t *s = CONVERT_TO_SHORTPTR(s8);
+  int r, c;
+
+  for (r = 0; r < 8; ++r) {
+    for (c = 0; c < 8; c += 4) {
+      const __m128i b0 = sum_8x8(s + 8 * c, p);
+      const __m128i b1 = sum_8x8(s + 8 * (c + 1), p);
+      const __m128i b2 = sum_8x8(s + 8 * (c + 2), p);
+      const __m128i b3 = sum_8x8(s + 8 * (c + 3), p);
+      __m128i sum = _mm_hadd_epi32(_mm_hadd_epi32(b0, b1),
+                                   _mm_hadd_epi32(b2, b3));
+      sum = _mm_srli_epi32(_mm_add_epi32(sum, rounding), 6);
+      _mm_storeu_si128((__m128i *)(avg + 8 * r + c), sum);
+    }
+    s += 8 * p;
+  }
+}
+
+// Each row of a strip of 4 blocks is two loads of 2 blocks.
+void vp9_highbd_avg_4x4_16x16_sse4_1(const uint8_t *s8, int p, int *avg) {
+  const __m128i rounding = _mm_set1_epi32(8);
+  const uint16_t *s = CONVERT_TO_SHORTPTR(s8);
+  int r, i;
+
+  for (r = 0; r < 4; ++r) {
+    __m128i lo = _mm_loadu_si128((const __m128i *)s);
+    __m128i hi = _mm_loadu_si128((const __m128i *)(s + 8));
+    __m128i sum;
+    for (i = 1; i < 4; ++i) {
+      lo = _mm_add_epi16(lo, _mm_loadu_si128((const __m128i *)(s + i * p)));
+      hi = _mm_add_epi16(hi,
+                         _mm_loadu_si128((const __m128i *)(s + i * p + 8)));
+    }
+    sum = _mm_hadd_epi32(add_pairs_epu16(lo), add_pairs_epu16(hi));
+    sum = _mm_srli_epi32(_mm_add_epi32(sum, rounding), 4);
+    _mm_storeu_si128((__m128i *)(avg + 4 * r), sum);
+    s += 4 * p;
+  }
+}
+
+// As in the C version the minimum is capped at 255. The maximum is found with
+// _mm_minpos_epu16() on the inverted differences.
+void vp9_highbd_minmax_8x8_sse4_1(const uint8_t *s8, int p,
+                                  const uint8_t *d8, int dp,
+                                  int *min, int *max) {
+  const uint16_t *s = CONVERT_TO_SHORTPTR(s8);
+  const uint16_t *d = CONVERT_TO_SHORTPTR(d8);
+  __m128i maxabsdiff = _mm_setzero_si128();
+  __m128i minabsdiff = _mm_set1_epi16(255);
+  int i, minpos;
+
+  for (i = 0; i < 8; ++i, s += p, d += dp) {
+    const __m128i s0 = _mm_loadu_si128((const __m128i *)s);
+    const __m128i d0 = _mm_loadu_si128((const __m128i *)d);
+    const __m128i absdiff =
+        _mm_sub_epi16(_mm_max_epu16(s0, d0), _mm_min_epu16(s0, d0));
+    maxabsdiff = _mm_max_epu16(maxabsdiff, absdiff);
+    minabsdiff = _mm_min_epu16(minabsdiff, absdiff);
+  }
+
+  maxabsdiff = _mm_xor_si128(maxabsdiff, _mm_set1_epi16(-1));
+  minpos = _mm_cvtsi128_si32(_mm_minpos_epu16(maxabsdiff));
+  *max = 0xffff - (minpos & 0xffff);
+  *min = _mm_cvtsi128_si32(_mm_minpos_epu16(minabsdiff)) & 0xffff;
+}
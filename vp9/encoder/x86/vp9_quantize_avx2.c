@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// 16 coefficients per iteration. The 32x32 version applies the
+// abs_coeff >= dequant / 4 test of the C code to each coefficient, where the
+// SSSE3 version only uses it to skip groups of 16, and takes the quant
+// product unsigned so that quant << 1 can't wrap. Groups that quantize to
+// zero skip the dequantization and eob update.
+
+typedef struct {
+  __m256i round;
+  __m256i quant;
+  __m256i dequant;
+  __m256i thr;
+} QuantizeParams;
+
+// Loads the DC and AC values of |p| in the layout of the first 16
+// coefficients: the DC value in lane 0 and AC values in the rest.
+static INLINE __m256i load_dc_ac(const int16_t *p) {
+  const __m128i v = _mm_load_si128((const __m128i *)p);
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(v),
+                                 _mm_unpackhi_epi64(v, v), 1);
+}
+
+// Replaces the DC value of a load_dc_ac() register with an AC value.
+static INLINE __m256i ac_only(const __m256i v) {
+  return _mm256_permute2x128_si256(v, v, 0x11);
+}
+
+static INLINE void store_zero_16(int16_t *qcoeff_ptr, int16_t *dqcoeff_ptr) {
+  const __m256i zero = _mm256_setzero_si256();
+  _mm256_storeu_si256((__m256i *)qcoeff_ptr, zero);
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr, zero);
+}
+
+static INLINE void quantize_fp_16(const int16_t *coeff_ptr,
+                                  const int16_t *iscan_ptr,
+                                  int16_t *qcoeff_ptr, int16_t *dqcoeff_ptr,
+                                  const QuantizeParams *p, int is_32x32,
+                                  __m256i *eob) {
+  const __m256i coeff = _mm256_loadu_si256((const __m256i *)coeff_ptr);
+  const __m256i coeff_sign = _mm256_srai_epi16(coeff, 15);
+  const __m256i abs_coeff = _mm256_abs_epi16(coeff);
+  __m256i tmp, qcoeff, dqcoeff, nz_iscan;
+
+  tmp = _mm256_adds_epi16(abs_coeff, p->round);
+  if (is_32x32) {
+    const __m256i thr_mask = _mm256_cmpgt_epi16(abs_coeff, p->thr);
+    tmp = _mm256_and_si256(_mm256_mulhi_epu16(tmp, p->quant), thr_mask);
+  } else {
+    tmp = _mm256_mulhi_epi16(tmp, p->quant);
+  }
+
+  if (_mm256_testz_si256(tmp, tmp)) {
+    store_zero_16(qcoeff_ptr, dqcoeff_ptr);
+    return;
+  }
+
+  qcoeff = _mm256_sub_epi16(_mm256_xor_si256(tmp, coeff_sign), coeff_sign);
+  if (is_32x32) {
+    // The low 16 bits of tmp * dequant / 2.
+    dqcoeff = _mm256_or_si256(
+        _mm256_srli_epi16(_mm256_mullo_epi16(tmp, p->dequant), 1),
+        _mm256_slli_epi16(_mm256_mulhi_epu16(tmp, p->dequant), 15));
+    dqcoeff = _mm256_sub_epi16(_mm256_xor_si256(dqcoeff, coeff_sign),
+                               coeff_sign);
+  } else {
+    dqcoeff = _mm256_mullo_epi16(qcoeff, p->dequant);
+  }
+  _mm256_storeu_si256((__m256i *)qcoeff_ptr, qcoeff);
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr, dqcoeff);
+
+  // iscan + 1 where the quantized value is nonzero, otherwise 0.
+  nz_iscan = _mm256_sub_epi16(
+      _mm256_loadu_si256((const __m256i *)iscan_ptr),
+      _mm256_cmpeq_epi16(tmp, tmp));
+  nz_iscan = _mm256_andnot_si256(
+      _mm256_cmpeq_epi16(tmp, _mm256_setzero_si256()), nz_iscan);
+  *eob = _mm256_max_epi16(*eob, nz_iscan);
+}
+
+static INLINE void quantize_fp(const int16_t *coeff_ptr, intptr_t n_coeffs,
+                               int skip_block, const int16_t *round_ptr,
+                               const int16_t *quant_ptr, int16_t *qcoeff_ptr,
+                               int16_t *dqcoeff_ptr,
+                               const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                               const int16_t *iscan_ptr, int is_32x32) {
+  __m256i eob = _mm256_setzero_si256();
+  __m128i eob_8;
+  QuantizeParams p;
+  intptr_t i;
+
+  if (skip_block) {
+    for (i = 0; i < n_coeffs; i += 16)
+      store_zero_16(qcoeff_ptr + i, dqcoeff_ptr + i);
+    *eob_ptr = 0;
+    return;
+  }
+
+  p.round = load_dc_ac(round_ptr);
+  p.quant = load_dc_ac(quant_ptr);
+  p.dequant = load_dc_ac(dequant_ptr);
+  p.thr = _mm256_setzero_si256();
+  if (is_32x32) {
+    // ROUND_POWER_OF_TWO(round, 1), a shift of 15 instead of 16 for the
+    // quant product, and abs_coeff >= dequant / 4 tested as
+    // abs_coeff > dequant / 4 - 1.
+    p.round = _mm256_srli_epi16(
+        _mm256_add_epi16(p.round, _mm256_set1_epi16(1)), 1);
+    p.quant = _mm256_slli_epi16(p.quant, 1);
+    p.thr = _mm256_sub_epi16(_mm256_srai_epi16(p.dequant, 2),
+                             _mm256_set1_epi16(1));
+  }
+
+  quantize_fp_16(coeff_ptr, iscan_ptr, qcoeff_ptr, dqcoeff_ptr, &p, is_32x32,
+                 &eob);
+
+  p.round = ac_only(p.round);
+  p.quant = ac_only(p.quant);
+  p.dequant = ac_only(p.dequant);
+  p.thr = ac_only(p.thr);
+  for (i = 16; i < n_coeffs; i += 16) {
+    quantize_fp_16(coeff_ptr + i, iscan_ptr + i, qcoeff_ptr + i,
+                   dqcoeff_ptr + i, &p, is_32x32, &eob);
+  }
+
+  // Accumulate the eob.
+  eob_8 = _mm_max_epi16(_mm256_castsi256_si128(eob),
+                        _mm256_extracti128_si256(eob, 1));
+  eob_8 = _mm_max_epi16(eob_8, _mm_srli_si128(eob_8, 8));
+  eob_8 = _mm_max_epi16(eob_8, _mm_srli_si128(eob_8, 4));
+  eob_8 = _mm_max_epi16(eob_8, _mm_srli_si128(eob_8, 2));
+  *eob_ptr = (uint16_t)_mm_extract_epi16(eob_8, 0);
+}
+
+void vp9_quantize_fp_avx2(const int16_t *coeff_ptr, intptr_t n_coeffs,
+                          int skip_block, const int16_t *zbin_ptr,
+                          const int16_t *round_ptr, const int16_t *quant_ptr,
+                          const int16_t *quant_shift_ptr, int16_t *qcoeff_ptr,
+                          int16_t *dqcoeff_ptr, const int16_t *dequant_ptr,
+                          uint16_t *eob_ptr, const int16_t *scan_ptr,
+                          const int16_t *iscan_ptr) {
+  (void)zbin_ptr;
+  (void)quant_shift_ptr;
+  (void)scan_ptr;
+  quantize_fp(coeff_ptr, n_coeffs, skip_block, round_ptr, quant_ptr,
+              qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, iscan_ptr, 0);
+}
+
+void vp9_quantize_fp_32x32_avx2(const int16_t *coeff_ptr, intptr_t n_coeffs,
+                                int skip_block, const int16_t *zbin_ptr,
+                                const int16_t *round_ptr,
+                                const int16_t *quant_ptr,
+                                const int16_t *quant_shift_ptr,
+                                int16_t *qcoeff_ptr, int16_t *dqcoeff_ptr,
+                                const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                                const int16_t *scan_ptr,
+                                const int16_t *iscan_ptr) {
+  (void)zbin_ptr;
+  (void)quant_shift_ptr;
+  (void)scan_ptr;
+  quantize_fp(coeff_ptr, n_coeffs, skip_block, round_ptr, quant_ptr,
+              qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, iscan_ptr, 1);
+}
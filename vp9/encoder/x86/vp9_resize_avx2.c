@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// As in the SSE2 version, but with 32 pixels per iteration. The unpacks and
+// packs all work within 128 bit lanes, so the pixels come out in order.
+static INLINE void madd_pair(const __m256i a, const __m256i b,
+                             const __m256i f, __m256i sum[4]) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i lo = _mm256_unpacklo_epi8(a, b);
+  const __m256i hi = _mm256_unpackhi_epi8(a, b);
+  sum[0] = _mm256_add_epi32(sum[0],
+                            _mm256_madd_epi16(_mm256_unpacklo_epi8(lo, zero),
+                                              f));
+  sum[1] = _mm256_add_epi32(sum[1],
+                            _mm256_madd_epi16(_mm256_unpackhi_epi8(lo, zero),
+                                              f));
+  sum[2] = _mm256_add_epi32(sum[2],
+                            _mm256_madd_epi16(_mm256_unpacklo_epi8(hi, zero),
+                                              f));
+  sum[3] = _mm256_add_epi32(sum[3],
+                            _mm256_madd_epi16(_mm256_unpackhi_epi8(hi, zero),
+                                              f));
+}
+
+static INLINE void filter_32(const uint8_t *const src[8], const __m256i f[4],
+                             uint8_t *dst, int x) {
+  const __m256i round = _mm256_set1_epi32(1 << 6);
+  __m256i sum[4];
+  int k;
+
+  sum[0] = sum[1] = sum[2] = sum[3] = round;
+  for (k = 0; k < 4; ++k)
+    madd_pair(_mm256_loadu_si256((const __m256i *)(src[2 * k] + x)),
+              _mm256_loadu_si256((const __m256i *)(src[2 * k + 1] + x)),
+              f[k], sum);
+  for (k = 0; k < 4; ++k)
+    sum[k] = _mm256_srai_epi32(sum[k], 7);
+  _mm256_storeu_si256((__m256i *)(dst + x),
+                      _mm256_packus_epi16(_mm256_packs_epi32(sum[0], sum[1]),
+                                          _mm256_packs_epi32(sum[2], sum[3])));
+}
+
+void vp9_resize_filter_8tap_avx2(const uint8_t *const src[8],
+                                 const int16_t *filter, uint8_t *dst,
+                                 int width) {
+  __m256i f[4];
+  int k, x;
+
+  if (width < 32) {
+    vp9_resize_filter_8tap_sse2(src, filter, dst, width);
+    return;
+  }
+  for (k = 0; k < 4; ++k)
+    f[k] = _mm256_set1_epi32(
+        (int)((uint16_t)filter[2 * k] |
+              ((uint32_t)(uint16_t)filter[2 * k + 1] << 16)));
+  for (x = 0; x + 32 <= width; x += 32)
+    filter_32(src, f, dst, x);
+  // The last few pixels are done by redoing part of the previous 32.
+  if (x < width)
+    filter_32(src, f, dst, width - 32);
+}
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Adds the products of the taps in |f|, a pair of taps repeated, with the
+// pixels of |a| and |b| to the 32 bit sums of 16 pixels in |sum|.
+static INLINE void madd_pair(const __m128i a, const __m128i b,
+                             const __m128i f, __m128i sum[4]) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i lo = _mm_unpacklo_epi8(a, b);
+  const __m128i hi = _mm_unpackhi_epi8(a, b);
+  sum[0] = _mm_add_epi32(sum[0],
+                         _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), f));
+  sum[1] = _mm_add_epi32(sum[1],
+                         _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), f));
+  sum[2] = _mm_add_epi32(sum[2],
+                         _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), f));
+  sum[3] = _mm_add_epi32(sum[3],
+                         _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), f));
+}
+
+static INLINE void filter_16(const uint8_t *const src[8], const __m128i f[4],
+                             uint8_t *dst, int x) {
+  const __m128i round = _mm_set1_epi32(1 << 6);
+  __m128i sum[4];
+  int k;
+
+  sum[0] = sum[1] = sum[2] = sum[3] = round;
+  for (k = 0; k < 4; ++k)
+    madd_pair(_mm_loadu_si128((const __m128i *)(src[2 * k] + x)),
+              _mm_loadu_si128((const __m128i *)(src[2 * k + 1] + x)),
+              f[k], sum);
+  for (k = 0; k < 4; ++k)
+    sum[k] = _mm_srai_epi32(sum[k], 7);
+  _mm_storeu_si128((__m128i *)(dst + x),
+                   _mm_packus_epi16(_mm_packs_epi32(sum[0], sum[1]),
+                                    _mm_packs_epi32(sum[2], sum[3])));
+}
+
+void vp9_resize_filter_8tap_sse2(const uint8_t *const src[8],
+                                 const int16_t *filter, uint8_t *dst,
+                                 int width) {
+  __m128i f[4];
+  int k, x;
+
+  if (width < 16) {
+    vp9_resize_filter_8tap_c(src, filter, dst, width);
+    return;
+  }
+  for (k = 0; k < 4; ++k)
+    f[k] = _mm_set1_epi32((int)((uint16_t)filter[2 * k] |
+                                ((uint32_t)(uint16_t)filter[2 * k + 1] << 16)));
+  for (x = 0; x + 16 <= width; x += 16)
+    filter_16(src, f, dst, x);
+  // The last few pixels are done by redoing part of the previous 16.
+  if (x < width)
+    filter_16(src, f, dst, width - 16);
+}
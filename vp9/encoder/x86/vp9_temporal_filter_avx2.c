@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+
+#include "./vp9_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// The modifier is computed in 32 bits, so unlike the SSE2 version these match
+// the C code for any difference and strength. Each 32 bit lane holds one
+// pixel, with the high 16 bits clear, which lets madd_epi16 do the
+// multiplies.
+
+typedef struct {
+  __m256i rounding;
+  __m128i strength;
+  __m256i weight;
+  __m256i sixteen;
+} ModifierParams;
+
+static INLINE void init_params(ModifierParams *p, int strength,
+                               int filter_weight) {
+  p->rounding = _mm256_set1_epi32(strength > 0 ? 1 << (strength - 1) : 0);
+  p->strength = _mm_cvtsi32_si128(strength);
+  p->weight = _mm256_set1_epi32(filter_weight);
+  p->sixteen = _mm256_set1_epi32(16);
+}
+
+// Adds the filter modifier of 8 pixels, given their absolute differences
+// |abs_diff| and predictor values |pixel|, to |count| and |accumulator|.
+static INLINE void apply_8(const __m256i abs_diff, const __m256i pixel,
+                           const ModifierParams *p,
+                           unsigned int *accumulator, uint16_t *count) {
+  const __m256i diff3 =
+      _mm256_add_epi32(abs_diff, _mm256_add_epi32(abs_diff, abs_diff));
+  __m256i modifier = _mm256_madd_epi16(abs_diff, diff3);
+  __m128i count_8;
+
+  modifier = _mm256_srl_epi32(_mm256_add_epi32(modifier, p->rounding),
+                              p->strength);
+  modifier = _mm256_sub_epi32(p->sixteen,
+                              _mm256_min_epu32(modifier, p->sixteen));
+  modifier = _mm256_madd_epi16(modifier, p->weight);
+
+  count_8 = _mm_loadu_si128((const __m128i *)count);
+  count_8 = _mm_add_epi16(count_8,
+                          _mm_packus_epi32(_mm256_castsi256_si128(modifier),
+                                           _mm256_extracti128_si256(modifier,
+                                                                    1)));
+  _mm_storeu_si128((__m128i *)count, count_8);
+  _mm256_storeu_si256(
+      (__m256i *)accumulator,
+      _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)accumulator),
+                       _mm256_madd_epi16(modifier, pixel)));
+}
+
+static INLINE void apply_8_lowbd(const uint8_t *frame1, const uint8_t *frame2,
+                                 const ModifierParams *p,
+                                 unsigned int *accumulator, uint16_t *count) {
+  const __m128i a = _mm_loadl_epi64((const __m128i *)frame1);
+  const __m128i b = _mm_loadl_epi64((const __m128i *)frame2);
+  const __m128i abs_diff = _mm_or_si128(_mm_subs_epu8(a, b),
+                                        _mm_subs_epu8(b, a));
+  apply_8(_mm256_cvtepu8_epi32(abs_diff), _mm256_cvtepu8_epi32(b), p,
+          accumulator, count);
+}
+
+void vp9_temporal_filter_apply_avx2(uint8_t *frame1,
+                                    unsigned int stride,
+                                    uint8_t *frame2,
+                                    unsigned int block_width,
+                                    unsigned int block_height,
+                                    int strength,
+                                    int filter_weight,
+                                    unsigned int *accumulator,
+                                    uint16_t *count) {
+  ModifierParams p;
+  unsigned int i, j;
+
+  assert(block_width % 8 == 0);
+  init_params(&p, strength, filter_weight);
+
+  for (i = 0; i < block_height; ++i) {
+    for (j = 0; j < block_width; j += 8) {
+      apply_8_lowbd(frame1 + j, frame2, &p, accumulator, count);
+      frame2 += 8;
+      accumulator += 8;
+      count += 8;
+    }
+    frame1 += stride;
+  }
+}
+
+#if CONFIG_VP9_HIGHBITDEPTH
+void vp9_highbd_temporal_filter_apply_avx2(uint8_t *frame1_8,
+                                           unsigned int stride,
+                                           uint8_t *frame2_8,
+                                           unsigned int block_width,
+                                           unsigned int block_height,
+                                           int strength,
+                                           int filter_weight,
+                                           unsigned int *accumulator,
+                                           uint16_t *count) {
+  const uint16_t *frame1 = CONVERT_TO_SHORTPTR(frame1_8);
+  const uint16_t *frame2 = CONVERT_TO_SHORTPTR(frame2_8);
+  ModifierParams p;
+  unsigned int i, j;
+
+  assert(block_width % 8 == 0);
+  init_params(&p, strength, filter_weight);
+
+  for (i = 0; i < block_height; ++i) {
+    for (j = 0; j < block_width; j += 8) {
+      const __m128i a = _mm_loadu_si128((const __m128i *)(frame1 + j));
+      const __m128i b = _mm_loadu_si128((const __m128i *)frame2);
+      const __m128i abs_diff = _mm_or_si128(_mm_subs_epu16(a, b),
+                                            _mm_subs_epu16(b, a));
+      apply_8(_mm256_cvtepu16_epi32(abs_diff), _mm256_cvtepu16_epi32(b), &p,
+              accumulator, count);
+      frame2 += 8;
+      accumulator += 8;
+      count += 8;
+    }
+    frame1 += stride;
+  }
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
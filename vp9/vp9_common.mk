@@ -68,6 +68,8 @@ VP9_COMMON_SRCS-$(CONFIG_VP9_POSTPROC) += common/vp9_mfqe.c
 ifeq ($(CONFIG_VP9_POSTPROC),yes)
 VP9_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp9_mfqe_sse2.asm
 VP9_COMMON_SRCS-$(HAVE_SSE2) += common/x86/vp9_postproc_sse2.asm
+VP9_COMMON_SRCS-$(HAVE_AVX2) += common/x86/vp9_mfqe_avx2.c
+VP9_COMMON_SRCS-$(HAVE_AVX2) += common/x86/vp9_postproc_avx2.c
 endif
 
 ifneq ($(CONFIG_VP9_HIGHBITDEPTH),yes)
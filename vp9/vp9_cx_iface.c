@@ -14,6 +14,10 @@
 #include "./vpx_config.h"
 #include "vpx/vpx_encoder.h"
 #include "vpx_ports/vpx_once.h"
+#if ARCH_X86 || ARCH_X86_64
+#include "vpx_ports/x86.h"
+#endif
+#include "vpx_util/vpx_thread.h"
 #include "vpx/internal/vpx_codec_internal.h"
 #include "./vpx_version.h"
 #include "vp9/encoder/vp9_encoder.h"
@@ -79,6 +83,15 @@ static struct vp9_extracfg default_extra_cfg = {
   0,                          // render height
 };
 
+// A frame queued for asynchronous encoding.
+struct async_frame {
+  vpx_image_t             img;
+  vpx_codec_pts_t         pts;
+  unsigned long           duration;
+  vpx_enc_frame_flags_t   flags;
+  unsigned long           deadline;
+};
+
 struct vpx_codec_alg_priv {
   vpx_codec_priv_t        base;
   vpx_codec_enc_cfg_t     cfg;
@@ -98,6 +111,30 @@ struct vpx_codec_alg_priv {
   vpx_codec_pkt_list_decl(256) pkt_list;
   unsigned int                 fixed_kf_cntr;
   vpx_codec_priv_output_cx_pkt_cb_pair_t output_cx_pkt_cb;
+  vpx_input_frame_ref_t   input_frame_ref;
+  vpx_output_buffer_cb_t  output_buffer_cb;
+  // Application buffer the next packet is written to, in output buffer
+  // callback mode.
+  unsigned char          *out_buf;
+  size_t                  out_buf_sz;
+  // Asynchronous encoding: frames are encoded by async_worker and their
+  // packets are delivered through async_cb. Meanwhile async_stage_worker
+  // stages the frame queued next (async_frame) into the lookahead.
+  vpx_codec_priv_output_cx_pkt_cb_pair_t async_cb;
+  VPxWorker               async_worker;
+  VPxWorker               async_stage_worker;
+  struct async_frame      async_frame;
+  int                     async_queued;
+  int                     async_staging;
+  int                     async_pending;
+  // First error of the queued frames, returned by the next
+  // vpx_codec_encode() call. The details are kept apart from
+  // base.err_detail, which the application may read meanwhile.
+  vpx_codec_err_t         async_res;
+  const char             *async_err_detail;
+  // Copy of the queued image when the application's frames are not
+  // referenced.
+  vpx_image_t            *async_copy;
   // BufferPool that holds all reference frames.
   BufferPool              *buffer_pool;
 };
@@ -556,11 +593,63 @@ static vpx_codec_err_t set_encoder_config(
   return VPX_CODEC_OK;
 }
 
+// Keeps the first error of the frames queued for asynchronous encoding.
+static void set_async_error(vpx_codec_alg_priv_t *ctx, vpx_codec_err_t res,
+                            const char *detail) {
+  if (res != VPX_CODEC_OK && ctx->async_res == VPX_CODEC_OK) {
+    ctx->async_res = res;
+    ctx->async_err_detail = detail;
+  }
+}
+
+// Returns the error kept by set_async_error(), publishing its details. Only
+// called while async_worker is idle.
+static vpx_codec_err_t take_async_error(vpx_codec_alg_priv_t *ctx) {
+  const vpx_codec_err_t res = ctx->async_res;
+  if (res != VPX_CODEC_OK)
+    ctx->base.err_detail = ctx->async_err_detail;
+  ctx->async_res = VPX_CODEC_OK;
+  ctx->async_err_detail = NULL;
+  return res;
+}
+
+static void sync_async_workers(vpx_codec_alg_priv_t *ctx) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  if (ctx->async_queued) {
+    winterface->sync(&ctx->async_worker);
+    ctx->async_queued = 0;
+  }
+  if (ctx->async_staging) {
+    winterface->sync(&ctx->async_stage_worker);
+    ctx->async_staging = 0;
+  }
+}
+
+static void encode_async_frame(vpx_codec_alg_priv_t *ctx,
+                               const vpx_image_t *img,
+                               vpx_codec_pts_t pts,
+                               unsigned long duration,
+                               vpx_enc_frame_flags_t flags,
+                               unsigned long deadline);
+
+// Waits until the frames queued for asynchronous encoding, if any, are
+// done. Their result is returned by the next vpx_codec_encode() call.
+static void wait_for_async_encode(vpx_codec_alg_priv_t *ctx) {
+  sync_async_workers(ctx);
+  if (ctx->async_pending) {
+    const struct async_frame *const frame = &ctx->async_frame;
+    ctx->async_pending = 0;
+    encode_async_frame(ctx, &frame->img, frame->pts, frame->duration,
+                       frame->flags, frame->deadline);
+  }
+}
+
 static vpx_codec_err_t encoder_set_config(vpx_codec_alg_priv_t *ctx,
                                           const vpx_codec_enc_cfg_t  *cfg) {
   vpx_codec_err_t res;
   int force_key = 0;
 
+  wait_for_async_encode(ctx);
   if (cfg->g_w != ctx->cfg.g_w || cfg->g_h != ctx->cfg.g_h) {
     if (cfg->g_lag_in_frames > 1 || cfg->g_pass != VPX_RC_ONE_PASS)
       ERROR("Cannot change width or height after initialization");
@@ -598,6 +687,7 @@ static vpx_codec_err_t ctrl_get_quantizer(vpx_codec_alg_priv_t *ctx,
   int *const arg = va_arg(args, int *);
   if (arg == NULL)
     return VPX_CODEC_INVALID_PARAM;
+  wait_for_async_encode(ctx);
   *arg = vp9_get_quantizer(ctx->cpi);
   return VPX_CODEC_OK;
 }
@@ -607,14 +697,32 @@ static vpx_codec_err_t ctrl_get_quantizer64(vpx_codec_alg_priv_t *ctx,
   int *const arg = va_arg(args, int *);
   if (arg == NULL)
     return VPX_CODEC_INVALID_PARAM;
+  wait_for_async_encode(ctx);
   *arg = vp9_qindex_to_quantizer(vp9_get_quantizer(ctx->cpi));
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_get_perf_stats(vpx_codec_alg_priv_t *ctx,
+                                           va_list args) {
+#if CONFIG_PERF_STATS
+  vpx_enc_perf_stats_t *const arg = va_arg(args, vpx_enc_perf_stats_t *);
+  if (arg == NULL)
+    return VPX_CODEC_INVALID_PARAM;
+  wait_for_async_encode(ctx);
+  *arg = ctx->cpi->perf_stats;
+  return VPX_CODEC_OK;
+#else
+  (void)ctx;
+  (void)args;
+  return VPX_CODEC_INCAPABLE;
+#endif
+}
+
 static vpx_codec_err_t update_extra_cfg(vpx_codec_alg_priv_t *ctx,
                                         const struct vp9_extracfg *extra_cfg) {
   const vpx_codec_err_t res = validate_config(ctx, &ctx->cfg, extra_cfg);
   if (res == VPX_CODEC_OK) {
+    wait_for_async_encode(ctx);
     ctx->extra_cfg = *extra_cfg;
     set_encoder_config(&ctx->oxcf, &ctx->cfg, &ctx->extra_cfg);
     vp9_change_config(ctx->cpi, &ctx->oxcf);
@@ -825,7 +933,25 @@ static vpx_codec_err_t encoder_init(vpx_codec_ctx_t *ctx,
   return res;
 }
 
+// Hands the held application buffer back. No packet has been returned in it,
+// though it may hold invisible frames that are now dropped.
+static void release_output_buffer(vpx_codec_alg_priv_t *ctx) {
+  if (ctx->out_buf != NULL) {
+    ctx->output_buffer_cb.release_buffer(ctx->output_buffer_cb.cb_priv,
+                                         ctx->out_buf);
+    ctx->out_buf = NULL;
+    ctx->out_buf_sz = 0;
+  }
+}
+
 static vpx_codec_err_t encoder_destroy(vpx_codec_alg_priv_t *ctx) {
+  wait_for_async_encode(ctx);
+  if (ctx->async_cb.output_cx_pkt != NULL) {
+    vpx_get_worker_interface()->end(&ctx->async_worker);
+    vpx_get_worker_interface()->end(&ctx->async_stage_worker);
+  }
+  release_output_buffer(ctx);
+  vpx_img_free(ctx->async_copy);
   free(ctx->cx_data);
   vp9_remove_compressor(ctx->cpi);
 #if CONFIG_MULTITHREAD
@@ -894,7 +1020,9 @@ static int write_superframe_index(vpx_codec_alg_priv_t *ctx) {
 
   // Write the index
   index_sz = 2 + (mag + 1) * ctx->pending_frame_count;
-  if (ctx->pending_cx_data_sz + index_sz < ctx->cx_data_sz) {
+  if (ctx->pending_cx_data_sz + index_sz < (ctx->output_buffer_cb.get_buffer
+                                                 ? ctx->out_buf_sz
+                                                 : ctx->cx_data_sz)) {
     uint8_t *x = ctx->pending_cx_data + ctx->pending_cx_data_sz;
     int i, j;
 #ifdef TEST_SUPPLEMENTAL_SUPERFRAME_DATA
@@ -962,17 +1090,79 @@ static vpx_codec_frame_flags_t get_frame_pkt_flags(const VP9_COMP *cpi,
   return flags;
 }
 
-static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
-                                      const vpx_image_t *img,
-                                      vpx_codec_pts_t pts,
-                                      unsigned long duration,
-                                      vpx_enc_frame_flags_t flags,
-                                      unsigned long deadline) {
+// Compressing may run on async_worker while the application reads
+// base.err_detail, so the details of queued frames are published later by
+// take_async_error().
+static void set_compress_error(vpx_codec_alg_priv_t *ctx, const char *detail) {
+  if (ctx->async_cb.output_cx_pkt == NULL)
+    ctx->base.err_detail = detail;
+  else if (ctx->async_res == VPX_CODEC_OK)
+    ctx->async_err_detail = detail;
+}
+
+// Makes sure there is an application buffer large enough for the next packet
+// in output buffer callback mode. A buffer holding pending invisible frames is
+// always kept, as the rest of the superframe has to follow them.
+static int get_output_buffer(vpx_codec_alg_priv_t *ctx) {
+  if (ctx->out_buf != NULL &&
+      (ctx->pending_cx_data != NULL || ctx->out_buf_sz >= ctx->cx_data_sz))
+    return 1;
+  // A held buffer that has become too small is not used.
+  release_output_buffer(ctx);
+  ctx->out_buf = (unsigned char *)ctx->output_buffer_cb.get_buffer(
+      ctx->output_buffer_cb.cb_priv, ctx->cx_data_sz);
+  ctx->out_buf_sz = ctx->out_buf != NULL ? ctx->cx_data_sz : 0;
+  if (ctx->out_buf == NULL) {
+    set_compress_error(ctx, "Output buffer callback failed");
+    return 0;
+  }
+  return 1;
+}
+
+// Each packet gets a buffer of its own, so the frame after a completed
+// packet starts in a new one. The buffer just returned in a packet is the
+// application's again.
+static int next_output_buffer(vpx_codec_alg_priv_t *ctx,
+                              unsigned char **cx_data, size_t *cx_data_sz) {
+  ctx->out_buf = NULL;
+  ctx->out_buf_sz = 0;
+  if (!get_output_buffer(ctx))
+    return 0;
+  *cx_data = ctx->out_buf;
+  *cx_data_sz = ctx->out_buf_sz;
+  return 1;
+}
+
+// The application frame backing img in VP9E_SET_INPUT_FRAME_REF mode, or
+// NULL.
+static const struct lookahead_ext_frame *get_ext_frame(
+    const vpx_codec_alg_priv_t *ctx, const vpx_image_t *img,
+    struct lookahead_ext_frame *ext) {
+  if (ctx->input_frame_ref.release_cb == NULL)
+    return NULL;
+  ext->img = *img;
+  ext->release_cb = ctx->input_frame_ref.release_cb;
+  ext->cb_priv = ctx->input_frame_ref.cb_priv;
+  ext->border = ctx->input_frame_ref.border;
+  return ext;
+}
+
+// Hands img, if any, to the encoder. Sets *encode unless the frame was
+// rejected before reaching it, in which case the encoder is not run.
+static vpx_codec_err_t receive_frame(vpx_codec_alg_priv_t  *ctx,
+                                     const vpx_image_t *img,
+                                     vpx_codec_pts_t pts,
+                                     unsigned long duration,
+                                     vpx_enc_frame_flags_t flags,
+                                     unsigned long deadline,
+                                     int *encode) {
   vpx_codec_err_t res = VPX_CODEC_OK;
   VP9_COMP *const cpi = ctx->cpi;
   const vpx_rational_t *const timebase = &ctx->cfg.g_timebase;
   size_t data_sz;
 
+  *encode = 0;
+
   if (img != NULL) {
     res = validate_img(ctx, img);
     // TODO(jzern) the checks related to cpi's validity should be treated as a
@@ -984,7 +1174,10 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
                 (cpi->multi_arf_allowed ? 8 : 2);
       if (data_sz < 4096)
         data_sz = 4096;
-      if (ctx->cx_data == NULL || ctx->cx_data_sz < data_sz) {
+      if (ctx->output_buffer_cb.get_buffer != NULL) {
+        // Frames go straight into the application's buffers.
+        ctx->cx_data_sz = data_sz;
+      } else if (ctx->cx_data == NULL || ctx->cx_data_sz < data_sz) {
         ctx->cx_data_sz = data_sz;
         free(ctx->cx_data);
         ctx->cx_data = (unsigned char*)malloc(ctx->cx_data_sz);
@@ -1018,167 +1211,379 @@ static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
 
   // Initialize the encoder instance on the first frame.
   if (res == VPX_CODEC_OK && cpi != NULL) {
-    unsigned int lib_flags = 0;
     YV12_BUFFER_CONFIG sd;
-    int64_t dst_time_stamp = timebase_units_to_ticks(timebase, pts);
-    int64_t dst_end_time_stamp =
+    const int64_t dst_time_stamp = timebase_units_to_ticks(timebase, pts);
+    const int64_t dst_end_time_stamp =
         timebase_units_to_ticks(timebase, pts + duration);
-    size_t size, cx_data_sz;
-    unsigned char *cx_data;
 
     // Set up internal flags
     if (ctx->base.init_flags & VPX_CODEC_USE_PSNR)
       cpi->b_calculate_psnr = 1;
 
     if (img != NULL) {
+      struct lookahead_ext_frame ext;
       res = image2yuvconfig(img, &sd);
 
       // Store the original flags in to the frame buffer. Will extract the
       // key frame flag when we actually encode this frame.
       if (vp9_receive_raw_frame(cpi, flags | ctx->next_frame_flags,
-                                &sd, dst_time_stamp, dst_end_time_stamp)) {
+                                &sd, dst_time_stamp, dst_end_time_stamp,
+                                get_ext_frame(ctx, img, &ext))) {
         res = update_error_state(ctx, &cpi->common.error);
       }
       ctx->next_frame_flags = 0;
     }
+    *encode = 1;
+  }
 
-    cx_data = ctx->cx_data;
-    cx_data_sz = ctx->cx_data_sz;
+  return res;
+}
 
+// Runs the encoder on the frames received so far, flushing the lookahead if
+// flush is set.
+static vpx_codec_err_t compress_frames(vpx_codec_alg_priv_t *ctx,
+                                       int flush) {
+  VP9_COMP *const cpi = ctx->cpi;
+  const vpx_rational_t *const timebase = &ctx->cfg.g_timebase;
+  unsigned int lib_flags = 0;
+  int64_t dst_time_stamp, dst_end_time_stamp;
+  size_t size;
+  size_t cx_data_sz = ctx->cx_data_sz;
+  unsigned char *cx_data = ctx->cx_data;
+
+  if (ctx->output_buffer_cb.get_buffer != NULL && ctx->cx_data_sz != 0) {
+    // Pending invisible frames are already at the start of the buffer.
+    if (!get_output_buffer(ctx))
+      return VPX_CODEC_MEM_ERROR;
+    cx_data = ctx->out_buf + ctx->pending_cx_data_sz;
+    cx_data_sz = ctx->out_buf_sz - ctx->pending_cx_data_sz;
+  } else if (ctx->pending_cx_data) {
     /* Any pending invisible frames? */
-    if (ctx->pending_cx_data) {
-      memmove(cx_data, ctx->pending_cx_data, ctx->pending_cx_data_sz);
-      ctx->pending_cx_data = cx_data;
-      cx_data += ctx->pending_cx_data_sz;
-      cx_data_sz -= ctx->pending_cx_data_sz;
-
-      /* TODO: this is a minimal check, the underlying codec doesn't respect
-       * the buffer size anyway.
-       */
-      if (cx_data_sz < ctx->cx_data_sz / 2) {
-        ctx->base.err_detail = "Compressed data buffer too small";
-        return VPX_CODEC_ERROR;
-      }
+    memmove(cx_data, ctx->pending_cx_data, ctx->pending_cx_data_sz);
+    ctx->pending_cx_data = cx_data;
+    cx_data += ctx->pending_cx_data_sz;
+    cx_data_sz -= ctx->pending_cx_data_sz;
+
+    /* TODO: this is a minimal check, the underlying codec doesn't respect
+     * the buffer size anyway.
+     */
+    if (cx_data_sz < ctx->cx_data_sz / 2) {
+      set_compress_error(ctx, "Compressed data buffer too small");
+      return VPX_CODEC_ERROR;
     }
+  }
 
-    while (cx_data_sz >= ctx->cx_data_sz / 2 &&
-           -1 != vp9_get_compressed_data(cpi, &lib_flags, &size,
-                                         cx_data, &dst_time_stamp,
-                                         &dst_end_time_stamp, !img)) {
-      if (size) {
-        vpx_codec_cx_pkt_t pkt;
+  while (cx_data_sz >= ctx->cx_data_sz / 2 &&
+         -1 != vp9_get_compressed_data(cpi, &lib_flags, &size,
+                                       cx_data, &dst_time_stamp,
+                                       &dst_end_time_stamp, flush)) {
+    if (size) {
+      vpx_codec_cx_pkt_t pkt;
 
 #if CONFIG_SPATIAL_SVC
-        if (cpi->use_svc)
-          cpi->svc.layer_context[cpi->svc.spatial_layer_id *
-              cpi->svc.number_temporal_layers].layer_size += size;
+      if (cpi->use_svc)
+        cpi->svc.layer_context[cpi->svc.spatial_layer_id *
+            cpi->svc.number_temporal_layers].layer_size += size;
 #endif
 
-        // Pack invisible frames with the next visible frame
-        if (!cpi->common.show_frame ||
-            (cpi->use_svc &&
-             cpi->svc.spatial_layer_id < cpi->svc.number_spatial_layers - 1)
-            ) {
-          if (ctx->pending_cx_data == 0)
-            ctx->pending_cx_data = cx_data;
-          ctx->pending_cx_data_sz += size;
-          ctx->pending_frame_sizes[ctx->pending_frame_count++] = size;
-          ctx->pending_frame_magnitude |= size;
-          cx_data += size;
-          cx_data_sz -= size;
-
-          if (ctx->output_cx_pkt_cb.output_cx_pkt) {
-            pkt.kind = VPX_CODEC_CX_FRAME_PKT;
-            pkt.data.frame.pts = ticks_to_timebase_units(timebase,
-                                                         dst_time_stamp);
-            pkt.data.frame.duration =
-               (unsigned long)ticks_to_timebase_units(timebase,
-                   dst_end_time_stamp - dst_time_stamp);
-            pkt.data.frame.flags = get_frame_pkt_flags(cpi, lib_flags);
-            pkt.data.frame.buf = ctx->pending_cx_data;
-            pkt.data.frame.sz  = size;
-            ctx->pending_cx_data = NULL;
-            ctx->pending_cx_data_sz = 0;
-            ctx->pending_frame_count = 0;
-            ctx->pending_frame_magnitude = 0;
-            ctx->output_cx_pkt_cb.output_cx_pkt(
-                &pkt, ctx->output_cx_pkt_cb.user_priv);
-          }
-          continue;
-        }
+      // Pack invisible frames with the next visible frame
+      if (!cpi->common.show_frame ||
+          (cpi->use_svc &&
+           cpi->svc.spatial_layer_id < cpi->svc.number_spatial_layers - 1)
+          ) {
+        if (ctx->pending_cx_data == 0)
+          ctx->pending_cx_data = cx_data;
+        ctx->pending_cx_data_sz += size;
+        ctx->pending_frame_sizes[ctx->pending_frame_count++] = size;
+        ctx->pending_frame_magnitude |= size;
+        cx_data += size;
+        cx_data_sz -= size;
 
-        // Add the frame packet to the list of returned packets.
-        pkt.kind = VPX_CODEC_CX_FRAME_PKT;
-        pkt.data.frame.pts = ticks_to_timebase_units(timebase, dst_time_stamp);
-        pkt.data.frame.duration =
-           (unsigned long)ticks_to_timebase_units(timebase,
-               dst_end_time_stamp - dst_time_stamp);
-        pkt.data.frame.flags = get_frame_pkt_flags(cpi, lib_flags);
-
-        if (ctx->pending_cx_data) {
-          ctx->pending_frame_sizes[ctx->pending_frame_count++] = size;
-          ctx->pending_frame_magnitude |= size;
-          ctx->pending_cx_data_sz += size;
-          // write the superframe only for the case when
-          if (!ctx->output_cx_pkt_cb.output_cx_pkt)
-            size += write_superframe_index(ctx);
+        if (ctx->output_cx_pkt_cb.output_cx_pkt) {
+          pkt.kind = VPX_CODEC_CX_FRAME_PKT;
+          pkt.data.frame.pts = ticks_to_timebase_units(timebase,
+                                                       dst_time_stamp);
+          pkt.data.frame.duration =
+             (unsigned long)ticks_to_timebase_units(timebase,
+                 dst_end_time_stamp - dst_time_stamp);
+          pkt.data.frame.flags = get_frame_pkt_flags(cpi, lib_flags);
           pkt.data.frame.buf = ctx->pending_cx_data;
-          pkt.data.frame.sz  = ctx->pending_cx_data_sz;
+          pkt.data.frame.sz  = size;
           ctx->pending_cx_data = NULL;
           ctx->pending_cx_data_sz = 0;
           ctx->pending_frame_count = 0;
           ctx->pending_frame_magnitude = 0;
-        } else {
-          pkt.data.frame.buf = cx_data;
-          pkt.data.frame.sz  = size;
+          ctx->output_cx_pkt_cb.output_cx_pkt(
+              &pkt, ctx->output_cx_pkt_cb.user_priv);
+          if (ctx->output_buffer_cb.get_buffer != NULL) {
+            if (!next_output_buffer(ctx, &cx_data, &cx_data_sz))
+              return VPX_CODEC_MEM_ERROR;
+          }
         }
-        pkt.data.frame.partition_id = -1;
+        continue;
+      }
+
+      // Add the frame packet to the list of returned packets.
+      pkt.kind = VPX_CODEC_CX_FRAME_PKT;
+      pkt.data.frame.pts = ticks_to_timebase_units(timebase, dst_time_stamp);
+      pkt.data.frame.duration =
+         (unsigned long)ticks_to_timebase_units(timebase,
+             dst_end_time_stamp - dst_time_stamp);
+      pkt.data.frame.flags = get_frame_pkt_flags(cpi, lib_flags);
+
+      if (ctx->pending_cx_data) {
+        ctx->pending_frame_sizes[ctx->pending_frame_count++] = size;
+        ctx->pending_frame_magnitude |= size;
+        ctx->pending_cx_data_sz += size;
+        // write the superframe only for the case when
+        if (!ctx->output_cx_pkt_cb.output_cx_pkt)
+          size += write_superframe_index(ctx);
+        pkt.data.frame.buf = ctx->pending_cx_data;
+        pkt.data.frame.sz  = ctx->pending_cx_data_sz;
+        ctx->pending_cx_data = NULL;
+        ctx->pending_cx_data_sz = 0;
+        ctx->pending_frame_count = 0;
+        ctx->pending_frame_magnitude = 0;
+      } else {
+        pkt.data.frame.buf = cx_data;
+        pkt.data.frame.sz  = size;
+      }
+      pkt.data.frame.partition_id = -1;
 
-        if(ctx->output_cx_pkt_cb.output_cx_pkt)
-          ctx->output_cx_pkt_cb.output_cx_pkt(&pkt,
-                                              ctx->output_cx_pkt_cb.user_priv);
-        else
-          vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt);
+      if(ctx->output_cx_pkt_cb.output_cx_pkt)
+        ctx->output_cx_pkt_cb.output_cx_pkt(&pkt,
+                                            ctx->output_cx_pkt_cb.user_priv);
+      else
+        vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt);
 
-        cx_data += size;
-        cx_data_sz -= size;
+      cx_data += size;
+      cx_data_sz -= size;
+      if (ctx->output_buffer_cb.get_buffer != NULL) {
+        if (!next_output_buffer(ctx, &cx_data, &cx_data_sz))
+          return VPX_CODEC_MEM_ERROR;
+      }
 #if VPX_ENCODER_ABI_VERSION > (5 + VPX_CODEC_ABI_VERSION)
 #if CONFIG_SPATIAL_SVC
-        if (cpi->use_svc && !ctx->output_cx_pkt_cb.output_cx_pkt) {
-          vpx_codec_cx_pkt_t pkt_sizes, pkt_psnr;
-          int sl;
-          vp9_zero(pkt_sizes);
-          vp9_zero(pkt_psnr);
-          pkt_sizes.kind = VPX_CODEC_SPATIAL_SVC_LAYER_SIZES;
-          pkt_psnr.kind = VPX_CODEC_SPATIAL_SVC_LAYER_PSNR;
-          for (sl = 0; sl < cpi->svc.number_spatial_layers; ++sl) {
-            LAYER_CONTEXT *lc =
-                &cpi->svc.layer_context[sl * cpi->svc.number_temporal_layers];
-            pkt_sizes.data.layer_sizes[sl] = lc->layer_size;
-            pkt_psnr.data.layer_psnr[sl] = lc->psnr_pkt;
-            lc->layer_size = 0;
-          }
+      if (cpi->use_svc && !ctx->output_cx_pkt_cb.output_cx_pkt) {
+        vpx_codec_cx_pkt_t pkt_sizes, pkt_psnr;
+        int sl;
+        vp9_zero(pkt_sizes);
+        vp9_zero(pkt_psnr);
+        pkt_sizes.kind = VPX_CODEC_SPATIAL_SVC_LAYER_SIZES;
+        pkt_psnr.kind = VPX_CODEC_SPATIAL_SVC_LAYER_PSNR;
+        for (sl = 0; sl < cpi->svc.number_spatial_layers; ++sl) {
+          LAYER_CONTEXT *lc =
+              &cpi->svc.layer_context[sl * cpi->svc.number_temporal_layers];
+          pkt_sizes.data.layer_sizes[sl] = lc->layer_size;
+          pkt_psnr.data.layer_psnr[sl] = lc->psnr_pkt;
+          lc->layer_size = 0;
+        }
 
-          vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt_sizes);
+        vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt_sizes);
 
-          vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt_psnr);
-        }
+        vpx_codec_pkt_list_add(&ctx->pkt_list.head, &pkt_psnr);
+      }
 #endif
 #endif
-        if (is_one_pass_cbr_svc(cpi) &&
-            (cpi->svc.spatial_layer_id == cpi->svc.number_spatial_layers - 1)) {
-          // Encoded all spatial layers; exit loop.
-          break;
-        }
+      if (is_one_pass_cbr_svc(cpi) &&
+          (cpi->svc.spatial_layer_id == cpi->svc.number_spatial_layers - 1)) {
+        // Encoded all spatial layers; exit loop.
+        break;
       }
     }
   }
 
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t encode_frame(vpx_codec_alg_priv_t  *ctx,
+                                    const vpx_image_t *img,
+                                    vpx_codec_pts_t pts,
+                                    unsigned long duration,
+                                    vpx_enc_frame_flags_t flags,
+                                    unsigned long deadline) {
+  int encode;
+  const vpx_codec_err_t res = receive_frame(ctx, img, pts, duration, flags,
+                                            deadline, &encode);
+  if (encode) {
+    const vpx_codec_err_t compress_res = compress_frames(ctx, img == NULL);
+    if (compress_res != VPX_CODEC_OK)
+      return compress_res;
+  }
+  return res;
+}
+
+// Runs the encoder and hands the packets to the asynchronous encoding
+// callback.
+static vpx_codec_err_t compress_to_callback(vpx_codec_alg_priv_t *ctx,
+                                            int flush) {
+  const vpx_codec_err_t res = compress_frames(ctx, flush);
+  vpx_codec_iter_t iter = NULL;
+  const vpx_codec_cx_pkt_t *pkt;
+
+  while ((pkt = vpx_codec_pkt_list_get(&ctx->pkt_list.head, &iter)) != NULL) {
+    // The callback takes a mutable packet; hand it a copy of the list entry.
+    vpx_codec_cx_pkt_t out = *pkt;
+    ctx->async_cb.output_cx_pkt(&out, ctx->async_cb.user_priv);
+  }
+  return res;
+}
+
+// Encodes a queued frame, or flushes if img is NULL, on the calling thread.
+static void encode_async_frame(vpx_codec_alg_priv_t *ctx,
+                               const vpx_image_t *img,
+                               vpx_codec_pts_t pts,
+                               unsigned long duration,
+                               vpx_enc_frame_flags_t flags,
+                               unsigned long deadline) {
+  int encode;
+  const vpx_codec_err_t res = receive_frame(ctx, img, pts, duration, flags,
+                                            deadline, &encode);
+  set_async_error(ctx, res, ctx->base.err_detail);
+  if (encode)
+    set_async_error(ctx, compress_to_callback(ctx, img == NULL),
+                    ctx->async_err_detail);
+  else
+    vp9_drop_staged_frame(ctx->cpi);
+}
+
+static int async_encode_hook(void *arg1, void *arg2) {
+  vpx_codec_alg_priv_t *const ctx = (vpx_codec_alg_priv_t *)arg1;
+#if ARCH_X86 || ARCH_X86_64
+  // Same floating point environment as vpx_codec_encode() sets up for
+  // synchronous encoding.
+  const unsigned short x87_orig_mode = x87_set_double_precision();
+#endif
+  (void)arg2;
+
+  set_async_error(ctx, compress_to_callback(ctx, 0), ctx->async_err_detail);
+#if ARCH_X86 || ARCH_X86_64
+  x87_set_control_word(x87_orig_mode);
+#endif
+  return 1;
+}
+
+// Copies the queued frame into the lookahead while the previous one is
+// being encoded, leaving vp9_receive_raw_frame() only a buffer swap.
+static int async_stage_hook(void *arg1, void *arg2) {
+  vpx_codec_alg_priv_t *const ctx = (vpx_codec_alg_priv_t *)arg1;
+  const vpx_image_t *const img = &ctx->async_frame.img;
+  struct lookahead_ext_frame ext;
+  YV12_BUFFER_CONFIG sd;
+  (void)arg2;
+
+  // Until the first frame has allocated the lookahead this does nothing.
+  if (image2yuvconfig(img, &sd) == VPX_CODEC_OK)
+    vp9_stage_raw_frame(ctx->cpi, &sd, get_ext_frame(ctx, img, &ext));
+  return 1;
+}
+
+// Keeps the image of the frame being queued. The application's planes are
+// referenced when it keeps them valid for the encoder anyway
+// (VP9E_SET_INPUT_FRAME_REF), and copied otherwise.
+static vpx_codec_err_t queue_async_image(vpx_codec_alg_priv_t *ctx,
+                                         const vpx_image_t *img) {
+  vpx_image_t *dst = ctx->async_copy;
+  int plane, y;
+
+  if (ctx->input_frame_ref.release_cb != NULL) {
+    ctx->async_frame.img = *img;
+    return VPX_CODEC_OK;
+  }
+
+  if (dst == NULL || dst->fmt != img->fmt || dst->d_w != img->d_w ||
+      dst->d_h != img->d_h) {
+    vpx_img_free(dst);
+    dst = ctx->async_copy = vpx_img_alloc(NULL, img->fmt, img->d_w, img->d_h,
+                                          16);
+    if (dst == NULL)
+      return VPX_CODEC_MEM_ERROR;
+  }
+
+  for (plane = 0; plane < 3; ++plane) {
+    const int bytes = (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+    const int w = plane ? (int)((img->d_w + img->x_chroma_shift) >>
+                                img->x_chroma_shift) : (int)img->d_w;
+    const int h = plane ? (int)((img->d_h + img->y_chroma_shift) >>
+                                img->y_chroma_shift) : (int)img->d_h;
+    for (y = 0; y < h; ++y)
+      memcpy(dst->planes[plane] + y * dst->stride[plane],
+             img->planes[plane] + y * img->stride[plane], w * bytes);
+  }
+  dst->cs = img->cs;
+  dst->range = img->range;
+  dst->bit_depth = img->bit_depth;
+  dst->user_priv = img->user_priv;
+  ctx->async_frame.img = *dst;
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t encoder_encode(vpx_codec_alg_priv_t  *ctx,
+                                      const vpx_image_t *img,
+                                      vpx_codec_pts_t pts,
+                                      unsigned long duration,
+                                      vpx_enc_frame_flags_t flags,
+                                      unsigned long deadline) {
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+  vpx_codec_err_t res;
+
+  if (ctx->async_cb.output_cx_pkt == NULL)
+    return encode_frame(ctx, img, pts, duration, flags, deadline);
+
+  // Flushing encodes the remaining frames on the calling thread.
+  if (img == NULL) {
+    wait_for_async_encode(ctx);
+    encode_async_frame(ctx, NULL, pts, duration, flags, deadline);
+    return take_async_error(ctx);
+  }
+
+  res = validate_img(ctx, img);
+  if (res != VPX_CODEC_OK)
+    return res;
+
+  // The frame queued by the previous call has been staged meanwhile. It goes
+  // into the lookahead here, while both workers are idle, and is encoded
+  // while this one is staged.
+  sync_async_workers(ctx);
+  if (ctx->async_pending) {
+    const struct async_frame *const frame = &ctx->async_frame;
+    int encode;
+    res = receive_frame(ctx, &frame->img, frame->pts, frame->duration,
+                        frame->flags, frame->deadline, &encode);
+    set_async_error(ctx, res, ctx->base.err_detail);
+    ctx->async_pending = 0;
+    if (!encode)
+      vp9_drop_staged_frame(ctx->cpi);
+    // Failures of earlier frames are returned, but do not stop this one.
+    res = take_async_error(ctx);
+    if (encode) {
+      ctx->async_queued = 1;
+      winterface->launch(&ctx->async_worker);
+    }
+  } else {
+    res = take_async_error(ctx);
+  }
+
+  {
+    const vpx_codec_err_t queue_res = queue_async_image(ctx, img);
+    if (queue_res != VPX_CODEC_OK)
+      return res != VPX_CODEC_OK ? res : queue_res;
+  }
+  ctx->async_frame.pts = pts;
+  ctx->async_frame.duration = duration;
+  ctx->async_frame.flags = flags;
+  ctx->async_frame.deadline = deadline;
+  ctx->async_pending = 1;
+  ctx->async_staging = 1;
+  winterface->launch(&ctx->async_stage_worker);
   return res;
 }
 
 static const vpx_codec_cx_pkt_t *encoder_get_cxdata(vpx_codec_alg_priv_t *ctx,
                                                     vpx_codec_iter_t *iter) {
+  // Packets of asynchronously encoded frames only go to the callback.
+  if (ctx->async_cb.output_cx_pkt != NULL)
+    return NULL;
   return vpx_codec_pkt_list_get(&ctx->pkt_list.head, iter);
 }
 
@@ -1186,6 +1591,7 @@ static vpx_codec_err_t ctrl_set_reference(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   vpx_ref_frame_t *const frame = va_arg(args, vpx_ref_frame_t *);
 
+  wait_for_async_encode(ctx);
   if (frame != NULL) {
     YV12_BUFFER_CONFIG sd;
 
@@ -1202,6 +1608,7 @@ static vpx_codec_err_t ctrl_copy_reference(vpx_codec_alg_priv_t *ctx,
                                            va_list args) {
   vpx_ref_frame_t *const frame = va_arg(args, vpx_ref_frame_t *);
 
+  wait_for_async_encode(ctx);
   if (frame != NULL) {
     YV12_BUFFER_CONFIG sd;
 
@@ -1218,6 +1625,7 @@ static vpx_codec_err_t ctrl_get_reference(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   vp9_ref_frame_t *const frame = va_arg(args, vp9_ref_frame_t *);
 
+  wait_for_async_encode(ctx);
   if (frame != NULL) {
     YV12_BUFFER_CONFIG *fb = get_ref_frame(&ctx->cpi->common, frame->idx);
     if (fb == NULL) return VPX_CODEC_ERROR;
@@ -1252,6 +1660,7 @@ static vpx_image_t *encoder_get_preview(vpx_codec_alg_priv_t *ctx) {
   vp9_ppflags_t flags;
   vp9_zero(flags);
 
+  wait_for_async_encode(ctx);
   if (ctx->preview_ppcfg.post_proc_flag) {
     flags.post_proc_flag   = ctx->preview_ppcfg.post_proc_flag;
     flags.deblocking_level = ctx->preview_ppcfg.deblocking_level;
@@ -1270,6 +1679,7 @@ static vpx_codec_err_t ctrl_update_entropy(vpx_codec_alg_priv_t *ctx,
                                            va_list args) {
   const int update = va_arg(args, int);
 
+  wait_for_async_encode(ctx);
   vp9_update_entropy(ctx->cpi, update);
   return VPX_CODEC_OK;
 }
@@ -1278,6 +1688,7 @@ static vpx_codec_err_t ctrl_update_reference(vpx_codec_alg_priv_t *ctx,
                                              va_list args) {
   const int ref_frame_flags = va_arg(args, int);
 
+  wait_for_async_encode(ctx);
   vp9_update_reference(ctx->cpi, ref_frame_flags);
   return VPX_CODEC_OK;
 }
@@ -1286,6 +1697,7 @@ static vpx_codec_err_t ctrl_use_reference(vpx_codec_alg_priv_t *ctx,
                                           va_list args) {
   const int reference_flag = va_arg(args, int);
 
+  wait_for_async_encode(ctx);
   vp9_use_as_reference(ctx->cpi, reference_flag);
   return VPX_CODEC_OK;
 }
@@ -1304,6 +1716,7 @@ static vpx_codec_err_t ctrl_set_active_map(vpx_codec_alg_priv_t *ctx,
                                            va_list args) {
   vpx_active_map_t *const map = va_arg(args, vpx_active_map_t *);
 
+  wait_for_async_encode(ctx);
   if (map) {
     if (!vp9_set_active_map(ctx->cpi, map->active_map,
                             (int)map->rows, (int)map->cols))
@@ -1319,6 +1732,7 @@ static vpx_codec_err_t ctrl_get_active_map(vpx_codec_alg_priv_t *ctx,
                                            va_list args) {
   vpx_active_map_t *const map = va_arg(args, vpx_active_map_t *);
 
+  wait_for_async_encode(ctx);
   if (map) {
     if (!vp9_get_active_map(ctx->cpi, map->active_map,
                             (int)map->rows, (int)map->cols))
@@ -1334,6 +1748,7 @@ static vpx_codec_err_t ctrl_set_scale_mode(vpx_codec_alg_priv_t *ctx,
                                            va_list args) {
   vpx_scaling_mode_t *const mode = va_arg(args, vpx_scaling_mode_t *);
 
+  wait_for_async_encode(ctx);
   if (mode) {
     const int res = vp9_set_internal_size(ctx->cpi,
                                           (VPX_SCALING)mode->h_scaling_mode,
@@ -1354,6 +1769,7 @@ static vpx_codec_err_t ctrl_set_svc(vpx_codec_alg_priv_t *ctx, va_list args) {
   // In one-pass setting:
   //      either or both cfg->ss_number_layers > 1, or cfg->ts_number_layers > 1
 
+  wait_for_async_encode(ctx);
   vp9_set_svc(ctx->cpi, data);
 
   if (data == 1 &&
@@ -1372,6 +1788,7 @@ static vpx_codec_err_t ctrl_set_svc_layer_id(vpx_codec_alg_priv_t *ctx,
   VP9_COMP *const cpi = (VP9_COMP *)ctx->cpi;
   SVC *const svc = &cpi->svc;
 
+  wait_for_async_encode(ctx);
   svc->spatial_layer_id = data->spatial_layer_id;
   svc->temporal_layer_id = data->temporal_layer_id;
   // Checks on valid layer_id input.
@@ -1392,6 +1809,7 @@ static vpx_codec_err_t ctrl_get_svc_layer_id(vpx_codec_alg_priv_t *ctx,
   VP9_COMP *const cpi = (VP9_COMP *)ctx->cpi;
   SVC *const svc = &cpi->svc;
 
+  wait_for_async_encode(ctx);
   data->spatial_layer_id = svc->spatial_layer_id;
   data->temporal_layer_id = svc->temporal_layer_id;
 
@@ -1404,6 +1822,7 @@ static vpx_codec_err_t ctrl_set_svc_parameters(vpx_codec_alg_priv_t *ctx,
   vpx_svc_extra_cfg_t *const params = va_arg(args, vpx_svc_extra_cfg_t *);
   int sl, tl;
 
+  wait_for_async_encode(ctx);
   // Number of temporal layers and number of spatial layers have to be set
   // properly before calling this control function.
   for (sl = 0; sl < cpi->svc.number_spatial_layers; ++sl) {
@@ -1427,6 +1846,7 @@ static vpx_codec_err_t ctrl_set_svc_ref_frame_config(vpx_codec_alg_priv_t *ctx,
   VP9_COMP *const cpi = ctx->cpi;
   vpx_svc_ref_frame_config_t *data = va_arg(args, vpx_svc_ref_frame_config_t *);
   int sl;
+  wait_for_async_encode(ctx);
   for (sl = 0; sl < cpi->svc.number_spatial_layers; ++sl) {
     cpi->svc.ext_frame_flags[sl] = data->frame_flags[sl];
     cpi->svc.ext_lst_fb_idx[sl] = data->lst_fb_idx[sl];
@@ -1440,12 +1860,91 @@ static vpx_codec_err_t ctrl_register_cx_callback(vpx_codec_alg_priv_t *ctx,
                                                  va_list args) {
   vpx_codec_priv_output_cx_pkt_cb_pair_t *cbp =
       (vpx_codec_priv_output_cx_pkt_cb_pair_t *)va_arg(args, void *);
+  wait_for_async_encode(ctx);
   ctx->output_cx_pkt_cb.output_cx_pkt = cbp->output_cx_pkt;
   ctx->output_cx_pkt_cb.user_priv = cbp->user_priv;
 
   return VPX_CODEC_OK;
 }
 
+static vpx_codec_err_t ctrl_set_input_frame_ref(vpx_codec_alg_priv_t *ctx,
+                                                va_list args) {
+  vpx_input_frame_ref_t *const data = va_arg(args, vpx_input_frame_ref_t *);
+
+  wait_for_async_encode(ctx);
+  if (data == NULL) {
+    memset(&ctx->input_frame_ref, 0, sizeof(ctx->input_frame_ref));
+    return VPX_CODEC_OK;
+  }
+  if (data->release_cb == NULL)
+    return VPX_CODEC_INVALID_PARAM;
+
+  ctx->input_frame_ref = *data;
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_output_buffer_cb(vpx_codec_alg_priv_t *ctx,
+                                                 va_list args) {
+  vpx_output_buffer_cb_t *const data = va_arg(args, vpx_output_buffer_cb_t *);
+
+  wait_for_async_encode(ctx);
+  if (ctx->cx_data_sz != 0) {
+    ctx->base.err_detail =
+        "Output buffers must be set before the first frame is encoded";
+    return VPX_CODEC_ERROR;
+  }
+  if (data == NULL) {
+    memset(&ctx->output_buffer_cb, 0, sizeof(ctx->output_buffer_cb));
+    return VPX_CODEC_OK;
+  }
+  if (data->get_buffer == NULL || data->release_buffer == NULL)
+    return VPX_CODEC_INVALID_PARAM;
+
+  ctx->output_buffer_cb = *data;
+  return VPX_CODEC_OK;
+}
+
+static vpx_codec_err_t ctrl_set_async_encode(vpx_codec_alg_priv_t *ctx,
+                                             va_list args) {
+  vpx_codec_priv_output_cx_pkt_cb_pair_t *const data =
+      va_arg(args, vpx_codec_priv_output_cx_pkt_cb_pair_t *);
+  const VPxWorkerInterface *const winterface = vpx_get_worker_interface();
+
+  if (data != NULL && data->output_cx_pkt == NULL)
+    return VPX_CODEC_INVALID_PARAM;
+
+  wait_for_async_encode(ctx);
+  if (data == NULL) {
+    if (ctx->async_cb.output_cx_pkt != NULL) {
+      winterface->end(&ctx->async_worker);
+      winterface->end(&ctx->async_stage_worker);
+    }
+    memset(&ctx->async_cb, 0, sizeof(ctx->async_cb));
+    // A failure of the last queued frames is not lost.
+    return take_async_error(ctx);
+  }
+
+  if (ctx->async_cb.output_cx_pkt == NULL) {
+    winterface->init(&ctx->async_worker);
+    winterface->init(&ctx->async_stage_worker);
+    if (!winterface->reset(&ctx->async_worker) ||
+        !winterface->reset(&ctx->async_stage_worker)) {
+      winterface->end(&ctx->async_worker);
+      winterface->end(&ctx->async_stage_worker);
+      ctx->base.err_detail = "Asynchronous encoding thread creation failed";
+      return VPX_CODEC_MEM_ERROR;
+    }
+    ctx->async_worker.hook = async_encode_hook;
+    ctx->async_worker.data1 = ctx;
+    ctx->async_worker.data2 = NULL;
+    ctx->async_stage_worker.hook = async_stage_hook;
+    ctx->async_stage_worker.data1 = ctx;
+    ctx->async_stage_worker.data2 = NULL;
+  }
+  ctx->async_cb = *data;
+  return VPX_CODEC_OK;
+}
+
 static vpx_codec_err_t ctrl_set_tune_content(vpx_codec_alg_priv_t *ctx,
                                              va_list args) {
   struct vp9_extracfg extra_cfg = ctx->extra_cfg;
@@ -1518,6 +2017,9 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   {VP9E_SET_MAX_GF_INTERVAL,          ctrl_set_max_gf_interval},
   {VP9E_SET_SVC_REF_FRAME_CONFIG,     ctrl_set_svc_ref_frame_config},
   {VP9E_SET_RENDER_SIZE,              ctrl_set_render_size},
+  {VP9E_SET_INPUT_FRAME_REF,          ctrl_set_input_frame_ref},
+  {VP9E_SET_OUTPUT_BUFFER_CB,         ctrl_set_output_buffer_cb},
+  {VP9E_SET_ASYNC_ENCODE,             ctrl_set_async_encode},
 
   // Getters
   {VP8E_GET_LAST_QUANTIZER,           ctrl_get_quantizer},
@@ -1525,6 +2027,7 @@ static vpx_codec_ctrl_fn_map_t encoder_ctrl_maps[] = {
   {VP9_GET_REFERENCE,                 ctrl_get_reference},
   {VP9E_GET_SVC_LAYER_ID,             ctrl_get_svc_layer_id},
   {VP9E_GET_ACTIVEMAP,                ctrl_get_active_map},
+  {VP9E_GET_PERF_STATS,               ctrl_get_perf_stats},
 
   { -1, NULL},
 };
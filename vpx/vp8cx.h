@@ -572,6 +572,79 @@ enum vp8e_enc_control_id {
    * Supported in codecs: VP9
    */
   VP9E_SET_RENDER_SIZE,
+
+  /*!\brief Codec control function to let the encoder reference input frames
+   * instead of copying them into its lookahead queue.
+   *
+   * Once set, every image accepted by vpx_codec_encode() is handed back
+   * exactly once through the release callback of the #vpx_input_frame_ref_t
+   * argument, at the latest when the encoder is destroyed. Its planes must
+   * stay valid and unmodified until then. Frames are only
+   * referenced when they have at least 160 pixels (luma, scaled down for
+   * chroma) of writable padding around each plane, which the encoder uses
+   * for border extension, and when temporal denoising is off; other frames
+   * are copied as before and released immediately. Passing NULL disables the
+   * mode for subsequent frames.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_INPUT_FRAME_REF,
+
+  /*!\brief Codec control function to have the encoder write compressed
+   * frames directly into buffers provided by the application.
+   *
+   * Once set, the get_buffer callback of the #vpx_output_buffer_cb_t
+   * argument is asked for a buffer of at least min_sz bytes before each
+   * frame packet is written, and the packet, including any superframe index,
+   * is assembled in place in that buffer without further copies. The
+   * packet's data.frame.buf points into the buffer, and the buffer belongs to
+   * the application again once the packet has been returned. The encoder
+   * requests the next buffer before it knows whether another frame will be
+   * produced, so it may hold one buffer that no packet has been returned in
+   * yet. That buffer is used for the next packet, or is handed back through
+   * the release_buffer callback once the encoder no longer needs it, at the
+   * latest when the encoder is destroyed. Every buffer handed out is thus
+   * either returned in a packet or released. Must be set before the first
+   * frame is encoded.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_OUTPUT_BUFFER_CB,
+
+  /*!\brief Codec control function to encode frames asynchronously.
+   *
+   * Once set, vpx_codec_encode() copies the frame (or, with
+   * #VP9E_SET_INPUT_FRAME_REF, keeps a reference to it) and returns without
+   * waiting for it to be encoded, so the application can prepare the next
+   * frame meanwhile. The frames are pipelined over two threads: while one
+   * frame is encoded, the frame queued after it is copied into the
+   * lookahead and has its borders extended. Each vpx_codec_encode() call
+   * moves the pipeline on by one frame. Any other control or configuration
+   * call first finishes the queued frames. An error encoding a queued frame
+   * is returned by a later vpx_codec_encode() call, which still queues its
+   * own frame.
+   *
+   * All packets, including superframes, first pass statistics and PSNR
+   * packets, are delivered through the output_cx_pkt callback of the
+   * #vpx_codec_priv_output_cx_pkt_cb_pair_t argument, from the encoding
+   * thread, and vpx_codec_get_cx_data() returns none. Packet data is only
+   * valid during the callback. Flushing with a NULL image encodes the
+   * remaining frames before returning. Passing NULL goes back to
+   * synchronous encoding.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_SET_ASYNC_ENCODE,
+
+  /*!\brief Codec control function to get per-stage encoder timings and
+   * counters, see #vpx_enc_perf_stats_t.
+   *
+   * Returns #VPX_CODEC_INCAPABLE unless libvpx was configured with
+   * --enable-perf-stats.
+   *
+   * Supported in codecs: VP9
+   */
+  VP9E_GET_PERF_STATS,
 };
 
 /*!\brief vpx 1-D scaling mode
@@ -713,6 +786,90 @@ typedef struct vpx_svc_ref_frame_config {
   int alt_fb_idx[VPX_TS_MAX_LAYERS];  /**< Altref buffer index. */
 } vpx_svc_ref_frame_config_t;
 
+/*!\brief Input frame release callback prototype
+ *
+ * Called once the encoder no longer references the planes of an image passed
+ * to vpx_codec_encode(). img is the encoder's copy of the image descriptor,
+ * so img->user_priv can be used to identify the application's buffer.
+ */
+typedef void (*vpx_release_input_frame_cb_fn_t)(void *cb_priv,
+                                                const vpx_image_t *img);
+
+/*!\brief  vp9 referenced input frame parameters
+ *
+ * This is used with the #VP9E_SET_INPUT_FRAME_REF control to let the encoder
+ * keep references to the application's input frames instead of copies.
+ *
+ */
+typedef struct vpx_input_frame_ref {
+  vpx_release_input_frame_cb_fn_t release_cb;  /**< Release callback. */
+  void *cb_priv;                               /**< Passed to release_cb. */
+  /*! Writable padding around each plane, in luma pixels. */
+  unsigned int border;
+} vpx_input_frame_ref_t;
+
+/*!\brief Output buffer allocation callback prototype
+ *
+ * Returns a buffer of at least min_sz bytes for the next compressed frame
+ * packet, or NULL on failure, which fails the current vpx_codec_encode() call
+ * with #VPX_CODEC_MEM_ERROR.
+ */
+typedef void *(*vpx_get_output_buffer_cb_fn_t)(void *cb_priv, size_t min_sz);
+
+/*!\brief Output buffer release callback prototype
+ *
+ * Hands back a buffer from the allocation callback that no packet was
+ * returned in.
+ */
+typedef void (*vpx_release_output_buffer_cb_fn_t)(void *cb_priv, void *buf);
+
+/*!\brief  vp9 application provided output buffers
+ *
+ * This is used with the #VP9E_SET_OUTPUT_BUFFER_CB control to let the encoder
+ * write compressed frames directly into the application's buffers.
+ *
+ */
+typedef struct vpx_output_buffer_cb {
+  vpx_get_output_buffer_cb_fn_t get_buffer;  /**< Allocation callback. */
+  vpx_release_output_buffer_cb_fn_t release_buffer;  /**< Release callback. */
+  void *cb_priv;  /**< Passed to get_buffer and release_buffer. */
+} vpx_output_buffer_cb_t;
+
+/*!\brief vp9 encoder per-frame timings and counters
+ *
+ * Times are wall clock microseconds measured on the thread driving the
+ * encoder. Stages that use tile threads are timed as a whole, so
+ * thread_wait_us is included in encode_us.
+ */
+typedef struct vpx_enc_frame_perf {
+  int64_t lookahead_us;        /**< Copying input frames into the lookahead. */
+  int64_t first_pass_us;       /**< First pass analysis. */
+  int64_t temporal_filter_us;  /**< Alt-ref temporal filtering (ARNR). */
+  /*! Partitioning, motion search, RD mode decision, transform, quantization
+   * and tokenization, which are interleaved block by block. */
+  int64_t encode_us;
+  int64_t thread_wait_us;      /**< Waiting for tile threads to finish. */
+  int64_t loopfilter_pick_us;  /**< Loop filter level search. */
+  int64_t loopfilter_us;       /**< Loop filtering. */
+  int64_t extend_us;           /**< Border extension of the reconstruction. */
+  int64_t pack_us;             /**< Bitstream packing, including recodes. */
+  int64_t frame_us;            /**< All of the above but lookahead_us. */
+  int64_t motion_searches;     /**< Full pixel motion searches. */
+  int64_t tokens;              /**< Coefficient tokens coded. */
+} vpx_enc_frame_perf_t;
+
+/*!\brief  vp9 encoder performance statistics
+ *
+ * This is used with the #VP9E_GET_PERF_STATS control. Time spent receiving
+ * input is attributed to the next frame coded.
+ *
+ */
+typedef struct vpx_enc_perf_stats {
+  unsigned int frames;              /**< Frames coded so far. */
+  vpx_enc_frame_perf_t last_frame;  /**< The most recently coded frame. */
+  vpx_enc_frame_perf_t total;       /**< Sum over all coded frames. */
+} vpx_enc_perf_stats_t;
+
 /*!\brief VP8 encoder control function parameter type
  *
  * Defines the data types that VP8E control functions take. Note that
@@ -813,6 +970,15 @@ VPX_CTRL_USE_TYPE(VP9E_SET_SVC_REF_FRAME_CONFIG, vpx_svc_ref_frame_config_t *)
  */
 #define VPX_CTRL_VP9E_SET_RENDER_SIZE
 VPX_CTRL_USE_TYPE(VP9E_SET_RENDER_SIZE, int *)
+
+VPX_CTRL_USE_TYPE(VP9E_SET_INPUT_FRAME_REF, vpx_input_frame_ref_t *)
+
+VPX_CTRL_USE_TYPE(VP9E_SET_OUTPUT_BUFFER_CB, vpx_output_buffer_cb_t *)
+
+VPX_CTRL_USE_TYPE(VP9E_SET_ASYNC_ENCODE,
+                  vpx_codec_priv_output_cx_pkt_cb_pair_t *)
+
+VPX_CTRL_USE_TYPE(VP9E_GET_PERF_STATS, vpx_enc_perf_stats_t *)
 /*! @} - end defgroup vp8_encoder */
 #ifdef __cplusplus
 }  // extern "C"
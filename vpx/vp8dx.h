@@ -121,6 +121,13 @@ enum vp8_dec_control_id {
    */
   VP9_SET_SKIP_LOOP_FILTER,
 
+  /** control function to get per-stage decoder timings, see
+   * vpx_dec_perf_stats_t. Returns VPX_CODEC_INCAPABLE unless libvpx was
+   * configured with --enable-perf-stats, and is not supported in frame
+   * parallel decode.
+   */
+  VP9D_GET_PERF_STATS,
+
   VP8_DECODER_CTRL_ID_MAX
 };
 
@@ -147,6 +154,37 @@ typedef struct vpx_decrypt_init {
 typedef vpx_decrypt_init vp8_decrypt_init;
 
 
+/*!\brief vp9 decoder per-frame timings
+ *
+ * Times are wall clock microseconds measured on the decoding thread. Borders
+ * of reference frames are extended on demand during prediction, which is
+ * part of tiles_us.
+ */
+typedef struct vpx_dec_frame_perf {
+  int64_t header_us;       /**< Frame setup and header parsing. */
+  /*! Tile parsing and reconstruction, without the loop filtering and waiting
+   * below. */
+  int64_t tiles_us;
+  int64_t loopfilter_us;   /**< Loop filtering on the decoding thread. */
+  int64_t thread_wait_us;  /**< Waiting for tile or loop filter threads. */
+  int64_t adapt_us;        /**< Backward probability adaptation. */
+  int64_t frame_us;        /**< The whole frame. */
+} vpx_dec_frame_perf_t;
+
+/*!\brief Structure to hold vp9 decoder performance statistics
+ *
+ * This is used with the VP9D_GET_PERF_STATS control.
+ */
+typedef struct vpx_dec_perf_stats {
+  /*! Frames decoded so far. */
+  unsigned int frames;
+  /*! The most recently decoded frame. */
+  vpx_dec_frame_perf_t last_frame;
+  /*! Sum over all decoded frames. */
+  vpx_dec_frame_perf_t total;
+} vpx_dec_perf_stats_t;
+
+
 /*!\brief VP8 decoder control function parameter type
  *
  * Defines the data types that VP8D control functions take. Note that
@@ -164,6 +202,7 @@ VPX_CTRL_USE_TYPE(VP9D_GET_DISPLAY_SIZE,        int *)
 VPX_CTRL_USE_TYPE(VP9D_GET_BIT_DEPTH,           unsigned int *)
 VPX_CTRL_USE_TYPE(VP9D_GET_FRAME_SIZE,          int *)
 VPX_CTRL_USE_TYPE(VP9_INVERT_TILE_DECODE_ORDER, int)
+VPX_CTRL_USE_TYPE(VP9D_GET_PERF_STATS,          vpx_dec_perf_stats_t *)
 
 /*! @} - end defgroup vp8_decoder */
 
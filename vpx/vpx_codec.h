@@ -361,6 +361,72 @@ extern "C" {
   vpx_codec_caps_t vpx_codec_get_caps(vpx_codec_iface_t *iface);
 
 
+  /*!\brief Kernel ISA rule modes, for vpx_codec_set_kernel_isa() */
+  typedef enum vpx_kernel_isa_mode {
+    VPX_KERNEL_ISA_DENY,  /**< Never use the variant */
+    VPX_KERNEL_ISA_FORCE  /**< Use the variant where the CPU supports it */
+  } vpx_kernel_isa_mode_t;
+
+
+  /*!\brief Override the instruction set used by a family of kernels.
+   *
+   * The SIMD kernels (DSP functions) have variants for several instruction
+   * set extensions, and by default the one for the newest extension the CPU
+   * supports is used. This overrides that choice for the kernels whose
+   * name starts with the given prefix, e.g. "vpx_convolve8" for all the
+   * 8-tap convolutions, or "" for every kernel. The extension is named as in
+   * the build configuration: "c", "sse2", "ssse3", "avx2", "neon", etc.
+   *
+   * Rules apply in the order they are set, later ones taking precedence for
+   * the kernels both match. The VPX_SIMD_KERNELS environment variable adds
+   * rules after those, as a comma separated list of prefix=isa (force) or
+   * prefix=-isa (deny) entries.
+   *
+   * Kernels are selected once per process, when the first codec instance
+   * is initialized, so this must be called before that. A variant can only
+   * be denied if the build links another one for the kernel.
+   *
+   * \param[in] kernels   Kernel name prefix
+   * \param[in] isa       Instruction set extension of the variant
+   * \param[in] mode      Whether to deny or force the variant
+   *
+   * \retval #VPX_CODEC_OK
+   *     The rule was added.
+   * \retval #VPX_CODEC_INVALID_PARAM
+   *     The extension is unknown or an argument is missing.
+   * \retval #VPX_CODEC_MEM_ERROR
+   *     The maximum number of rules has been reached.
+   * \retval #VPX_CODEC_ERROR
+   *     Kernels have already been selected.
+   */
+  vpx_codec_err_t vpx_codec_set_kernel_isa(const char *kernels,
+                                           const char *isa,
+                                           vpx_kernel_isa_mode_t mode);
+
+
+  /*!\brief Select kernels by timing their variants.
+   *
+   * When enabled, the SAD, variance, sub-pixel variance and convolution
+   * kernels that have more than one variant usable on the CPU are timed on
+   * each of them when kernels are selected, and the fastest is used. Only
+   * the variants allowed by vpx_codec_set_kernel_isa() are considered, and
+   * a forced variant is used without timing. All variants give the same
+   * results, so this only affects speed. Setting the VPX_SIMD_TUNE
+   * environment variable to 1 enables it too.
+   *
+   * Like vpx_codec_set_kernel_isa(), this must be called before the first
+   * codec instance is initialized.
+   *
+   * \param[in] enable    1 to time the kernels, 0 for the default choice
+   *
+   * \retval #VPX_CODEC_OK
+   *     The mode was set.
+   * \retval #VPX_CODEC_ERROR
+   *     Kernels have already been selected.
+   */
+  vpx_codec_err_t vpx_codec_set_kernel_tuning(int enable);
+
+
   /*!\brief Control algorithm
    *
    * This function is used to exchange algorithm specific data with the codec
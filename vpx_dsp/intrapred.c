@@ -781,7 +781,7 @@ intra_pred_allsizes(dc_128)
 intra_pred_allsizes(dc_left)
 intra_pred_allsizes(dc_top)
 intra_pred_allsizes(dc)
-#if CONFIG_VP9_HIGHBITDEPTH && CONFIG_MISC_FIXES
+#if CONFIG_VP9_HIGHBITDEPTH
 intra_pred_highbd_sized(d45e, 4)
 #endif
 #undef intra_pred_allsizes
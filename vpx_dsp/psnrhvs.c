@@ -89,6 +89,12 @@ static double convert_score_db(double _score, double _weight) {
   return 10 * (log10(255 * 255) - log10(_weight * _score));
 }
 
+/*Sum of the squared differences from the mean of _n pixels, from their sum
+ and sum of squares.*/
+static float sum_sq_var(uint32_t _sum, uint32_t _sum_sq, uint32_t _n) {
+  return (float)(_n * _sum_sq - _sum * _sum) / _n;
+}
+
 static double calc_psnrhvs(const unsigned char *_src, int _systride,
                            const unsigned char *_dst, int _dystride,
                            double _par, int _w, int _h, int _step,
@@ -126,46 +132,39 @@ static double calc_psnrhvs(const unsigned char *_src, int _systride,
     for (x = 0; x < _w - 7; x += _step) {
       int i;
       int j;
-      float s_means[4];
-      float d_means[4];
+      uint32_t sum_s[4], sum_d[4], sum_sq_s[4], sum_sq_d[4], sum_sd[4];
+      uint32_t s_gsum = 0, d_gsum = 0, s_gsum_sq = 0, d_gsum_sq = 0;
       float s_vars[4];
       float d_vars[4];
-      float s_gmean = 0;
-      float d_gmean = 0;
-      float s_gvar = 0;
-      float d_gvar = 0;
+      float s_gvar;
+      float d_gvar;
       float s_mask = 0;
       float d_mask = 0;
-      for (i = 0; i < 4; i++)
-        s_means[i] = d_means[i] = s_vars[i] = d_vars[i] = 0;
       for (i = 0; i < 8; i++) {
         for (j = 0; j < 8; j++) {
-          int sub = ((i & 12) >> 2) + ((j & 12) >> 1);
           dct_s[i * 8 + j] = _src[(y + i) * _systride + (j + x)];
           dct_d[i * 8 + j] = _dst[(y + i) * _dystride + (j + x)];
-          s_gmean += dct_s[i * 8 + j];
-          d_gmean += dct_d[i * 8 + j];
-          s_means[sub] += dct_s[i * 8 + j];
-          d_means[sub] += dct_d[i * 8 + j];
         }
       }
-      s_gmean /= 64.f;
-      d_gmean /= 64.f;
-      for (i = 0; i < 4; i++)
-        s_means[i] /= 16.f;
-      for (i = 0; i < 4; i++)
-        d_means[i] /= 16.f;
-      for (i = 0; i < 8; i++) {
-        for (j = 0; j < 8; j++) {
-          int sub = ((i & 12) >> 2) + ((j & 12) >> 1);
-          s_gvar += (dct_s[i * 8 + j] - s_gmean) * (dct_s[i * 8 + j] - s_gmean);
-          d_gvar += (dct_d[i * 8 + j] - d_gmean) * (dct_d[i * 8 + j] - d_gmean);
-          s_vars[sub] += (dct_s[i * 8 + j] - s_means[sub])
-              * (dct_s[i * 8 + j] - s_means[sub]);
-          d_vars[sub] += (dct_d[i * 8 + j] - d_means[sub])
-              * (dct_d[i * 8 + j] - d_means[sub]);
-        }
+      /*The sums of the four 4x4 sub-blocks give their variances, and those of
+       the whole block, exactly.*/
+      for (i = 0; i < 8; i += 4) {
+        vpx_ssim_parms_4x4_row(_src + (y + i) * _systride + x, _systride,
+                               _dst + (y + i) * _dystride + x, _dystride, 2,
+                               sum_s + i / 2, sum_d + i / 2,
+                               sum_sq_s + i / 2, sum_sq_d + i / 2,
+                               sum_sd + i / 2);
+      }
+      for (i = 0; i < 4; i++) {
+        s_gsum += sum_s[i];
+        d_gsum += sum_d[i];
+        s_gsum_sq += sum_sq_s[i];
+        d_gsum_sq += sum_sq_d[i];
+        s_vars[i] = sum_sq_var(sum_s[i], sum_sq_s[i], 16);
+        d_vars[i] = sum_sq_var(sum_d[i], sum_sq_d[i], 16);
       }
+      s_gvar = sum_sq_var(s_gsum, s_gsum_sq, 64);
+      d_gvar = sum_sq_var(d_gsum, d_gsum_sq, 64);
       s_gvar *= 1 / 63.f * 64;
       d_gvar *= 1 / 63.f * 64;
       for (i = 0; i < 4; i++)
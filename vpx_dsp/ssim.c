@@ -11,6 +11,7 @@
 #include <math.h>
 #include "./vpx_dsp_rtcd.h"
 #include "vpx_dsp/ssim.h"
+#include "vpx_mem/vpx_mem.h"
 #include "vpx_ports/mem.h"
 #include "vpx_ports/system_state.h"
 
@@ -45,6 +46,27 @@ void vpx_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r, int rp,
   }
 }
 
+// Sums of the n 4x4 blocks side by side at s and r. Unlike the functions
+// above the sums of block k are stored to sum_s[k] etc rather than added.
+void vpx_ssim_parms_4x4_row_c(const uint8_t *s, int sp, const uint8_t *r,
+                              int rp, int n, uint32_t *sum_s, uint32_t *sum_r,
+                              uint32_t *sum_sq_s, uint32_t *sum_sq_r,
+                              uint32_t *sum_sxr) {
+  int i, j, k;
+  for (k = 0; k < n; k++, s += 4, r += 4) {
+    sum_s[k] = sum_r[k] = sum_sq_s[k] = sum_sq_r[k] = sum_sxr[k] = 0;
+    for (i = 0; i < 4; i++) {
+      for (j = 0; j < 4; j++) {
+        sum_s[k] += s[i * sp + j];
+        sum_r[k] += r[i * rp + j];
+        sum_sq_s[k] += s[i * sp + j] * s[i * sp + j];
+        sum_sq_r[k] += r[i * rp + j] * r[i * rp + j];
+        sum_sxr[k] += s[i * sp + j] * r[i * rp + j];
+      }
+    }
+  }
+}
+
 #if CONFIG_VP9_HIGHBITDEPTH
 void vpx_highbd_ssim_parms_8x8_c(const uint16_t *s, int sp,
                                  const uint16_t *r, int rp,
@@ -87,13 +109,6 @@ static double similarity(uint32_t sum_s, uint32_t sum_r,
   return ssim_n * 1.0 / ssim_d;
 }
 
-static double ssim_8x8(const uint8_t *s, int sp, const uint8_t *r, int rp) {
-  uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-  vpx_ssim_parms_8x8(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r,
-                     &sum_sxr);
-  return similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64);
-}
-
 #if CONFIG_VP9_HIGHBITDEPTH
 static double highbd_ssim_8x8(const uint16_t *s, int sp, const uint16_t *r,
                               int rp, unsigned int bd) {
@@ -110,25 +125,62 @@ static double highbd_ssim_8x8(const uint16_t *s, int sp, const uint16_t *r,
 }
 #endif  // CONFIG_VP9_HIGHBITDEPTH
 
+// The sums of a row of 4x4 blocks, one array of n for each of sum_s, sum_r,
+// sum_sq_s, sum_sq_r and sum_sxr in turn.
+static void ssim_parms_row(const uint8_t *s, int sp, const uint8_t *r, int rp,
+                           int n, uint32_t *sums) {
+  vpx_ssim_parms_4x4_row(s, sp, r, rp, n, sums, sums + n, sums + 2 * n,
+                         sums + 3 * n, sums + 4 * n);
+}
+
 // We are using a 8x8 moving window with starting location of each 8x8 window
 // on the 4x4 pixel grid. Such arrangement allows the windows to overlap
 // block boundaries to penalize blocking artifacts.
+//
+// Each window is made up of four 4x4 blocks that it shares with its
+// neighbours, so the sums of every 4x4 block are computed once, a row at a
+// time, and added up for the windows between the last two rows.
 static double vpx_ssim2(const uint8_t *img1, const uint8_t *img2,
                         int stride_img1, int stride_img2, int width,
                         int height) {
-  int i, j;
+  const int n = width >> 2;
+  uint32_t *sums, *above, *below;
+  int i, j, q;
   int samples = 0;
   double ssim_total = 0;
 
+  sums = (uint32_t *)vpx_malloc(2 * 5 * n * sizeof(*sums));
+  if (sums == NULL)
+    return 0;
+  above = sums;
+  below = sums + 5 * n;
+
+  if (height >= 8)
+    ssim_parms_row(img1, stride_img1, img2, stride_img2, n, above);
+
   // sample point start with each 4x4 location
-  for (i = 0; i <= height - 8;
-       i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
-    for (j = 0; j <= width - 8; j += 4) {
-      double v = ssim_8x8(img1 + j, stride_img1, img2 + j, stride_img2);
-      ssim_total += v;
+  for (i = 0; i <= height - 8; i += 4) {
+    uint32_t *const tmp = above;
+    img1 += stride_img1 * 4;
+    img2 += stride_img2 * 4;
+    ssim_parms_row(img1, stride_img1, img2, stride_img2, n, below);
+
+    for (j = 0; j < n - 1; ++j) {
+      uint32_t window[5];
+      for (q = 0; q < 5; ++q) {
+        window[q] = above[q * n + j] + above[q * n + j + 1] +
+                    below[q * n + j] + below[q * n + j + 1];
+      }
+      ssim_total += similarity(window[0], window[1], window[2], window[3],
+                               window[4], 64);
       samples++;
     }
+
+    above = below;
+    below = tmp;
   }
+
+  vpx_free(sums);
   ssim_total /= samples;
   return ssim_total;
 }
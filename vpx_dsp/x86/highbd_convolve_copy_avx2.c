@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_ports/mem.h"
+
+// Blocks narrower than 16 pixels are no faster than with SSE2 and go there.
+
+void vpx_highbd_convolve_copy_avx2(const uint8_t *src8, ptrdiff_t src_stride,
+                                   uint8_t *dst8, ptrdiff_t dst_stride,
+                                   const int16_t *filter_x, int filter_x_stride,
+                                   const int16_t *filter_y, int filter_y_stride,
+                                   int w, int h, int bd) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  uint16_t *dst = CONVERT_TO_SHORTPTR(dst8);
+  int x, y;
+
+  if (w < 16) {
+    vpx_highbd_convolve_copy_sse2(src8, src_stride, dst8, dst_stride,
+                                  filter_x, filter_x_stride,
+                                  filter_y, filter_y_stride, w, h, bd);
+    return;
+  }
+
+  for (y = 0; y < h; ++y) {
+    for (x = 0; x < w; x += 16)
+      _mm256_storeu_si256((__m256i *)(dst + x),
+                          _mm256_loadu_si256((const __m256i *)(src + x)));
+    src += src_stride;
+    dst += dst_stride;
+  }
+}
+
+void vpx_highbd_convolve_avg_avx2(const uint8_t *src8, ptrdiff_t src_stride,
+                                  uint8_t *dst8, ptrdiff_t dst_stride,
+                                  const int16_t *filter_x, int filter_x_stride,
+                                  const int16_t *filter_y, int filter_y_stride,
+                                  int w, int h, int bd) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  uint16_t *dst = CONVERT_TO_SHORTPTR(dst8);
+  int x, y;
+
+  if (w < 16) {
+    vpx_highbd_convolve_avg_sse2(src8, src_stride, dst8, dst_stride,
+                                 filter_x, filter_x_stride,
+                                 filter_y, filter_y_stride, w, h, bd);
+    return;
+  }
+
+  for (y = 0; y < h; ++y) {
+    for (x = 0; x < w; x += 16) {
+      const __m256i s = _mm256_loadu_si256((const __m256i *)(src + x));
+      const __m256i d = _mm256_loadu_si256((const __m256i *)(dst + x));
+      _mm256_storeu_si256((__m256i *)(dst + x), _mm256_avg_epu16(s, d));
+    }
+    src += src_stride;
+    dst += dst_stride;
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_ports/mem.h"
+
+void vpx_highbd_convolve_copy_sse2(const uint8_t *src8, ptrdiff_t src_stride,
+                                   uint8_t *dst8, ptrdiff_t dst_stride,
+                                   const int16_t *filter_x, int filter_x_stride,
+                                   const int16_t *filter_y, int filter_y_stride,
+                                   int w, int h, int bd) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  uint16_t *dst = CONVERT_TO_SHORTPTR(dst8);
+  int x, y;
+  (void)filter_x;
+  (void)filter_x_stride;
+  (void)filter_y;
+  (void)filter_y_stride;
+  (void)bd;
+
+  for (y = 0; y < h; ++y) {
+    if (w == 4) {
+      _mm_storel_epi64((__m128i *)dst,
+                       _mm_loadl_epi64((const __m128i *)src));
+    } else {
+      for (x = 0; x < w; x += 8)
+        _mm_storeu_si128((__m128i *)(dst + x),
+                         _mm_loadu_si128((const __m128i *)(src + x)));
+    }
+    src += src_stride;
+    dst += dst_stride;
+  }
+}
+
+void vpx_highbd_convolve_avg_sse2(const uint8_t *src8, ptrdiff_t src_stride,
+                                  uint8_t *dst8, ptrdiff_t dst_stride,
+                                  const int16_t *filter_x, int filter_x_stride,
+                                  const int16_t *filter_y, int filter_y_stride,
+                                  int w, int h, int bd) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  uint16_t *dst = CONVERT_TO_SHORTPTR(dst8);
+  int x, y;
+  (void)filter_x;
+  (void)filter_x_stride;
+  (void)filter_y;
+  (void)filter_y_stride;
+  (void)bd;
+
+  for (y = 0; y < h; ++y) {
+    if (w == 4) {
+      const __m128i s = _mm_loadl_epi64((const __m128i *)src);
+      const __m128i d = _mm_loadl_epi64((const __m128i *)dst);
+      _mm_storel_epi64((__m128i *)dst, _mm_avg_epu16(s, d));
+    } else {
+      for (x = 0; x < w; x += 8) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+        const __m128i d = _mm_loadu_si128((const __m128i *)(dst + x));
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_avg_epu16(s, d));
+      }
+    }
+    src += src_stride;
+    dst += dst_stride;
+  }
+}
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>  // SSE2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Stores |bs| pixels of |row| to each of the |bs| rows of |dst|.
+static INLINE void fill_block(uint16_t *dst, ptrdiff_t stride, int bs,
+                              const __m128i row) {
+  int r, c;
+  for (r = 0; r < bs; ++r) {
+    if (bs == 4) {
+      _mm_storel_epi64((__m128i *)dst, row);
+    } else {
+      for (c = 0; c < bs; c += 8)
+        _mm_storeu_si128((__m128i *)(dst + c), row);
+    }
+    dst += stride;
+  }
+}
+
+// Returns the rounded average of the |bs| pixels at |p|. The sums are done
+// in 32 bits since 32 12-bit pixels overflow 16.
+static INLINE int average(const uint16_t *p, int bs, int log2_bs) {
+  const __m128i one = _mm_set1_epi16(1);
+  __m128i sum;
+  int i;
+
+  if (bs == 4) {
+    sum = _mm_madd_epi16(_mm_loadl_epi64((const __m128i *)p), one);
+  } else {
+    sum = _mm_setzero_si128();
+    for (i = 0; i < bs; i += 8)
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(
+          _mm_loadu_si128((const __m128i *)(p + i)), one));
+  }
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+  sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+  return (_mm_cvtsi128_si32(sum) + (bs >> 1)) >> log2_bs;
+}
+
+static INLINE void highbd_h_predictor(uint16_t *dst, ptrdiff_t stride, int bs,
+                                      const uint16_t *left) {
+  int r, c;
+  for (r = 0; r < bs; ++r) {
+    const __m128i row = _mm_set1_epi16((int16_t)left[r]);
+    if (bs == 4) {
+      _mm_storel_epi64((__m128i *)dst, row);
+    } else {
+      for (c = 0; c < bs; c += 8)
+        _mm_storeu_si128((__m128i *)(dst + c), row);
+    }
+    dst += stride;
+  }
+}
+
+#define HIGHBD_PRED(size, log2_size) \
+void vpx_highbd_h_predictor_##size##x##size##_sse2( \
+    uint16_t *dst, ptrdiff_t stride, const uint16_t *above, \
+    const uint16_t *left, int bd) { \
+  (void)above; \
+  (void)bd; \
+  highbd_h_predictor(dst, stride, size, left); \
+} \
+\
+void vpx_highbd_dc_top_predictor_##size##x##size##_sse2( \
+    uint16_t *dst, ptrdiff_t stride, const uint16_t *above, \
+    const uint16_t *left, int bd) { \
+  (void)left; \
+  (void)bd; \
+  fill_block(dst, stride, size, \
+             _mm_set1_epi16((int16_t)average(above, size, log2_size))); \
+} \
+\
+void vpx_highbd_dc_left_predictor_##size##x##size##_sse2( \
+    uint16_t *dst, ptrdiff_t stride, const uint16_t *above, \
+    const uint16_t *left, int bd) { \
+  (void)above; \
+  (void)bd; \
+  fill_block(dst, stride, size, \
+             _mm_set1_epi16((int16_t)average(left, size, log2_size))); \
+} \
+\
+void vpx_highbd_dc_128_predictor_##size##x##size##_sse2( \
+    uint16_t *dst, ptrdiff_t stride, const uint16_t *above, \
+    const uint16_t *left, int bd) { \
+  (void)above; \
+  (void)left; \
+  fill_block(dst, stride, size, _mm_set1_epi16(128 << (bd - 8))); \
+}
+
+HIGHBD_PRED(4, 2)
+HIGHBD_PRED(8, 3)
+HIGHBD_PRED(16, 4)
+HIGHBD_PRED(32, 5)
+
+#undef HIGHBD_PRED
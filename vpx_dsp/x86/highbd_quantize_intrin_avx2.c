@@ -0,0 +1,185 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+#include <string.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/vpx_dsp_common.h"
+
+#if CONFIG_VP9_HIGHBITDEPTH
+// 8 coefficients per iteration in 32 bit lanes, with the 64 bit products of
+// the C code done as separate multiplies of the even and odd lanes. The SSE2
+// version only vectorizes the zbin test and quantizes one coefficient at a
+// time. The eob is the maximum of iscan + 1 over the nonzero lanes.
+
+typedef struct {
+  __m256i zbin;
+  __m256i round;
+  __m256i quant;
+  __m256i shift;
+  __m256i dequant;
+} QuantizeParams;
+
+// Returns the low 32 bits of (a * b) >> shift, computed in 64 bits, for the
+// signed 32 bit lanes of |a| and |b|. As shift is at most 32 the low 32 bits
+// are the same for a logical and an arithmetic shift.
+static INLINE __m256i mul_shift_epi32(const __m256i a, const __m256i b,
+                                      int shift) {
+  const __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), shift);
+  const __m256i odd = _mm256_slli_epi64(
+      _mm256_srli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32),
+                                         _mm256_srli_epi64(b, 32)), shift),
+      32);
+  return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+// Returns |dc| in lane 0 and |ac| in the other lanes.
+static INLINE __m256i dc_ac_epi32(int dc, int ac) {
+  return _mm256_setr_epi32(dc, ac, ac, ac, ac, ac, ac, ac);
+}
+
+// Sets up |p| for the first 8 coefficients when |dc| is set, otherwise for
+// the AC only groups. The 32x32 zbin and round values are halved, rounding
+// up, as in the C code.
+static INLINE void set_params(QuantizeParams *p, int dc, const int16_t *zbin,
+                              const int16_t *round, const int16_t *quant,
+                              const int16_t *quant_shift,
+                              const int16_t *dequant, int log_scale) {
+  const int i = dc ? 0 : 1;
+  // abs_coeff >= zbin is tested as abs_coeff > zbin - 1.
+  p->zbin = dc_ac_epi32(((zbin[i] + log_scale) >> log_scale) - 1,
+                        ((zbin[1] + log_scale) >> log_scale) - 1);
+  p->round = dc_ac_epi32((round[i] + log_scale) >> log_scale,
+                         (round[1] + log_scale) >> log_scale);
+  p->quant = dc_ac_epi32(quant[i], quant[1]);
+  p->shift = dc_ac_epi32(quant_shift[i], quant_shift[1]);
+  p->dequant = dc_ac_epi32(dequant[i], dequant[1]);
+}
+
+static INLINE void quantize_8(const tran_low_t *coeff_ptr,
+                              const int16_t *iscan_ptr,
+                              tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+                              const QuantizeParams *p, int log_scale,
+                              __m256i *eob) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i coeff = _mm256_loadu_si256((const __m256i *)coeff_ptr);
+  const __m256i coeff_sign = _mm256_srai_epi32(coeff, 31);
+  const __m256i abs_coeff = _mm256_abs_epi32(coeff);
+  const __m256i zbin_mask = _mm256_cmpgt_epi32(abs_coeff, p->zbin);
+  __m256i tmp, qcoeff, dqcoeff, nz_iscan;
+
+  // Nothing reaches the zero bin: skip the arithmetic.
+  if (_mm256_testz_si256(zbin_mask, zbin_mask)) {
+    _mm256_storeu_si256((__m256i *)qcoeff_ptr, zero);
+    _mm256_storeu_si256((__m256i *)dqcoeff_ptr, zero);
+    return;
+  }
+
+  tmp = _mm256_add_epi32(abs_coeff, p->round);
+  tmp = _mm256_add_epi32(mul_shift_epi32(tmp, p->quant, 16), tmp);
+  tmp = mul_shift_epi32(tmp, p->shift, 16 - log_scale);
+  tmp = _mm256_and_si256(tmp, zbin_mask);
+
+  qcoeff = _mm256_sub_epi32(_mm256_xor_si256(tmp, coeff_sign), coeff_sign);
+  dqcoeff = _mm256_mullo_epi32(qcoeff, p->dequant);
+  if (log_scale) {
+    // Divide by 2, rounding towards zero.
+    dqcoeff = _mm256_srai_epi32(
+        _mm256_add_epi32(dqcoeff, _mm256_srli_epi32(dqcoeff, 31)), 1);
+  }
+  _mm256_storeu_si256((__m256i *)qcoeff_ptr, qcoeff);
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr, dqcoeff);
+
+  // iscan + 1 where the quantized value is nonzero, otherwise 0.
+  nz_iscan = _mm256_cvtepi16_epi32(
+      _mm_loadu_si128((const __m128i *)iscan_ptr));
+  nz_iscan = _mm256_sub_epi32(nz_iscan, _mm256_cmpeq_epi32(zero, zero));
+  nz_iscan = _mm256_andnot_si256(_mm256_cmpeq_epi32(tmp, zero), nz_iscan);
+  *eob = _mm256_max_epi32(*eob, nz_iscan);
+}
+
+static INLINE void highbd_quantize_b(const tran_low_t *coeff_ptr,
+                                     intptr_t n_coeffs, int skip_block,
+                                     const int16_t *zbin_ptr,
+                                     const int16_t *round_ptr,
+                                     const int16_t *quant_ptr,
+                                     const int16_t *quant_shift_ptr,
+                                     tran_low_t *qcoeff_ptr,
+                                     tran_low_t *dqcoeff_ptr,
+                                     const int16_t *dequant_ptr,
+                                     uint16_t *eob_ptr,
+                                     const int16_t *iscan_ptr,
+                                     int log_scale) {
+  __m256i eob = _mm256_setzero_si256();
+  __m128i eob_4;
+  QuantizeParams p;
+  intptr_t i;
+
+  if (skip_block) {
+    memset(qcoeff_ptr, 0, n_coeffs * sizeof(*qcoeff_ptr));
+    memset(dqcoeff_ptr, 0, n_coeffs * sizeof(*dqcoeff_ptr));
+    *eob_ptr = 0;
+    return;
+  }
+
+  set_params(&p, 1, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+             dequant_ptr, log_scale);
+  quantize_8(coeff_ptr, iscan_ptr, qcoeff_ptr, dqcoeff_ptr, &p, log_scale,
+             &eob);
+
+  set_params(&p, 0, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+             dequant_ptr, log_scale);
+  for (i = 8; i < n_coeffs; i += 8) {
+    quantize_8(coeff_ptr + i, iscan_ptr + i, qcoeff_ptr + i, dqcoeff_ptr + i,
+               &p, log_scale, &eob);
+  }
+
+  eob_4 = _mm_max_epi32(_mm256_castsi256_si128(eob),
+                        _mm256_extracti128_si256(eob, 1));
+  eob_4 = _mm_max_epi32(eob_4, _mm_srli_si128(eob_4, 8));
+  eob_4 = _mm_max_epi32(eob_4, _mm_srli_si128(eob_4, 4));
+  *eob_ptr = (uint16_t)_mm_cvtsi128_si32(eob_4);
+}
+
+void vpx_highbd_quantize_b_avx2(const tran_low_t *coeff_ptr,
+                                intptr_t n_coeffs, int skip_block,
+                                const int16_t *zbin_ptr,
+                                const int16_t *round_ptr,
+                                const int16_t *quant_ptr,
+                                const int16_t *quant_shift_ptr,
+                                tran_low_t *qcoeff_ptr,
+                                tran_low_t *dqcoeff_ptr,
+                                const int16_t *dequant_ptr,
+                                uint16_t *eob_ptr, const int16_t *scan,
+                                const int16_t *iscan) {
+  (void)scan;
+  highbd_quantize_b(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr,
+                    quant_ptr, quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr,
+                    dequant_ptr, eob_ptr, iscan, 0);
+}
+
+void vpx_highbd_quantize_b_32x32_avx2(const tran_low_t *coeff_ptr,
+                                      intptr_t n_coeffs, int skip_block,
+                                      const int16_t *zbin_ptr,
+                                      const int16_t *round_ptr,
+                                      const int16_t *quant_ptr,
+                                      const int16_t *quant_shift_ptr,
+                                      tran_low_t *qcoeff_ptr,
+                                      tran_low_t *dqcoeff_ptr,
+                                      const int16_t *dequant_ptr,
+                                      uint16_t *eob_ptr, const int16_t *scan,
+                                      const int16_t *iscan) {
+  (void)scan;
+  highbd_quantize_b(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr,
+                    quant_ptr, quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr,
+                    dequant_ptr, eob_ptr, iscan, 1);
+}
+#endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// The pixels are at most 12 bits, so the differences fit in 16 bits.
+void vpx_highbd_subtract_block_sse2(int rows, int cols,
+                                    int16_t *diff, ptrdiff_t diff_stride,
+                                    const uint8_t *src8, ptrdiff_t src_stride,
+                                    const uint8_t *pred8,
+                                    ptrdiff_t pred_stride, int bd) {
+  const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
+  const uint16_t *pred = CONVERT_TO_SHORTPTR(pred8);
+  int r, c;
+
+  if (cols == 4) {
+    for (r = 0; r < rows; ++r) {
+      const __m128i s = _mm_loadl_epi64((const __m128i *)src);
+      const __m128i p = _mm_loadl_epi64((const __m128i *)pred);
+      _mm_storel_epi64((__m128i *)diff, _mm_sub_epi16(s, p));
+      diff += diff_stride;
+      src += src_stride;
+      pred += pred_stride;
+    }
+  } else if (!(cols & 7)) {
+    for (r = 0; r < rows; ++r) {
+      for (c = 0; c < cols; c += 8) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + c));
+        const __m128i p = _mm_loadu_si128((const __m128i *)(pred + c));
+        _mm_storeu_si128((__m128i *)(diff + c), _mm_sub_epi16(s, p));
+      }
+      diff += diff_stride;
+      src += src_stride;
+      pred += pred_stride;
+    }
+  } else {
+    vpx_highbd_subtract_block_c(rows, cols, diff, diff_stride, src8,
+                                src_stride, pred8, pred_stride, bd);
+  }
+}
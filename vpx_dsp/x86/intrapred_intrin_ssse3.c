@@ -0,0 +1,219 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <tmmintrin.h>  // SSSE3
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// The d117 and d135 predictors only read the AVG3 filtered edge running from
+// left[bs - 1] up to the corner and along the top to above[bs - 1]. It is
+// kept in registers and each row is produced from the previous one with a
+// byte shift.
+
+DECLARE_ALIGNED(16, static const uint8_t, reverse_bytes[16]) = {
+  15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
+};
+
+DECLARE_ALIGNED(16, static const uint8_t, deinterleave_bytes[16]) = {
+  0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15
+};
+
+// AVG3(a, b, c) of each byte. The rounding of the first average is undone by
+// subtracting the bit it lost, which makes the second one exact.
+static INLINE __m128i avg3_epu8(const __m128i a, const __m128i b,
+                                const __m128i c) {
+  const __m128i lsb = _mm_and_si128(_mm_xor_si128(a, c), _mm_set1_epi8(1));
+  return _mm_avg_epu8(_mm_sub_epi8(_mm_avg_epu8(a, c), lsb), b);
+}
+
+// Stores the first |bs| bytes of |row|, held in one register per 16 pixels.
+static INLINE void store_row(uint8_t *dst, const __m128i *row, int bs) {
+  if (bs == 4) {
+    *(int *)dst = _mm_cvtsi128_si32(row[0]);
+  } else if (bs == 8) {
+    _mm_storel_epi64((__m128i *)dst, row[0]);
+  } else {
+    _mm_storeu_si128((__m128i *)dst, row[0]);
+    if (bs == 32) _mm_storeu_si128((__m128i *)(dst + 16), row[1]);
+  }
+}
+
+// Fills |filt| with the filtered edge: byte j of the registers holds AVG3 of
+// edge[j], edge[j + 1] and edge[j + 2], where the edge is left[bs - 1] ...
+// left[0], above[-1] ... above[bs - 1]. The corner ends up in byte bs - 1.
+static INLINE void filter_edge(__m128i *filt, int bs, const uint8_t *above,
+                               const uint8_t *left) {
+  const __m128i rev = _mm_load_si128((const __m128i *)reverse_bytes);
+  const int n = bs < 16 ? 1 : bs / 8;
+  __m128i edge[5];
+  int i;
+
+  if (bs == 4) {
+    edge[0] = _mm_alignr_epi8(
+        _mm_loadl_epi64((const __m128i *)(above - 1)),
+        _mm_shuffle_epi8(_mm_cvtsi32_si128(*(const int *)left), rev), 12);
+    edge[1] = _mm_setzero_si128();
+  } else if (bs == 8) {
+    edge[0] = _mm_alignr_epi8(
+        _mm_loadl_epi64((const __m128i *)(above - 1)),
+        _mm_shuffle_epi8(_mm_loadl_epi64((const __m128i *)left), rev), 8);
+    edge[1] = _mm_cvtsi32_si128(above[7]);
+  } else {
+    for (i = 0; i < bs / 16; ++i) {
+      edge[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i *)(left + bs - 16 - 16 * i)), rev);
+      edge[bs / 16 + i] =
+          _mm_loadu_si128((const __m128i *)(above - 1 + 16 * i));
+    }
+    edge[n] = _mm_cvtsi32_si128(above[bs - 1]);
+  }
+
+  for (i = 0; i < n; ++i)
+    filt[i] = avg3_epu8(edge[i], _mm_alignr_epi8(edge[i + 1], edge[i], 1),
+                        _mm_alignr_epi8(edge[i + 1], edge[i], 2));
+}
+
+// Each row is the one above it moved one pixel to the right, so the bottom
+// row starts at the beginning of the filtered edge and the rows above it are
+// found by shifting it down a byte at a time.
+static INLINE void d135_predictor(uint8_t *dst, ptrdiff_t stride, int bs,
+                                  const uint8_t *above, const uint8_t *left) {
+  const int n = bs < 16 ? 1 : bs / 8;
+  __m128i filt[4];
+  int r, i;
+
+  filter_edge(filt, bs, above, left);
+  dst += (bs - 1) * stride;
+  for (r = 0; r < bs; ++r) {
+    store_row(dst, filt, bs);
+    for (i = 0; i < n - 1; ++i)
+      filt[i] = _mm_alignr_epi8(filt[i + 1], filt[i], 1);
+    filt[n - 1] = _mm_srli_si128(filt[n - 1], 1);
+    dst -= stride;
+  }
+}
+
+// Moves |row| one pixel to the right, taking the new first pixel from the
+// top byte of |feed|, which is shifted up to expose the next one.
+static INLINE void shift_in(__m128i *row, __m128i *feed, int bs) {
+  if (bs == 32) row[1] = _mm_alignr_epi8(row[1], row[0], 15);
+  row[0] = _mm_alignr_epi8(row[0], *feed, 15);
+  *feed = _mm_slli_si128(*feed, 1);
+}
+
+// Rows 0 and 1 are the 2 and 3 tap averages along the top, and every other
+// row is the one two above it moved one pixel to the right, with alternate
+// values of the filtered left edge shifted in from |feed_even| and
+// |feed_odd|.
+static INLINE void d117_predictor(uint8_t *dst, ptrdiff_t stride, int bs,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m128i deinterleave =
+      _mm_load_si128((const __m128i *)deinterleave_bytes);
+  __m128i filt[4], even[2], odd[2], feed_even, feed_odd, s0, s1;
+  int r;
+
+  filter_edge(filt, bs, above, left);
+
+  if (bs == 4) {
+    const __m128i a = _mm_loadl_epi64((const __m128i *)(above - 1));
+    even[0] = _mm_avg_epu8(a, _mm_srli_si128(a, 1));
+    odd[0] = _mm_srli_si128(filt[0], 3);
+    feed_even = _mm_slli_si128(filt[0], 13);
+    feed_odd = _mm_slli_si128(filt[0], 14);
+  } else if (bs == 8) {
+    const __m128i a = _mm_loadu_si128((const __m128i *)(above - 1));
+    even[0] = _mm_avg_epu8(a, _mm_srli_si128(a, 1));
+    odd[0] = _mm_srli_si128(filt[0], 7);
+    s0 = _mm_shuffle_epi8(filt[0], deinterleave);
+    feed_even = _mm_slli_si128(s0, 12);
+    feed_odd = _mm_slli_si128(s0, 5);
+  } else if (bs == 16) {
+    even[0] = _mm_avg_epu8(_mm_loadu_si128((const __m128i *)(above - 1)),
+                           _mm_loadu_si128((const __m128i *)above));
+    odd[0] = _mm_alignr_epi8(filt[1], filt[0], 15);
+    s0 = _mm_shuffle_epi8(filt[0], deinterleave);
+    feed_even = _mm_slli_si128(s0, 8);
+    feed_odd = _mm_slli_si128(s0, 1);
+  } else {
+    even[0] = _mm_avg_epu8(_mm_loadu_si128((const __m128i *)(above - 1)),
+                           _mm_loadu_si128((const __m128i *)above));
+    even[1] = _mm_avg_epu8(_mm_loadu_si128((const __m128i *)(above + 15)),
+                           _mm_loadu_si128((const __m128i *)(above + 16)));
+    odd[0] = _mm_alignr_epi8(filt[2], filt[1], 15);
+    odd[1] = _mm_alignr_epi8(filt[3], filt[2], 15);
+    s0 = _mm_shuffle_epi8(filt[0], deinterleave);
+    s1 = _mm_shuffle_epi8(filt[1], deinterleave);
+    feed_even = _mm_unpacklo_epi64(s0, s1);
+    feed_odd = _mm_slli_si128(_mm_unpackhi_epi64(s0, s1), 1);
+  }
+
+  for (r = 0; r < bs; r += 2) {
+    store_row(dst, even, bs);
+    store_row(dst + stride, odd, bs);
+    shift_in(even, &feed_even, bs);
+    shift_in(odd, &feed_odd, bs);
+    dst += 2 * stride;
+  }
+}
+
+#define DIRECTIONAL_PRED(type, size) \
+void vpx_##type##_predictor_##size##x##size##_ssse3(uint8_t *dst, \
+                                                    ptrdiff_t stride, \
+                                                    const uint8_t *above, \
+                                                    const uint8_t *left) { \
+  type##_predictor(dst, stride, size, above, left); \
+}
+
+DIRECTIONAL_PRED(d135, 4)
+DIRECTIONAL_PRED(d135, 8)
+DIRECTIONAL_PRED(d135, 16)
+DIRECTIONAL_PRED(d135, 32)
+DIRECTIONAL_PRED(d117, 4)
+DIRECTIONAL_PRED(d117, 8)
+DIRECTIONAL_PRED(d117, 16)
+DIRECTIONAL_PRED(d117, 32)
+
+#undef DIRECTIONAL_PRED
+
+// The 3 tap averages of above[0..7], with above[8] taken to be above[7].
+void vpx_d45e_predictor_4x4_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m128i a = _mm_shuffle_epi8(_mm_loadl_epi64((const __m128i *)above),
+                                     _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                                   7, 7, 7, 7, 7, 7, 7, 7));
+  const __m128i avg3 = avg3_epu8(a, _mm_srli_si128(a, 1),
+                                 _mm_srli_si128(a, 2));
+  (void)left;
+  *(int *)dst = _mm_cvtsi128_si32(avg3);
+  *(int *)(dst + stride) = _mm_cvtsi128_si32(_mm_srli_si128(avg3, 1));
+  *(int *)(dst + 2 * stride) = _mm_cvtsi128_si32(_mm_srli_si128(avg3, 2));
+  *(int *)(dst + 3 * stride) = _mm_cvtsi128_si32(_mm_srli_si128(avg3, 3));
+}
+
+// Rows 2 and 3 are rows 0 and 1 moved one pixel to the left, except that
+// their last pixels are the 3 tap averages centred on above[5] and above[6].
+void vpx_d63e_predictor_4x4_ssse3(uint8_t *dst, ptrdiff_t stride,
+                                  const uint8_t *above, const uint8_t *left) {
+  const __m128i a = _mm_loadl_epi64((const __m128i *)above);
+  const __m128i b = _mm_srli_si128(a, 1);
+  const __m128i avg2 = _mm_avg_epu8(a, b);
+  const __m128i avg3 = avg3_epu8(a, b, _mm_srli_si128(a, 2));
+  const __m128i rows23 = _mm_shuffle_epi8(
+      _mm_unpacklo_epi64(avg2, avg3),
+      _mm_setr_epi8(1, 2, 3, 12, 9, 10, 11, 13, -1, -1, -1, -1, -1, -1, -1,
+                    -1));
+  (void)left;
+  *(int *)dst = _mm_cvtsi128_si32(avg2);
+  *(int *)(dst + stride) = _mm_cvtsi128_si32(avg3);
+  *(int *)(dst + 2 * stride) = _mm_cvtsi128_si32(rows23);
+  *(int *)(dst + 3 * stride) = _mm_cvtsi128_si32(_mm_srli_si128(rows23, 4));
+}
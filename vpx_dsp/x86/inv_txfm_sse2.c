@@ -4058,4 +4058,70 @@ void vpx_highbd_idct16x16_10_add_sse2(const tran_low_t *input, uint8_t *dest8,
     }
   }
 }
+
+// Adds the residual |a1| of a DC only block to the |size|x|size| pixels at
+// |dest|. Clamping |a1| to +/-(1 << bd) first lets the sum be done in 16 bits
+// without changing any clipped result.
+static void highbd_idct_dc_add_sse2(tran_high_t a1, uint16_t *dest, int stride,
+                                    int size, int bd) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i max = _mm_set1_epi16((1 << bd) - 1);
+  __m128i dc_value;
+  int i, j;
+
+  a1 = a1 > (1 << bd) ? (1 << bd) : a1 < -(1 << bd) ? -(1 << bd) : a1;
+  dc_value = _mm_set1_epi16((int16_t)a1);
+
+  for (i = 0; i < size; ++i) {
+    if (size == 4) {
+      __m128i d = _mm_loadl_epi64((const __m128i *)dest);
+      d = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(d, dc_value), zero), max);
+      _mm_storel_epi64((__m128i *)dest, d);
+    } else {
+      for (j = 0; j < size; j += 8) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dest + j));
+        d = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(d, dc_value), zero),
+                          max);
+        _mm_storeu_si128((__m128i *)(dest + j), d);
+      }
+    }
+    dest += stride;
+  }
+}
+
+void vpx_highbd_idct4x4_1_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                   int stride, int bd) {
+  tran_low_t out = WRAPLOW(
+      highbd_dct_const_round_shift(input[0] * cospi_16_64, bd), bd);
+  out = WRAPLOW(highbd_dct_const_round_shift(out * cospi_16_64, bd), bd);
+  highbd_idct_dc_add_sse2(ROUND_POWER_OF_TWO(out, 4),
+                          CONVERT_TO_SHORTPTR(dest8), stride, 4, bd);
+}
+
+void vpx_highbd_idct8x8_1_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                   int stride, int bd) {
+  tran_low_t out = WRAPLOW(
+      highbd_dct_const_round_shift(input[0] * cospi_16_64, bd), bd);
+  out = WRAPLOW(highbd_dct_const_round_shift(out * cospi_16_64, bd), bd);
+  highbd_idct_dc_add_sse2(ROUND_POWER_OF_TWO(out, 5),
+                          CONVERT_TO_SHORTPTR(dest8), stride, 8, bd);
+}
+
+void vpx_highbd_idct16x16_1_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int bd) {
+  tran_low_t out = WRAPLOW(
+      highbd_dct_const_round_shift(input[0] * cospi_16_64, bd), bd);
+  out = WRAPLOW(highbd_dct_const_round_shift(out * cospi_16_64, bd), bd);
+  highbd_idct_dc_add_sse2(ROUND_POWER_OF_TWO(out, 6),
+                          CONVERT_TO_SHORTPTR(dest8), stride, 16, bd);
+}
+
+void vpx_highbd_idct32x32_1_add_sse2(const tran_low_t *input, uint8_t *dest8,
+                                     int stride, int bd) {
+  tran_low_t out = WRAPLOW(
+      highbd_dct_const_round_shift(input[0] * cospi_16_64, bd), bd);
+  out = WRAPLOW(highbd_dct_const_round_shift(out * cospi_16_64, bd), bd);
+  highbd_idct_dc_add_sse2(ROUND_POWER_OF_TWO(out, 6),
+                          CONVERT_TO_SHORTPTR(dest8), stride, 32, bd);
+}
 #endif  // CONFIG_VP9_HIGHBITDEPTH
@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// 16 coefficients per iteration. Unlike the SSE2 and SSSE3 versions these
+// follow the C code when abs_coeff + round + the quant product doesn't fit
+// in a signed 16 bit value, and for the largest 32x32 quant_shift values,
+// by taking the quant_shift product unsigned. The eob is the maximum of
+// iscan + 1 over the lanes with a nonzero qcoeff.
+
+typedef struct {
+  __m256i zbin;
+  __m256i round;
+  __m256i quant;
+  __m256i shift;
+  __m256i dequant;
+} QuantizeParams;
+
+// Loads the DC and AC values of |p| in the layout of the first 16
+// coefficients: the DC value in lane 0 and AC values in the rest.
+static INLINE __m256i load_dc_ac(const int16_t *p) {
+  const __m128i v = _mm_load_si128((const __m128i *)p);
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(v),
+                                 _mm_unpackhi_epi64(v, v), 1);
+}
+
+// Replaces the DC value of a load_dc_ac() register with an AC value.
+static INLINE __m256i ac_only(const __m256i v) {
+  return _mm256_permute2x128_si256(v, v, 0x11);
+}
+
+// Returns the low 16 bits of (a * b) >> 1 for unsigned a and b.
+static INLINE __m256i mul_half_epu16(const __m256i a, const __m256i b) {
+  return _mm256_or_si256(_mm256_srli_epi16(_mm256_mullo_epi16(a, b), 1),
+                         _mm256_slli_epi16(_mm256_mulhi_epu16(a, b), 15));
+}
+
+static INLINE void store_zero_16(int16_t *qcoeff_ptr, int16_t *dqcoeff_ptr) {
+  const __m256i zero = _mm256_setzero_si256();
+  _mm256_storeu_si256((__m256i *)qcoeff_ptr, zero);
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr, zero);
+}
+
+// Returns the maximum of the 16 lanes of |eob|.
+static INLINE uint16_t accumulate_eob(const __m256i eob) {
+  __m128i eob_8 = _mm_max_epi16(_mm256_castsi256_si128(eob),
+                                _mm256_extracti128_si256(eob, 1));
+  eob_8 = _mm_max_epi16(eob_8, _mm_srli_si128(eob_8, 8));
+  eob_8 = _mm_max_epi16(eob_8, _mm_srli_si128(eob_8, 4));
+  eob_8 = _mm_max_epi16(eob_8, _mm_srli_si128(eob_8, 2));
+  return (uint16_t)_mm_extract_epi16(eob_8, 0);
+}
+
+static INLINE void quantize_b_16(const int16_t *coeff_ptr,
+                                 const int16_t *iscan_ptr,
+                                 int16_t *qcoeff_ptr, int16_t *dqcoeff_ptr,
+                                 const QuantizeParams *p, int is_32x32,
+                                 __m256i *eob) {
+  const __m256i coeff = _mm256_loadu_si256((const __m256i *)coeff_ptr);
+  const __m256i coeff_sign = _mm256_srai_epi16(coeff, 15);
+  const __m256i abs_coeff = _mm256_abs_epi16(coeff);
+  const __m256i zbin_mask = _mm256_cmpgt_epi16(abs_coeff, p->zbin);
+  __m256i tmp, qcoeff, dqcoeff, nz_iscan;
+
+  // Nothing reaches the zero bin: skip the arithmetic.
+  if (_mm256_testz_si256(zbin_mask, zbin_mask)) {
+    store_zero_16(qcoeff_ptr, dqcoeff_ptr);
+    return;
+  }
+
+  tmp = _mm256_adds_epi16(abs_coeff, p->round);
+  tmp = _mm256_add_epi16(tmp, _mm256_mulhi_epi16(tmp, p->quant));
+  tmp = _mm256_mulhi_epu16(tmp, p->shift);
+  tmp = _mm256_and_si256(tmp, zbin_mask);
+
+  qcoeff = _mm256_sub_epi16(_mm256_xor_si256(tmp, coeff_sign), coeff_sign);
+  if (is_32x32) {
+    dqcoeff = mul_half_epu16(tmp, p->dequant);
+    dqcoeff = _mm256_sub_epi16(_mm256_xor_si256(dqcoeff, coeff_sign),
+                               coeff_sign);
+  } else {
+    dqcoeff = _mm256_mullo_epi16(qcoeff, p->dequant);
+  }
+  _mm256_storeu_si256((__m256i *)qcoeff_ptr, qcoeff);
+  _mm256_storeu_si256((__m256i *)dqcoeff_ptr, dqcoeff);
+
+  // iscan + 1 where the quantized value is nonzero, otherwise 0.
+  nz_iscan = _mm256_sub_epi16(
+      _mm256_loadu_si256((const __m256i *)iscan_ptr),
+      _mm256_cmpeq_epi16(tmp, tmp));
+  nz_iscan = _mm256_andnot_si256(
+      _mm256_cmpeq_epi16(tmp, _mm256_setzero_si256()), nz_iscan);
+  *eob = _mm256_max_epi16(*eob, nz_iscan);
+}
+
+static INLINE void quantize_b(const int16_t *coeff_ptr, intptr_t n_coeffs,
+                              int skip_block, const int16_t *zbin_ptr,
+                              const int16_t *round_ptr,
+                              const int16_t *quant_ptr,
+                              const int16_t *quant_shift_ptr,
+                              int16_t *qcoeff_ptr, int16_t *dqcoeff_ptr,
+                              const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                              const int16_t *iscan_ptr, int is_32x32) {
+  const __m256i one = _mm256_set1_epi16(1);
+  __m256i eob = _mm256_setzero_si256();
+  QuantizeParams p;
+  intptr_t i;
+
+  if (skip_block) {
+    for (i = 0; i < n_coeffs; i += 16)
+      store_zero_16(qcoeff_ptr + i, dqcoeff_ptr + i);
+    *eob_ptr = 0;
+    return;
+  }
+
+  p.zbin = load_dc_ac(zbin_ptr);
+  p.round = load_dc_ac(round_ptr);
+  p.quant = load_dc_ac(quant_ptr);
+  p.shift = load_dc_ac(quant_shift_ptr);
+  p.dequant = load_dc_ac(dequant_ptr);
+  if (is_32x32) {
+    // ROUND_POWER_OF_TWO(zbin, 1), ROUND_POWER_OF_TWO(round, 1), and a shift
+    // of 15 instead of 16 for the quant_shift product.
+    p.zbin = _mm256_srli_epi16(_mm256_add_epi16(p.zbin, one), 1);
+    p.round = _mm256_srli_epi16(_mm256_add_epi16(p.round, one), 1);
+    p.shift = _mm256_slli_epi16(p.shift, 1);
+  }
+  // abs_coeff >= zbin is tested as abs_coeff > zbin - 1.
+  p.zbin = _mm256_sub_epi16(p.zbin, one);
+
+  quantize_b_16(coeff_ptr, iscan_ptr, qcoeff_ptr, dqcoeff_ptr, &p, is_32x32,
+                &eob);
+
+  p.zbin = ac_only(p.zbin);
+  p.round = ac_only(p.round);
+  p.quant = ac_only(p.quant);
+  p.shift = ac_only(p.shift);
+  p.dequant = ac_only(p.dequant);
+  for (i = 16; i < n_coeffs; i += 16) {
+    quantize_b_16(coeff_ptr + i, iscan_ptr + i, qcoeff_ptr + i,
+                  dqcoeff_ptr + i, &p, is_32x32, &eob);
+  }
+
+  *eob_ptr = accumulate_eob(eob);
+}
+
+void vpx_quantize_b_avx2(const int16_t *coeff_ptr, intptr_t n_coeffs,
+                         int skip_block, const int16_t *zbin_ptr,
+                         const int16_t *round_ptr, const int16_t *quant_ptr,
+                         const int16_t *quant_shift_ptr, int16_t *qcoeff_ptr,
+                         int16_t *dqcoeff_ptr, const int16_t *dequant_ptr,
+                         uint16_t *eob_ptr, const int16_t *scan_ptr,
+                         const int16_t *iscan_ptr) {
+  (void)scan_ptr;
+  quantize_b(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr, quant_ptr,
+             quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr,
+             iscan_ptr, 0);
+}
+
+void vpx_quantize_b_32x32_avx2(const int16_t *coeff_ptr, intptr_t n_coeffs,
+                               int skip_block, const int16_t *zbin_ptr,
+                               const int16_t *round_ptr,
+                               const int16_t *quant_ptr,
+                               const int16_t *quant_shift_ptr,
+                               int16_t *qcoeff_ptr, int16_t *dqcoeff_ptr,
+                               const int16_t *dequant_ptr, uint16_t *eob_ptr,
+                               const int16_t *scan_ptr,
+                               const int16_t *iscan_ptr) {
+  (void)scan_ptr;
+  quantize_b(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr, quant_ptr,
+             quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr,
+             iscan_ptr, 1);
+}
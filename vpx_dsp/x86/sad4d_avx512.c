@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX512
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Loads 32 bytes from each of two rows into the low and high halves of a 512
+// bit register.
+static INLINE __m512i load_2x32(const uint8_t *p, int stride) {
+  const __m256i r0 = _mm256_loadu_si256((const __m256i *)p);
+  const __m256i r1 = _mm256_loadu_si256((const __m256i *)(p + stride));
+  return _mm512_inserti64x4(_mm512_castsi256_si512(r0), r1, 1);
+}
+
+static INLINE void store_sums(const __m512i sum[4], uint32_t res[4]) {
+  res[0] = (uint32_t)_mm512_reduce_add_epi64(sum[0]);
+  res[1] = (uint32_t)_mm512_reduce_add_epi64(sum[1]);
+  res[2] = (uint32_t)_mm512_reduce_add_epi64(sum[2]);
+  res[3] = (uint32_t)_mm512_reduce_add_epi64(sum[3]);
+}
+
+static INLINE void sad64xhx4d_avx512(const uint8_t *src, int src_stride,
+                                     const uint8_t *const ref[4],
+                                     int ref_stride, int h, uint32_t res[4]) {
+  __m512i sum[4];
+  int i, j;
+  for (j = 0; j < 4; j++)
+    sum[j] = _mm512_setzero_si512();
+  for (i = 0; i < h; i++) {
+    const __m512i src_reg = _mm512_loadu_si512((const void *)src);
+    for (j = 0; j < 4; j++) {
+      const __m512i ref_reg =
+          _mm512_loadu_si512((const void *)(ref[j] + i * ref_stride));
+      sum[j] = _mm512_add_epi64(sum[j], _mm512_sad_epu8(src_reg, ref_reg));
+    }
+    src += src_stride;
+  }
+  store_sums(sum, res);
+}
+
+static INLINE void sad32xhx4d_avx512(const uint8_t *src, int src_stride,
+                                     const uint8_t *const ref[4],
+                                     int ref_stride, int h, uint32_t res[4]) {
+  __m512i sum[4];
+  int i, j;
+  for (j = 0; j < 4; j++)
+    sum[j] = _mm512_setzero_si512();
+  // Two rows per iteration, one in each 256 bit half.
+  for (i = 0; i < h; i += 2) {
+    const __m512i src_reg = load_2x32(src, src_stride);
+    for (j = 0; j < 4; j++) {
+      const __m512i ref_reg = load_2x32(ref[j] + i * ref_stride, ref_stride);
+      sum[j] = _mm512_add_epi64(sum[j], _mm512_sad_epu8(src_reg, ref_reg));
+    }
+    src += src_stride << 1;
+  }
+  store_sums(sum, res);
+}
+
+void vpx_sad64x64x4d_avx512(const uint8_t *src, int src_stride,
+                            const uint8_t *const ref[], int ref_stride,
+                            uint32_t *res) {
+  sad64xhx4d_avx512(src, src_stride, ref, ref_stride, 64, res);
+}
+
+void vpx_sad64x32x4d_avx512(const uint8_t *src, int src_stride,
+                            const uint8_t *const ref[], int ref_stride,
+                            uint32_t *res) {
+  sad64xhx4d_avx512(src, src_stride, ref, ref_stride, 32, res);
+}
+
+void vpx_sad32x64x4d_avx512(const uint8_t *src, int src_stride,
+                            const uint8_t *const ref[], int ref_stride,
+                            uint32_t *res) {
+  sad32xhx4d_avx512(src, src_stride, ref, ref_stride, 64, res);
+}
+
+void vpx_sad32x32x4d_avx512(const uint8_t *src, int src_stride,
+                            const uint8_t *const ref[], int ref_stride,
+                            uint32_t *res) {
+  sad32xhx4d_avx512(src, src_stride, ref, ref_stride, 32, res);
+}
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX512
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Loads 32 bytes from each of two rows into the low and high halves of a 512
+// bit register.
+static INLINE __m512i load_2x32(const uint8_t *p, int stride) {
+  const __m256i r0 = _mm256_loadu_si256((const __m256i *)p);
+  const __m256i r1 = _mm256_loadu_si256((const __m256i *)(p + stride));
+  return _mm512_inserti64x4(_mm512_castsi256_si512(r0), r1, 1);
+}
+
+#define FSAD64_H(h) \
+unsigned int vpx_sad64x##h##_avx512(const uint8_t *src_ptr, \
+                                    int src_stride, \
+                                    const uint8_t *ref_ptr, \
+                                    int ref_stride) { \
+  int i; \
+  __m512i sum_sad = _mm512_setzero_si512(); \
+  for (i = 0; i < h; i++) { \
+    const __m512i src_reg = _mm512_loadu_si512((const void *)src_ptr); \
+    const __m512i ref_reg = _mm512_loadu_si512((const void *)ref_ptr); \
+    sum_sad = _mm512_add_epi64(sum_sad, _mm512_sad_epu8(src_reg, ref_reg)); \
+    src_ptr += src_stride; \
+    ref_ptr += ref_stride; \
+  } \
+  return (unsigned int)_mm512_reduce_add_epi64(sum_sad); \
+}
+
+#define FSAD32_H(h) \
+unsigned int vpx_sad32x##h##_avx512(const uint8_t *src_ptr, \
+                                    int src_stride, \
+                                    const uint8_t *ref_ptr, \
+                                    int ref_stride) { \
+  int i; \
+  __m512i sum_sad = _mm512_setzero_si512(); \
+  for (i = 0; i < h; i += 2) { \
+    const __m512i src_reg = load_2x32(src_ptr, src_stride); \
+    const __m512i ref_reg = load_2x32(ref_ptr, ref_stride); \
+    sum_sad = _mm512_add_epi64(sum_sad, _mm512_sad_epu8(src_reg, ref_reg)); \
+    src_ptr += src_stride << 1; \
+    ref_ptr += ref_stride << 1; \
+  } \
+  return (unsigned int)_mm512_reduce_add_epi64(sum_sad); \
+}
+
+FSAD64_H(64);
+FSAD64_H(32);
+FSAD32_H(64);
+FSAD32_H(32);
+
+#undef FSAD64_H
+#undef FSAD32_H
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// 8 blocks per iteration, with the 16 pixels of blocks 0-3 and 4-7 of each
+// row widened to 16 bits in separate registers. The remaining blocks are left
+// to the SSE2 version.
+
+typedef struct {
+  __m256i s, r, sq_s, sq_r, sxr;
+} BlockSums;
+
+static INLINE void accumulate_row(BlockSums *sums, const __m256i s,
+                                  const __m256i r) {
+  sums->s = _mm256_add_epi16(sums->s, s);
+  sums->r = _mm256_add_epi16(sums->r, r);
+  sums->sq_s = _mm256_add_epi32(sums->sq_s, _mm256_madd_epi16(s, s));
+  sums->sq_r = _mm256_add_epi32(sums->sq_r, _mm256_madd_epi16(r, r));
+  sums->sxr = _mm256_add_epi32(sums->sxr, _mm256_madd_epi16(s, r));
+}
+
+// Adds up the lane pairs of |lo|, holding blocks 0-3, and |hi|, holding
+// blocks 4-7, into the 8 block sums in order.
+static INLINE void store_8(uint32_t *dst, const __m256i lo, const __m256i hi) {
+  const __m256i sum = _mm256_hadd_epi32(lo, hi);
+  _mm256_storeu_si256((__m256i *)dst, _mm256_permute4x64_epi64(sum, 0xd8));
+}
+
+void vpx_ssim_parms_4x4_row_avx2(const uint8_t *s, int sp, const uint8_t *r,
+                                 int rp, int n, uint32_t *sum_s,
+                                 uint32_t *sum_r, uint32_t *sum_sq_s,
+                                 uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi16(1);
+  int i, k;
+
+  for (k = 0; k + 8 <= n; k += 8) {
+    BlockSums lo, hi;
+    lo.s = lo.r = lo.sq_s = lo.sq_r = lo.sxr = zero;
+    hi.s = hi.r = hi.sq_s = hi.sq_r = hi.sxr = zero;
+    for (i = 0; i < 4; ++i) {
+      const __m256i s8 =
+          _mm256_loadu_si256((const __m256i *)(s + i * sp + 4 * k));
+      const __m256i r8 =
+          _mm256_loadu_si256((const __m256i *)(r + i * rp + 4 * k));
+      accumulate_row(&lo, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(s8)),
+                     _mm256_cvtepu8_epi16(_mm256_castsi256_si128(r8)));
+      accumulate_row(&hi, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(s8, 1)),
+                     _mm256_cvtepu8_epi16(_mm256_extracti128_si256(r8, 1)));
+    }
+    store_8(sum_s + k, _mm256_madd_epi16(lo.s, one),
+            _mm256_madd_epi16(hi.s, one));
+    store_8(sum_r + k, _mm256_madd_epi16(lo.r, one),
+            _mm256_madd_epi16(hi.r, one));
+    store_8(sum_sq_s + k, lo.sq_s, hi.sq_s);
+    store_8(sum_sq_r + k, lo.sq_r, hi.sq_r);
+    store_8(sum_sxr + k, lo.sxr, hi.sxr);
+  }
+
+  if (k < n) {
+    vpx_ssim_parms_4x4_row_sse2(s + 4 * k, sp, r + 4 * k, rp, n - k,
+                                sum_s + k, sum_r + k, sum_sq_s + k,
+                                sum_sq_r + k, sum_sxr + k);
+  }
+}
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_ports/mem.h"
+
+// The pixels are widened to 16 bits, where the column sums of 4 rows fit, and
+// the products are summed in pairs by _mm_madd_epi16(). Lanes 2k and 2k + 1
+// of the 32 bit sums then make up block k.
+
+typedef struct {
+  __m128i s, r, sq_s, sq_r, sxr;
+} BlockSums;
+
+static INLINE void accumulate_row(BlockSums *sums, const __m128i s,
+                                  const __m128i r) {
+  sums->s = _mm_add_epi16(sums->s, s);
+  sums->r = _mm_add_epi16(sums->r, r);
+  sums->sq_s = _mm_add_epi32(sums->sq_s, _mm_madd_epi16(s, s));
+  sums->sq_r = _mm_add_epi32(sums->sq_r, _mm_madd_epi16(r, r));
+  sums->sxr = _mm_add_epi32(sums->sxr, _mm_madd_epi16(s, r));
+}
+
+// Sums of the 4 rows of 8 pixels at s and r. Only the first 4 pixels of each
+// row are read when |half| is set.
+static INLINE void sums_8x4(const uint8_t *s, int sp, const uint8_t *r,
+                            int rp, int half, BlockSums *sums) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i one = _mm_set1_epi16(1);
+  int i;
+
+  sums->s = sums->r = zero;
+  sums->sq_s = sums->sq_r = sums->sxr = zero;
+  for (i = 0; i < 4; ++i) {
+    const __m128i s8 = half ? _mm_cvtsi32_si128(*(const int *)(s + i * sp))
+                            : _mm_loadl_epi64((const __m128i *)(s + i * sp));
+    const __m128i r8 = half ? _mm_cvtsi32_si128(*(const int *)(r + i * rp))
+                            : _mm_loadl_epi64((const __m128i *)(r + i * rp));
+    accumulate_row(sums, _mm_unpacklo_epi8(s8, zero),
+                   _mm_unpacklo_epi8(r8, zero));
+  }
+  sums->s = _mm_madd_epi16(sums->s, one);
+  sums->r = _mm_madd_epi16(sums->r, one);
+}
+
+// Adds up the lane pairs of |lo| and |hi|, blocks 0, 1 and 2, 3.
+static INLINE __m128i add_pairs(const __m128i lo, const __m128i hi) {
+  const __m128 even = _mm_shuffle_ps(_mm_castsi128_ps(lo),
+                                     _mm_castsi128_ps(hi),
+                                     _MM_SHUFFLE(2, 0, 2, 0));
+  const __m128 odd = _mm_shuffle_ps(_mm_castsi128_ps(lo),
+                                    _mm_castsi128_ps(hi),
+                                    _MM_SHUFFLE(3, 1, 3, 1));
+  return _mm_add_epi32(_mm_castps_si128(even), _mm_castps_si128(odd));
+}
+
+static INLINE void store_4(uint32_t *dst, const __m128i lo, const __m128i hi) {
+  _mm_storeu_si128((__m128i *)dst, add_pairs(lo, hi));
+}
+
+// Stores block 0 of |v|, and block 1 unless |half| is set.
+static INLINE void store_2(uint32_t *dst, const __m128i v, int half) {
+  const __m128i sum = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+  dst[0] = _mm_cvtsi128_si32(sum);
+  if (!half)
+    dst[1] = _mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+}
+
+void vpx_ssim_parms_4x4_row_sse2(const uint8_t *s, int sp, const uint8_t *r,
+                                 int rp, int n, uint32_t *sum_s,
+                                 uint32_t *sum_r, uint32_t *sum_sq_s,
+                                 uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+  BlockSums lo, hi;
+  int k;
+
+  for (k = 0; k + 4 <= n; k += 4) {
+    sums_8x4(s + 4 * k, sp, r + 4 * k, rp, 0, &lo);
+    sums_8x4(s + 4 * k + 8, sp, r + 4 * k + 8, rp, 0, &hi);
+    store_4(sum_s + k, lo.s, hi.s);
+    store_4(sum_r + k, lo.r, hi.r);
+    store_4(sum_sq_s + k, lo.sq_s, hi.sq_s);
+    store_4(sum_sq_r + k, lo.sq_r, hi.sq_r);
+    store_4(sum_sxr + k, lo.sxr, hi.sxr);
+  }
+
+  for (; k < n; k += 2) {
+    const int half = k + 1 == n;
+    sums_8x4(s + 4 * k, sp, r + 4 * k, rp, half, &lo);
+    store_2(sum_s + k, lo.s, half);
+    store_2(sum_r + k, lo.r, half);
+    store_2(sum_sq_s + k, lo.sq_s, half);
+    store_2(sum_sq_r + k, lo.sq_r, half);
+    store_2(sum_sxr + k, lo.sxr, half);
+  }
+}
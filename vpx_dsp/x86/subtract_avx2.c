@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>  // AVX2
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+static INLINE void subtract_16(int16_t *diff, const uint8_t *src,
+                               const uint8_t *pred) {
+  const __m256i s =
+      _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)src));
+  const __m256i p =
+      _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)pred));
+  _mm256_storeu_si256((__m256i *)diff, _mm256_sub_epi16(s, p));
+}
+
+// The 64 wide blocks are the bulk of the work of vp9_subtract_plane(), so
+// their rows are unrolled.
+static void subtract_64xn(int rows, int16_t *diff, ptrdiff_t diff_stride,
+                          const uint8_t *src, ptrdiff_t src_stride,
+                          const uint8_t *pred, ptrdiff_t pred_stride) {
+  int r;
+  for (r = 0; r < rows; ++r) {
+    subtract_16(diff, src, pred);
+    subtract_16(diff + 16, src + 16, pred + 16);
+    subtract_16(diff + 32, src + 32, pred + 32);
+    subtract_16(diff + 48, src + 48, pred + 48);
+    diff += diff_stride;
+    src += src_stride;
+    pred += pred_stride;
+  }
+}
+
+static void subtract_32xn(int rows, int16_t *diff, ptrdiff_t diff_stride,
+                          const uint8_t *src, ptrdiff_t src_stride,
+                          const uint8_t *pred, ptrdiff_t pred_stride) {
+  int r;
+  for (r = 0; r < rows; ++r) {
+    subtract_16(diff, src, pred);
+    subtract_16(diff + 16, src + 16, pred + 16);
+    diff += diff_stride;
+    src += src_stride;
+    pred += pred_stride;
+  }
+}
+
+static void subtract_16xn(int rows, int16_t *diff, ptrdiff_t diff_stride,
+                          const uint8_t *src, ptrdiff_t src_stride,
+                          const uint8_t *pred, ptrdiff_t pred_stride) {
+  int r;
+  for (r = 0; r < rows; ++r) {
+    subtract_16(diff, src, pred);
+    diff += diff_stride;
+    src += src_stride;
+    pred += pred_stride;
+  }
+}
+
+// Two rows per iteration, one in each 128 bit lane.
+static void subtract_8xn(int rows, int16_t *diff, ptrdiff_t diff_stride,
+                         const uint8_t *src, ptrdiff_t src_stride,
+                         const uint8_t *pred, ptrdiff_t pred_stride) {
+  int r;
+  for (r = 0; r < rows; r += 2) {
+    const __m128i s = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)src),
+        _mm_loadl_epi64((const __m128i *)(src + src_stride)));
+    const __m128i p = _mm_unpacklo_epi64(
+        _mm_loadl_epi64((const __m128i *)pred),
+        _mm_loadl_epi64((const __m128i *)(pred + pred_stride)));
+    const __m256i d =
+        _mm256_sub_epi16(_mm256_cvtepu8_epi16(s), _mm256_cvtepu8_epi16(p));
+    _mm_storeu_si128((__m128i *)diff, _mm256_castsi256_si128(d));
+    _mm_storeu_si128((__m128i *)(diff + diff_stride),
+                     _mm256_extracti128_si256(d, 1));
+    diff += 2 * diff_stride;
+    src += 2 * src_stride;
+    pred += 2 * pred_stride;
+  }
+}
+
+static void subtract_4xn(int rows, int16_t *diff, ptrdiff_t diff_stride,
+                         const uint8_t *src, ptrdiff_t src_stride,
+                         const uint8_t *pred, ptrdiff_t pred_stride) {
+  int r;
+  for (r = 0; r < rows; ++r) {
+    const __m128i s =
+        _mm_cvtepu8_epi16(_mm_cvtsi32_si128(*(const int *)src));
+    const __m128i p =
+        _mm_cvtepu8_epi16(_mm_cvtsi32_si128(*(const int *)pred));
+    _mm_storel_epi64((__m128i *)diff, _mm_sub_epi16(s, p));
+    diff += diff_stride;
+    src += src_stride;
+    pred += pred_stride;
+  }
+}
+
+void vpx_subtract_block_avx2(int rows, int cols,
+                             int16_t *diff, ptrdiff_t diff_stride,
+                             const uint8_t *src, ptrdiff_t src_stride,
+                             const uint8_t *pred, ptrdiff_t pred_stride) {
+  if (cols == 64) {
+    subtract_64xn(rows, diff, diff_stride, src, src_stride, pred,
+                  pred_stride);
+  } else if (cols == 32) {
+    subtract_32xn(rows, diff, diff_stride, src, src_stride, pred,
+                  pred_stride);
+  } else if (cols == 16) {
+    subtract_16xn(rows, diff, diff_stride, src, src_stride, pred,
+                  pred_stride);
+  } else if (cols == 8 && !(rows & 1)) {
+    subtract_8xn(rows, diff, diff_stride, src, src_stride, pred,
+                 pred_stride);
+  } else if (cols == 4) {
+    subtract_4xn(rows, diff, diff_stride, src, src_stride, pred,
+                 pred_stride);
+  } else {
+    vpx_subtract_block_c(rows, cols, diff, diff_stride, src, src_stride,
+                         pred, pred_stride);
+  }
+}
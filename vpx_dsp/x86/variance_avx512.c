@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <immintrin.h>  // AVX512
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx/vpx_integer.h"
+
+// Adds the 16 bit differences |d_lo| and |d_hi| to the running sum and sum of
+// squares. Each 16 bit lane of |sum| receives two differences per call, so
+// it holds at most 128 calls' worth (64 rows) without overflowing.
+static INLINE void accumulate_diff(const __m512i d_lo, const __m512i d_hi,
+                                   __m512i *sum, __m512i *sse) {
+  *sum = _mm512_add_epi16(*sum, _mm512_add_epi16(d_lo, d_hi));
+  *sse = _mm512_add_epi32(*sse,
+                          _mm512_add_epi32(_mm512_madd_epi16(d_lo, d_lo),
+                                           _mm512_madd_epi16(d_hi, d_hi)));
+}
+
+static INLINE void accumulate_row(const __m512i src, const __m512i ref,
+                                  __m512i *sum, __m512i *sse) {
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i d_lo = _mm512_sub_epi16(_mm512_unpacklo_epi8(src, zero),
+                                        _mm512_unpacklo_epi8(ref, zero));
+  const __m512i d_hi = _mm512_sub_epi16(_mm512_unpackhi_epi8(src, zero),
+                                        _mm512_unpackhi_epi8(ref, zero));
+  accumulate_diff(d_lo, d_hi, sum, sse);
+}
+
+static INLINE void reduce(const __m512i sum, const __m512i sse,
+                          unsigned int *sse_out, int *sum_out) {
+  *sum_out = _mm512_reduce_add_epi32(_mm512_madd_epi16(sum,
+                                                       _mm512_set1_epi16(1)));
+  *sse_out = (unsigned int)_mm512_reduce_add_epi32(sse);
+}
+
+static INLINE __m512i load_2x32(const uint8_t *p, int stride) {
+  const __m256i r0 = _mm256_loadu_si256((const __m256i *)p);
+  const __m256i r1 = _mm256_loadu_si256((const __m256i *)(p + stride));
+  return _mm512_inserti64x4(_mm512_castsi256_si512(r0), r1, 1);
+}
+
+static void variance64_avx512(const uint8_t *src, int src_stride,
+                              const uint8_t *ref, int ref_stride, int h,
+                              unsigned int *sse, int *sum) {
+  __m512i vsum = _mm512_setzero_si512();
+  __m512i vsse = _mm512_setzero_si512();
+  int i;
+
+  for (i = 0; i < h; i++) {
+    accumulate_row(_mm512_loadu_si512((const void *)src),
+                   _mm512_loadu_si512((const void *)ref), &vsum, &vsse);
+    src += src_stride;
+    ref += ref_stride;
+  }
+  reduce(vsum, vsse, sse, sum);
+}
+
+static void variance32_avx512(const uint8_t *src, int src_stride,
+                              const uint8_t *ref, int ref_stride, int h,
+                              unsigned int *sse, int *sum) {
+  __m512i vsum = _mm512_setzero_si512();
+  __m512i vsse = _mm512_setzero_si512();
+  int i;
+
+  // Two rows per iteration, one in each 256 bit half.
+  for (i = 0; i < h; i += 2) {
+    accumulate_row(load_2x32(src, src_stride), load_2x32(ref, ref_stride),
+                   &vsum, &vsse);
+    src += src_stride << 1;
+    ref += ref_stride << 1;
+  }
+  reduce(vsum, vsse, sse, sum);
+}
+
+#define VAR(W, H, shift) \
+unsigned int vpx_variance##W##x##H##_avx512(const uint8_t *src, \
+                                            int src_stride, \
+                                            const uint8_t *ref, \
+                                            int ref_stride, \
+                                            unsigned int *sse) { \
+  int sum; \
+  variance##W##_avx512(src, src_stride, ref, ref_stride, H, sse, &sum); \
+  return *sse - (unsigned int)(((int64_t)sum * sum) >> shift); \
+}
+
+VAR(64, 64, 12)
+VAR(64, 32, 11)
+VAR(32, 64, 11)
+VAR(32, 32, 10)
+
+#undef VAR
+
+// The bilinear taps of vpx_dsp/variance.c are all multiples of 8, so the
+// filters below use them divided by 8 and round by 4 bits instead of 7.
+static INLINE __m512i round_filter(const __m512i x) {
+  return _mm512_srli_epi16(_mm512_add_epi16(x, _mm512_set1_epi16(8)), 4);
+}
+
+// Horizontally filters the 64 pixels at |src| into 16 bit values, in the
+// interleaved order of unpacklo/unpackhi.
+static INLINE void filter_row_h(const uint8_t *src, const __m512i filter,
+                                __m512i *lo, __m512i *hi) {
+  const __m512i a = _mm512_loadu_si512((const void *)src);
+  const __m512i b = _mm512_loadu_si512((const void *)(src + 1));
+  *lo = round_filter(_mm512_maddubs_epi16(_mm512_unpacklo_epi8(a, b), filter));
+  *hi = round_filter(_mm512_maddubs_epi16(_mm512_unpackhi_epi8(a, b), filter));
+}
+
+static INLINE __m512i filter_v(const __m512i prev, const __m512i cur,
+                               const __m512i f0, const __m512i f1) {
+  return round_filter(_mm512_add_epi16(_mm512_mullo_epi16(prev, f0),
+                                       _mm512_mullo_epi16(cur, f1)));
+}
+
+// Sub-pixel variance of a 64 pixel wide block, optionally averaged with the
+// 64 pixel wide |sec| first. Returns the sum of the differences.
+static int sub_pixel_variance64xh_avx512(const uint8_t *src, int src_stride,
+                                         int x_offset, int y_offset,
+                                         const uint8_t *dst, int dst_stride,
+                                         const uint8_t *sec, int h,
+                                         unsigned int *sse) {
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i hfilter =
+      _mm512_set1_epi16((int16_t)((x_offset << 9) | (16 - 2 * x_offset)));
+  const __m512i vf0 = _mm512_set1_epi16(16 - 2 * y_offset);
+  const __m512i vf1 = _mm512_set1_epi16(2 * y_offset);
+  __m512i vsum = zero;
+  __m512i vsse = zero;
+  __m512i prev_lo, prev_hi;
+  int i, sum;
+
+  filter_row_h(src, hfilter, &prev_lo, &prev_hi);
+  for (i = 0; i < h; i++) {
+    const __m512i d = _mm512_loadu_si512((const void *)dst);
+    __m512i cur_lo, cur_hi, v_lo, v_hi;
+
+    src += src_stride;
+    filter_row_h(src, hfilter, &cur_lo, &cur_hi);
+    v_lo = filter_v(prev_lo, cur_lo, vf0, vf1);
+    v_hi = filter_v(prev_hi, cur_hi, vf0, vf1);
+    if (sec != NULL) {
+      const __m512i s = _mm512_loadu_si512((const void *)sec);
+      v_lo = _mm512_avg_epu16(v_lo, _mm512_unpacklo_epi8(s, zero));
+      v_hi = _mm512_avg_epu16(v_hi, _mm512_unpackhi_epi8(s, zero));
+      sec += 64;
+    }
+    accumulate_diff(_mm512_sub_epi16(v_lo, _mm512_unpacklo_epi8(d, zero)),
+                    _mm512_sub_epi16(v_hi, _mm512_unpackhi_epi8(d, zero)),
+                    &vsum, &vsse);
+    prev_lo = cur_lo;
+    prev_hi = cur_hi;
+    dst += dst_stride;
+  }
+  reduce(vsum, vsse, sse, &sum);
+  return sum;
+}
+
+#define SUBPIX_VAR(H, shift) \
+unsigned int vpx_sub_pixel_variance64x##H##_avx512(const uint8_t *src, \
+                                                   int src_stride, \
+                                                   int x_offset, \
+                                                   int y_offset, \
+                                                   const uint8_t *dst, \
+                                                   int dst_stride, \
+                                                   unsigned int *sse) { \
+  const int se = sub_pixel_variance64xh_avx512(src, src_stride, x_offset, \
+                                               y_offset, dst, dst_stride, \
+                                               NULL, H, sse); \
+  return *sse - (unsigned int)(((int64_t)se * se) >> shift); \
+} \
+\
+unsigned int vpx_sub_pixel_avg_variance64x##H##_avx512(const uint8_t *src, \
+                                                       int src_stride, \
+                                                       int x_offset, \
+                                                       int y_offset, \
+                                                       const uint8_t *dst, \
+                                                       int dst_stride, \
+                                                       unsigned int *sse, \
+                                                       const uint8_t *sec) { \
+  const int se = sub_pixel_variance64xh_avx512(src, src_stride, x_offset, \
+                                               y_offset, dst, dst_stride, \
+                                               sec, H, sse); \
+  return *sse - (unsigned int)(((int64_t)se * se) >> shift); \
+}
+
+SUBPIX_VAR(64, 12)
+SUBPIX_VAR(32, 11)
+
+#undef SUBPIX_VAR
@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "./vpx_dsp_rtcd.h"
+#include "vpx_dsp/x86/convolve.h"
+#include "vpx_ports/mem.h"
+
+// Rows of 32 or 64 pixels are filtered one row per 512 bit register, using
+// byte masked loads and stores for the 32 pixel case. Narrower blocks and the
+// 2-tap filters go to the AVX2 versions.
+
+#if HAVE_AVX2 && HAVE_SSSE3
+DECLARE_ALIGNED(16, static const uint8_t, filt_global_avx512[4][16]) = {
+  { 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8 },
+  { 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10 },
+  { 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12 },
+  { 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14 }
+};
+
+// Splits the 8 taps into the four byte pairs maddubs multiplies by.
+static INLINE void load_filters(const int16_t *filter, __m512i f[4]) {
+  const __m128i taps = _mm_loadu_si128((const __m128i *)filter);
+  const __m512i taps8 = _mm512_broadcast_i32x4(_mm_packs_epi16(taps, taps));
+  f[0] = _mm512_shuffle_epi8(taps8, _mm512_set1_epi16(0x100u));
+  f[1] = _mm512_shuffle_epi8(taps8, _mm512_set1_epi16(0x302u));
+  f[2] = _mm512_shuffle_epi8(taps8, _mm512_set1_epi16(0x504u));
+  f[3] = _mm512_shuffle_epi8(taps8, _mm512_set1_epi16(0x706u));
+}
+
+// Sums the four tap pair products in the same order as the SSSE3 and AVX2
+// versions, so that the saturation behaves identically.
+static INLINE __m512i sum_taps(const __m512i p01, const __m512i p23,
+                               const __m512i p45, const __m512i p67) {
+  __m512i sum = _mm512_adds_epi16(p01, p67);
+  sum = _mm512_adds_epi16(sum, _mm512_min_epi16(p23, p45));
+  sum = _mm512_adds_epi16(sum, _mm512_max_epi16(p23, p45));
+  sum = _mm512_adds_epi16(sum, _mm512_set1_epi16(64));
+  return _mm512_srai_epi16(sum, 7);
+}
+
+// Filters 8 pixels per 128 bit lane from the 16 bytes of |src| in that lane.
+static INLINE __m512i filter_h8(const __m512i src, const __m512i filt[4],
+                                const __m512i f[4]) {
+  return sum_taps(
+      _mm512_maddubs_epi16(_mm512_shuffle_epi8(src, filt[0]), f[0]),
+      _mm512_maddubs_epi16(_mm512_shuffle_epi8(src, filt[1]), f[1]),
+      _mm512_maddubs_epi16(_mm512_shuffle_epi8(src, filt[2]), f[2]),
+      _mm512_maddubs_epi16(_mm512_shuffle_epi8(src, filt[3]), f[3]));
+}
+
+static void filter_block_h8_avx512(const uint8_t *src_ptr,
+                                   ptrdiff_t src_pitch,
+                                   uint8_t *output_ptr,
+                                   ptrdiff_t out_pitch,
+                                   int w, int h,
+                                   const int16_t *filter) {
+  const __mmask64 mask = w == 64 ? ~(__mmask64)0 : ((__mmask64)1 << w) - 1;
+  __m512i filt[4], f[4];
+  int i;
+
+  for (i = 0; i < 4; i++)
+    filt[i] = _mm512_broadcast_i32x4(
+        _mm_load_si128((const __m128i *)filt_global_avx512[i]));
+  load_filters(filter, f);
+
+  for (i = 0; i < h; i++) {
+    // Lane k of |src0| holds the 16 bytes starting 3 pixels before output
+    // pixel 16k, and lane k of |src1| the 16 bytes starting 5 pixels after
+    // it: the inputs of output pixels 16k..16k+7 and 16k+8..16k+15.
+    const __m512i src0 = _mm512_maskz_loadu_epi8(mask, src_ptr - 3);
+    const __m512i src1 = _mm512_maskz_loadu_epi8(mask, src_ptr + 5);
+    const __m512i res = _mm512_packus_epi16(filter_h8(src0, filt, f),
+                                            filter_h8(src1, filt, f));
+    _mm512_mask_storeu_epi8(output_ptr, mask, res);
+    src_ptr += src_pitch;
+    output_ptr += out_pitch;
+  }
+}
+
+static void filter_block_v8_avx512(const uint8_t *src_ptr,
+                                   ptrdiff_t src_pitch,
+                                   uint8_t *output_ptr,
+                                   ptrdiff_t out_pitch,
+                                   int w, int h,
+                                   const int16_t *filter) {
+  const __mmask64 mask = w == 64 ? ~(__mmask64)0 : ((__mmask64)1 << w) - 1;
+  __m512i f[4], rows[8];
+  int i;
+
+  load_filters(filter, f);
+  for (i = 0; i < 7; i++)
+    rows[i] = _mm512_maskz_loadu_epi8(mask, src_ptr + i * src_pitch);
+
+  for (i = 0; i < h; i++) {
+    __m512i lo, hi;
+    rows[7] = _mm512_maskz_loadu_epi8(mask, src_ptr + 7 * src_pitch);
+
+    lo = sum_taps(
+        _mm512_maddubs_epi16(_mm512_unpacklo_epi8(rows[0], rows[1]), f[0]),
+        _mm512_maddubs_epi16(_mm512_unpacklo_epi8(rows[2], rows[3]), f[1]),
+        _mm512_maddubs_epi16(_mm512_unpacklo_epi8(rows[4], rows[5]), f[2]),
+        _mm512_maddubs_epi16(_mm512_unpacklo_epi8(rows[6], rows[7]), f[3]));
+    hi = sum_taps(
+        _mm512_maddubs_epi16(_mm512_unpackhi_epi8(rows[0], rows[1]), f[0]),
+        _mm512_maddubs_epi16(_mm512_unpackhi_epi8(rows[2], rows[3]), f[1]),
+        _mm512_maddubs_epi16(_mm512_unpackhi_epi8(rows[4], rows[5]), f[2]),
+        _mm512_maddubs_epi16(_mm512_unpackhi_epi8(rows[6], rows[7]), f[3]));
+    _mm512_mask_storeu_epi8(output_ptr, mask, _mm512_packus_epi16(lo, hi));
+
+    rows[0] = rows[1];
+    rows[1] = rows[2];
+    rows[2] = rows[3];
+    rows[3] = rows[4];
+    rows[4] = rows[5];
+    rows[5] = rows[6];
+    rows[6] = rows[7];
+    src_ptr += src_pitch;
+    output_ptr += out_pitch;
+  }
+}
+
+void vpx_convolve8_horiz_avx512(const uint8_t *src, ptrdiff_t src_stride,
+                                uint8_t *dst, ptrdiff_t dst_stride,
+                                const int16_t *filter_x, int x_step_q4,
+                                const int16_t *filter_y, int y_step_q4,
+                                int w, int h) {
+  assert(filter_x[3] != 128);
+  assert(x_step_q4 == 16);
+  if ((w == 32 || w == 64) && (filter_x[0] || filter_x[1] || filter_x[2])) {
+    filter_block_h8_avx512(src, src_stride, dst, dst_stride, w, h, filter_x);
+  } else {
+    vpx_convolve8_horiz_avx2(src, src_stride, dst, dst_stride, filter_x,
+                             x_step_q4, filter_y, y_step_q4, w, h);
+  }
+}
+
+void vpx_convolve8_vert_avx512(const uint8_t *src, ptrdiff_t src_stride,
+                               uint8_t *dst, ptrdiff_t dst_stride,
+                               const int16_t *filter_x, int x_step_q4,
+                               const int16_t *filter_y, int y_step_q4,
+                               int w, int h) {
+  assert(filter_y[3] != 128);
+  assert(y_step_q4 == 16);
+  if ((w == 32 || w == 64) && (filter_y[0] || filter_y[1] || filter_y[2])) {
+    filter_block_v8_avx512(src - src_stride * 3, src_stride, dst, dst_stride,
+                           w, h, filter_y);
+  } else {
+    vpx_convolve8_vert_avx2(src, src_stride, dst, dst_stride, filter_x,
+                            x_step_q4, filter_y, y_step_q4, w, h);
+  }
+}
+
+// Unlike FUN_CONV_2D(), the 2-tap filters go straight to the AVX2 version,
+// so the 8-tap passes only ever see the 8-tap intermediate buffer.
+void vpx_convolve8_avx512(const uint8_t *src, ptrdiff_t src_stride,
+                          uint8_t *dst, ptrdiff_t dst_stride,
+                          const int16_t *filter_x, int x_step_q4,
+                          const int16_t *filter_y, int y_step_q4,
+                          int w, int h) {
+  assert(filter_x[3] != 128);
+  assert(filter_y[3] != 128);
+  assert(w <= 64);
+  assert(h <= 64);
+  assert(x_step_q4 == 16);
+  assert(y_step_q4 == 16);
+  if (filter_x[0] || filter_x[1] || filter_x[2] ||
+      filter_y[0] || filter_y[1] || filter_y[2]) {
+    DECLARE_ALIGNED(16, uint8_t, fdata2[64 * 71]);
+    vpx_convolve8_horiz_avx512(src - 3 * src_stride, src_stride, fdata2, 64,
+                               filter_x, x_step_q4, filter_y, y_step_q4,
+                               w, h + 7);
+    vpx_convolve8_vert_avx512(fdata2 + 3 * 64, 64, dst, dst_stride,
+                              filter_x, x_step_q4, filter_y, y_step_q4,
+                              w, h);
+  } else {
+    vpx_convolve8_avx2(src, src_stride, dst, dst_stride, filter_x,
+                       x_step_q4, filter_y, y_step_q4, w, h);
+  }
+}
+#endif  // HAVE_AVX2 && HAVE_SSSE3
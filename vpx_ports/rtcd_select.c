@@ -0,0 +1,437 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./vpx_config.h"
+#include "vpx/vpx_codec.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_mem/vpx_mem.h"
+#include "vpx_ports/mem.h"
+#include "vpx_ports/rtcd_select.h"
+#include "vpx_ports/system_state.h"
+#include "vpx_ports/vpx_once.h"
+#include "vpx_ports/vpx_timer.h"
+
+#define MAX_RULES 64
+#define MAX_PREFIX 64
+#define MAX_VARIANTS 16
+
+typedef struct {
+  char prefix[MAX_PREFIX];
+  const char *isa;
+  int deny;
+} IsaRule;
+
+static const char *const kIsaNames[] = {
+  "c", "mmx", "sse", "sse2", "sse3", "ssse3", "sse4_1", "avx", "avx2",
+  "avx512", "media", "neon", "neon_asm", "mips32", "mips64", "dspr2", "msa"
+};
+
+static IsaRule rules[MAX_RULES];
+static int num_rules;
+static int tuning;
+// Set once the first kernel has been selected, after which the rules can
+// no longer take effect.
+static int selected;
+
+static const char *find_isa(const char *isa, size_t len) {
+  size_t i;
+
+  for (i = 0; i < sizeof(kIsaNames) / sizeof(kIsaNames[0]); ++i) {
+    if (strlen(kIsaNames[i]) == len && !strncmp(kIsaNames[i], isa, len))
+      return kIsaNames[i];
+  }
+  return NULL;
+}
+
+static vpx_codec_err_t add_rule(const char *prefix, size_t prefix_len,
+                                const char *isa, size_t isa_len, int deny) {
+  IsaRule *rule;
+
+  if (prefix_len >= MAX_PREFIX)
+    return VPX_CODEC_INVALID_PARAM;
+  if (num_rules == MAX_RULES)
+    return VPX_CODEC_MEM_ERROR;
+  rule = &rules[num_rules];
+  rule->isa = find_isa(isa, isa_len);
+  if (!rule->isa)
+    return VPX_CODEC_INVALID_PARAM;
+  memcpy(rule->prefix, prefix, prefix_len);
+  rule->prefix[prefix_len] = '\0';
+  rule->deny = deny;
+  ++num_rules;
+  return VPX_CODEC_OK;
+}
+
+vpx_codec_err_t vpx_codec_set_kernel_isa(const char *kernels,
+                                         const char *isa,
+                                         vpx_kernel_isa_mode_t mode) {
+  if (!kernels || !isa || !find_isa(isa, strlen(isa)) ||
+      (mode != VPX_KERNEL_ISA_DENY && mode != VPX_KERNEL_ISA_FORCE))
+    return VPX_CODEC_INVALID_PARAM;
+  if (selected)
+    return VPX_CODEC_ERROR;
+  return add_rule(kernels, strlen(kernels), isa, strlen(isa),
+                  mode == VPX_KERNEL_ISA_DENY);
+}
+
+vpx_codec_err_t vpx_codec_set_kernel_tuning(int enable) {
+  if (selected)
+    return VPX_CODEC_ERROR;
+  tuning = !!enable;
+  return VPX_CODEC_OK;
+}
+
+// Adds the rules of VPX_SIMD_KERNELS, e.g. "vpx_convolve8=-avx2,vpx_sad=sse2",
+// after those set through the API. Invalid entries are ignored.
+static void read_environment(void) {
+  const char *env = getenv("VPX_SIMD_KERNELS");
+
+  while (env && *env) {
+    const size_t len = strcspn(env, ",");
+    const char *const eq = (const char *)memchr(env, '=', len);
+
+    if (eq) {
+      const int deny = eq[1] == '-';
+      const char *const isa = eq + 1 + deny;
+      add_rule(env, eq - env, isa, env + len - isa, deny);
+    }
+    env += len;
+    if (*env)
+      ++env;
+  }
+
+  env = getenv("VPX_SIMD_TUNE");
+  if (env && *env)
+    tuning = atoi(env) != 0;
+}
+
+static int isa_matches(const char *rule_isa, const char *isa) {
+  // The NEON assembly variants need the same CPU support as the intrinsics.
+  return !strcmp(rule_isa, isa) ||
+         (!strcmp(rule_isa, "neon") && !strcmp(isa, "neon_asm"));
+}
+
+#if CONFIG_OS_SUPPORT
+// Kernel tuning: the candidates are timed on pseudo random blocks, through
+// a runner matching their prototype.
+
+#define kStride 160
+#define kRows 160
+#define kBorder 32
+#define kMinBatchUs 100
+#define kRounds 3
+
+typedef struct {
+  uint8_t *src;
+  uint8_t *ref;
+  uint8_t *dst;
+  int width;
+  int height;
+} TuneBlock;
+
+typedef void (*tune_runner_fn)(rtcd_fn_t fn, const TuneBlock *b, int n);
+
+DECLARE_ALIGNED(256, static const int16_t, filter_kernels[16][8]) = {
+  { 0, 0, 0, 128, 0, 0, 0, 0 },  { 0, 0, 0, 128, 0, 0, 0, 0 },
+  { 0, 0, 0, 128, 0, 0, 0, 0 },  { 0, 0, 0, 128, 0, 0, 0, 0 },
+  { 0, 0, 0, 128, 0, 0, 0, 0 },  { 0, 0, 0, 128, 0, 0, 0, 0 },
+  { 0, 0, 0, 128, 0, 0, 0, 0 },  { 0, 0, 0, 128, 0, 0, 0, 0 },
+  { -1, 6, -19, 78, 78, -19, 6, -1 }, { 0, 0, 0, 128, 0, 0, 0, 0 },
+  { 0, 0, 0, 128, 0, 0, 0, 0 },  { 0, 0, 0, 128, 0, 0, 0, 0 },
+  { 0, 0, 0, 128, 0, 0, 0, 0 },  { 0, 0, 0, 128, 0, 0, 0, 0 },
+  { 0, 0, 0, 128, 0, 0, 0, 0 },  { 0, 0, 0, 128, 0, 0, 0, 0 }
+};
+
+static volatile uint32_t sink;
+
+static void run_sad(rtcd_fn_t fn, const TuneBlock *b, int n) {
+  unsigned int (*const f)(const uint8_t *, int, const uint8_t *, int) =
+      (unsigned int (*)(const uint8_t *, int, const uint8_t *, int))fn;
+  unsigned int sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(b->src, kStride, b->ref, kStride);
+  sink = sum;
+}
+
+static void run_sad4d(rtcd_fn_t fn, const TuneBlock *b, int n) {
+  void (*const f)(const uint8_t *, int, const uint8_t *const *, int,
+                  uint32_t *) =
+      (void (*)(const uint8_t *, int, const uint8_t *const *, int,
+                uint32_t *))fn;
+  const uint8_t *refs[4];
+  uint32_t sads[4];
+  int i;
+  // Neighbouring positions, as in a motion search.
+  refs[0] = b->ref;
+  refs[1] = b->ref + 1;
+  refs[2] = b->ref + kStride;
+  refs[3] = b->ref + kStride + 1;
+  for (i = 0; i < n; ++i)
+    f(b->src, kStride, refs, kStride, sads);
+  sink = sads[0];
+}
+
+static void run_variance(rtcd_fn_t fn, const TuneBlock *b, int n) {
+  unsigned int (*const f)(const uint8_t *, int, const uint8_t *, int,
+                          unsigned int *) =
+      (unsigned int (*)(const uint8_t *, int, const uint8_t *, int,
+                        unsigned int *))fn;
+  unsigned int sse, sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(b->src, kStride, b->ref, kStride, &sse);
+  sink = sum + sse;
+}
+
+static void run_subpel_variance(rtcd_fn_t fn, const TuneBlock *b, int n) {
+  uint32_t (*const f)(const uint8_t *, int, int, int, const uint8_t *, int,
+                      uint32_t *) =
+      (uint32_t (*)(const uint8_t *, int, int, int, const uint8_t *, int,
+                    uint32_t *))fn;
+  uint32_t sse, sum = 0;
+  int i;
+  for (i = 0; i < n; ++i)
+    sum += f(b->src, kStride, 3, 5, b->ref, kStride, &sse);
+  sink = sum + sse;
+}
+
+static void run_convolve(rtcd_fn_t fn, const TuneBlock *b, int n) {
+  void (*const f)(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t,
+                  const int16_t *, int, const int16_t *, int, int, int) =
+      (void (*)(const uint8_t *, ptrdiff_t, uint8_t *, ptrdiff_t,
+                const int16_t *, int, const int16_t *, int, int, int))fn;
+  int i;
+  for (i = 0; i < n; ++i) {
+    f(b->src, kStride, b->dst, kStride, filter_kernels[8], 16,
+      filter_kernels[8], 16, b->width, b->height);
+  }
+}
+
+typedef struct {
+  const char *prototype;
+  tune_runner_fn run;
+  // Whether the high bitdepth kernels sharing the prototype can be timed.
+  int high_bitdepth;
+  // Block size for the kernels without one in their name.
+  int width;
+  int height;
+} TuneRunner;
+
+static const TuneRunner kTuneRunners[] = {
+  { "unsignedint(constuint8_t*,int,constuint8_t*,int)", run_sad, 1, 0, 0 },
+  { "void(constuint8_t*,int,constuint8_t*const*,int,uint32_t*)", run_sad4d,
+    1, 0, 0 },
+  { "unsignedint(constuint8_t*,int,constuint8_t*,int,unsignedint*)",
+    run_variance, 1, 0, 0 },
+  { "uint32_t(constuint8_t*,int,int,int,constuint8_t*,int,uint32_t*)",
+    run_subpel_variance, 1, 0, 0 },
+  { "void(constuint8_t*,ptrdiff_t,uint8_t*,ptrdiff_t,constint16_t*,int,"
+    "constint16_t*,int,int,int)", run_convolve, 0, 32, 32 },
+};
+
+// Reads the first "<width>x<height>" in |name|, as in vpx_sad16x8.
+static int parse_block_size(const char *name, int *width, int *height) {
+  const char *p;
+
+  for (p = name; *p; ++p) {
+    if (*p >= '0' && *p <= '9' && (p == name || p[-1] < '0' || p[-1] > '9')) {
+      char *end;
+      const long w = strtol(p, &end, 10);
+      if (*end == 'x' && end[1] >= '0' && end[1] <= '9') {
+        *width = (int)w;
+        *height = (int)strtol(end + 1, NULL, 10);
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+// Returns a kStride x kRows buffer of pseudo random pixels, or NULL.
+static void *alloc_pixels(int high_bitdepth, uint32_t *seed) {
+  const int count = kStride * kRows;
+  void *const p = vpx_memalign(32, count * (high_bitdepth ? 2 : 1));
+  int i;
+
+  if (!p)
+    return NULL;
+  for (i = 0; i < count; ++i) {
+    // 8-bit values are valid for every bit depth.
+    *seed = *seed * 1103515245 + 12345;
+    if (high_bitdepth)
+      ((uint16_t *)p)[i] = (*seed >> 16) & 0xff;
+    else
+      ((uint8_t *)p)[i] = (*seed >> 16) & 0xff;
+  }
+  return p;
+}
+
+static uint8_t *block_start(void *buf, int high_bitdepth) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (high_bitdepth)
+    return CONVERT_TO_BYTEPTR((uint16_t *)buf + kBorder * kStride + kBorder);
+#else
+  (void)high_bitdepth;
+#endif
+  return (uint8_t *)buf + kBorder * kStride + kBorder;
+}
+
+static int64_t time_batch(const TuneRunner *runner, rtcd_fn_t fn,
+                          const TuneBlock *b, int n) {
+  struct vpx_usec_timer timer;
+
+  vpx_usec_timer_start(&timer);
+  runner->run(fn, b, n);
+  vpx_usec_timer_mark(&timer);
+  return vpx_usec_timer_elapsed(&timer);
+}
+
+// Returns the index of the fastest of the |usable| variants, or -1 if
+// |function| has no runner.
+static int tune(const char *function, const char *prototype,
+                const rtcd_variant_t *variants, const int *usable,
+                int num_variants) {
+  const TuneRunner *runner = NULL;
+  const int high_bitdepth = strstr(function, "highbd") != NULL;
+  void *src = NULL, *ref = NULL, *dst = NULL;
+  int batch[MAX_VARIANTS];
+  double best_time[MAX_VARIANTS];
+  TuneBlock b;
+  uint32_t seed = 0x1234;
+  int best = -1, i, r;
+
+  for (i = 0; i < (int)(sizeof(kTuneRunners) / sizeof(kTuneRunners[0]));
+       ++i) {
+    if (!strcmp(kTuneRunners[i].prototype, prototype))
+      runner = &kTuneRunners[i];
+  }
+  if (!runner || (high_bitdepth && !runner->high_bitdepth))
+    return -1;
+  if (!parse_block_size(function, &b.width, &b.height)) {
+    b.width = runner->width;
+    b.height = runner->height;
+  }
+  if (b.width <= 0 || b.height <= 0 || b.width > 64 || b.height > 64)
+    return -1;
+
+  src = alloc_pixels(high_bitdepth, &seed);
+  ref = alloc_pixels(high_bitdepth, &seed);
+  dst = alloc_pixels(high_bitdepth, &seed);
+  if (src && ref && dst) {
+    b.src = block_start(src, high_bitdepth);
+    b.ref = block_start(ref, high_bitdepth);
+    b.dst = block_start(dst, high_bitdepth);
+
+    // Size the batches to take at least kMinBatchUs, then time each
+    // variant in turn kRounds times, keeping its best time.
+    for (i = 0; i < num_variants; ++i) {
+      if (!usable[i])
+        continue;
+      runner->run(variants[i].fn, &b, 1);
+      batch[i] = 16;
+      while (time_batch(runner, variants[i].fn, &b, batch[i]) < kMinBatchUs &&
+             batch[i] < (1 << 20))
+        batch[i] *= 2;
+      best_time[i] = -1;
+    }
+    for (r = 0; r < kRounds; ++r) {
+      for (i = 0; i < num_variants; ++i) {
+        double t;
+        if (!usable[i])
+          continue;
+        t = (double)time_batch(runner, variants[i].fn, &b, batch[i]) /
+            batch[i];
+        if (best_time[i] < 0 || t < best_time[i])
+          best_time[i] = t;
+      }
+    }
+    for (i = 0; i < num_variants; ++i) {
+      // Ties go to the later, preferred, variant.
+      if (usable[i] && (best < 0 || best_time[i] <= best_time[best]))
+        best = i;
+    }
+    vpx_clear_system_state();
+  }
+  vpx_free(src);
+  vpx_free(ref);
+  vpx_free(dst);
+  return best;
+}
+#endif  // CONFIG_OS_SUPPORT
+
+rtcd_fn_t vpx_rtcd_select(const char *function, const char *prototype,
+                          int cpu_flags, const rtcd_variant_t *variants,
+                          int num_variants) {
+  int usable[MAX_VARIANTS];
+  int forced = -1, choice = 0, num_usable = 0, i, r;
+
+  once(read_environment);
+  selected = 1;
+  if (num_variants > MAX_VARIANTS)
+    num_variants = MAX_VARIANTS;
+
+  for (i = 0; i < num_variants; ++i) {
+    usable[i] = !variants[i].cpu_flag || (cpu_flags & variants[i].cpu_flag);
+  }
+  for (r = 0; r < num_rules; ++r) {
+    const IsaRule *const rule = &rules[r];
+    if (strncmp(function, rule->prefix, strlen(rule->prefix)))
+      continue;
+    for (i = 0; i < num_variants; ++i) {
+      if (!isa_matches(rule->isa, variants[i].isa))
+        continue;
+      if (rule->deny) {
+        usable[i] = 0;
+        if (forced == i)
+          forced = -1;
+      } else if (!variants[i].cpu_flag ||
+                 (cpu_flags & variants[i].cpu_flag)) {
+        usable[i] = 1;
+        forced = i;
+      }
+    }
+  }
+  if (forced >= 0)
+    return variants[forced].fn;
+
+  // The last usable variant is the preferred one. If every variant has been
+  // denied, the default, which the CPU always supports, is kept.
+  for (i = 0; i < num_variants; ++i) {
+    if (usable[i]) {
+      choice = i;
+      ++num_usable;
+    }
+  }
+#if CONFIG_OS_SUPPORT
+  if (tuning && num_usable > 1) {
+    const int fastest = tune(function, prototype, variants, usable,
+                             num_variants);
+    if (fastest >= 0)
+      choice = fastest;
+  }
+#else
+  (void)prototype;
+  (void)num_usable;
+#endif
+  return variants[choice].fn;
+}
+
+void vpx_rtcd_select_reset(void) {
+  // The environment is only read once, keep it from adding its rules later.
+  once(read_environment);
+  num_rules = 0;
+  tuning = 0;
+  selected = 0;
+}
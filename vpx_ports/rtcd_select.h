@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VPX_PORTS_RTCD_SELECT_H_
+#define VPX_PORTS_RTCD_SELECT_H_
+
+#include "vpx/vpx_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*rtcd_fn_t)(void);
+
+typedef struct {
+  rtcd_fn_t fn;
+  // The extension the variant is written for, e.g. "sse2", or "c".
+  const char *isa;
+  // The CPU capability flag the variant needs, or 0 if it is always usable.
+  int cpu_flag;
+} rtcd_variant_t;
+
+// Returns the variant |function| dispatches to. |variants| lists the
+// variants linked in, starting with the default and then in increasing order
+// of preference. Without any rule set through vpx_codec_set_kernel_isa() or
+// VPX_SIMD_KERNELS, the last one |cpu_flags| supports is returned, unless
+// kernel tuning is enabled, in which case the fastest one is.
+// |prototype| is the type of |function| with the parameter names and spaces
+// removed, e.g. "unsignedint(constuint8_t*,int,constuint8_t*,int)".
+rtcd_fn_t vpx_rtcd_select(const char *function, const char *prototype,
+                          int cpu_flags, const rtcd_variant_t *variants,
+                          int num_variants);
+
+// Drops the rules and the tuning setting, so that new ones may be set before
+// the next vpx_rtcd_select(). The functions already selected are unchanged.
+// Only meant for tests.
+void vpx_rtcd_select_reset(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // VPX_PORTS_RTCD_SELECT_H_
@@ -151,6 +151,7 @@ static INLINE uint64_t xgetbv(void) {
 #define HAS_SSE4_1  0x20
 #define HAS_AVX     0x40
 #define HAS_AVX2    0x80
+#define HAS_AVX512  0x100
 #ifndef BIT
 #define BIT(n) (1<<n)
 #endif
@@ -205,6 +206,12 @@ x86_simd_caps(void) {
         cpuid(7, 0, reg_eax, reg_ebx, reg_ecx, reg_edx);
 
         if (reg_ebx & BIT(5)) flags |= HAS_AVX2;
+
+        // bits 16 (AVX-512F) & 30 (AVX-512BW), and the OS must save the
+        // opmask and ZMM state (XCR0 bits 5-7).
+        if ((reg_ebx & (BIT(16) | BIT(30))) == (BIT(16) | BIT(30)) &&
+            (xgetbv() & 0xe0) == 0xe0)
+          flags |= HAS_AVX512;
       }
     }
   }
@@ -235,6 +242,26 @@ x86_readtsc(void) {
 #endif
 }
 
+// 64-bit CPU cycle count
+static INLINE uint64_t
+x86_readtsc64(void) {
+#if defined(__GNUC__) && __GNUC__
+  uint32_t hi, lo;
+  __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+  return ((uint64_t)hi << 32) | lo;
+#elif defined(__SUNPRO_C) || defined(__SUNPRO_CC)
+  uint_t hi, lo;
+  asm volatile("rdtsc\n\t" : "=a"(lo), "=d"(hi));
+  return ((uint64_t)hi << 32) | lo;
+#else
+#if ARCH_X86_64
+  return (uint64_t)__rdtsc();
+#else
+  __asm  rdtsc;
+#endif
+#endif
+}
+
 
 #if defined(__GNUC__) && __GNUC__
 #define x86_pause_hint()\
@@ -8,6 +8,11 @@ SCALE_SRCS-$(CONFIG_SPATIAL_RESAMPLING) += generic/gen_scalers.c
 SCALE_SRCS-yes += vpx_scale_rtcd.c
 SCALE_SRCS-yes += vpx_scale_rtcd.pl
 
+#x86
+ifneq ($(filter yes,$(CONFIG_VP9) $(CONFIG_VP10)),)
+SCALE_SRCS-$(HAVE_AVX2) += x86/yv12extend_avx2.c
+endif
+
 #mips(dspr2)
 SCALE_SRCS-$(HAVE_DSPR2)  += mips/dspr2/yv12extend_dspr2.c
 
@@ -24,9 +24,9 @@ add_proto qw/void vpx_yv12_copy_y/, "const struct yv12_buffer_config *src_ybc, s
 
 if ((vpx_config("CONFIG_VP9") eq "yes") || (vpx_config("CONFIG_VP10") eq "yes")) {
     add_proto qw/void vpx_extend_frame_borders/, "struct yv12_buffer_config *ybf";
-    specialize qw/vpx_extend_frame_borders dspr2/;
+    specialize qw/vpx_extend_frame_borders dspr2 avx2/;
 
     add_proto qw/void vpx_extend_frame_inner_borders/, "struct yv12_buffer_config *ybf";
-    specialize qw/vpx_extend_frame_inner_borders dspr2/;
+    specialize qw/vpx_extend_frame_inner_borders dspr2 avx2/;
 }
 1;
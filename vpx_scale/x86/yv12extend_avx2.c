@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2016 The WebM project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <assert.h>
+#include <immintrin.h>  // AVX2
+#include <string.h>
+
+#include "./vpx_config.h"
+#include "./vpx_scale_rtcd.h"
+#include "vpx/vpx_integer.h"
+#include "vpx_scale/yv12config.h"
+
+// Sets the |n| bytes at |dst| to |value|. Runs of 32 bytes or more are
+// written with 32 byte stores, the last one overlapping the one before it.
+static INLINE void set_run(uint8_t *dst, uint8_t value, int n) {
+  if (n >= 32) {
+    const __m256i v = _mm256_set1_epi8((char)value);
+    int i;
+    for (i = 0; i < n - 32; i += 32)
+      _mm256_storeu_si256((__m256i *)(dst + i), v);
+    _mm256_storeu_si256((__m256i *)(dst + n - 32), v);
+  } else {
+    memset(dst, value, n);
+  }
+}
+
+// Copies the |n| bytes at |src| to each of the |rows| rows from |dst| on.
+static INLINE void copy_rows(uint8_t *dst, const uint8_t *src, int stride,
+                             int n, int rows) {
+  int r, i;
+  if (n < 32) {
+    for (r = 0; r < rows; ++r)
+      memcpy(dst + r * stride, src, n);
+    return;
+  }
+  for (r = 0; r < rows; ++r) {
+    for (i = 0; i < n - 32; i += 32)
+      _mm256_storeu_si256((__m256i *)(dst + i),
+                          _mm256_loadu_si256((const __m256i *)(src + i)));
+    _mm256_storeu_si256(
+        (__m256i *)(dst + n - 32),
+        _mm256_loadu_si256((const __m256i *)(src + n - 32)));
+    dst += stride;
+  }
+}
+
+// Replicates the first and last pixels of the |width| pixel row at |row|
+// into |left| and |right| pixels either side of it.
+static INLINE void extend_row(uint8_t *row, int width, int left, int right) {
+  set_run(row - left, row[0], left);
+  set_run(row + width, row[width - 1], right);
+}
+
+static void extend_frame(YV12_BUFFER_CONFIG *const ybf, int ext_size) {
+  const int y_w = ybf->y_crop_width;
+  const int y_h = ybf->y_crop_height;
+  const int y_et = ext_size;
+  const int y_el = ext_size;
+  const int y_eb = y_et + ybf->y_height - ybf->y_crop_height;
+  const int y_er = y_el + ybf->y_width - ybf->y_crop_width;
+  const int c_w = ybf->uv_crop_width;
+  const int c_h = ybf->uv_crop_height;
+  const int ss_x = ybf->uv_width < ybf->y_width;
+  const int ss_y = ybf->uv_height < ybf->y_height;
+  const int c_et = ext_size >> ss_y;
+  const int c_el = ext_size >> ss_x;
+  const int c_eb = c_et + ybf->uv_height - ybf->uv_crop_height;
+  const int c_er = c_el + ybf->uv_width - ybf->uv_crop_width;
+  const int y_stride = ybf->y_stride;
+  const int c_stride = ybf->uv_stride;
+  uint8_t *const y = ybf->y_buffer;
+  uint8_t *const u = ybf->u_buffer;
+  uint8_t *const v = ybf->v_buffer;
+  int r;
+
+  assert(ybf->y_height - ybf->y_crop_height < 16);
+  assert(ybf->y_width - ybf->y_crop_width < 16);
+  assert(ybf->y_height - ybf->y_crop_height >= 0);
+  assert(ybf->y_width - ybf->y_crop_width >= 0);
+
+  // The left and right borders of all three planes are filled in one pass
+  // down the frame, taking a chroma row along with each luma row it covers.
+  for (r = 0; r < y_h; ++r) {
+    extend_row(y + r * y_stride, y_w, y_el, y_er);
+    if (!(r & ss_y) && (r >> ss_y) < c_h) {
+      const int offset = (r >> ss_y) * c_stride;
+      extend_row(u + offset, c_w, c_el, c_er);
+      extend_row(v + offset, c_w, c_el, c_er);
+    }
+  }
+  for (r = (y_h + ss_y) >> ss_y; r < c_h; ++r) {
+    extend_row(u + r * c_stride, c_w, c_el, c_er);
+    extend_row(v + r * c_stride, c_w, c_el, c_er);
+  }
+
+  // Then the first and last rows, now extended, are copied up and down.
+  copy_rows(y - y_et * y_stride - y_el, y - y_el, y_stride,
+            y_el + y_w + y_er, y_et);
+  copy_rows(y + y_h * y_stride - y_el, y + (y_h - 1) * y_stride - y_el,
+            y_stride, y_el + y_w + y_er, y_eb);
+  copy_rows(u - c_et * c_stride - c_el, u - c_el, c_stride,
+            c_el + c_w + c_er, c_et);
+  copy_rows(u + c_h * c_stride - c_el, u + (c_h - 1) * c_stride - c_el,
+            c_stride, c_el + c_w + c_er, c_eb);
+  copy_rows(v - c_et * c_stride - c_el, v - c_el, c_stride,
+            c_el + c_w + c_er, c_et);
+  copy_rows(v + c_h * c_stride - c_el, v + (c_h - 1) * c_stride - c_el,
+            c_stride, c_el + c_w + c_er, c_eb);
+}
+
+void vpx_extend_frame_borders_avx2(YV12_BUFFER_CONFIG *ybf) {
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (ybf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    vpx_extend_frame_borders_c(ybf);
+    return;
+  }
+#endif
+  extend_frame(ybf, ybf->border);
+}
+
+void vpx_extend_frame_inner_borders_avx2(YV12_BUFFER_CONFIG *ybf) {
+  const int inner_bw = (ybf->border > VP9INNERBORDERINPIXELS) ?
+                       VP9INNERBORDERINPIXELS : ybf->border;
+#if CONFIG_VP9_HIGHBITDEPTH
+  if (ybf->flags & YV12_FLAG_HIGHBITDEPTH) {
+    vpx_extend_frame_inner_borders_c(ybf);
+    return;
+  }
+#endif
+  extend_frame(ybf, inner_bw);
+}
@@ -22,11 +22,13 @@
 #endif
 
 #include "./args.h"
+#include "./async_writer.h"
 #include "./ivfdec.h"
 
 #include "vpx/vpx_decoder.h"
 #include "vpx_ports/mem_ops.h"
 #include "vpx_ports/vpx_timer.h"
+#include "vpx_util/vpx_thread.h"
 
 #if CONFIG_VP8_DECODER || CONFIG_VP9_DECODER || CONFIG_VP10_DECODER
 #include "vpx/vp8dx.h"
@@ -42,6 +44,9 @@
 
 static const char *exec_name;
 
+// Number of decoded frames that can wait to be written out.
+static const int kOutputQueueSize = 8;
+
 struct VpxDecInputContext {
   struct VpxInputContext *vpx_input_ctx;
   struct WebmInputContext *webm_ctx;
@@ -355,13 +360,36 @@ struct ExternalFrameBuffer {
   uint8_t* data;
   size_t size;
   int in_use;
+  // Number of queued output frames that still read from the buffer.
+  int held;
 };
 
 struct ExternalFrameBufferList {
   int num_external_frame_buffers;
   struct ExternalFrameBuffer *ext_fb;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_t mutex;
+  // Signalled when a buffer that was held for output becomes free.
+  pthread_cond_t released;
+#endif
 };
 
+static void lock_frame_buffers(struct ExternalFrameBufferList *ext_fb_list) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_lock(&ext_fb_list->mutex);
+#else
+  (void)ext_fb_list;
+#endif
+}
+
+static void unlock_frame_buffers(struct ExternalFrameBufferList *ext_fb_list) {
+#if CONFIG_MULTITHREAD
+  pthread_mutex_unlock(&ext_fb_list->mutex);
+#else
+  (void)ext_fb_list;
+#endif
+}
+
 // Callback used by libvpx to request an external frame buffer. |cb_priv|
 // Application private data passed into the set function. |min_size| is the
 // minimum size in bytes needed to decode the next frame. |fb| pointer to the
@@ -371,33 +399,57 @@ static int get_vp9_frame_buffer(void *cb_priv, size_t min_size,
   int i;
   struct ExternalFrameBufferList *const ext_fb_list =
       (struct ExternalFrameBufferList *)cb_priv;
+  struct ExternalFrameBuffer *ext_fb;
   if (ext_fb_list == NULL)
     return -1;
 
-  // Find a free frame buffer.
-  for (i = 0; i < ext_fb_list->num_external_frame_buffers; ++i) {
-    if (!ext_fb_list->ext_fb[i].in_use)
+  lock_frame_buffers(ext_fb_list);
+  for (;;) {
+    int num_held = 0;
+
+    // Find a free frame buffer.
+    for (i = 0; i < ext_fb_list->num_external_frame_buffers; ++i) {
+      if (!ext_fb_list->ext_fb[i].in_use && !ext_fb_list->ext_fb[i].held)
+        break;
+      if (!ext_fb_list->ext_fb[i].in_use)
+        ++num_held;
+    }
+    if (i < ext_fb_list->num_external_frame_buffers || !num_held)
       break;
+#if CONFIG_MULTITHREAD
+    // The decoder is done with a buffer that is still being written out.
+    pthread_cond_wait(&ext_fb_list->released, &ext_fb_list->mutex);
+#endif
   }
 
-  if (i == ext_fb_list->num_external_frame_buffers)
+  if (i == ext_fb_list->num_external_frame_buffers) {
+    unlock_frame_buffers(ext_fb_list);
     return -1;
+  }
 
-  if (ext_fb_list->ext_fb[i].size < min_size) {
-    free(ext_fb_list->ext_fb[i].data);
-    ext_fb_list->ext_fb[i].data = (uint8_t *)calloc(min_size, sizeof(uint8_t));
-    if (!ext_fb_list->ext_fb[i].data)
+  ext_fb = &ext_fb_list->ext_fb[i];
+  ext_fb->in_use = 1;
+  unlock_frame_buffers(ext_fb_list);
+
+  if (ext_fb->size < min_size) {
+    free(ext_fb->data);
+    ext_fb->data = (uint8_t *)calloc(min_size, sizeof(uint8_t));
+    if (!ext_fb->data) {
+      ext_fb->size = 0;
+      lock_frame_buffers(ext_fb_list);
+      ext_fb->in_use = 0;
+      unlock_frame_buffers(ext_fb_list);
       return -1;
+    }
 
-    ext_fb_list->ext_fb[i].size = min_size;
+    ext_fb->size = min_size;
   }
 
-  fb->data = ext_fb_list->ext_fb[i].data;
-  fb->size = ext_fb_list->ext_fb[i].size;
-  ext_fb_list->ext_fb[i].in_use = 1;
+  fb->data = ext_fb->data;
+  fb->size = ext_fb->size;
 
   // Set the frame buffer's private data to point at the external frame buffer.
-  fb->priv = &ext_fb_list->ext_fb[i];
+  fb->priv = ext_fb;
   return 0;
 }
 
@@ -406,13 +458,49 @@ static int get_vp9_frame_buffer(void *cb_priv, size_t min_size,
 // to the frame buffer.
 static int release_vp9_frame_buffer(void *cb_priv,
                                     vpx_codec_frame_buffer_t *fb) {
+  struct ExternalFrameBufferList *const ext_fb_list =
+      (struct ExternalFrameBufferList *)cb_priv;
   struct ExternalFrameBuffer *const ext_fb =
       (struct ExternalFrameBuffer *)fb->priv;
-  (void)cb_priv;
+  lock_frame_buffers(ext_fb_list);
   ext_fb->in_use = 0;
+  unlock_frame_buffers(ext_fb_list);
   return 0;
 }
 
+// Returns the external frame buffer |img| was decoded into, or NULL if the
+// image lives in memory owned by the decoder.
+static struct ExternalFrameBuffer *find_image_frame_buffer(
+    const struct ExternalFrameBufferList *ext_fb_list, const vpx_image_t *img) {
+  int i;
+
+  for (i = 0; i < ext_fb_list->num_external_frame_buffers; ++i) {
+    struct ExternalFrameBuffer *const ext_fb = &ext_fb_list->ext_fb[i];
+    if (img->fb_priv == ext_fb && img->planes[VPX_PLANE_Y] >= ext_fb->data &&
+        img->planes[VPX_PLANE_Y] < ext_fb->data + ext_fb->size)
+      return ext_fb;
+  }
+  return NULL;
+}
+
+static void hold_frame_buffer(struct ExternalFrameBufferList *ext_fb_list,
+                              struct ExternalFrameBuffer *ext_fb) {
+  lock_frame_buffers(ext_fb_list);
+  ++ext_fb->held;
+  unlock_frame_buffers(ext_fb_list);
+}
+
+static void unhold_frame_buffer(struct ExternalFrameBufferList *ext_fb_list,
+                                struct ExternalFrameBuffer *ext_fb) {
+  lock_frame_buffers(ext_fb_list);
+  --ext_fb->held;
+#if CONFIG_MULTITHREAD
+  if (!ext_fb->held && !ext_fb->in_use)
+    pthread_cond_signal(&ext_fb_list->released);
+#endif
+  unlock_frame_buffers(ext_fb_list);
+}
+
 static void generate_filename(const char *pattern, char *out, size_t q_len,
                               unsigned int d_w, unsigned int d_h,
                               unsigned int frame_in) {
@@ -527,6 +615,125 @@ static FILE *open_outfile(const char *name) {
   }
 }
 
+// A decoded frame waiting to be written out.
+struct OutputFrame {
+  // Y4M headers to write ahead of the frame.
+  char header[2 * Y4M_BUFFER_SIZE];
+  size_t header_len;
+  int planes[3];
+  // Set when the frame goes to a file of its own.
+  char filename[PATH_MAX];
+  // |img| refers to the decoder's memory, which |held| keeps from being
+  // reused. Frames the decoder owns are written from the copy |img_copy|.
+  vpx_image_t img;
+  struct ExternalFrameBuffer *held;
+  vpx_image_t *img_copy;
+};
+
+struct OutputContext {
+  int do_md5;
+  FILE *outfile;
+  MD5Context md5_ctx;
+  struct ExternalFrameBufferList *ext_fb_list;
+  // The first file the writer thread failed to open, reported by the main
+  // thread.
+  char failed_filename[PATH_MAX];
+};
+
+static vpx_image_t *copy_image(const vpx_image_t *img) {
+  int plane, y;
+  vpx_image_t *const copy = vpx_img_alloc(NULL, img->fmt, img->d_w, img->d_h,
+                                          16);
+  const int bytes_per_sample =
+      (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+
+  if (copy == NULL)
+    fatal("Failed to allocate output frame");
+  copy->bit_depth = img->bit_depth;
+  copy->cs = img->cs;
+  copy->range = img->range;
+  for (plane = 0; plane < 3; ++plane) {
+    const int w = vpx_img_plane_width(img, plane) * bytes_per_sample;
+    const int h = vpx_img_plane_height(img, plane);
+
+    for (y = 0; y < h; ++y) {
+      memcpy(copy->planes[plane] + y * copy->stride[plane],
+             img->planes[plane] + y * img->stride[plane], w);
+    }
+  }
+  return copy;
+}
+
+static int write_output_frame(void *item, void *priv) {
+  struct OutputFrame *const frame = (struct OutputFrame *)item;
+  struct OutputContext *const output = (struct OutputContext *)priv;
+  const vpx_image_t *const img = frame->img_copy ? frame->img_copy :
+                                                   &frame->img;
+  int ok = 1;
+
+  if (frame->filename[0] == '\0') {
+    if (output->do_md5) {
+      if (frame->header_len > 0) {
+        MD5Update(&output->md5_ctx, (md5byte *)frame->header,
+                  (unsigned int)frame->header_len);
+      }
+      update_image_md5(img, frame->planes, &output->md5_ctx);
+    } else {
+      if (frame->header_len > 0)
+        fwrite(frame->header, 1, frame->header_len, output->outfile);
+      write_image_file(img, frame->planes, output->outfile);
+    }
+  } else {
+    if (output->do_md5) {
+      MD5Context md5_ctx;
+      unsigned char md5_digest[16];
+
+      MD5Init(&md5_ctx);
+      update_image_md5(img, frame->planes, &md5_ctx);
+      MD5Final(md5_digest, &md5_ctx);
+      print_md5(md5_digest, frame->filename);
+    } else {
+      FILE *const outfile = fopen(frame->filename, "wb");
+
+      if (outfile) {
+        write_image_file(img, frame->planes, outfile);
+        fclose(outfile);
+      } else {
+        // Only the first failure is kept, the main thread may be reading it.
+        if (output->failed_filename[0] == '\0') {
+          snprintf(output->failed_filename, sizeof(output->failed_filename),
+                   "%s", frame->filename);
+        }
+        ok = 0;
+      }
+    }
+  }
+
+  if (frame->held)
+    unhold_frame_buffer(output->ext_fb_list, frame->held);
+  if (frame->img_copy)
+    vpx_img_free(frame->img_copy);
+  free(frame);
+  return ok;
+}
+
+// Queues |img| for writing. The frame buffer it was decoded into is held
+// until it has been written, anything else is copied. Returns 0 if a frame
+// queued earlier failed to be written.
+static int queue_output_frame(struct AsyncWriter *writer,
+                               struct ExternalFrameBufferList *ext_fb_list,
+                               struct OutputFrame *frame,
+                               const vpx_image_t *img) {
+  frame->held = find_image_frame_buffer(ext_fb_list, img);
+  if (frame->held) {
+    hold_frame_buffer(ext_fb_list, frame->held);
+    frame->img = *img;
+  } else {
+    frame->img_copy = copy_image(img);
+  }
+  return async_writer_push(writer, frame);
+}
+
 #if CONFIG_VP9_HIGHBITDEPTH
 static int img_shifted_realloc_required(const vpx_image_t *img,
                                         const vpx_image_t *shifted,
@@ -580,13 +787,13 @@ static int main_loop(int argc, const char **argv_) {
 #endif
   int                     frame_avail, got_data, flush_decoder = 0;
   int                     num_external_frame_buffers = 0;
-  struct ExternalFrameBufferList ext_fb_list = {0, NULL};
+  struct ExternalFrameBufferList ext_fb_list;
 
   const char *outfile_pattern = NULL;
   char outfile_name[PATH_MAX] = {0};
-  FILE *outfile = NULL;
+  struct OutputContext output;
+  struct AsyncWriter *writer = NULL;
 
-  MD5Context md5_ctx;
   unsigned char md5_digest[16];
 
   struct VpxDecInputContext input = {NULL, NULL};
@@ -597,6 +804,8 @@ static int main_loop(int argc, const char **argv_) {
   input.webm_ctx = &webm_ctx;
 #endif
   input.vpx_input_ctx = &vpx_input_ctx;
+  memset(&ext_fb_list, 0, sizeof(ext_fb_list));
+  memset(&output, 0, sizeof(output));
 
   /* Parse command line */
   exec_name = argv_[0];
@@ -765,9 +974,9 @@ static int main_loop(int argc, const char **argv_) {
     generate_filename(outfile_pattern, outfile_name, PATH_MAX,
                       vpx_input_ctx.width, vpx_input_ctx.height, 0);
     if (do_md5)
-      MD5Init(&md5_ctx);
+      MD5Init(&output.md5_ctx);
     else
-      outfile = open_outfile(outfile_name);
+      output.outfile = open_outfile(outfile_name);
   }
 
   if (use_y4m && !noblit) {
@@ -860,19 +1069,43 @@ static int main_loop(int argc, const char **argv_) {
     arg_skip--;
   }
 
-  if (num_external_frame_buffers > 0) {
-    ext_fb_list.num_external_frame_buffers = num_external_frame_buffers;
+#if CONFIG_MULTITHREAD
+  pthread_mutex_init(&ext_fb_list.mutex, NULL);
+  pthread_cond_init(&ext_fb_list.released, NULL);
+#endif
+  // Frames are written out on a thread of their own. Decoding into our own
+  // frame buffers lets the queued frames be written without a copy.
+  if (num_external_frame_buffers > 0 || !noblit) {
+    ext_fb_list.num_external_frame_buffers = num_external_frame_buffers > 0 ?
+        num_external_frame_buffers :
+        VP9_MAXIMUM_REF_BUFFERS + VPX_MAXIMUM_WORK_BUFFERS + kOutputQueueSize;
     ext_fb_list.ext_fb = (struct ExternalFrameBuffer *)calloc(
-        num_external_frame_buffers, sizeof(*ext_fb_list.ext_fb));
+        ext_fb_list.num_external_frame_buffers, sizeof(*ext_fb_list.ext_fb));
     if (vpx_codec_set_frame_buffer_functions(
             &decoder, get_vp9_frame_buffer, release_vp9_frame_buffer,
             &ext_fb_list)) {
-      fprintf(stderr, "Failed to configure external frame buffers: %s\n",
-              vpx_codec_error(&decoder));
-      return EXIT_FAILURE;
+      if (num_external_frame_buffers > 0) {
+        fprintf(stderr, "Failed to configure external frame buffers: %s\n",
+                vpx_codec_error(&decoder));
+        return EXIT_FAILURE;
+      }
+      // The codec manages its own frame buffers, so the frames get copied.
+      free(ext_fb_list.ext_fb);
+      ext_fb_list.ext_fb = NULL;
+      ext_fb_list.num_external_frame_buffers = 0;
     }
   }
 
+  if (!noblit) {
+    output.do_md5 = do_md5;
+    output.ext_fb_list = &ext_fb_list;
+    output.failed_filename[0] = '\0';
+    writer = async_writer_create(kOutputQueueSize, write_output_frame,
+                                 &output);
+    if (!writer)
+      fatal("Failed to create output writer");
+  }
+
   frame_avail = 1;
   got_data = 0;
 
@@ -880,6 +1113,7 @@ static int main_loop(int argc, const char **argv_) {
   while (frame_avail || got_data) {
     vpx_codec_iter_t  iter = NULL;
     vpx_image_t    *img;
+    struct OutputFrame *frame;
     struct vpx_usec_timer timer;
     int                   corrupted = 0;
 
@@ -1016,35 +1250,29 @@ static int main_loop(int argc, const char **argv_) {
       }
 #endif
 
+      frame = (struct OutputFrame *)calloc(1, sizeof(*frame));
+      if (!frame)
+        fatal("Failed to allocate output frame");
+      memcpy(frame->planes, planes, sizeof(frame->planes));
+
       if (single_file) {
         if (use_y4m) {
-          char buf[Y4M_BUFFER_SIZE] = {0};
-          size_t len = 0;
           if (img->fmt == VPX_IMG_FMT_I440 || img->fmt == VPX_IMG_FMT_I44016) {
             fprintf(stderr, "Cannot produce y4m output for 440 sampling.\n");
+            free(frame);
             goto fail;
           }
           if (frame_out == 1) {
             // Y4M file header
-            len = y4m_write_file_header(buf, sizeof(buf),
-                                        vpx_input_ctx.width,
-                                        vpx_input_ctx.height,
-                                        &vpx_input_ctx.framerate,
-                                        img->fmt, img->bit_depth);
-            if (do_md5) {
-              MD5Update(&md5_ctx, (md5byte *)buf, (unsigned int)len);
-            } else {
-              fputs(buf, outfile);
-            }
+            frame->header_len = y4m_write_file_header(
+                frame->header, Y4M_BUFFER_SIZE, vpx_input_ctx.width,
+                vpx_input_ctx.height, &vpx_input_ctx.framerate, img->fmt,
+                img->bit_depth);
           }
 
           // Y4M frame header
-          len = y4m_write_frame_header(buf, sizeof(buf));
-          if (do_md5) {
-            MD5Update(&md5_ctx, (md5byte *)buf, (unsigned int)len);
-          } else {
-            fputs(buf, outfile);
-          }
+          frame->header_len += y4m_write_frame_header(
+              frame->header + frame->header_len, Y4M_BUFFER_SIZE);
         } else {
           if (frame_out == 1) {
             // Check if --yv12 or --i420 options are consistent with the
@@ -1053,6 +1281,7 @@ static int main_loop(int argc, const char **argv_) {
               if (img->fmt != VPX_IMG_FMT_I420 &&
                   img->fmt != VPX_IMG_FMT_I42016) {
                 fprintf(stderr, "Cannot produce i420 output for bit-stream.\n");
+                free(frame);
                 goto fail;
               }
             }
@@ -1060,31 +1289,19 @@ static int main_loop(int argc, const char **argv_) {
               if ((img->fmt != VPX_IMG_FMT_I420 &&
                    img->fmt != VPX_IMG_FMT_YV12) || img->bit_depth != 8) {
                 fprintf(stderr, "Cannot produce yv12 output for bit-stream.\n");
+                free(frame);
                 goto fail;
               }
             }
           }
         }
-
-        if (do_md5) {
-          update_image_md5(img, planes, &md5_ctx);
-        } else {
-          write_image_file(img, planes, outfile);
-        }
       } else {
-        generate_filename(outfile_pattern, outfile_name, PATH_MAX,
+        generate_filename(outfile_pattern, frame->filename, PATH_MAX,
                           img->d_w, img->d_h, frame_in);
-        if (do_md5) {
-          MD5Init(&md5_ctx);
-          update_image_md5(img, planes, &md5_ctx);
-          MD5Final(md5_digest, &md5_ctx);
-          print_md5(md5_digest, outfile_name);
-        } else {
-          outfile = open_outfile(outfile_name);
-          write_image_file(img, planes, outfile);
-          fclose(outfile);
-        }
       }
+
+      if (!queue_output_frame(writer, &ext_fb_list, frame, img))
+        fatal("Failed to open output file '%s'", output.failed_filename);
     }
   }
 
@@ -1098,6 +1315,10 @@ static int main_loop(int argc, const char **argv_) {
 
 fail:
 
+  // Writes out the queued frames.
+  if (!async_writer_destroy(writer))
+    fatal("Failed to open output file '%s'", output.failed_filename);
+
   if (vpx_codec_destroy(&decoder)) {
     fprintf(stderr, "Failed to destroy decoder: %s\n",
             vpx_codec_error(&decoder));
@@ -1106,10 +1327,10 @@ fail:
 
   if (!noblit && single_file) {
     if (do_md5) {
-      MD5Final(md5_digest, &md5_ctx);
+      MD5Final(md5_digest, &output.md5_ctx);
       print_md5(md5_digest, outfile_name);
     } else {
-      fclose(outfile);
+      fclose(output.outfile);
     }
   }
 
@@ -1130,6 +1351,10 @@ fail:
     free(ext_fb_list.ext_fb[i].data);
   }
   free(ext_fb_list.ext_fb);
+#if CONFIG_MULTITHREAD
+  pthread_cond_destroy(&ext_fb_list.released);
+  pthread_mutex_destroy(&ext_fb_list.mutex);
+#endif
 
   fclose(infile);
   free(argv);
@@ -29,6 +29,7 @@
 #endif
 
 #include "./args.h"
+#include "./async_writer.h"
 #include "./ivfenc.h"
 #include "./tools_common.h"
 
@@ -42,6 +43,8 @@
 #include "vpx/vpx_integer.h"
 #include "vpx_ports/mem_ops.h"
 #include "vpx_ports/vpx_timer.h"
+#include "vpx_util/vpx_thread.h"
+#include "./mmapinput.h"
 #include "./rate_hist.h"
 #include "./vpxstats.h"
 #include "./warnings.h"
@@ -66,6 +69,9 @@ static size_t wrap_fwrite(const void *ptr, size_t size, size_t nmemb,
 
 static const char *exec_name;
 
+// Number of compressed frames that can wait to be written out per stream.
+static const int kOutputQueueSize = 16;
+
 static void warn_or_exit_on_errorv(vpx_codec_ctx_t *ctx, int fatal,
                                    const char *s, va_list ap) {
   if (ctx->err) {
@@ -99,11 +105,59 @@ static void warn_or_exit_on_error(vpx_codec_ctx_t *ctx, int fatal,
   va_end(ap);
 }
 
-static int read_frame(struct VpxInputContext *input_ctx, vpx_image_t *img) {
+// Points the planes of |img| at the next raw frame in the mapped input.
+static int read_mapped_yuv_frame(struct VpxMappedInput *map,
+                                 vpx_image_t *img) {
+  const int bytespp = (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) ? 2 : 1;
+  size_t frame_size = 0;
+  size_t available;
+  uint8_t *data = mapped_input_peek(map, &available);
+  int plane;
+
+  for (plane = 0; plane < 3; ++plane)
+    frame_size += (size_t)vpx_img_plane_width(img, plane) *
+                  vpx_img_plane_height(img, plane) * bytespp;
+  if (available < frame_size)
+    return 0;
+
+  for (plane = 0; plane < 3; ++plane) {
+    const int w = vpx_img_plane_width(img, plane);
+    const int h = vpx_img_plane_height(img, plane);
+    int dst_plane = plane;
+
+    /* The planes are in Y,U,V order on disk. */
+    if (plane > 0 && img->fmt == VPX_IMG_FMT_YV12)
+      dst_plane = plane == 1 ? VPX_PLANE_V : VPX_PLANE_U;
+    img->planes[dst_plane] = data;
+    img->stride[dst_plane] = w * bytespp;
+    data += (size_t)w * h * bytespp;
+  }
+  mapped_input_consume(map, frame_size, frame_size);
+  return 1;
+}
+
+static int read_frame(struct VpxInputContext *input_ctx,
+                      struct VpxMappedInput *map, vpx_image_t *img) {
   FILE *f = input_ctx->file;
   y4m_input *y4m = &input_ctx->y4m;
   int shortread = 0;
 
+  if (mapped_input_is_open(map)) {
+    int frame_read;
+
+    if (input_ctx->file_type == FILE_TYPE_Y4M) {
+      size_t available;
+      uint8_t *const data = mapped_input_peek(map, &available);
+      const int size = y4m_input_fetch_frame_mem(y4m, data, available, img);
+      frame_read = size > 0;
+      if (frame_read)
+        mapped_input_consume(map, size, size);
+    } else {
+      frame_read = read_mapped_yuv_frame(map, img);
+    }
+    return frame_read;
+  }
+
   if (input_ctx->file_type == FILE_TYPE_Y4M) {
     if (y4m_input_fetch_frame(y4m, f, img) < 1)
       return 0;
@@ -829,6 +883,16 @@ struct stream_state {
   struct vpx_image         *img;
   vpx_codec_ctx_t           decoder;
   int                       mismatch_seen;
+#if CONFIG_MULTITHREAD
+  pthread_t                 thread;
+  int                       thread_started;
+#endif
+  struct VpxEncoderConfig  *global;
+  struct vpx_image         *frame_img;
+  unsigned int              frames_in;
+  struct AsyncWriter       *writer;
+  size_t                    ivf_frame_size;
+  int64_t                   ivf_header_pos;
 };
 
 
@@ -1011,6 +1075,24 @@ static void open_input_file(struct VpxInputContext *input) {
 }
 
 
+// Maps the frames of a regular input file. Other inputs are read with stdio.
+static void map_input_file(struct VpxInputContext *input,
+                           struct VpxMappedInput *map) {
+  // Raw frames start with the bytes read for file type detection.
+  const int64_t offset = ftello(input->file) -
+      (input->file_type == FILE_TYPE_RAW ? (int64_t)input->detect.buf_read : 0);
+  mapped_input_open(map, input->file, offset);
+}
+
+
+// The mapped input is read without moving the file position.
+static int64_t input_position(const struct VpxInputContext *input,
+                              const struct VpxMappedInput *map) {
+  return mapped_input_is_open(map) ? mapped_input_position(map)
+                                   : ftello(input->file);
+}
+
+
 static void close_input_file(struct VpxInputContext *input) {
   fclose(input->file);
   if (input->file_type == FILE_TYPE_Y4M)
@@ -1438,6 +1520,58 @@ static void show_stream_config(struct stream_state *stream,
 }
 
 
+// Writes a compressed frame packet queued by get_cx_data() to the output file
+// of the stream, on the stream's writer thread.
+static int write_frame_packet(void *item, void *priv) {
+  const vpx_codec_cx_pkt_t *const pkt = (const vpx_codec_cx_pkt_t *)item;
+  struct stream_state *const stream = (struct stream_state *)priv;
+
+#if CONFIG_WEBM_IO
+  if (stream->config.write_webm) {
+    write_webm_block(&stream->ebml, &stream->config.cfg, pkt);
+  }
+#endif
+  if (!stream->config.write_webm) {
+    if (pkt->data.frame.partition_id <= 0) {
+      stream->ivf_header_pos = ftello(stream->file);
+      stream->ivf_frame_size = pkt->data.frame.sz;
+
+      ivf_write_frame_header(stream->file, pkt->data.frame.pts,
+                             stream->ivf_frame_size);
+    } else {
+      stream->ivf_frame_size += pkt->data.frame.sz;
+
+      if (!(pkt->data.frame.flags & VPX_FRAME_IS_FRAGMENT)) {
+        const int64_t currpos = ftello(stream->file);
+        fseeko(stream->file, stream->ivf_header_pos, SEEK_SET);
+        ivf_write_frame_size(stream->file, stream->ivf_frame_size);
+        fseeko(stream->file, currpos, SEEK_SET);
+      }
+    }
+
+    (void) fwrite(pkt->data.frame.buf, 1, pkt->data.frame.sz,
+                  stream->file);
+  }
+  free(item);
+  return 1;
+}
+
+// Copies |pkt| and its data, which the encoder may overwrite once the
+// packets are retrieved, and queues them for writing.
+static void queue_frame_packet(struct stream_state *stream,
+                               const vpx_codec_cx_pkt_t *pkt) {
+  vpx_codec_cx_pkt_t *const copy =
+      (vpx_codec_cx_pkt_t *)malloc(sizeof(*copy) + pkt->data.frame.sz);
+
+  if (!copy)
+    fatal("Failed to allocate output packet");
+  *copy = *pkt;
+  copy->data.frame.buf = copy + 1;
+  memcpy(copy->data.frame.buf, pkt->data.frame.buf, pkt->data.frame.sz);
+  async_writer_push(stream->writer, copy);
+}
+
+
 static void open_output_file(struct stream_state *stream,
                              struct VpxEncoderConfig *global,
                              const struct VpxRational *pixel_aspect_ratio) {
@@ -1469,6 +1603,11 @@ static void open_output_file(struct stream_state *stream,
   if (!stream->config.write_webm) {
     ivf_write_file_header(stream->file, cfg, global->codec->fourcc, 0);
   }
+
+  stream->writer = async_writer_create(kOutputQueueSize, write_frame_packet,
+                                       stream);
+  if (!stream->writer)
+    fatal("Failed to create output writer");
 }
 
 
@@ -1479,6 +1618,10 @@ static void close_output_file(struct stream_state *stream,
   if (cfg->g_pass == VPX_RC_FIRST_PASS)
     return;
 
+  // Writes out the queued packets.
+  async_writer_destroy(stream->writer);
+  stream->writer = NULL;
+
 #if CONFIG_WEBM_IO
   if (stream->config.write_webm) {
     write_webm_file_footer(&stream->ebml);
@@ -1575,51 +1718,49 @@ static void initialize_encoder(struct stream_state *stream,
 }
 
 
-static void encode_frame(struct stream_state *stream,
-                         struct VpxEncoderConfig *global,
-                         struct vpx_image *img,
-                         unsigned int frames_in) {
-  vpx_codec_pts_t frame_start, next_frame_start;
+// Returns the input scaled to the stream resolution. Streams of the same
+// resolution share the image scaled for the first of them.
+static struct vpx_image *scale_input(struct stream_state *streams,
+                                     struct stream_state *stream,
+                                     struct vpx_image *img) {
   struct vpx_codec_enc_cfg *cfg = &stream->config.cfg;
-  struct vpx_usec_timer timer;
+  const struct stream_state *prev;
 
-  frame_start = (cfg->g_timebase.den * (int64_t)(frames_in - 1)
-                 * global->framerate.den)
-                / cfg->g_timebase.num / global->framerate.num;
-  next_frame_start = (cfg->g_timebase.den * (int64_t)(frames_in)
-                      * global->framerate.den)
-                     / cfg->g_timebase.num / global->framerate.num;
+  if (!img || (img->d_w == cfg->g_w && img->d_h == cfg->g_h))
+    return img;
+
+  for (prev = streams; prev != stream; prev = prev->next) {
+    if (prev->img && prev->img->d_w == cfg->g_w && prev->img->d_h == cfg->g_h)
+      return prev->img;
+  }
 
-  /* Scale if necessary */
 #if CONFIG_VP9_HIGHBITDEPTH
-  if (img) {
-    if ((img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) &&
-        (img->d_w != cfg->g_w || img->d_h != cfg->g_h)) {
-      if (img->fmt != VPX_IMG_FMT_I42016) {
-        fprintf(stderr, "%s can only scale 4:2:0 inputs\n", exec_name);
-        exit(EXIT_FAILURE);
-      }
+  if (img->fmt & VPX_IMG_FMT_HIGHBITDEPTH) {
+    if (img->fmt != VPX_IMG_FMT_I42016) {
+      fprintf(stderr, "%s can only scale 4:2:0 inputs\n", exec_name);
+      exit(EXIT_FAILURE);
+    }
 #if CONFIG_LIBYUV
-      if (!stream->img) {
-        stream->img = vpx_img_alloc(NULL, VPX_IMG_FMT_I42016,
-                                    cfg->g_w, cfg->g_h, 16);
-      }
-      I420Scale_16((uint16*)img->planes[VPX_PLANE_Y],
-                   img->stride[VPX_PLANE_Y]/2,
-                   (uint16*)img->planes[VPX_PLANE_U],
-                   img->stride[VPX_PLANE_U]/2,
-                   (uint16*)img->planes[VPX_PLANE_V],
-                   img->stride[VPX_PLANE_V]/2,
-                   img->d_w, img->d_h,
-                   (uint16*)stream->img->planes[VPX_PLANE_Y],
-                   stream->img->stride[VPX_PLANE_Y]/2,
-                   (uint16*)stream->img->planes[VPX_PLANE_U],
-                   stream->img->stride[VPX_PLANE_U]/2,
-                   (uint16*)stream->img->planes[VPX_PLANE_V],
-                   stream->img->stride[VPX_PLANE_V]/2,
-                   stream->img->d_w, stream->img->d_h,
-                   kFilterBox);
-      img = stream->img;
+    if (!stream->img) {
+      stream->img = vpx_img_alloc(NULL, VPX_IMG_FMT_I42016,
+                                  cfg->g_w, cfg->g_h, 16);
+    }
+    I420Scale_16((uint16*)img->planes[VPX_PLANE_Y],
+                 img->stride[VPX_PLANE_Y]/2,
+                 (uint16*)img->planes[VPX_PLANE_U],
+                 img->stride[VPX_PLANE_U]/2,
+                 (uint16*)img->planes[VPX_PLANE_V],
+                 img->stride[VPX_PLANE_V]/2,
+                 img->d_w, img->d_h,
+                 (uint16*)stream->img->planes[VPX_PLANE_Y],
+                 stream->img->stride[VPX_PLANE_Y]/2,
+                 (uint16*)stream->img->planes[VPX_PLANE_U],
+                 stream->img->stride[VPX_PLANE_U]/2,
+                 (uint16*)stream->img->planes[VPX_PLANE_V],
+                 stream->img->stride[VPX_PLANE_V]/2,
+                 stream->img->d_w, stream->img->d_h,
+                 kFilterBox);
+    img = stream->img;
 #else
     stream->encoder.err = 1;
     ctx_exit_on_error(&stream->encoder,
@@ -1628,10 +1769,9 @@ static void encode_frame(struct stream_state *stream,
                       "To enable, configure with --enable-libyuv\n",
                       stream->index);
 #endif
-    }
   }
 #endif
-  if (img && (img->d_w != cfg->g_w || img->d_h != cfg->g_h)) {
+  if (img->d_w != cfg->g_w || img->d_h != cfg->g_h) {
     if (img->fmt != VPX_IMG_FMT_I420 && img->fmt != VPX_IMG_FMT_YV12) {
       fprintf(stderr, "%s can only scale 4:2:0 8bpp inputs\n", exec_name);
       exit(EXIT_FAILURE);
@@ -1663,14 +1803,81 @@ static void encode_frame(struct stream_state *stream,
 #endif
   }
 
+  return img;
+}
+
+
+// Runs on the stream's encoder thread, so errors are left in the encoder
+// context for encode_frames() to report.
+static void encode_frame(struct stream_state *stream,
+                         struct VpxEncoderConfig *global,
+                         struct vpx_image *img,
+                         unsigned int frames_in) {
+  vpx_codec_pts_t frame_start, next_frame_start;
+  struct vpx_codec_enc_cfg *cfg = &stream->config.cfg;
+  struct vpx_usec_timer timer;
+
+  frame_start = (cfg->g_timebase.den * (int64_t)(frames_in - 1)
+                 * global->framerate.den)
+                / cfg->g_timebase.num / global->framerate.num;
+  next_frame_start = (cfg->g_timebase.den * (int64_t)(frames_in)
+                      * global->framerate.den)
+                     / cfg->g_timebase.num / global->framerate.num;
+
   vpx_usec_timer_start(&timer);
   vpx_codec_encode(&stream->encoder, img, frame_start,
                    (unsigned long)(next_frame_start - frame_start),
                    0, global->deadline);
   vpx_usec_timer_mark(&timer);
   stream->cx_time += vpx_usec_timer_elapsed(&timer);
-  ctx_exit_on_error(&stream->encoder, "Stream %d: Failed to encode frame",
-                    stream->index);
+}
+
+
+#if CONFIG_MULTITHREAD
+static THREADFN encode_frame_thread(void *arg) {
+  struct stream_state *const stream = (struct stream_state *)arg;
+  encode_frame(stream, stream->global, stream->frame_img, stream->frames_in);
+  return THREAD_RETURN(NULL);
+}
+#endif
+
+
+static void encode_frames(struct stream_state *streams,
+                          struct VpxEncoderConfig *global,
+                          struct vpx_image *img,
+                          unsigned int frames_in) {
+  struct stream_state *stream;
+
+  // The input and the scaled images are only read while the encoders run.
+  for (stream = streams; stream; stream = stream->next) {
+    stream->global = global;
+    stream->frame_img = scale_input(streams, stream, img);
+    stream->frames_in = frames_in;
+  }
+
+  // The last stream, and any stream whose thread can not be started, is
+  // encoded on the main thread.
+  for (stream = streams; stream; stream = stream->next) {
+#if CONFIG_MULTITHREAD
+    stream->thread_started = stream->next != NULL &&
+        !pthread_create(&stream->thread, NULL, encode_frame_thread, stream);
+    if (stream->thread_started)
+      continue;
+#endif
+    encode_frame(stream, global, stream->frame_img, frames_in);
+  }
+
+#if CONFIG_MULTITHREAD
+  for (stream = streams; stream; stream = stream->next) {
+    if (stream->thread_started)
+      pthread_join(stream->thread, NULL);
+  }
+#endif
+
+  for (stream = streams; stream; stream = stream->next) {
+    ctx_exit_on_error(&stream->encoder, "Stream %d: Failed to encode frame",
+                      stream->index);
+  }
 }
 
 
@@ -1694,9 +1901,6 @@ static void get_cx_data(struct stream_state *stream,
 
   *got_data = 0;
   while ((pkt = vpx_codec_get_cx_data(&stream->encoder, &iter))) {
-    static size_t fsize = 0;
-    static int64_t ivf_header_pos = 0;
-
     switch (pkt->kind) {
       case VPX_CODEC_CX_FRAME_PKT:
         if (!(pkt->data.frame.flags & VPX_FRAME_IS_FRAGMENT)) {
@@ -1706,31 +1910,7 @@ static void get_cx_data(struct stream_state *stream,
           fprintf(stderr, " %6luF", (unsigned long)pkt->data.frame.sz);
 
         update_rate_histogram(stream->rate_hist, cfg, pkt);
-#if CONFIG_WEBM_IO
-        if (stream->config.write_webm) {
-          write_webm_block(&stream->ebml, cfg, pkt);
-        }
-#endif
-        if (!stream->config.write_webm) {
-          if (pkt->data.frame.partition_id <= 0) {
-            ivf_header_pos = ftello(stream->file);
-            fsize = pkt->data.frame.sz;
-
-            ivf_write_frame_header(stream->file, pkt->data.frame.pts, fsize);
-          } else {
-            fsize += pkt->data.frame.sz;
-
-            if (!(pkt->data.frame.flags & VPX_FRAME_IS_FRAGMENT)) {
-              const int64_t currpos = ftello(stream->file);
-              fseeko(stream->file, ivf_header_pos, SEEK_SET);
-              ivf_write_frame_size(stream->file, fsize);
-              fseeko(stream->file, currpos, SEEK_SET);
-            }
-          }
-
-          (void) fwrite(pkt->data.frame.buf, 1, pkt->data.frame.sz,
-                        stream->file);
-        }
+        queue_frame_packet(stream, pkt);
         stream->nbytes += pkt->data.raw.sz;
 
         *got_data = 1;
@@ -1922,6 +2102,7 @@ int main(int argc, const char **argv_) {
   int frame_avail, got_data;
 
   struct VpxInputContext input;
+  struct VpxMappedInput input_map;
   struct VpxEncoderConfig global;
   struct stream_state *streams = NULL;
   char **argv, **argi;
@@ -2006,6 +2187,7 @@ int main(int argc, const char **argv_) {
     int64_t lagged_count = 0;
 
     open_input_file(&input);
+    map_input_file(&input, &input_map);
 
     /* If the input file doesn't specify its w/h (raw files), try to get
      * the data from the first stream's configuration.
@@ -2126,7 +2308,7 @@ int main(int argc, const char **argv_) {
       struct vpx_usec_timer timer;
 
       if (!global.limit || frames_in < global.limit) {
-        frame_avail = read_frame(&input, &raw);
+        frame_avail = read_frame(&input, &input_map, &raw);
 
         if (frame_avail)
           frames_in++;
@@ -2172,28 +2354,19 @@ int main(int argc, const char **argv_) {
         } else {
           frame_to_encode = &raw;
         }
-        vpx_usec_timer_start(&timer);
         if (use_16bit_internal) {
           assert(frame_to_encode->fmt & VPX_IMG_FMT_HIGHBITDEPTH);
-          FOREACH_STREAM({
-            if (stream->config.use_16bit_internal)
-              encode_frame(stream, &global,
-                           frame_avail ? frame_to_encode : NULL,
-                           frames_in);
-            else
-              assert(0);
-          });
+          FOREACH_STREAM(assert(stream->config.use_16bit_internal));
         } else {
           assert((frame_to_encode->fmt & VPX_IMG_FMT_HIGHBITDEPTH) == 0);
-          FOREACH_STREAM(encode_frame(stream, &global,
-                                      frame_avail ? frame_to_encode : NULL,
-                                      frames_in));
         }
+        vpx_usec_timer_start(&timer);
+        encode_frames(streams, &global,
+                      frame_avail ? frame_to_encode : NULL,
+                      frames_in);
 #else
         vpx_usec_timer_start(&timer);
-        FOREACH_STREAM(encode_frame(stream, &global,
-                                    frame_avail ? &raw : NULL,
-                                    frames_in));
+        encode_frames(streams, &global, frame_avail ? &raw : NULL, frames_in);
 #endif
         vpx_usec_timer_mark(&timer);
         cx_time += vpx_usec_timer_elapsed(&timer);
@@ -2205,7 +2378,8 @@ int main(int argc, const char **argv_) {
 
         if (!got_data && input.length && streams != NULL &&
             !streams->frames_out) {
-          lagged_count = global.limit ? seen_frames : ftello(input.file);
+          lagged_count = global.limit ? seen_frames
+                                      : input_position(&input, &input_map);
         } else if (input.length) {
           int64_t remaining;
           int64_t rate;
@@ -2217,7 +2391,7 @@ int main(int argc, const char **argv_) {
             remaining = 1000 * (global.limit - global.skip_frames
                                 - seen_frames + lagged_count);
           } else {
-            const int64_t input_pos = ftello(input.file);
+            const int64_t input_pos = input_position(&input, &input_map);
             const int64_t input_pos_lagged = input_pos - lagged_count;
             const int64_t limit = input.length;
 
@@ -2273,6 +2447,7 @@ int main(int argc, const char **argv_) {
       FOREACH_STREAM(vpx_codec_destroy(&stream->decoder));
     }
 
+    mapped_input_close(&input_map);
     close_input_file(&input);
 
     if (global.test_decode == TEST_DECODE_FATAL) {
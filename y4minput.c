@@ -989,13 +989,43 @@ void y4m_input_close(y4m_input *_y4m) {
   free(_y4m->aux_buf);
 }
 
-int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *_img) {
-  char frame[6];
+/*Points the image planes at a converted frame in _buf.*/
+static void y4m_input_set_img(y4m_input *_y4m, vpx_image_t *_img,
+                              unsigned char *_buf) {
   int  pic_sz;
   int  c_w;
   int  c_h;
   int  c_sz;
   int  bytes_per_sample = _y4m->bit_depth > 8 ? 2 : 1;
+  /*Fill in the frame buffer pointers.
+    We don't use vpx_img_wrap() because it forces padding for odd picture
+     sizes, which would require a separate fread call for every row.*/
+  memset(_img, 0, sizeof(*_img));
+  /*Y4M has the planes in Y'CbCr order, which libvpx calls Y, U, and V.*/
+  _img->fmt = _y4m->vpx_fmt;
+  _img->w = _img->d_w = _y4m->pic_w;
+  _img->h = _img->d_h = _y4m->pic_h;
+  _img->x_chroma_shift = _y4m->dst_c_dec_h >> 1;
+  _img->y_chroma_shift = _y4m->dst_c_dec_v >> 1;
+  _img->bps = _y4m->bps;
+
+  /*Set up the buffer pointers.*/
+  pic_sz = _y4m->pic_w * _y4m->pic_h * bytes_per_sample;
+  c_w = (_y4m->pic_w + _y4m->dst_c_dec_h - 1) / _y4m->dst_c_dec_h;
+  c_w *= bytes_per_sample;
+  c_h = (_y4m->pic_h + _y4m->dst_c_dec_v - 1) / _y4m->dst_c_dec_v;
+  c_sz = c_w * c_h;
+  _img->stride[VPX_PLANE_Y] = _img->stride[VPX_PLANE_ALPHA] =
+      _y4m->pic_w * bytes_per_sample;
+  _img->stride[VPX_PLANE_U] = _img->stride[VPX_PLANE_V] = c_w;
+  _img->planes[VPX_PLANE_Y] = _buf;
+  _img->planes[VPX_PLANE_U] = _buf + pic_sz;
+  _img->planes[VPX_PLANE_V] = _buf + pic_sz + c_sz;
+  _img->planes[VPX_PLANE_ALPHA] = _buf + pic_sz + 2 * c_sz;
+}
+
+int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *_img) {
+  char frame[6];
   /*Read and skip the frame header.*/
   if (!file_read(frame, 6, _fin)) return 0;
   if (memcmp(frame, "FRAME", 5)) {
@@ -1023,30 +1053,39 @@ int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *_img) {
   }
   /*Now convert the just read frame.*/
   (*_y4m->convert)(_y4m, _y4m->dst_buf, _y4m->aux_buf);
-  /*Fill in the frame buffer pointers.
-    We don't use vpx_img_wrap() because it forces padding for odd picture
-     sizes, which would require a separate fread call for every row.*/
-  memset(_img, 0, sizeof(*_img));
-  /*Y4M has the planes in Y'CbCr order, which libvpx calls Y, U, and V.*/
-  _img->fmt = _y4m->vpx_fmt;
-  _img->w = _img->d_w = _y4m->pic_w;
-  _img->h = _img->d_h = _y4m->pic_h;
-  _img->x_chroma_shift = _y4m->dst_c_dec_h >> 1;
-  _img->y_chroma_shift = _y4m->dst_c_dec_v >> 1;
-  _img->bps = _y4m->bps;
-
-  /*Set up the buffer pointers.*/
-  pic_sz = _y4m->pic_w * _y4m->pic_h * bytes_per_sample;
-  c_w = (_y4m->pic_w + _y4m->dst_c_dec_h - 1) / _y4m->dst_c_dec_h;
-  c_w *= bytes_per_sample;
-  c_h = (_y4m->pic_h + _y4m->dst_c_dec_v - 1) / _y4m->dst_c_dec_v;
-  c_sz = c_w * c_h;
-  _img->stride[VPX_PLANE_Y] = _img->stride[VPX_PLANE_ALPHA] =
-      _y4m->pic_w * bytes_per_sample;
-  _img->stride[VPX_PLANE_U] = _img->stride[VPX_PLANE_V] = c_w;
-  _img->planes[VPX_PLANE_Y] = _y4m->dst_buf;
-  _img->planes[VPX_PLANE_U] = _y4m->dst_buf + pic_sz;
-  _img->planes[VPX_PLANE_V] = _y4m->dst_buf + pic_sz + c_sz;
-  _img->planes[VPX_PLANE_ALPHA] = _y4m->dst_buf + pic_sz + 2 * c_sz;
+  y4m_input_set_img(_y4m, _img, _y4m->dst_buf);
   return 1;
 }
+
+int y4m_input_fetch_frame_mem(y4m_input *_y4m, unsigned char *_data,
+                              size_t _size, vpx_image_t *_img) {
+  size_t hdr_sz;
+  if (_size == 0) return 0;
+  /*Skip the frame header.*/
+  if (_size < 6 || memcmp(_data, "FRAME", 5)) {
+    fprintf(stderr, "Loss of framing in Y4M input data\n");
+    return -1;
+  }
+  for (hdr_sz = 5; hdr_sz < _size && hdr_sz < 85 && _data[hdr_sz] != '\n';
+       hdr_sz++) {}
+  if (hdr_sz == _size || _data[hdr_sz] != '\n') {
+    fprintf(stderr, "Error parsing Y4M frame header\n");
+    return -1;
+  }
+  hdr_sz++;
+  if (_size - hdr_sz < _y4m->dst_buf_read_sz + _y4m->aux_buf_read_sz) {
+    fprintf(stderr, "Error reading Y4M frame data.\n");
+    return -1;
+  }
+  if (_y4m->convert == y4m_convert_null && _y4m->aux_buf_read_sz == 0) {
+    /*The image points straight at the frame data.*/
+    y4m_input_set_img(_y4m, _img, _data + hdr_sz);
+  } else {
+    memcpy(_y4m->dst_buf, _data + hdr_sz, _y4m->dst_buf_read_sz);
+    memcpy(_y4m->aux_buf, _data + hdr_sz + _y4m->dst_buf_read_sz,
+           _y4m->aux_buf_read_sz);
+    (*_y4m->convert)(_y4m, _y4m->dst_buf, _y4m->aux_buf);
+    y4m_input_set_img(_y4m, _img, _y4m->dst_buf);
+  }
+  return (int)(hdr_sz + _y4m->dst_buf_read_sz + _y4m->aux_buf_read_sz);
+}
@@ -66,6 +66,12 @@ int y4m_input_open(y4m_input *_y4m, FILE *_fin, char *_skip, int _nskip,
                    int only_420);
 void y4m_input_close(y4m_input *_y4m);
 int y4m_input_fetch_frame(y4m_input *_y4m, FILE *_fin, vpx_image_t *img);
+/*Like y4m_input_fetch_frame(), but takes the frame from the _size bytes at
+   _data. Returns the number of bytes used, 0 at the end of the data, or -1 on
+   error. If the frame needs no conversion, the image planes point into
+   _data.*/
+int y4m_input_fetch_frame_mem(y4m_input *_y4m, unsigned char *_data,
+                              size_t _size, vpx_image_t *img);
 
 #ifdef __cplusplus
 }  // extern "C"